@@ -0,0 +1,41 @@
+#pragma once
+
+// Minimal benchmarking helpers for the native platform. Every benchmark is a standalone program, see build.sh.
+
+#if !defined(NATIVE)
+#    error "Benchmarks are only meant to be run on the native platform"
+#endif
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+
+namespace spn::benchmark {
+
+template<typename T>
+/// Prevent the compiler from optimizing away `value`
+inline void do_not_optimize(const T& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template<typename F>
+/// Returns the average time in nanoseconds a call to `f(i)` takes, measured over `iterations` calls
+double ns_per_op(size_t iterations, F&& f) {
+    for (size_t i = 0; i < iterations / 10 + 1; ++i)
+        f(i); // warm up
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < iterations; ++i)
+        f(i);
+    const auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(end - start).count() / static_cast<double>(iterations);
+}
+
+/// Print a single measurement
+inline void report(const char* name, double ns_per_op) { std::printf("%-48s %12.2f ns/op\n", name, ns_per_op); }
+
+/// Print a single measurement alongside a baseline measurement
+inline void report(const char* name, double ns_per_op, double baseline_ns_per_op) {
+    std::printf("%-48s %12.2f ns/op %8.2fx\n", name, ns_per_op, baseline_ns_per_op / ns_per_op);
+}
+
+} // namespace spn::benchmark
@@ -0,0 +1,27 @@
+#!/bin/sh
+
+set -e
+
+# Builds and runs every benchmark (or the ones provided as arguments) on the native platform.
+# It is assumed this script lives in the repository root folder called benchmark
+
+OD="$(pwd)" # original directory
+SD="$(dirname "$(realpath "$0")")" # script directory
+RD="$SD/.." # root directory
+D="$RD/build_benchmarks" # build directory
+trap "[ -d $D ] && rm -rf $D; cd $OD" EXIT INT TERM HUP QUIT
+
+export PLATFORMIO_BUILD_CACHE_DIR="$RD/.pio/build_cache"
+export PLATFORMIO_BUILD_FLAGS="-O2 -I$SD"
+
+cd $RD
+benchmarks="$@"
+[ -z "$benchmarks" ] && benchmarks=$(find benchmark -type f -name "*.cpp")
+
+for benchmark_file in $benchmarks; do
+    echo "--- BENCHMARKING: $benchmark_file"
+    mkdir $D
+    pio ci $benchmark_file --lib src --build-dir $D --keep-build-dir --project-conf platformio.ini -e native
+    $D/.pio/build/native/program
+    rm -rf $D
+done
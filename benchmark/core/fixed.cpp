@@ -0,0 +1,133 @@
+#include "benchmark.hpp"
+
+#include <spine/controller/implementations/pid/pid_controller.hpp>
+#include <spine/core/fixed.hpp>
+#include <spine/filter/implementations/ewma.hpp>
+#include <spine/filter/implementations/mapped_range.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+// Compares spn::fixed_q16 against float for the EWMA filter, the MappedRange filter and the PID controller: accuracy
+// (largest deviation from a double precision reference) and throughput. Note that the native platform has a hardware
+// FPU, so the throughput numbers only show the overhead of saturation; on FPU-less targets (e.g. Cortex-M0) float
+// arithmetic is emulated in software and fixed point is expected to win by a wide margin.
+
+namespace bm = spn::benchmark;
+using Q16 = spn::fixed_q16;
+
+namespace {
+
+constexpr size_t iterations = 5000000;
+constexpr size_t accuracy_samples = 10000;
+
+/// Deterministic noisy sensor signal between roughly 0 and 100
+double sample_at(size_t i) { return 50.0 + 40.0 * std::sin(static_cast<double>(i) * 0.01) + static_cast<double>(i % 7); }
+
+template<typename T>
+spn::filter::MappedRange<T> make_range() {
+    return spn::filter::MappedRange<T>({.input_lower_limit = 0,
+                                        .input_upper_limit = 100,
+                                        .output_lower_limit = -5,
+                                        .output_upper_limit = 5,
+                                        .throw_for_value_out_of_range = false});
+}
+
+template<typename T>
+/// Runs a PID loop against a first order plant for `steps` steps, calling `f(step, input)` after every update
+struct PIDLoop {
+    using PID = spn::controller::BasicPIDController<T>;
+
+    T input = 0;
+    T output = 0;
+    T setpoint = 50;
+    PID pid = PID(&input, &output, &setpoint, 2, 0.5f, 0.1f, PID::Direction::FORWARD);
+    k_time_ms now = HAL::millis();
+
+    PIDLoop() { pid.initialize(); }
+
+    void step() {
+        now += k_time_ms(100);
+        pid.update(now);
+        input += (output - input) / 10;
+    }
+};
+
+} // namespace
+
+int main() {
+    // accuracy
+    double ewma_error_float = 0, ewma_error_fixed = 0;
+    double range_error_float = 0, range_error_fixed = 0;
+    double pid_error_float = 0, pid_error_fixed = 0;
+    {
+        auto ewma_double = spn::filter::EWMA<double>({.K = 16});
+        auto ewma_float = spn::filter::EWMA<float>({.K = 16});
+        auto ewma_fixed = spn::filter::EWMA<Q16>({.K = 16});
+        auto range_double = make_range<double>();
+        auto range_float = make_range<float>();
+        auto range_fixed = make_range<Q16>();
+        for (size_t i = 0; i < accuracy_samples; ++i) {
+            const auto s = sample_at(i);
+            const auto reference = ewma_double.value(s);
+            ewma_error_float = std::max(ewma_error_float, std::fabs(reference - ewma_float.value(s)));
+            ewma_error_fixed = std::max(ewma_error_fixed, std::fabs(reference - double(ewma_fixed.value(Q16(s)))));
+
+            const auto mapped = range_double.value(s);
+            range_error_float = std::max(range_error_float, std::fabs(mapped - range_float.value(s)));
+            range_error_fixed = std::max(range_error_fixed, std::fabs(mapped - double(range_fixed.value(Q16(s)))));
+        }
+
+        auto pid_double = PIDLoop<double>();
+        auto pid_float = PIDLoop<float>();
+        auto pid_fixed = PIDLoop<Q16>();
+        for (size_t i = 0; i < accuracy_samples; ++i) {
+            pid_double.step();
+            pid_float.step();
+            pid_fixed.step();
+            pid_error_float = std::max(pid_error_float, std::fabs(pid_double.output - pid_float.output));
+            pid_error_fixed = std::max(pid_error_fixed, std::fabs(pid_double.output - double(pid_fixed.output)));
+        }
+    }
+
+    // throughput
+    auto ewma_float = spn::filter::EWMA<float>({.K = 16});
+    auto ewma_fixed = spn::filter::EWMA<Q16>({.K = 16});
+    const auto ewma_float_ns = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(ewma_float.value(static_cast<float>(i & 0x3f)));
+    });
+    const auto ewma_fixed_ns = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(ewma_fixed.value(Q16(static_cast<int>(i & 0x3f))));
+    });
+
+    auto range_float = make_range<float>();
+    auto range_fixed = make_range<Q16>();
+    const auto range_float_ns = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(range_float.value(static_cast<float>(i & 0x3f)));
+    });
+    const auto range_fixed_ns = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(range_fixed.value(Q16(static_cast<int>(i & 0x3f))));
+    });
+
+    auto pid_float = PIDLoop<float>();
+    auto pid_fixed = PIDLoop<Q16>();
+    const auto pid_float_ns = bm::ns_per_op(iterations, [&](size_t) { pid_float.step(); });
+    const auto pid_fixed_ns = bm::ns_per_op(iterations, [&](size_t) { pid_fixed.step(); });
+    bm::do_not_optimize(pid_float.output);
+    bm::do_not_optimize(pid_fixed.output);
+
+    bm::report("EWMA<float>", ewma_float_ns);
+    bm::report("EWMA<fixed_q16>", ewma_fixed_ns, ewma_float_ns);
+    bm::report("MappedRange<float>", range_float_ns);
+    bm::report("MappedRange<fixed_q16>", range_fixed_ns, range_float_ns);
+    bm::report("BasicPIDController<float> + plant", pid_float_ns);
+    bm::report("BasicPIDController<fixed_q16> + plant", pid_fixed_ns, pid_float_ns);
+
+    std::printf("\nlargest deviation from double over %zu samples:\n", accuracy_samples);
+    std::printf("%-48s %12.6f (float) %12.6f (fixed_q16)\n", "EWMA (K = 16)", ewma_error_float, ewma_error_fixed);
+    std::printf("%-48s %12.6f (float) %12.6f (fixed_q16)\n", "MappedRange [0, 100] -> [-5, 5]", range_error_float,
+                range_error_fixed);
+    std::printf("%-48s %12.6f (float) %12.6f (fixed_q16)\n", "PID output", pid_error_float, pid_error_fixed);
+    return 0;
+}
@@ -0,0 +1,84 @@
+#include "benchmark.hpp"
+
+#include <spine/core/utils/format.hpp>
+
+#include <cinttypes>
+#include <cstdio>
+#include <string>
+
+// Compares the allocation-free formatters against snprintf: the previous `utils::repr` (snprintf into a stack buffer,
+// returned as a std::string), "%.2f" for floats and "%d" for integers.
+
+namespace bm = spn::benchmark;
+using namespace spn::core::utils;
+
+namespace {
+
+constexpr size_t iterations = 2000000;
+
+/// utils::repr as it was: pick the unit, snprintf and return a std::string
+std::string snprintf_repr(k_time_us t) {
+    char buffer[64];
+    const auto raw = (t.raw() < 1000)                ? t.raw()
+                     : (k_time_ms(t).raw() < 1000) ? k_time_ms(t).raw()
+                     : (k_time_s(t).raw() < 900)   ? k_time_s(t).raw()
+                     : (k_time_m(t).raw() < 1440)  ? k_time_m(t).raw()
+                     : (k_time_h(t).raw() < 24)    ? k_time_h(t).raw()
+                                                   : k_time_d(t).raw();
+    const auto unit = (t.raw() < 1000)                ? "us"
+                      : (k_time_ms(t).raw() < 1000) ? "ms"
+                      : (k_time_s(t).raw() < 900)   ? "s"
+                      : (k_time_m(t).raw() < 1440)  ? "m"
+                      : (k_time_h(t).raw() < 24)    ? "h"
+                                                    : "d";
+    const auto size = std::snprintf(buffer, sizeof(buffer), "%" PRId64 "%s", static_cast<int64_t>(raw), unit);
+    return std::string(buffer, static_cast<size_t>(size));
+}
+
+k_time_us sample_time(size_t i) { return k_time_us(static_cast<time_t>(i * 7919 % 100000000)); }
+float sample_float(size_t i) { return static_cast<float>(i % 100000) * 0.0137f - 500.0f; }
+
+} // namespace
+
+int main() {
+    char buffer[64];
+
+    const auto snprintf_time = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(snprintf_repr(sample_time(i)).size());
+    });
+    const auto spine_time = bm::ns_per_op(iterations, [&](size_t i) {
+        auto writer = BufferWriter(buffer);
+        bm::do_not_optimize(format_to(writer, readable(sample_time(i))));
+    });
+
+    const auto snprintf_float = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(std::snprintf(buffer, sizeof(buffer), "%.2f", static_cast<double>(sample_float(i))));
+    });
+    const auto spine_float = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(format_float(buffer, buffer + sizeof(buffer), sample_float(i)));
+    });
+
+    const auto snprintf_integer = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(std::snprintf(buffer, sizeof(buffer), "%d", static_cast<int>(i * 7919) - 1000000));
+    });
+    const auto spine_integer = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(format_integer(buffer, buffer + sizeof(buffer), static_cast<int>(i * 7919) - 1000000));
+    });
+
+    const auto snprintf_unit = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(std::snprintf(buffer, sizeof(buffer), "%.2fmV", static_cast<double>(sample_float(i))));
+    });
+    const auto spine_unit = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(format_unit(buffer, buffer + sizeof(buffer), volt_m(sample_float(i))));
+    });
+
+    bm::report("time (snprintf + std::string)", snprintf_time);
+    bm::report("time (format_to readable)", spine_time, snprintf_time);
+    bm::report("float (snprintf %.2f)", snprintf_float);
+    bm::report("float (format_float)", spine_float, snprintf_float);
+    bm::report("integer (snprintf %d)", snprintf_integer);
+    bm::report("integer (format_integer)", spine_integer, snprintf_integer);
+    bm::report("unit (snprintf %.2fmV)", snprintf_unit);
+    bm::report("unit (format_unit volt_m)", spine_unit, snprintf_unit);
+    return 0;
+}
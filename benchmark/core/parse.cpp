@@ -0,0 +1,71 @@
+#include "benchmark.hpp"
+
+#include <spine/core/utils/parse.hpp>
+
+#include <cstdlib>
+#include <string>
+#include <string_view>
+
+// Compares the allocation-free parsers against the standard calls spine used before: std::strtof for floats (which
+// needs a null terminated copy when the input is a string_view into a line buffer) and std::stoi on a temporary
+// std::string for integers and durations.
+
+namespace bm = spn::benchmark;
+using namespace spn::core::utils;
+
+namespace {
+
+constexpr size_t iterations = 2000000;
+
+constexpr std::string_view floats[] = {"1.5", "-0.0125", "273.15", "12.5e-3", "65535", "3.14159265", "-42.0", "0.1"};
+constexpr std::string_view integers[] = {"1", "-42", "1500", "65535", "-2147483", "7", "120", "99999"};
+constexpr std::string_view durations[] = {"10us", "500ms", "2h", "1d", "30s", "15m", "250ms", "12h"};
+constexpr size_t samples = 8;
+
+} // namespace
+
+int main() {
+    const auto std_float = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto sv = floats[i % samples];
+        char terminated[32];
+        sv.copy(terminated, sv.size());
+        terminated[sv.size()] = '\0';
+        bm::do_not_optimize(std::strtof(terminated, nullptr));
+    });
+    const auto spine_float = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(parse_float(floats[i % samples]).value_or(0.0f));
+    });
+
+    const auto std_integer = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(std::stoi(std::string(integers[i % samples])));
+    });
+    const auto spine_integer = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(parse_integer<int>(integers[i % samples]).value_or(0));
+    });
+
+    // the previous parse_time: find the unit, std::stoi the digits, then compare the unit
+    const auto std_duration = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto sv = durations[i % samples];
+        const auto pos = sv.find_first_not_of("0123456789");
+        const auto value = std::stoi(std::string(sv.substr(0, pos)));
+        const auto unit = sv.substr(pos);
+        const auto ms = unit == "us" ? k_time_ms(k_time_us(value))
+                        : unit == "ms" ? k_time_ms(value)
+                        : unit == "s"  ? k_time_ms(k_time_s(value))
+                        : unit == "m"  ? k_time_ms(k_time_m(value))
+                        : unit == "h"  ? k_time_ms(k_time_h(value))
+                                       : k_time_ms(k_time_d(value));
+        bm::do_not_optimize(ms.raw());
+    });
+    const auto spine_duration = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(parse_duration(durations[i % samples]).value_or(k_time_ms(0)).raw());
+    });
+
+    bm::report("float (strtof on a terminated copy)", std_float);
+    bm::report("float (parse_float)", spine_float, std_float);
+    bm::report("integer (std::stoi on std::string)", std_integer);
+    bm::report("integer (parse_integer)", spine_integer, std_integer);
+    bm::report("duration (std::stoi + unit compare)", std_duration);
+    bm::report("duration (parse_duration)", spine_duration, std_duration);
+    return 0;
+}
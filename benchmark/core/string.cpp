@@ -0,0 +1,116 @@
+#include "benchmark.hpp"
+
+#include <spine/core/utils/string.hpp>
+#include <spine/structure/linebuffer.hpp>
+
+#include <string>
+#include <string_view>
+
+// Compares the CharSet based string utilities against the implementations they replaced, which searched the
+// delimiters for every character (`delimiters.find(c)`), and against a LineBuffer scan that peeks every character.
+
+namespace bm = spn::benchmark;
+using namespace spn::core::utils;
+
+namespace {
+
+constexpr size_t iterations = 200000;
+
+size_t previous_find_first_of(const std::string_view& strv, const std::string_view& delimiters) {
+    for (std::size_t i = 0; i < strv.size(); ++i) {
+        if (delimiters.find(strv[i]) != std::string::npos) return i;
+    }
+    return std::string::npos;
+}
+
+std::string_view previous_lstrip(const std::string_view& strv, const std::string_view& delimiters) {
+    auto it = strv.begin();
+    while (it != strv.end() && delimiters.find(*it) != std::string::npos)
+        ++it;
+    return strv.substr(static_cast<size_t>(it - strv.begin()));
+}
+
+size_t previous_tokenize(const std::string_view line, const std::string_view delimiters) {
+    size_t count = 0;
+    auto rest = previous_lstrip(line, delimiters);
+    while (!rest.empty()) {
+        const auto pos = previous_find_first_of(rest, delimiters);
+        bm::do_not_optimize(rest.substr(0, pos));
+        ++count;
+        rest = pos == std::string::npos ? std::string_view() : previous_lstrip(rest.substr(pos), delimiters);
+    }
+    return count;
+}
+
+void compare_find(const char* name, const std::string& text, const std::string_view delimiters) {
+    const auto set = CharSet(delimiters);
+    const auto previous = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(previous_find_first_of(text, delimiters));
+    });
+    const auto current = bm::ns_per_op(iterations, [&](size_t) { bm::do_not_optimize(find_first_of(text, set)); });
+    std::printf("%s\n", name);
+    bm::report("  delimiters.find per char", previous);
+    bm::report("  find_first_of(CharSet)", current, previous);
+}
+
+} // namespace
+
+int main() {
+    // a 256 byte line with the delimiter at the end, the common case for a line buffer
+    const auto line = std::string(255, 'a') + '\n';
+    compare_find("1 delimiter, 256 bytes (memchr)", line, "\n");
+    compare_find("2 delimiters, 256 bytes (SIMD)", line, "\r\n");
+    compare_find("4 delimiters, 256 bytes (SIMD)", line, ";,\r\n");
+    compare_find("8 delimiters, 256 bytes (bitmap)", line, ";,:|=!\r\n");
+    compare_find("2 delimiters, 16 bytes", std::string(15, 'a') + '\n', "\r\n");
+
+    const auto padded = std::string(32, ' ') + "value" + std::string(32, ' ');
+    const auto previous_strip = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(previous_lstrip(padded, whitespace));
+    });
+    const auto current_strip = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(lstrip(padded, whitespace));
+    });
+    std::printf("lstrip of 32 whitespace chars\n");
+    bm::report("  delimiters.find per char", previous_strip);
+    bm::report("  lstrip (CharSet)", current_strip, previous_strip);
+
+    const auto command = std::string_view("  set controller.pid.kp 1.25 ki 0.5 kd 0.05 limit 100\r\n");
+    const auto previous_tokens = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(previous_tokenize(command, whitespace));
+    });
+    const auto spaces = CharSet(whitespace);
+    const auto current_tokens = bm::ns_per_op(iterations, [&](size_t) {
+        size_t count = 0;
+        for (const auto token : tokenize(command, spaces)) {
+            bm::do_not_optimize(token);
+            ++count;
+        }
+        bm::do_not_optimize(count);
+    });
+    std::printf("tokenize a 56 byte command into 10 tokens\n");
+    bm::report("  find/lstrip with delimiters.find", previous_tokens);
+    bm::report("  tokenize (CharSet)", current_tokens, previous_tokens);
+
+    // a line buffer holding a 200 byte line: peek every byte (as before) or scan its contiguous spans
+    auto buffer = spn::structure::LineBuffer(256);
+    buffer.push(std::string(199, 'a') + '\n');
+    const auto previous_line = bm::ns_per_op(iterations, [&](size_t) {
+        size_t length = 0;
+        char c;
+        for (size_t i = 0; i < buffer.used_space() && buffer.peek_at(c, i); ++i) {
+            if (buffer.delimiters().find(c) != std::string::npos) {
+                length = i + 1;
+                break;
+            }
+        }
+        bm::do_not_optimize(length);
+    });
+    const auto current_line = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(buffer.length_of_next_line());
+    });
+    std::printf("LineBuffer::length_of_next_line, 200 byte line\n");
+    bm::report("  peek_at + delimiters.find per char", previous_line);
+    bm::report("  length_of_next_line (spans + CharSet)", current_line, previous_line);
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "benchmark.hpp"
+
+#include <spine/core/utils/parse.hpp>
+#include <spine/core/utils/string.hpp>
+#include <spine/io/stream/buffered_stream.hpp>
+#include <spine/io/stream/command_router.hpp>
+#include <spine/io/stream/implementations/mock.hpp>
+
+#include <iterator>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Compares the CommandRouter (perfect hash over 64 command names) against the `if (starts_with(incoming, "..."))`
+// cascade firmware uses today, both for finding the command and for a full dispatch that parses an integer argument
+// and calls the handler. Commands are drawn uniformly, so the cascade compares against half of the names on average.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+using namespace spn::core::utils;
+
+namespace {
+
+constexpr size_t iterations = 1000000;
+
+constexpr std::string_view names[] = {
+    "motor.speed",     "motor.speed?",    "motor.enable",    "motor.disable",   "motor.dir",       "motor.dir?",
+    "motor.accel",     "motor.decel",     "motor.limit",     "motor.home",      "pid.kp",          "pid.ki",
+    "pid.kd",          "pid.kp?",         "pid.ki?",         "pid.kd?",         "pid.setpoint",    "pid.setpoint?",
+    "pid.reset",       "pid.autotune",    "heater.on",       "heater.off",      "heater.power",    "heater.power?",
+    "fan.on",          "fan.off",         "fan.speed",       "fan.speed?",      "pump.on",         "pump.off",
+    "pump.flow",       "pump.flow?",      "valve.open",      "valve.close",     "valve.state?",    "sensor.temp?",
+    "sensor.humid?",   "sensor.pressure?", "sensor.light?",  "sensor.rate",     "sensor.calib",    "log.level",
+    "log.level?",      "log.dump",        "clock.set",       "clock.get?",      "clock.tz",        "schedule.add",
+    "schedule.clear",  "schedule.list?",  "net.ssid",        "net.connect",     "net.status?",     "net.reset",
+    "sys.reboot",      "sys.version?",    "sys.uptime?",     "sys.mem?",        "sys.save",        "sys.load",
+    "sys.factory",     "sys.echo",        "sys.ping",        "sys.help",
+};
+constexpr size_t command_count = std::size(names);
+static_assert(command_count >= 50);
+
+int g_sum = 0;
+void handler(Transaction&, int value) { g_sum += value; }
+
+template<size_t... Is>
+constexpr auto make_router(std::index_sequence<Is...>) {
+    return CommandRouter{Command::of<&handler>(names[Is])...};
+}
+constexpr auto router = make_router(std::make_index_sequence<command_count>{});
+
+/// The cascade: compare the first word against every name in order
+int cascade_find(const std::string_view line) {
+    for (size_t i = 0; i < command_count; ++i) {
+        if (starts_with(line, names[i]) && (line.size() == names[i].size() || line[names[i].size()] == ' '))
+            return static_cast<int>(i);
+    }
+    return -1;
+}
+
+} // namespace
+
+int main() {
+    // lines such as "motor.speed 42", in a scrambled order
+    auto lines = std::vector<std::string>();
+    for (size_t i = 0; i < command_count; ++i)
+        lines.push_back(std::string(names[(i * 37) % command_count]) + " " + std::to_string(i));
+
+    const auto word = [&](size_t i) {
+        const auto& line = lines[i % command_count];
+        return std::string_view(line).substr(0, line.find(' '));
+    };
+    const auto cascade_lookup =
+        bm::ns_per_op(iterations, [&](size_t i) { bm::do_not_optimize(cascade_find(word(i))); });
+    const auto router_lookup = bm::ns_per_op(iterations, [&](size_t i) { bm::do_not_optimize(router.find(word(i))); });
+
+    // a full dispatch needs a transaction, keep one open on a single line and dispatch every line through it
+    auto mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 64});
+    mock->initialize();
+    mock->inject_bytestream({'x', '\n'});
+    auto stream = BufferedStream(mock, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+    stream.pull_in_data();
+    auto transaction = stream.new_transaction();
+
+    const auto cascade_dispatch = bm::ns_per_op(iterations, [&](size_t i) {
+        const std::string_view line = lines[i % command_count];
+        const auto index = cascade_find(line);
+        const auto argument = parse_integer<int>(line.substr(names[index].size() + 1));
+        if (argument) handler(*transaction, argument.value());
+    });
+    const auto router_dispatch = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(router.dispatch(*transaction, lines[i % command_count]));
+    });
+    bm::do_not_optimize(g_sum);
+
+    std::printf("%zu commands\n", command_count);
+    bm::report("find (starts_with cascade)", cascade_lookup);
+    bm::report("find (CommandRouter)", router_lookup, cascade_lookup);
+    bm::report("dispatch (starts_with cascade + parse)", cascade_dispatch);
+    bm::report("dispatch (CommandRouter)", router_dispatch, cascade_dispatch);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include "benchmark.hpp"
+
+#include <spine/io/stream/compressed_stream.hpp>
+#include <spine/io/stream/implementations/mock.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Compression ratio and CPU time per KiB of CompressedStream for a few window sizes: telemetry lines (repeated keys,
+// slowly changing values) synced after every line, and random bytes as the worst case. The compressed bytes are
+// written into a mock stream and decompressed back from it.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+
+namespace {
+
+constexpr size_t iterations = 20;
+
+std::string telemetry(size_t size) {
+    std::string data;
+    for (int i = 0; data.size() < size; ++i) {
+        data += "{\"t\":" + std::to_string(1700000000 + i) + ",\"temperature\":" + std::to_string(2150 + (i / 8) % 40)
+                + ",\"humidity\":" + std::to_string(420 + (i / 20) % 9) + ",\"heater\":\""
+                + ((i / 50) % 2 ? "on" : "off") + "\",\"duty\":" + std::to_string((i * 7) % 100) + "}\n";
+    }
+    return data;
+}
+
+std::string noise(size_t size) {
+    std::string data(size, '\0');
+    std::srand(1);
+    for (auto& c : data)
+        c = static_cast<char>(std::rand());
+    return data;
+}
+
+template<uint8_t WindowBits, uint8_t LookaheadBits>
+void measure(const char* name, const std::string& data) {
+    const auto cfg = MockStream::Config{.input_buffer_size = 2 * data.size(), .output_buffer_size = 2 * data.size()};
+    auto wire = std::make_shared<MockStream>(MockStream::Config(cfg));
+    std::vector<uint8_t> compressed;
+    std::string decompressed(data.size(), '\0');
+
+    const auto compress_ns = bm::ns_per_op(iterations, [&](size_t) {
+        auto tx = CompressedStream<WindowBits, LookaheadBits>(wire);
+        tx.write(std::string_view(data));
+        tx.flush();
+        compressed = *wire->extract_bytestream();
+    });
+    const auto decompress_ns = bm::ns_per_op(iterations, [&](size_t) {
+        auto rx = CompressedStream<WindowBits, LookaheadBits>(wire);
+        wire->inject_bytestream(compressed);
+        bm::do_not_optimize(rx.read(decompressed.data(), decompressed.size()));
+    });
+    if (decompressed != data) std::printf("%s: round trip failed\n", name);
+
+    const auto kib = static_cast<double>(data.size()) / 1024;
+    const auto ratio = static_cast<double>(data.size()) / static_cast<double>(compressed.size());
+    const auto state = sizeof(CompressedStream<WindowBits, LookaheadBits>);
+    std::printf("%-36s %6.2fx %5zu B state %10.0f ns/KiB compress %8.0f ns/KiB decompress\n", name, ratio, state,
+                compress_ns / kib, decompress_ns / kib);
+}
+
+} // namespace
+
+int main() {
+    const auto lines = telemetry(64 * 1024);
+    const auto random = noise(64 * 1024);
+
+    measure<6, 3>("telemetry, window 64", lines);
+    measure<8, 4>("telemetry, window 256 (default)", lines);
+    measure<10, 5>("telemetry, window 1024", lines);
+    measure<8, 4>("random bytes, window 256", random);
+    return 0;
+}
@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+
+#include <spine/io/stream/buffered_stream.hpp>
+#include <spine/io/stream/implementations/fd.hpp>
+
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+
+// Lines of 64 bytes through a BufferedStream over a pipe and over a pseudo terminal pair (raw mode), sender and
+// receiver in a single thread: the sender queues and pushes out 1 KiB, the receiver pulls in until it holds all of
+// its lines. Then a reply of four segments (prefix, value, unit, delimiter) written into a pipe as a single writev(2)
+// versus a write(2) per segment.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+
+namespace {
+
+constexpr size_t iterations = 20000;
+constexpr size_t line_size = 64;
+constexpr size_t lines_per_block = 16;
+constexpr size_t block_size = line_size * lines_per_block;
+
+/// Returns the ns it takes to move a block of lines from `tx` to `rx`
+double lines_through(const std::shared_ptr<FdStream>& tx, const std::shared_ptr<FdStream>& rx, size_t n) {
+    auto sender =
+        BufferedStream(tx, {.input_buffer_size = 16, .output_buffer_size = 4 * block_size, .delimiters = "\n"});
+    auto receiver =
+        BufferedStream(rx, {.input_buffer_size = 4 * block_size, .output_buffer_size = 16, .delimiters = "\n"});
+    char line[line_size];
+    std::memset(line, 'x', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\n';
+
+    return bm::ns_per_op(n, [&](size_t) {
+        for (size_t i = 0; i < lines_per_block; ++i)
+            sender.buffered_write(line, sizeof(line));
+        size_t lines = 0;
+        while (lines < lines_per_block) {
+            sender.push_out_data();
+            receiver.pull_in_data();
+            while (receiver.drop_next_line())
+                ++lines;
+        }
+    });
+}
+
+void report_throughput(const char* name, double ns) {
+    std::printf("%-48s %12.2f ns/op %8.1f MB/s %10.0f lines/s\n", name, ns, static_cast<double>(block_size) * 1e3 / ns,
+                static_cast<double>(lines_per_block) * 1e9 / ns);
+}
+
+} // namespace
+
+int main() {
+    int pipe_fds[2];
+    if (::pipe(pipe_fds) != 0) return 1;
+    auto pipe_rx = std::make_shared<FdStream>(FdStream::Config{.fd = pipe_fds[0]});
+    auto pipe_tx = std::make_shared<FdStream>(FdStream::Config{.fd = pipe_fds[1]});
+    pipe_rx->initialize();
+    pipe_tx->initialize();
+
+    const auto pty = open_pty_pair();
+    if (!pty) return 1;
+    auto pty_master = std::make_shared<FdStream>(FdStream::Config{.fd = pty->first});
+    auto pty_slave = std::make_shared<FdStream>(FdStream::Config{.fd = pty->second});
+    pty_master->initialize();
+    pty_slave->initialize();
+
+    const auto pipe_ns = lines_through(pipe_tx, pipe_rx, iterations);
+    const auto pty_ns = lines_through(pty_master, pty_slave, iterations / 4);
+
+    // a reply of four segments, drained right away
+    const std::string_view segments[] = {"temperature ", "21.5", " C", "\n"};
+    char drain[64];
+    const auto separate_ns = bm::ns_per_op(iterations, [&](size_t) {
+        for (const auto& segment : segments)
+            pipe_tx->write(segment);
+        bm::do_not_optimize(pipe_rx->read(drain, sizeof(drain)));
+    });
+    const auto gathered_ns = bm::ns_per_op(iterations, [&](size_t) {
+        pipe_tx->writev(segments, 4);
+        bm::do_not_optimize(pipe_rx->read(drain, sizeof(drain)));
+    });
+
+    report_throughput("BufferedStream over a pipe (16 lines)", pipe_ns);
+    report_throughput("BufferedStream over a pty pair (16 lines)", pty_ns);
+    bm::report("reply of 4 segments, write(2) per segment", separate_ns);
+    bm::report("reply of 4 segments, a single writev(2)", gathered_ns, separate_ns);
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include "benchmark.hpp"
+
+#include <spine/core/utils/cobs.hpp>
+#include <spine/core/utils/crc.hpp>
+#include <spine/core/utils/format.hpp>
+#include <spine/core/utils/parse.hpp>
+#include <spine/io/stream/buffered_stream.hpp>
+#include <spine/io/stream/framed_stream.hpp>
+#include <spine/io/stream/implementations/mock.hpp>
+
+#include <array>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+// Throughput of the checksums and COBS over 1 KiB, and a telemetry record of 16 floats sent as an ASCII line
+// (formatted and parsed) versus sent as a binary frame (COBS + CRC-16), both end to end through a MockStream: the
+// sender queues and pushes out the record, the receiver pulls it in and decodes it back into 16 floats.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+using namespace spn::core::utils;
+
+namespace {
+
+constexpr size_t iterations = 200000;
+constexpr size_t block_size = 1024;
+constexpr size_t channels = 16;
+
+/// The classic single table, one byte per step
+uint32_t crc32_bytewise(const uint8_t* data, size_t length) {
+    static const auto table = [] {
+        std::array<uint32_t, 256> t{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            auto crc = i;
+            for (int bit = 0; bit < 8; ++bit)
+                crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+            t[i] = crc;
+        }
+        return t;
+    }();
+    uint32_t crc = ~0u;
+    for (size_t i = 0; i < length; ++i)
+        crc = (crc >> 8) ^ table[(crc ^ data[i]) & 0xFF];
+    return ~crc;
+}
+
+void report_throughput(const char* name, double ns, size_t bytes) {
+    std::printf("%-48s %12.2f ns/op %8.1f MB/s\n", name, ns, static_cast<double>(bytes) * 1e3 / ns);
+}
+
+} // namespace
+
+int main() {
+    auto block = std::vector<uint8_t>(block_size);
+    for (size_t i = 0; i < block.size(); ++i)
+        block[i] = static_cast<uint8_t>((i * 131) >> 3); // holds a zero every now and then
+    auto encoded = std::vector<uint8_t>(cobs_max_encoded_size(block_size));
+    auto decoded = std::vector<uint8_t>(block_size);
+
+    const auto crc16_ns =
+        bm::ns_per_op(iterations, [&](size_t) { bm::do_not_optimize(crc16(block.data(), block_size)); });
+    const auto crc32_bytewise_ns =
+        bm::ns_per_op(iterations, [&](size_t) { bm::do_not_optimize(crc32_bytewise(block.data(), block_size)); });
+    const auto crc32_ns =
+        bm::ns_per_op(iterations, [&](size_t) { bm::do_not_optimize(crc32(block.data(), block_size)); });
+    size_t encoded_size = 0;
+    const auto encode_ns = bm::ns_per_op(iterations, [&](size_t) {
+        encoded_size = cobs_encode(block.data(), block_size, encoded.data());
+        bm::do_not_optimize(encoded[0]);
+    });
+    const auto decode_ns = bm::ns_per_op(iterations, [&](size_t) {
+        bm::do_not_optimize(cobs_decode(encoded.data(), encoded_size, decoded.data(), decoded.size()));
+    });
+
+    // telemetry
+    auto record = std::array<float, channels>{};
+    for (size_t c = 0; c < channels; ++c)
+        record[c] = 1000.0f / static_cast<float>(c + 3) - 100.0f;
+    auto received = std::array<float, channels>{};
+    size_t ascii_wire = 0;
+    size_t binary_wire = 0;
+
+    auto ascii_mock =
+        std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 512, .output_buffer_size = 512});
+    ascii_mock->initialize();
+    auto ascii = BufferedStream(ascii_mock, {.input_buffer_size = 256, .output_buffer_size = 256, .delimiters = "\n"});
+    const auto ascii_ns = bm::ns_per_op(iterations / 10, [&](size_t) {
+        char line[256];
+        char* it = line;
+        for (size_t c = 0; c < channels; ++c) {
+            it = format_float(it, line + sizeof(line), record[c], 3);
+            *it++ = c + 1 < channels ? ' ' : '\n';
+        }
+        ascii.buffered_write(line, static_cast<size_t>(it - line));
+        ascii.push_out_data();
+        const auto wire = ascii_mock->extract_bytestream();
+        ascii_wire = wire->size();
+        ascii_mock->inject_bytestream(*wire);
+        ascii.pull_in_data();
+
+        const auto view = *ascii.get_next_line_view();
+        const char* first = view.data();
+        const char* last = view.data() + view.size();
+        for (size_t c = 0; c < channels; ++c) {
+            first = scan_float(first, last, received[c]).ptr;
+            if (first != last) ++first; // separator
+        }
+        ascii.drop_next_line();
+        bm::do_not_optimize(received);
+    });
+
+    auto binary_mock =
+        std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 512, .output_buffer_size = 512});
+    binary_mock->initialize();
+    auto binary = FramedStream(binary_mock, {.input_buffer_size = 256,
+                                             .output_buffer_size = 256,
+                                             .max_payload_size = sizeof(record),
+                                             .check = FrameCheck::Crc16});
+    const auto binary_ns = bm::ns_per_op(iterations / 10, [&](size_t) {
+        binary.write_frame({reinterpret_cast<const char*>(record.data()), sizeof(record)});
+        binary.push_out_data();
+        const auto wire = binary_mock->extract_bytestream();
+        binary_wire = wire->size();
+        binary_mock->inject_bytestream(*wire);
+        binary.pull_in_data();
+
+        auto transaction = binary.new_transaction();
+        std::memcpy(received.data(), transaction->incoming().data(), sizeof(received));
+        transaction->commit();
+        bm::do_not_optimize(received);
+    });
+
+    report_throughput("crc16 (1 KiB)", crc16_ns, block_size);
+    report_throughput("crc32 bytewise (1 KiB)", crc32_bytewise_ns, block_size);
+    report_throughput("crc32 slicing-by-4 (1 KiB)", crc32_ns, block_size);
+    report_throughput("cobs encode (1 KiB)", encode_ns, block_size);
+    report_throughput("cobs decode (1 KiB)", decode_ns, block_size);
+    std::printf("telemetry record of %zu floats: %zu bytes as ascii line, %zu bytes as binary frame\n", channels,
+                ascii_wire, binary_wire);
+    bm::report("telemetry as ascii line (format + scan)", ascii_ns);
+    bm::report("telemetry as binary frame (cobs + crc16)", binary_ns, ascii_ns);
+    return 0;
+}
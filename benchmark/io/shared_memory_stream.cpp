@@ -0,0 +1,149 @@
+#include "benchmark.hpp"
+
+#include <spine/io/stream/implementations/fd.hpp>
+#include <spine/io/stream/implementations/shared_memory.hpp>
+
+#include <functional>
+#include <poll.h>
+#include <sched.h>
+#include <string>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Two processes exchanging data over a unix socket pair through FdStream, and over the shared memory stream with its
+// doorbell and spinning (yielding) instead. First the round trip of a 64 byte message the other process echoes, then
+// the throughput of 4 KiB writes the other process drains, acknowledging the last byte. Both sides block the same way
+// when there's nothing to read: poll(2) for the socket, `wait_for_input` for the shared memory.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+
+namespace {
+
+constexpr size_t round_trips = 20000;
+constexpr size_t message_size = 64;
+constexpr size_t chunk_size = 4096;
+constexpr size_t stream_size = 32 * 1024 * 1024;
+
+/// The amount of times `bm::ns_per_op` calls its function, warming up included
+constexpr size_t calls(size_t iterations) { return iterations + iterations / 10 + 1; }
+
+/// One side of a channel: its stream and how it blocks until there's input
+struct Endpoint {
+    Stream& stream;
+    std::function<void()> wait;
+};
+
+void write_all(Endpoint& endpoint, const char* buffer, size_t length) {
+    for (size_t written = 0; written < length;) {
+        const auto n = endpoint.stream.write(buffer + written, length - written);
+        if (n == 0) ::sched_yield(); // the other process drains its side
+        written += n;
+    }
+}
+
+void read_all(Endpoint& endpoint, char* buffer, size_t length) {
+    for (size_t received = 0; received < length;) {
+        const auto n = endpoint.stream.read(buffer + received, length - received);
+        if (n == 0) endpoint.wait();
+        received += n;
+    }
+}
+
+/// Run in the other process: echo the messages of the round trips, then drain the stream and acknowledge it
+void serve(Endpoint endpoint) {
+    char buffer[chunk_size];
+    for (size_t i = 0; i < calls(round_trips); ++i) {
+        read_all(endpoint, buffer, message_size);
+        write_all(endpoint, buffer, message_size);
+    }
+    for (size_t i = 0; i < calls(1); ++i) {
+        for (size_t received = 0; received < stream_size;) {
+            const auto n = endpoint.stream.read(buffer, sizeof(buffer));
+            if (n == 0) endpoint.wait();
+            received += n;
+        }
+        write_all(endpoint, "!", 1);
+    }
+}
+
+struct Result {
+    double round_trip_ns;
+    double stream_ns;
+};
+
+/// Measure against the other process, which is serving already
+Result measure(Endpoint endpoint) {
+    char message[message_size] = {};
+    const auto round_trip_ns = bm::ns_per_op(round_trips, [&](size_t) {
+        write_all(endpoint, message, sizeof(message));
+        read_all(endpoint, message, sizeof(message));
+    });
+    char chunk[chunk_size] = {};
+    const auto stream_ns = bm::ns_per_op(1, [&](size_t) {
+        for (size_t sent = 0; sent < stream_size; sent += sizeof(chunk))
+            write_all(endpoint, chunk, sizeof(chunk));
+        read_all(endpoint, chunk, 1);
+    });
+    return {round_trip_ns, stream_ns};
+}
+
+void wait_on(int fd) {
+    auto pfd = pollfd{fd, POLLIN, 0};
+    ::poll(&pfd, 1, -1);
+}
+
+Result socket_pair() {
+    int fds[2];
+    if (::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) std::exit(1);
+    if (::fork() == 0) {
+        ::close(fds[0]);
+        auto stream = FdStream({.fd = fds[1]});
+        stream.initialize();
+        serve({stream, [&] { wait_on(fds[1]); }});
+        ::_exit(0);
+    }
+    ::close(fds[1]);
+    auto stream = FdStream({.fd = fds[0]});
+    stream.initialize();
+    const auto result = measure({stream, [&] { wait_on(fds[0]); }});
+    ::wait(nullptr);
+    return result;
+}
+
+Result shared_memory(bool doorbell) {
+    const auto path = "/dev/shm/spine_benchmark_" + std::to_string(::getpid());
+    auto stream = SharedMemoryStream({.path = path.c_str(), .capacity = 64 * 1024, .doorbell = doorbell});
+    stream.initialize();
+    if (!stream.is_open()) std::exit(1);
+    if (::fork() == 0) {
+        auto other = SharedMemoryStream(
+            {.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary, .doorbell = doorbell});
+        other.initialize();
+        serve({other, [&] { other.wait_for_input(k_time_ms(1000)); }});
+        ::_exit(0);
+    }
+    const auto result = measure({stream, [&] { stream.wait_for_input(k_time_ms(1000)); }});
+    ::wait(nullptr);
+    return result;
+}
+
+void report(const char* name, const Result& result, const Result& baseline) {
+    const auto mb_per_s = static_cast<double>(stream_size) * 1e3 / result.stream_ns;
+    std::printf("%-40s %10.0f ns/round trip %5.2fx %10.1f MB/s %5.2fx\n", name, result.round_trip_ns,
+                baseline.round_trip_ns / result.round_trip_ns, mb_per_s, baseline.stream_ns / result.stream_ns);
+}
+
+} // namespace
+
+int main() {
+    const auto socket = socket_pair();
+    const auto doorbell = shared_memory(true);
+    const auto spinning = shared_memory(false);
+
+    report("FdStream, unix socket pair", socket, socket);
+    report("SharedMemoryStream, futex doorbell", doorbell, socket);
+    report("SharedMemoryStream, yielding", spinning, socket);
+    return 0;
+}
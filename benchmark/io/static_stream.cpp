@@ -0,0 +1,101 @@
+#include "benchmark.hpp"
+
+#include <spine/io/stream/buffered_stream.hpp>
+#include <spine/io/stream/implementations/mock.hpp>
+#include <spine/io/stream/static_stream.hpp>
+
+#include <cstring>
+#include <memory>
+
+// Bytes per second through the mock stream, called through the virtual `Stream` interface and through the static
+// stream it adapts: a byte at a time and through the LineBuffer pumps, which move whole spans of the ring. Last, lines
+// going out of and back into a BufferedStream, which holds a `Stream` and pumps spans as well. Between writing and
+// reading the bytes are moved from the mock's output to its input, which is the same for all.
+
+namespace bm = spn::benchmark;
+using namespace spn::io;
+using spn::structure::LineBuffer;
+
+namespace {
+
+constexpr size_t iterations = 20000;
+constexpr size_t block_size = 1024;
+
+void loop_back(StaticMockStream& mock) { mock.inject_bytestream(*mock.extract_bytestream()); }
+
+template<typename StreamT>
+/// Write a block into `stream` a byte at a time, then read it back the same way
+void bytewise(StreamT& stream, StaticMockStream& mock) {
+    for (size_t i = 0; i < block_size; ++i)
+        stream.write(static_cast<uint8_t>(i));
+    loop_back(mock);
+    uint8_t value = 0;
+    unsigned sum = 0;
+    for (size_t i = 0; i < block_size; ++i) {
+        stream.read(value);
+        sum += value;
+    }
+    bm::do_not_optimize(sum);
+}
+
+template<typename StreamT>
+/// Pump a block from one LineBuffer into `stream`, then from `stream` into another LineBuffer
+void pumped(StreamT& stream, StaticMockStream& mock, LineBuffer& out, LineBuffer& in) {
+    out.commit(block_size); // the contents don't matter
+    push_from(out, stream);
+    loop_back(mock);
+    pull_into(in, stream);
+    in.drop_first(block_size);
+    bm::do_not_optimize(in);
+}
+
+void report_throughput(const char* name, double ns, double baseline_ns) {
+    std::printf("%-48s %12.2f ns/op %8.1f MB/s %8.2fx\n", name, ns, static_cast<double>(block_size) * 1e3 / ns,
+                baseline_ns / ns);
+}
+
+} // namespace
+
+int main() {
+    auto static_stream = StaticMockStream({.input_buffer_size = block_size, .output_buffer_size = block_size});
+    auto adapter = MockStream({.input_buffer_size = block_size, .output_buffer_size = block_size});
+    Stream* dynamic_stream = &adapter;
+    bm::do_not_optimize(dynamic_stream); // hide the dynamic type, as when the stream is picked at runtime
+    auto out = LineBuffer(block_size);
+    auto in = LineBuffer(block_size);
+
+    const auto virtual_bytewise_ns =
+        bm::ns_per_op(iterations, [&](size_t) { bytewise(*dynamic_stream, adapter.stream()); });
+    const auto static_bytewise_ns = bm::ns_per_op(iterations, [&](size_t) { bytewise(static_stream, static_stream); });
+    const auto virtual_pumped_ns =
+        bm::ns_per_op(iterations, [&](size_t) { pumped(*dynamic_stream, adapter.stream(), out, in); });
+    const auto static_pumped_ns =
+        bm::ns_per_op(iterations, [&](size_t) { pumped(static_stream, static_stream, out, in); });
+
+    // 16 lines of 64 bytes out of and back into a BufferedStream
+    auto mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = block_size, //
+                                                                .output_buffer_size = block_size});
+    mock->initialize();
+    auto buffered = BufferedStream(mock, {.input_buffer_size = block_size, //
+                                          .output_buffer_size = block_size,
+                                          .delimiters = "\n"});
+    char line[64];
+    std::memset(line, 'x', sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\n';
+    const auto buffered_ns = bm::ns_per_op(iterations, [&](size_t) {
+        for (size_t i = 0; i < block_size / sizeof(line); ++i)
+            buffered.buffered_write(line, sizeof(line));
+        buffered.push_out_data();
+        loop_back(mock->stream());
+        buffered.pull_in_data();
+        while (buffered.drop_next_line()) {
+        }
+    });
+
+    report_throughput("virtual Stream, bytewise (1 KiB)", virtual_bytewise_ns, virtual_bytewise_ns);
+    report_throughput("StaticStream, bytewise (1 KiB)", static_bytewise_ns, virtual_bytewise_ns);
+    report_throughput("virtual Stream, pumped spans (1 KiB)", virtual_pumped_ns, virtual_bytewise_ns);
+    report_throughput("StaticStream, pumped spans (1 KiB)", static_pumped_ns, virtual_bytewise_ns);
+    report_throughput("BufferedStream out and in (16 lines, 1 KiB)", buffered_ns, virtual_bytewise_ns);
+    return 0;
+}
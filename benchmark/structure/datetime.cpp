@@ -0,0 +1,88 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/time/datetime.hpp>
+
+#include <cstdio>
+#include <ctime>
+
+// Compares DateTime's calendar math against the libc calls it used before: gmtime_r for timestamp to fields, mktime
+// for fields to timestamp and strftime for formatting. 'consecutive' converts one timestamp per second (the cached day
+// boundary applies), 'spread' jumps about 13 days per conversion.
+
+namespace bm = spn::benchmark;
+
+namespace {
+
+constexpr size_t iterations = 2000000;
+constexpr time_t base = 1700000000;
+
+time_t consecutive(size_t i) { return base + static_cast<time_t>(i % 86400); }
+time_t spread(size_t i) { return base + static_cast<time_t>(i * 1123457 % 2000000000); }
+
+void report(const char* name, double ns, double baseline_ns = 0) {
+    if (baseline_ns > 0) bm::report(name, ns, baseline_ns);
+    else bm::report(name, ns);
+    std::printf("%-48s %12.2f M/s\n", "", 1000.0 / ns);
+}
+
+} // namespace
+
+int main() {
+    const auto libc_consecutive = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto t = consecutive(i);
+        tm fields;
+        gmtime_r(&t, &fields);
+        bm::do_not_optimize(fields.tm_mday + fields.tm_sec);
+    });
+    const auto spine_consecutive = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto dt = DateTime(consecutive(i));
+        bm::do_not_optimize(dt.getDay() + dt.getSecond());
+    });
+
+    const auto libc_spread = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto t = spread(i);
+        tm fields;
+        gmtime_r(&t, &fields);
+        bm::do_not_optimize(fields.tm_mday + fields.tm_sec);
+    });
+    const auto spine_spread = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto dt = DateTime(spread(i));
+        bm::do_not_optimize(dt.getDay() + dt.getSecond());
+    });
+
+    const auto libc_fields = bm::ns_per_op(iterations, [&](size_t i) {
+        tm fields = {};
+        fields.tm_year = 124;
+        fields.tm_mon = static_cast<int>(i % 12);
+        fields.tm_mday = static_cast<int>(i % 28) + 1;
+        fields.tm_sec = static_cast<int>(i % 86400);
+        fields.tm_isdst = -1;
+        bm::do_not_optimize(mktime(&fields));
+    });
+    const auto spine_fields = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto dt = DateTime(2024, static_cast<int>(i % 12) + 1, static_cast<int>(i % 28) + 1, 0, 0,
+                                 static_cast<int>(i % 86400));
+        bm::do_not_optimize(dt.getUnixTime());
+    });
+
+    char buffer[32];
+    const auto libc_format = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto t = consecutive(i);
+        tm fields;
+        gmtime_r(&t, &fields);
+        bm::do_not_optimize(strftime(buffer, sizeof(buffer), "%Y-%m-%dT%H:%M:%SZ", &fields));
+    });
+    const auto spine_format = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(DateTime(consecutive(i)).to_iso8601(buffer, sizeof(buffer)));
+    });
+
+    report("timestamp to fields, consecutive (gmtime_r)", libc_consecutive);
+    report("timestamp to fields, consecutive (DateTime)", spine_consecutive, libc_consecutive);
+    report("timestamp to fields, spread (gmtime_r)", libc_spread);
+    report("timestamp to fields, spread (DateTime)", spine_spread, libc_spread);
+    report("fields to timestamp (mktime)", libc_fields);
+    report("fields to timestamp (DateTime)", spine_fields, libc_fields);
+    report("ISO-8601 (gmtime_r + strftime)", libc_format);
+    report("ISO-8601 (DateTime::to_iso8601)", spine_format, libc_format);
+    return 0;
+}
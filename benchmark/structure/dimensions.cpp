@@ -0,0 +1,39 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/units/primitives/compound_unit.hpp>
+#include <spine/structure/units/si.hpp>
+
+#include <cstdio>
+
+// Computes power from energy and time with plain floats, with dimensional unit arithmetic (joule / time_s -> watt) and
+// with the two-field CompoundUnit
+
+namespace bm = spn::benchmark;
+
+namespace {
+constexpr size_t iterations = 10000000;
+}
+
+int main() {
+    static_assert(sizeof(decltype(joule() / time_s())) == sizeof(float));
+
+    float sum = 0;
+    const auto plain = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto energy = static_cast<float>(i & 0xfff);
+        sum += energy / 2.5f * 3.0f;
+    });
+    const auto derived = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto power = joule(static_cast<float>(i & 0xfff)) / time_s(2.5f);
+        sum += (power * time_s(3.0f)).raw();
+    });
+    const auto compound = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto power = spnu::CompoundUnit<joule, time_s>(joule(static_cast<float>(i & 0xfff)), time_s(2.5f));
+        sum += power.raw() * time_s(3.0f).raw();
+    });
+    bm::do_not_optimize(sum);
+
+    bm::report("plain float", plain);
+    bm::report("joule / time_s -> watt", derived, compound);
+    bm::report("CompoundUnit<joule, time_s>", compound);
+    return 0;
+}
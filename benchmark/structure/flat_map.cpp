@@ -0,0 +1,74 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/flat_hash_map.hpp>
+#include <spine/structure/sorted_flat_map.hpp>
+#include <spine/structure/vector.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <utility>
+
+// Compares key lookups in FlatHashMap and SortedFlatMap against a linear scan over a Vector (the status quo), of keys
+// that are present (hits) and of keys that aren't (misses), which scan the whole Vector and probe up to the end of a
+// cluster in FlatHashMap
+
+using namespace spn::structure;
+namespace bm = spn::benchmark;
+
+namespace {
+
+constexpr size_t iterations = 1000000;
+
+/// Returns a scrambled, but deterministic key for `i`
+uint32_t key_for(size_t i) { return static_cast<uint32_t>(i * 2654435761u + 12345u); }
+
+template<size_t N>
+void benchmark_size() {
+    static auto vector = Vector<std::pair<uint32_t, uint32_t>>(N);
+    static auto hash_map = FlatHashMap<uint32_t, uint32_t, N>();
+    static auto sorted_map = SortedFlatMap<uint32_t, uint32_t, N>();
+    for (size_t i = 0; i < N; ++i) {
+        vector.push_back({key_for(i), static_cast<uint32_t>(i)});
+        hash_map.insert(key_for(i), static_cast<uint32_t>(i));
+        sorted_map.insert(key_for(i), static_cast<uint32_t>(i));
+    }
+
+    // the keys of the first N indices are present, those of the next N aren't
+    for (const auto [kind, offset] : {std::pair{"hit", size_t{0}}, std::pair{"miss", N}}) {
+        const auto linear = bm::ns_per_op(iterations, [offset = offset](size_t i) {
+            const auto key = key_for(i % N + offset);
+            for (const auto& [k, v] : vector) {
+                if (k == key) {
+                    bm::do_not_optimize(v);
+                    break;
+                }
+            }
+        });
+        const auto hashed = bm::ns_per_op(
+            iterations, [offset = offset](size_t i) { bm::do_not_optimize(hash_map.find(key_for(i % N + offset))); });
+        const auto sorted = bm::ns_per_op(
+            iterations, [offset = offset](size_t i) { bm::do_not_optimize(sorted_map.find(key_for(i % N + offset))); });
+
+        char name[64];
+        std::snprintf(name, sizeof(name), "%s n=%zu linear (Vector)", kind, N);
+        bm::report(name, linear);
+        std::snprintf(name, sizeof(name), "%s n=%zu FlatHashMap", kind, N);
+        bm::report(name, hashed, linear);
+        std::snprintf(name, sizeof(name), "%s n=%zu SortedFlatMap", kind, N);
+        bm::report(name, sorted, linear);
+    }
+}
+
+} // namespace
+
+int main() {
+    benchmark_size<8>();
+    benchmark_size<16>();
+    benchmark_size<32>();
+    benchmark_size<64>();
+    benchmark_size<128>();
+    benchmark_size<256>();
+    benchmark_size<512>();
+    benchmark_size<1024>();
+    return 0;
+}
@@ -0,0 +1,103 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/point_batch.hpp>
+
+#include <cstdio>
+
+// Compares a batch of 256 XYZPoint<float> stored as an array of structures (the scalar XYZPoint API in a loop)
+// against the same batch stored as a structure of arrays in PointBatch (vectorized kernels). Timings are per batch.
+// Component-wise operations (add, scalar_multiplication) are a contiguous stream of floats in both layouts and the
+// compiler vectorizes the AoS loop as well; the SoA layout pays off for per-point reductions (dot, mag, normalize).
+
+namespace bm = spn::benchmark;
+using namespace spn::structure;
+
+namespace {
+
+constexpr size_t points = 256;
+constexpr size_t iterations = 100000;
+
+using Point = XYZPoint<float>;
+using Batch = XYZPointBatch<float, points>;
+
+Point sample(size_t i) {
+    return Point(static_cast<float>(i % 17) - 8.5f, static_cast<float>(i % 13) + 0.5f, static_cast<float>(i % 11) - 4);
+}
+
+} // namespace
+
+int main() {
+    Point aos_a[points], aos_b[points];
+    auto soa_a = Batch();
+    auto soa_b = Batch();
+    for (size_t i = 0; i < points; ++i) {
+        aos_a[i] = sample(i);
+        aos_b[i] = sample(i * 7 + 3);
+        soa_a.push_back(aos_a[i]);
+        soa_b.push_back(aos_b[i]);
+    }
+    float out[points];
+
+    const auto aos_add = bm::ns_per_op(iterations, [&](size_t) {
+        for (size_t i = 0; i < points; ++i)
+            aos_a[i].add(aos_b[i]);
+        bm::do_not_optimize(aos_a[0]);
+    });
+    const auto soa_add = bm::ns_per_op(iterations, [&](size_t) {
+        soa_a.add(soa_b);
+        bm::do_not_optimize(soa_a.x());
+    });
+
+    const auto aos_scale = bm::ns_per_op(iterations, [&](size_t n) {
+        for (size_t i = 0; i < points; ++i)
+            aos_a[i].scalar_multiplication(n & 1 ? 2.0f : 0.5f);
+        bm::do_not_optimize(aos_a[0]);
+    });
+    const auto soa_scale = bm::ns_per_op(iterations, [&](size_t n) {
+        soa_a.scalar_multiplication(n & 1 ? 2.0f : 0.5f);
+        bm::do_not_optimize(soa_a.x());
+    });
+
+    const auto aos_dot = bm::ns_per_op(iterations, [&](size_t) {
+        for (size_t i = 0; i < points; ++i)
+            out[i] = aos_a[i].dot(aos_b[i]);
+        bm::do_not_optimize(out[0]);
+    });
+    const auto soa_dot = bm::ns_per_op(iterations, [&](size_t) {
+        soa_a.dot(soa_b, out);
+        bm::do_not_optimize(out[0]);
+    });
+
+    const auto aos_mag = bm::ns_per_op(iterations, [&](size_t) {
+        for (size_t i = 0; i < points; ++i)
+            out[i] = aos_b[i].mag();
+        bm::do_not_optimize(out[0]);
+    });
+    const auto soa_mag = bm::ns_per_op(iterations, [&](size_t) {
+        soa_b.mag(out);
+        bm::do_not_optimize(out[0]);
+    });
+
+    const auto aos_normalize = bm::ns_per_op(iterations, [&](size_t) {
+        for (size_t i = 0; i < points; ++i)
+            aos_b[i].normalize();
+        bm::do_not_optimize(aos_b[0]);
+    });
+    const auto soa_normalize = bm::ns_per_op(iterations, [&](size_t) {
+        soa_b.normalize();
+        bm::do_not_optimize(soa_b.x());
+    });
+
+    bm::report("add (AoS XYZPoint)", aos_add);
+    bm::report("add (SoA PointBatch)", soa_add, aos_add);
+    bm::report("scalar_multiplication (AoS XYZPoint)", aos_scale);
+    bm::report("scalar_multiplication (SoA PointBatch)", soa_scale, aos_scale);
+    bm::report("dot (AoS XYZPoint)", aos_dot);
+    bm::report("dot (SoA PointBatch)", soa_dot, aos_dot);
+    bm::report("mag (AoS XYZPoint)", aos_mag);
+    bm::report("mag (SoA PointBatch)", soa_mag, aos_mag);
+    bm::report("normalize (AoS XYZPoint)", aos_normalize);
+    bm::report("normalize (SoA PointBatch)", soa_normalize, aos_normalize);
+    std::printf("simd intrinsics: %s\n", detail::simd::enabled<float> ? "yes" : "no (auto-vectorized loops)");
+    return 0;
+}
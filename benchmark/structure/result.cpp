@@ -0,0 +1,83 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/result.hpp>
+
+#include <cstdint>
+#include <cstdio>
+#include <optional>
+#include <variant>
+
+// Creates and consumes Results in a tight loop, compared against the previous std::optional<std::variant> layout and
+// against a plain status code with an out parameter
+
+using namespace spn::structure;
+namespace bm = spn::benchmark;
+
+namespace {
+
+constexpr size_t iterations = 10000000;
+
+enum class Error : uint8_t { Odd };
+
+/// The layout Result used to have: an optional variant alongside a separate type enum
+struct LegacyResult {
+    enum class Type : uint8_t { NO_VALUE, OK, FAILED };
+
+    static LegacyResult ok(uint32_t v) { return {std::variant<uint32_t, Error>(std::in_place_index<0>, v), Type::OK}; }
+    static LegacyResult failed(Error e) {
+        return {std::variant<uint32_t, Error>(std::in_place_index<1>, e), Type::FAILED};
+    }
+
+    bool is_success() const { return type == Type::OK; }
+    uint32_t value() const { return std::get<0>(*v); }
+
+    std::optional<std::variant<uint32_t, Error>> v;
+    Type type;
+};
+
+__attribute__((noinline)) Result<uint32_t, Error> parse(uint32_t i) {
+    if (i & 1) return Result<uint32_t, Error>::failed(Error::Odd);
+    return i * 3;
+}
+
+__attribute__((noinline)) LegacyResult parse_legacy(uint32_t i) {
+    if (i & 1) return LegacyResult::failed(Error::Odd);
+    return LegacyResult::ok(i * 3);
+}
+
+__attribute__((noinline)) bool parse_status(uint32_t i, uint32_t& out) {
+    if (i & 1) return false;
+    out = i * 3;
+    return true;
+}
+
+} // namespace
+
+int main() {
+    std::printf("sizeof(Result<uint32_t, Error>) = %zu, sizeof(legacy) = %zu\n", sizeof(Result<uint32_t, Error>),
+                sizeof(LegacyResult));
+
+    uint32_t sum = 0;
+    const auto status = bm::ns_per_op(iterations, [&](size_t i) {
+        uint32_t v;
+        if (parse_status(static_cast<uint32_t>(i), v)) sum += v;
+    });
+    const auto legacy = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto r = parse_legacy(static_cast<uint32_t>(i));
+        if (r.is_success()) sum += r.value();
+    });
+    const auto compact = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto r = parse(static_cast<uint32_t>(i));
+        if (r.is_success()) sum += r.value();
+    });
+    const auto chained = bm::ns_per_op(iterations, [&](size_t i) {
+        sum += parse(static_cast<uint32_t>(i)).map([](uint32_t v) { return v + 1; }).value_or(0);
+    });
+    bm::do_not_optimize(sum);
+
+    bm::report("status code + out parameter", status);
+    bm::report("legacy optional<variant> result", legacy);
+    bm::report("Result", compact, legacy);
+    bm::report("Result map + value_or", chained, legacy);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/time/schedule.hpp>
+
+#include <vector>
+
+// Compares the indexed Schedule against the linear scan it replaced, for a weekly program of 336 blocks (a block of
+// 20 minutes every 30 minutes). Lookups are spread over the whole week.
+
+namespace bm = spn::benchmark;
+using spn::structure::time::Schedule;
+
+namespace {
+
+constexpr size_t iterations = 2000000;
+constexpr auto week = Schedule::week;
+
+/// The linear scan Schedule used before the index: every block is visited and the wrap recomputed per lookup
+struct LinearSchedule {
+    const std::vector<Schedule::Block>& blocks;
+
+    float value_at(const k_time_s t) const {
+        for (auto& b : blocks) {
+            const auto is_today = t >= b.start && t < b.start + b.duration;
+            const auto is_after_midnight = b.start + b.duration > week && t < b.start + b.duration - week;
+            if (is_today || is_after_midnight) return b.value;
+        }
+        return {};
+    }
+
+    k_time_s start_of_next_block(const k_time_s t) const {
+        for (auto& b : blocks) {
+            if (t < b.start) return b.start;
+        }
+        return week;
+    }
+};
+
+k_time_s sample(size_t i) { return k_time_s(static_cast<time_t>((i * 7919) % static_cast<size_t>(week.raw()))); }
+
+} // namespace
+
+int main() {
+    auto blocks = std::vector<Schedule::Block>();
+    for (time_t start = 0; start < week.raw(); start += 30 * 60) {
+        blocks.push_back({k_time_s(start), k_time_m(20), static_cast<float>(start % 7)});
+    }
+    const auto linear = LinearSchedule{blocks};
+    const auto indexed = Schedule(blocks.data(), blocks.size(), week);
+
+    const auto linear_value =
+        bm::ns_per_op(iterations, [&](size_t i) { bm::do_not_optimize(linear.value_at(sample(i))); });
+    const auto indexed_value =
+        bm::ns_per_op(iterations, [&](size_t i) { bm::do_not_optimize(indexed.value_at(sample(i))); });
+
+    const auto linear_next = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(linear.start_of_next_block(sample(i)).raw());
+    });
+    const auto indexed_next = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(indexed.start_of_next_block(sample(i)).raw());
+    });
+
+    const auto indexed_cursor = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto cursor = indexed.cursor(sample(i));
+        bm::do_not_optimize(cursor.next_transition.raw());
+    });
+
+    bm::report("value_at (linear scan)", linear_value);
+    bm::report("value_at (index)", indexed_value, linear_value);
+    bm::report("start_of_next_block (linear scan)", linear_next);
+    bm::report("start_of_next_block (index)", indexed_next, linear_next);
+    bm::report("cursor (index)", indexed_cursor);
+    return 0;
+}
@@ -0,0 +1,54 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/units/si.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+// Measures kernel time arithmetic at long uptimes (> 2^24 ms) with exact ratio conversions, compared against the
+// float ratio conversion that Unit used to do for every operation
+
+namespace bm = spn::benchmark;
+
+namespace {
+
+constexpr size_t iterations = 10000000;
+constexpr long long uptime_ms = 4321234567LL; // ~50 days
+
+/// The conversion Unit used to do: a float ratio multiplied with the raw value and rounded back
+inline time_t legacy_from_other(time_t raw, float ratio) { return std::round(ratio * static_cast<float>(raw)); }
+
+} // namespace
+
+int main() {
+    time_t sum = 0;
+    size_t legacy_errors = 0;
+
+    const auto legacy_same = bm::ns_per_op(iterations, [&](size_t i) {
+        sum += static_cast<time_t>(uptime_ms + i) + legacy_from_other(static_cast<time_t>(i & 0xff), 1.0f);
+    });
+    const auto exact_same = bm::ns_per_op(iterations, [&](size_t i) {
+        sum += (k_time_ms(uptime_ms + i) + k_time_ms(static_cast<time_t>(i & 0xff))).raw();
+    });
+    const auto legacy_cross = bm::ns_per_op(iterations, [&](size_t i) {
+        sum += legacy_from_other(static_cast<time_t>(uptime_ms + i), 1e-3f / 1.0f);
+    });
+    const auto exact_cross = bm::ns_per_op(iterations, [&](size_t i) {
+        sum += k_time_s(k_time_ms(uptime_ms + i)).raw();
+    });
+    bm::do_not_optimize(sum);
+
+    for (size_t i = 0; i < 1000; ++i) {
+        const auto uptime = static_cast<time_t>(uptime_ms + i);
+        if (static_cast<time_t>(uptime) + legacy_from_other(1, 1.0f) != uptime + 1) ++legacy_errors;
+        if (legacy_from_other(uptime, 1.0f) != uptime) ++legacy_errors;
+    }
+
+    bm::report("k_time_ms + k_time_ms (legacy float ratio)", legacy_same);
+    bm::report("k_time_ms + k_time_ms (exact ratio)", exact_same, legacy_same);
+    bm::report("k_time_ms -> k_time_s (legacy float ratio)", legacy_cross);
+    bm::report("k_time_ms -> k_time_s (exact ratio)", exact_cross, legacy_cross);
+    std::printf("legacy conversions off by at least 1 ms at ~50 days of uptime: %zu / 2000\n", legacy_errors);
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "benchmark.hpp"
+
+#include <spine/structure/units/si.hpp>
+
+#include <cstdint>
+
+// Checks that unit arithmetic costs the same as the equivalent raw arithmetic: every pair below should report a ratio
+// of about 1x. Conversions between magnitudes and constants such as `k_time_h(24)` are folded at compile time.
+
+namespace bm = spn::benchmark;
+
+namespace {
+
+constexpr size_t iterations = 20000000;
+
+constexpr auto day = k_time_ms(k_time_h(24));
+static_assert(day.raw() == 86400000);
+
+} // namespace
+
+int main() {
+    const auto raw_add = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(static_cast<time_t>(i) + 30 * 60 * 1000);
+    });
+    const auto unit_add = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize((k_time_ms(static_cast<time_t>(i)) + k_time_m(30)).raw());
+    });
+
+    const auto raw_modulo = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize((static_cast<time_t>(i) * 7919) % 86400000 < 12 * 3600 * 1000);
+    });
+    const auto unit_modulo = bm::ns_per_op(iterations, [&](size_t i) {
+        const auto t = k_time_ms((static_cast<time_t>(i) * 7919) % day.raw());
+        bm::do_not_optimize(t < k_time_h(12));
+    });
+
+    const auto raw_real = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize(static_cast<float>(i & 0xff) * 0.001f * 2.0f);
+    });
+    const auto unit_real = bm::ns_per_op(iterations, [&](size_t i) {
+        bm::do_not_optimize((meter(meter_m(static_cast<float>(i & 0xff))) * 2.0f).raw());
+    });
+
+    bm::report("raw time_t + constant", raw_add);
+    bm::report("k_time_ms + k_time_m(30)", unit_add, raw_add);
+    bm::report("raw time_t wrap and compare", raw_modulo);
+    bm::report("k_time_ms wrap and compare to k_time_h(12)", unit_modulo, raw_modulo);
+    bm::report("raw float scale and convert", raw_real);
+    bm::report("meter(meter_m) * 2", unit_real, raw_real);
+    return 0;
+}
@@ -1,10 +1,17 @@
 #include "spine/controller/pid.hpp"
 #include "spine/controller/sr_latch.hpp"
+#include "spine/core/clock.hpp"
 #include "spine/core/debugging.hpp"
 #include "spine/core/exception.hpp"
+#include "spine/core/fixed.hpp"
+#include "spine/core/memory.hpp"
 #include "spine/core/meta/enum.hpp"
 #include "spine/core/meta/unique_type_variant.hpp"
+#include "spine/core/utils/cobs.hpp"
 #include "spine/core/utils/concatenate.hpp"
+#include "spine/core/utils/crc.hpp"
+#include "spine/core/utils/format.hpp"
+#include "spine/core/utils/parse.hpp"
 #include "spine/core/utils/string.hpp"
 #include "spine/core/utils/time_repr.hpp"
 #include "spine/eventsystem/eventsystem.hpp"
@@ -16,25 +23,38 @@
 #include "spine/filter/implementations/mapped_range.hpp"
 #include "spine/filter/implementations/passthrough.hpp"
 #include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/command_router.hpp"
+#include "spine/io/stream/compressed_stream.hpp"
+#include "spine/io/stream/frame_transaction.hpp"
+#include "spine/io/stream/framed_stream.hpp"
+#include "spine/io/stream/implementations/fd.hpp"
 #include "spine/io/stream/implementations/mock.hpp"
+#include "spine/io/stream/implementations/shared_memory.hpp"
+#include "spine/io/stream/static_stream.hpp"
 #include "spine/io/stream/stream.hpp"
 #include "spine/io/stream/transaction.hpp"
 #include "spine/platform/gpio.hpp"
 #include "spine/platform/hal.hpp"
 #include "spine/platform/protocols/uart.hpp"
 #include "spine/structure/array.hpp"
+#include "spine/structure/flat_hash_map.hpp"
 #include "spine/structure/linebuffer.hpp"
 #include "spine/structure/point.hpp"
+#include "spine/structure/point_batch.hpp"
 #include "spine/structure/pool.hpp"
 #include "spine/structure/result.hpp"
 #include "spine/structure/ringbuffer.hpp"
+#include "spine/structure/sorted_flat_map.hpp"
 #include "spine/structure/stack.hpp"
 #include "spine/structure/static_string.hpp"
+#include "spine/structure/time/calendar.hpp"
 #include "spine/structure/time/datetime.hpp"
 #include "spine/structure/time/schedule.hpp"
 #include "spine/structure/time/timers.hpp"
 #include "spine/structure/tuple.hpp"
 #include "spine/structure/units/primitives/compound_unit.hpp"
+#include "spine/structure/units/primitives/dimension.hpp"
+#include "spine/structure/units/primitives/symbols.hpp"
 #include "spine/structure/units/primitives/unit.hpp"
 #include "spine/structure/units/si.hpp"
 #include "spine/structure/vector.hpp"
@@ -11,63 +11,173 @@
  * - use Spine's time units
  * - math is mostly consistent with original, deduplicated some functions
  * - remove unnecessary functionality
+ * - templated on the value type, such that fixed point types can be used on FPU-less targets
  **********************************************************************************************/
 
+#pragma once
+
+#include "spine/core/clock.hpp"
+#include "spine/core/debugging.hpp"
+#include "spine/core/fixed.hpp"
 #include "spine/structure/units/time.hpp"
 
 namespace spn::controller {
 
-class PIDController {
+template<typename ValueType = float>
+/// PID controller operating on `ValueType`, which is either a floating point type or a spn::Fixed
+class BasicPIDController {
 public:
+    static_assert(spn::is_real_v<ValueType>, "ValueType must be a floating point or fixed point type");
+
     enum class Direction { FORWARD, REVERSE };
     enum class Proportionality { ON_MEASUREMENT, ON_ERROR };
 
     // commonly used functions **************************************************************************
-    PIDController(float* const input, float* const output, float* const setpoint, const float Kp, const float Ki,
-                  const float Kd, const Proportionality proportionality, const Direction controllerDirection);
-
-    PIDController(float* Input, float* Output, float* Setpoint, float Kp, float Ki, float Kd,
-                  Direction ControllerDirection);
-
-    void initialize();
-
-    bool update(const k_time_ms now);
-
-    void set_output_limits(float Min, float Max);
-
-    void set_tunings(float Kp, float Ki, float Kd,
-                     const Proportionality proportionality = Proportionality::ON_MEASUREMENT);
-
-    void set_controller_direction(const Direction direction);
-
-    void set_sampling_time(const k_time_ms sampling_time);
-
-    float Kp() const { return _kp; }
-    float Ki() const { return _ki; }
-    float Kd() const { return _kd; }
+    BasicPIDController(ValueType* const input, ValueType* const output, ValueType* const setpoint, const ValueType Kp,
+                       const ValueType Ki, const ValueType Kd, const Proportionality proportionality,
+                       const Direction controllerDirection)
+        : _user_input(input), _user_output(output), _user_setpoint(setpoint) {
+        spn_assert(input);
+        spn_assert(output);
+        spn_assert(setpoint);
+        set_controller_direction(controllerDirection);
+        set_tunings(Kp, Ki, Kd, proportionality);
+        _last_time = spn::Clock::now() - _sampling_time;
+    }
+
+    BasicPIDController(ValueType* Input, ValueType* Output, ValueType* Setpoint, ValueType Kp, ValueType Ki,
+                       ValueType Kd, Direction ControllerDirection)
+        : BasicPIDController(Input, Output, Setpoint, Kp, Ki, Kd, Proportionality::ON_ERROR, ControllerDirection) {}
+
+    void initialize() {
+        _cumulative_output = *_user_output;
+        _last_reading = *_user_input;
+        if (_cumulative_output > _output_upper_limit) {
+            _cumulative_output = _output_upper_limit;
+        } else if (_cumulative_output < _output_lower_limit) {
+            _cumulative_output = _output_lower_limit;
+        }
+    }
+
+    bool update(const k_time_ms now) {
+        if (const auto timeChange = (now - _last_time); timeChange >= _sampling_time) {
+            /*Compute all the working error variables*/
+            const ValueType input = *_user_input;
+            const ValueType error = *_user_setpoint - input;
+            const ValueType dInput = (input - _last_reading);
+            _cumulative_output += (_ki * error);
+
+            /*Add Proportional on Measurement, if ON_MEASUREMENT is specified*/
+            if (_proportionality == Proportionality::ON_MEASUREMENT) _cumulative_output -= _kp * dInput;
+
+            if (_cumulative_output > _output_upper_limit) _cumulative_output = _output_upper_limit;
+            else if (_cumulative_output < _output_lower_limit)
+                _cumulative_output = _output_lower_limit;
+
+            /*Add Proportional on Error, if ON_ERROR is specified*/
+            ValueType output;
+            if (_proportionality == Proportionality::ON_ERROR) output = _kp * error;
+            else
+                output = 0;
+
+            /*Compute Rest of PID Output*/
+            output += _cumulative_output - _kd * dInput;
+
+            if (output > _output_upper_limit) output = _output_upper_limit;
+            else if (output < _output_lower_limit)
+                output = _output_lower_limit;
+            *_user_output = output;
+
+            /*Remember some variables for next time*/
+            _last_reading = input;
+            _last_time = now;
+            return true;
+        }
+        return false;
+    }
+
+    void set_output_limits(ValueType Min, ValueType Max) {
+        if (Min >= Max) return;
+        _output_lower_limit = Min;
+        _output_upper_limit = Max;
+
+        if (*_user_output > _output_upper_limit) *_user_output = _output_upper_limit;
+        else if (*_user_output < _output_lower_limit)
+            *_user_output = _output_lower_limit;
+
+        if (_cumulative_output > _output_upper_limit) _cumulative_output = _output_upper_limit;
+        else if (_cumulative_output < _output_lower_limit)
+            _cumulative_output = _output_lower_limit;
+    }
+
+    void set_tunings(ValueType Kp, ValueType Ki, ValueType Kd,
+                     const Proportionality proportionality = Proportionality::ON_MEASUREMENT) {
+        spn_assert(Kp >= 0 && Ki >= 0 && Kd >= 0);
+        spn_assert(_sampling_time > k_time_ms{});
+
+        _proportionality = proportionality;
+
+        const auto sampletime_in_seconds = ValueType(_sampling_time.raw()) / ValueType(1000);
+        _kp = Kp;
+        _ki = Ki * sampletime_in_seconds;
+        _kd = Kd / sampletime_in_seconds;
+
+        if (_controller_direction == Direction::REVERSE) {
+            _kp = (0 - _kp);
+            _ki = (0 - _ki);
+            _kd = (0 - _kd);
+        }
+    }
+
+    void set_controller_direction(const Direction direction) {
+        if (direction != _controller_direction) {
+            _kp = (0 - _kp);
+            _ki = (0 - _ki);
+            _kd = (0 - _kd);
+            _controller_direction = direction;
+        }
+    }
+
+    void set_sampling_time(const k_time_ms sampling_time) {
+        // adjust sample
+        if (sampling_time > k_time_ms(0)) {
+            const auto ratio = ValueType(sampling_time.raw()) / ValueType(_sampling_time.raw());
+            _ki *= ratio;
+            _kd /= ratio;
+            _sampling_time = sampling_time;
+        }
+    }
+
+    ValueType Kp() const { return _kp; }
+    ValueType Ki() const { return _ki; }
+    ValueType Kd() const { return _kd; }
 
     Direction direction() const { return _controller_direction; }
 
 private:
-    float _kp = 0; // * (P)roportional Tuning Parameter
-    float _ki = 0; // * (I)ntegral Tuning Parameter
-    float _kd = 0; // * (D)erivative Tuning Parameter
+    ValueType _kp = 0; // * (P)roportional Tuning Parameter
+    ValueType _ki = 0; // * (I)ntegral Tuning Parameter
+    ValueType _kd = 0; // * (D)erivative Tuning Parameter
 
     enum Direction _controller_direction = Direction::FORWARD;
 
-    float* _user_input = nullptr; // * Pointers to the Input, Output, and Setpoint variables
-    float* _user_output = nullptr; //   This creates a hard link between the variables and the
-    float* _user_setpoint = nullptr; //   PID, freeing the user from having to constantly tell us
+    ValueType* _user_input = nullptr; // * Pointers to the Input, Output, and Setpoint variables
+    ValueType* _user_output = nullptr; //   This creates a hard link between the variables and the
+    ValueType* _user_setpoint = nullptr; //   PID, freeing the user from having to constantly tell us
     //   what these values are.  with pointers we'll just know.
 
     k_time_ms _last_time{};
-    float _cumulative_output = 0;
-    float _last_reading = 0;
+    ValueType _cumulative_output = 0;
+    ValueType _last_reading = 0;
 
     k_time_ms _sampling_time = k_time_ms{100};
-    float _output_lower_limit = 0;
-    float _output_upper_limit = 255;
+    ValueType _output_lower_limit = 0;
+    ValueType _output_upper_limit = 255;
     Proportionality _proportionality = Proportionality::ON_MEASUREMENT;
 };
 
+extern template class BasicPIDController<float>;
+
+using PIDController = BasicPIDController<float>;
+
 } // namespace spn::controller
@@ -15,7 +15,7 @@ void PID::initialize() {
     _pid_backend.initialize();
 }
 
-void PID::new_reading(float value) { new_reading(value, HAL::millis()); }
+void PID::new_reading(float value) { new_reading(value, spn::Clock::now()); }
 
 void PID::new_reading(float value, k_time_ms now) {
     _input = value;
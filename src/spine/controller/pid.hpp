@@ -2,8 +2,10 @@
 
 #include "spine/controller/implementations/pid/pid_controller.hpp"
 #include "spine/controller/implementations/pid/pid_tuner.hpp"
+#include "spine/core/clock.hpp"
 #include "spine/core/debugging.hpp"
 #include "spine/core/logging.hpp"
+#include "spine/platform/hal.hpp"
 #include "spine/structure/time/timers.hpp"
 
 #include <cmath>
@@ -73,7 +75,7 @@ public:
     /// Autotune the proportional weights for the target_setpoint
     Tunings autotune(const TuneConfig& tune_config, std::function<void(float)> process_setter,
                      std::function<float(void)> process_getter, std::function<void(void)> loop = {},
-                     std::function<k_time_ms(void)> uptime = HAL::millis,
+                     std::function<k_time_ms(void)> uptime = spn::Clock::now,
                      std::function<void(k_time_ms)> sleep = HAL::delay) const;
 
     /// Get the controller response
@@ -26,7 +26,7 @@ public:
 
     using State = core::LogicalState;
 
-    SRLatch(const Config&& cfg) : _cfg(std::move(cfg)), _last_turned(Timer(HAL::millis() - _cfg.minimal_off_time)) {}
+    SRLatch(const Config&& cfg) : _cfg(std::move(cfg)), _last_turned(Timer(spn::Clock::now() - _cfg.minimal_off_time)) {}
 
     void initialize(){}; // boilerplate
 
@@ -0,0 +1,54 @@
+#include "spine/core/clock.hpp"
+
+#include "spine/platform/hal.hpp"
+
+namespace spn {
+
+namespace {
+uint32_t platform_source() { return static_cast<uint32_t>(HAL::millis().raw()); }
+
+Clock::Source g_source = platform_source;
+uint32_t g_last_read = 0; // last value returned by the source
+uint64_t g_monotonic = 0; // milliseconds accumulated from the differences between reads
+uint64_t g_reads = 0;
+bool g_ticking = false;
+k_time_ms g_snapshot = k_time_ms(0);
+
+k_time_ms read() {
+    const auto value = g_source();
+    g_monotonic += static_cast<uint32_t>(value - g_last_read); // unsigned subtraction handles the source's wrap
+    g_last_read = value;
+    ++g_reads;
+    return k_time_ms(static_cast<spnu::KernelTimeRawType>(g_monotonic));
+}
+} // namespace
+
+k_time_ms Clock::tick() {
+    g_snapshot = read();
+    g_ticking = true;
+    return g_snapshot;
+}
+
+void Clock::release() { g_ticking = false; }
+
+bool Clock::is_ticking() { return g_ticking; }
+
+k_time_ms Clock::now() { return g_ticking ? g_snapshot : read(); }
+
+void Clock::set_source(Source source) {
+    g_source = source != nullptr ? source : platform_source;
+    g_last_read = g_source(); // continue from the current time
+    ++g_reads;
+}
+
+uint64_t Clock::reads() { return g_reads; }
+
+Clock::ScopedTick::ScopedTick() : _outermost(!Clock::is_ticking()) {
+    if (_outermost) Clock::tick();
+}
+
+Clock::ScopedTick::~ScopedTick() {
+    if (_outermost) Clock::release();
+}
+
+} // namespace spn
@@ -0,0 +1,57 @@
+#pragma once
+
+#include "spine/structure/units/time.hpp"
+
+#include <cstdint>
+
+namespace spn {
+
+/// Monotonic millisecond clock that timers and the eventsystem consult instead of reading the platform directly.
+///
+/// A tick takes a single snapshot of the time source, which `now()` returns until the tick is released. Everything
+/// that runs within one tick (e.g. a batch of timer checks) thus sees the same moment in time and the source
+/// is read once. Outside of a tick `now()` reads the source on every call.
+///
+/// The source is a (wrapping) 32-bit millisecond counter, such as Arduino's `millis()`. The clock accumulates the
+/// difference between reads in 64 bits, so it doesn't wrap as long as the source is read at least once every 49 days.
+///
+/// Not thread-safe: spine expects a single thread of execution.
+class Clock {
+public:
+    /// Returns a millisecond counter that may wrap around at 2^32
+    using Source = uint32_t (*)();
+
+    /// Read the source once and hold the result as `now()` until `release()` (or the next `tick()`)
+    static k_time_ms tick();
+
+    /// Stop holding the snapshot of the last tick
+    static void release();
+
+    /// Returns true while a snapshot is held
+    static bool is_ticking();
+
+    /// Returns the snapshot while ticking, otherwise reads the source
+    static k_time_ms now();
+
+    /// Replace the time source, e.g. to run simulated time. Passing nullptr restores the platform's clock. The clock
+    /// continues from its current time, so swapping sources never makes it go backwards.
+    static void set_source(Source source);
+
+    /// Returns the amount of times the source was read since startup
+    static uint64_t reads();
+
+    /// Ticks for the duration of its lifetime. Scopes nest: only the outermost one takes a snapshot and releases it.
+    class ScopedTick {
+    public:
+        ScopedTick();
+        ~ScopedTick();
+
+        ScopedTick(const ScopedTick&) = delete;
+        ScopedTick& operator=(const ScopedTick&) = delete;
+
+    private:
+        bool _outermost;
+    };
+};
+
+} // namespace spn
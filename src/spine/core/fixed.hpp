@@ -0,0 +1,174 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace spn {
+
+namespace detail {
+template<int Bits>
+/// Smallest signed integer type holding `Bits` bits
+using fixed_storage_t = std::conditional_t<
+    Bits <= 8, int8_t, std::conditional_t<Bits <= 16, int16_t, std::conditional_t<Bits <= 32, int32_t, int64_t>>>;
+} // namespace detail
+
+template<int IntBits, int FracBits>
+/// Signed fixed point number with `IntBits` integer bits and `FracBits` fractional bits (plus a sign bit), for targets
+/// without an FPU. All arithmetic saturates at the representable range instead of wrapping around, and rounds to the
+/// nearest representable value. Division by zero saturates towards the sign of the dividend.
+class Fixed {
+public:
+    static_assert(IntBits >= 0 && FracBits >= 0, "Fixed requires a non-negative amount of bits");
+    static_assert(IntBits + FracBits <= 31, "Fixed supports at most 31 bits (plus sign)");
+
+    using RawType = detail::fixed_storage_t<IntBits + FracBits + 1>;
+    using WideType = detail::fixed_storage_t<2 * (IntBits + FracBits + 1)>;
+
+    static constexpr int integer_bits = IntBits;
+    static constexpr int fraction_bits = FracBits;
+
+    constexpr Fixed() = default;
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    constexpr Fixed(T value) : _raw(from_integral(value)) {}
+
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    constexpr Fixed(T value) : _raw(from_floating(static_cast<long double>(value))) {}
+
+    /// Construct from the raw representation (`value * 2^FracBits`)
+    static constexpr Fixed from_raw(RawType raw) {
+        Fixed f;
+        f._raw = raw;
+        return f;
+    }
+
+    /// Returns the raw representation (`value * 2^FracBits`)
+    constexpr RawType raw() const { return _raw; }
+
+    static constexpr Fixed max() { return from_raw(max_raw); }
+    static constexpr Fixed lowest() { return from_raw(min_raw); }
+    /// Smallest representable step
+    static constexpr Fixed resolution() { return from_raw(1); }
+
+    template<typename T, std::enable_if_t<std::is_floating_point_v<T>, int> = 0>
+    explicit constexpr operator T() const {
+        return static_cast<T>(_raw) / static_cast<T>(one);
+    }
+
+    template<typename T, std::enable_if_t<std::is_integral_v<T>, int> = 0>
+    /// Converts to an integer, truncating towards zero (like a float to int conversion)
+    explicit constexpr operator T() const {
+        return static_cast<T>(_raw / one);
+    }
+
+    constexpr Fixed operator-() const { return from_raw(saturate(-static_cast<WideType>(_raw))); }
+    constexpr Fixed operator+() const { return *this; }
+
+    friend constexpr Fixed operator+(Fixed a, Fixed b) {
+        return from_raw(saturate(static_cast<WideType>(a._raw) + static_cast<WideType>(b._raw)));
+    }
+    friend constexpr Fixed operator-(Fixed a, Fixed b) {
+        return from_raw(saturate(static_cast<WideType>(a._raw) - static_cast<WideType>(b._raw)));
+    }
+    friend constexpr Fixed operator*(Fixed a, Fixed b) {
+        const auto product = static_cast<WideType>(a._raw) * static_cast<WideType>(b._raw);
+        return from_raw(saturate(shift_down_rounded(product)));
+    }
+    friend constexpr Fixed operator/(Fixed a, Fixed b) {
+        if (b._raw == 0) return a._raw < 0 ? lowest() : (a._raw > 0 ? max() : Fixed());
+        const auto dividend = static_cast<WideType>(a._raw) * static_cast<WideType>(one);
+        const auto divisor = static_cast<WideType>(b._raw);
+        const auto half = (divisor < 0 ? -divisor : divisor) / 2;
+        const auto rounded = (dividend < 0) == (divisor < 0) ? dividend + half : dividend - half;
+        return from_raw(saturate(rounded / divisor));
+    }
+
+    constexpr Fixed& operator+=(Fixed other) { return *this = *this + other; }
+    constexpr Fixed& operator-=(Fixed other) { return *this = *this - other; }
+    constexpr Fixed& operator*=(Fixed other) { return *this = *this * other; }
+    constexpr Fixed& operator/=(Fixed other) { return *this = *this / other; }
+    constexpr Fixed& operator++() { return *this += Fixed(1); }
+    constexpr Fixed& operator--() { return *this -= Fixed(1); }
+
+    friend constexpr bool operator==(Fixed a, Fixed b) { return a._raw == b._raw; }
+    friend constexpr bool operator!=(Fixed a, Fixed b) { return a._raw != b._raw; }
+    friend constexpr bool operator<(Fixed a, Fixed b) { return a._raw < b._raw; }
+    friend constexpr bool operator>(Fixed a, Fixed b) { return a._raw > b._raw; }
+    friend constexpr bool operator<=(Fixed a, Fixed b) { return a._raw <= b._raw; }
+    friend constexpr bool operator>=(Fixed a, Fixed b) { return a._raw >= b._raw; }
+
+private:
+    static constexpr RawType max_raw = static_cast<RawType>((WideType(1) << (IntBits + FracBits)) - 1);
+    static constexpr RawType min_raw = static_cast<RawType>(-max_raw - 1);
+    static constexpr RawType one = static_cast<RawType>(WideType(1) << FracBits);
+
+    static constexpr RawType saturate(WideType v) {
+        return v > max_raw ? max_raw : (v < min_raw ? min_raw : static_cast<RawType>(v));
+    }
+
+    /// Divide by 2^FracBits, rounding half up
+    static constexpr WideType shift_down_rounded(WideType v) {
+        if constexpr (FracBits == 0) return v;
+        else return (v + (WideType(1) << (FracBits - 1))) >> FracBits;
+    }
+
+    template<typename T>
+    static constexpr RawType from_integral(T v) {
+        constexpr auto max_integer = static_cast<long long>(max_raw / one);
+        constexpr auto min_integer = static_cast<long long>(min_raw / one);
+        if constexpr (std::is_unsigned_v<T>) {
+            if (v > static_cast<unsigned long long>(max_integer)) return max_raw;
+        } else {
+            if (v > max_integer) return max_raw;
+            if (v < min_integer) return min_raw;
+        }
+        return static_cast<RawType>(static_cast<WideType>(v) * one);
+    }
+
+    static constexpr RawType from_floating(long double v) {
+        if (v != v) return 0; // NaN
+        const auto scaled = v * one;
+        if (scaled >= static_cast<long double>(max_raw)) return max_raw;
+        if (scaled <= static_cast<long double>(min_raw)) return min_raw;
+        return static_cast<RawType>(static_cast<WideType>(scaled < 0 ? scaled - 0.5L : scaled + 0.5L));
+    }
+
+    RawType _raw = 0;
+};
+
+template<typename T>
+struct is_fixed : std::false_type {};
+template<int IntBits, int FracBits>
+struct is_fixed<Fixed<IntBits, FracBits>> : std::true_type {};
+
+/// True when `T` is a spn::Fixed
+template<typename T>
+constexpr bool is_fixed_v = is_fixed<T>::value;
+
+/// True for types that can be used where a real number is expected: floating point types and spn::Fixed
+template<typename T>
+constexpr bool is_real_v = std::is_floating_point_v<T> || is_fixed_v<T>;
+
+/// Q15.16: range of about +-32768 with a resolution of 1.5e-5
+using fixed_q16 = Fixed<15, 16>;
+
+} // namespace spn
+
+namespace std {
+template<int IntBits, int FracBits>
+class numeric_limits<spn::Fixed<IntBits, FracBits>> {
+    using F = spn::Fixed<IntBits, FracBits>;
+
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = true;
+    static constexpr int digits = IntBits + FracBits;
+    static constexpr F min() { return F::resolution(); }
+    static constexpr F max() { return F::max(); }
+    static constexpr F lowest() { return F::lowest(); }
+    static constexpr F epsilon() { return F::resolution(); }
+};
+} // namespace std
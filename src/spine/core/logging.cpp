@@ -1,6 +1,7 @@
 #include "spine/core/logging.hpp"
 
 #include "spine/platform/hal.hpp"
+#include "spine/structure/static_string.hpp"
 
 #include <cinttypes>
 
@@ -37,27 +38,26 @@ const char* get_current_time() {
 
 void print(const LogLevel level, const char* filename, const int line_number, const char* function_name,
            const char* fmt, ...) {
-    char msg_buffer[SPINE_LOGGING_MAX_MSG_SIZE];
-    size_t space_used = 0;
+    // messages that don't fit are truncated
+    auto msg = spn::structure::StaticString<SPINE_LOGGING_MAX_MSG_SIZE - 1>();
 
 #ifndef SPN_LOG_OVERLOAD
-    space_used += snprintf(msg_buffer, sizeof(msg_buffer), "[%s] [%s] ", get_current_time(), to_string(level));
+    msg.append("[").append(get_current_time()).append("] [").append(to_string(level)).append("] ");
 #endif
 
     va_list args;
     va_start(args, fmt);
-    space_used += vsnprintf(msg_buffer + space_used, sizeof(msg_buffer) - space_used, fmt, args);
+    msg.append_vprintf(fmt, args);
     va_end(args);
 
     if (level == LogLevel::DEBUG) {
-        space_used += snprintf(msg_buffer + space_used, sizeof(msg_buffer) - space_used, " (%s:%d %s)", filename,
-                               line_number, function_name);
+        msg.format(" (", filename, ':', line_number, ' ', function_name, ')');
     }
 
 #if defined(SPN_LOG_OVERLOAD)
-    SPN_LOG_OVERLOAD(level, msg_buffer);
+    SPN_LOG_OVERLOAD(level, msg.c_str());
 #elif defined(SPINE_PLATFORM_CAP_PRINT) && defined(SPINE_PLATFORM_CAP_PRINTF)
-    HAL::println(msg_buffer);
+    HAL::println(msg.c_str());
     HAL::printflush();
 #else
 #    error "Platform doesnt provide print capacity, nor was an overload of SPN_LOG_OVERLOAD provided."
@@ -0,0 +1,169 @@
+#include "spine/core/memory.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+namespace spn::memory {
+
+namespace {
+constexpr auto subsystem_count = static_cast<size_t>(Subsystem::SIZE);
+
+/// The statistics of a subsystem as they're recorded, from any thread. They're only counters: relaxed ordering will do.
+struct AtomicUsage {
+    std::atomic<size_t> current_bytes{0};
+    std::atomic<size_t> peak_bytes{0};
+    std::atomic<size_t> allocations{0};
+    std::atomic<size_t> deallocations{0};
+};
+
+// constant initialized, so accounting is valid before any static constructor runs
+AtomicUsage g_usage[subsystem_count] = {};
+Subsystem g_active_subsystem = Subsystem::UNTAGGED;
+
+AtomicUsage& usage_mut(Subsystem subsystem) {
+    const auto idx = static_cast<size_t>(subsystem);
+    return g_usage[idx < subsystem_count ? idx : 0];
+}
+
+Usage snapshot(const AtomicUsage& u) {
+    return {.current_bytes = u.current_bytes.load(std::memory_order_relaxed),
+            .peak_bytes = u.peak_bytes.load(std::memory_order_relaxed),
+            .allocations = u.allocations.load(std::memory_order_relaxed),
+            .deallocations = u.deallocations.load(std::memory_order_relaxed)};
+}
+} // namespace
+
+const char* to_string(Subsystem subsystem) {
+    switch (subsystem) {
+    case Subsystem::UNTAGGED: return "untagged";
+    case Subsystem::STRUCTURE: return "structure";
+    case Subsystem::EVENTSYSTEM: return "eventsystem";
+    case Subsystem::IO: return "io";
+    case Subsystem::FILTER: return "filter";
+    case Subsystem::CONTROLLER: return "controller";
+    case Subsystem::USER: return "user";
+    default: return "unknown";
+    }
+}
+
+Usage usage(Subsystem subsystem) { return snapshot(usage_mut(subsystem)); }
+
+Usage total_usage() {
+    Usage total;
+    for (const auto& atomic_usage : g_usage) {
+        const auto u = snapshot(atomic_usage);
+        total.current_bytes += u.current_bytes;
+        total.peak_bytes += u.peak_bytes;
+        total.allocations += u.allocations;
+        total.deallocations += u.deallocations;
+    }
+    return total;
+}
+
+void reset_peak(Subsystem subsystem) {
+    auto& u = usage_mut(subsystem);
+    u.peak_bytes.store(u.current_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
+
+Subsystem active_subsystem() { return g_active_subsystem; }
+
+void record_allocation(size_t bytes, Subsystem subsystem) {
+    auto& u = usage_mut(subsystem);
+    const auto current = u.current_bytes.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+    auto peak = u.peak_bytes.load(std::memory_order_relaxed);
+    while (peak < current && !u.peak_bytes.compare_exchange_weak(peak, current, std::memory_order_relaxed)) {}
+    u.allocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void record_deallocation(size_t bytes, Subsystem subsystem) {
+    auto& u = usage_mut(subsystem);
+    auto current = u.current_bytes.load(std::memory_order_relaxed);
+    while (!u.current_bytes.compare_exchange_weak(current, current - std::min(current, bytes),
+                                                  std::memory_order_relaxed)) {}
+    u.deallocations.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* allocate(size_t bytes, Subsystem subsystem) {
+    void* ptr = std::malloc(bytes);
+    if (ptr != nullptr) record_allocation(bytes, subsystem);
+    return ptr;
+}
+
+void deallocate(void* ptr, size_t bytes, Subsystem subsystem) {
+    if (ptr == nullptr) return;
+    record_deallocation(bytes, subsystem);
+    std::free(ptr);
+}
+
+ScopedTag::ScopedTag(Subsystem subsystem) : _previous(g_active_subsystem) { g_active_subsystem = subsystem; }
+ScopedTag::~ScopedTag() { g_active_subsystem = _previous; }
+
+} // namespace spn::memory
+
+#if defined(NATIVE)
+
+// Global allocation hook for the native platform: every `operator new` is charged to the active subsystem such that
+// (unit)tests can assert that hot paths do not touch the heap. The allocation is prefixed with a header that remembers
+// the size and subsystem, since the matching `operator delete` is not guaranteed to receive either. The over-aligned
+// forms (`alignas` beyond `std::max_align_t`) are hooked as well: their header sits right in front of the aligned
+// pointer and remembers where the block starts.
+
+namespace {
+struct alignas(alignof(std::max_align_t)) AllocationHeader {
+    void* block; // as returned by malloc
+    size_t bytes;
+    spn::memory::Subsystem subsystem;
+};
+
+void* hooked_new(size_t bytes, size_t alignment = alignof(AllocationHeader)) {
+    alignment = std::max(alignment, alignof(AllocationHeader));
+    const auto block_bytes = sizeof(AllocationHeader) + (alignment - alignof(AllocationHeader)) + bytes;
+    void* block = std::malloc(block_bytes);
+    // like the standard operator new, give the new handler the chance to free memory before failing
+    while (block == nullptr) {
+        const auto handler = std::get_new_handler();
+        if (handler == nullptr) throw std::bad_alloc();
+        handler();
+        block = std::malloc(block_bytes);
+    }
+    // both are multiples of the header's alignment, so the header in front of the aligned pointer is aligned as well
+    const auto address = reinterpret_cast<uintptr_t>(block) + sizeof(AllocationHeader);
+    auto* ptr = reinterpret_cast<void*>((address + alignment - 1) & ~(uintptr_t{alignment} - 1));
+    auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+    header->block = block;
+    header->bytes = bytes;
+    header->subsystem = spn::memory::active_subsystem();
+    spn::memory::record_allocation(bytes, header->subsystem);
+    return ptr;
+}
+
+void hooked_delete(void* ptr) noexcept {
+    if (ptr == nullptr) return;
+    auto* header = static_cast<AllocationHeader*>(ptr) - 1;
+    spn::memory::record_deallocation(header->bytes, header->subsystem);
+    std::free(header->block);
+}
+} // namespace
+
+void* operator new(size_t bytes) { return hooked_new(bytes); }
+void* operator new[](size_t bytes) { return hooked_new(bytes); }
+void operator delete(void* ptr) noexcept { hooked_delete(ptr); }
+void operator delete[](void* ptr) noexcept { hooked_delete(ptr); }
+void operator delete(void* ptr, size_t) noexcept { hooked_delete(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { hooked_delete(ptr); }
+
+void* operator new(size_t bytes, std::align_val_t alignment) {
+    return hooked_new(bytes, static_cast<size_t>(alignment));
+}
+void* operator new[](size_t bytes, std::align_val_t alignment) {
+    return hooked_new(bytes, static_cast<size_t>(alignment));
+}
+void operator delete(void* ptr, std::align_val_t) noexcept { hooked_delete(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { hooked_delete(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { hooked_delete(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { hooked_delete(ptr); }
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spn::memory {
+
+/// Label under which allocations are accounted
+enum class Subsystem : uint8_t { UNTAGGED, STRUCTURE, EVENTSYSTEM, IO, FILTER, CONTROLLER, USER, SIZE };
+
+/// Allocation statistics of a single subsystem
+struct Usage {
+    size_t current_bytes = 0; // bytes currently held
+    size_t peak_bytes = 0; // highest amount of bytes held at any one time
+    size_t allocations = 0; // amount of allocations made since startup
+    size_t deallocations = 0; // amount of deallocations made since startup
+};
+
+/// True when every `operator new` is accounted for as well (only on native), otherwise only spine containers are
+#if defined(NATIVE)
+constexpr bool heap_is_instrumented = true;
+#else
+constexpr bool heap_is_instrumented = false;
+#endif
+
+/// Returns a human readable name for `subsystem`
+const char* to_string(Subsystem subsystem);
+
+/// Returns a snapshot of the allocation statistics for `subsystem`
+Usage usage(Subsystem subsystem);
+
+/// Returns the allocation statistics summed over all subsystems
+Usage total_usage();
+
+/// Reset the peak of `subsystem` to its current usage
+void reset_peak(Subsystem subsystem);
+
+/// Returns the subsystem to which new allocations are currently charged
+Subsystem active_subsystem();
+
+/// Allocate `bytes` and charge them to `subsystem`. Returns nullptr on failure.
+void* allocate(size_t bytes, Subsystem subsystem = active_subsystem());
+
+/// Release `bytes` at `ptr` that were allocated through `allocate` under `subsystem`
+void deallocate(void* ptr, size_t bytes, Subsystem subsystem);
+
+/// Charge an allocation of `bytes` to `subsystem` without allocating (for allocators outside of spine's control)
+void record_allocation(size_t bytes, Subsystem subsystem);
+
+/// Release a charge of `bytes` from `subsystem` without deallocating
+void record_deallocation(size_t bytes, Subsystem subsystem);
+
+/// Charges all allocations made during its lifetime to `subsystem`. Tags nest; the previous tag is restored on
+/// destruction. Not thread-safe: spine expects a single thread of execution. The statistics themselves are, so the
+/// allocations of other threads (e.g. of the standard library on native) are accounted for correctly, although charged
+/// to whatever subsystem is active.
+class ScopedTag {
+public:
+    explicit ScopedTag(Subsystem subsystem);
+    ~ScopedTag();
+
+    ScopedTag(const ScopedTag&) = delete;
+    ScopedTag& operator=(const ScopedTag&) = delete;
+
+private:
+    Subsystem _previous;
+};
+
+} // namespace spn::memory
@@ -0,0 +1,69 @@
+#include "spine/core/utils/cobs.hpp"
+
+#include <cstring>
+
+namespace spn::core::utils {
+
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out) {
+    const auto start = out;
+    const auto end = data + length;
+    while (true) {
+        // a block is up to 254 non-zero bytes, preceded by its length + 1
+        const auto limit = static_cast<size_t>(end - data) < 254 ? static_cast<size_t>(end - data) : 254;
+        const auto zero = limit > 0 ? static_cast<const uint8_t*>(std::memchr(data, 0, limit)) : nullptr;
+        const auto run = zero ? static_cast<size_t>(zero - data) : limit;
+        *out++ = static_cast<uint8_t>(run + 1);
+        if (run > 0) std::memcpy(out, data, run);
+        out += run;
+        data += run;
+        if (zero) {
+            ++data; // the zero is implied by the block length
+            continue;
+        }
+        // the end of the data, a full block that ends there needs no empty block after it
+        if (run < 254 || data == end) break;
+    }
+    return static_cast<size_t>(out - start);
+}
+
+bool CobsDecoder::feed(const uint8_t* data, size_t length) {
+    while (length > 0 && !_failed) {
+        if (_remaining == 0) {
+            const auto code = *data++;
+            --length;
+            if (code == 0) {
+                _failed = true;
+                break;
+            }
+            if (_zero_pending) {
+                if (_size == _capacity) {
+                    _failed = true;
+                    break;
+                }
+                _out[_size++] = 0;
+            }
+            _remaining = static_cast<uint8_t>(code - 1);
+            _zero_pending = code != 0xFF;
+            continue;
+        }
+        const auto n = length < _remaining ? length : _remaining;
+        if (n > _capacity - _size) {
+            _failed = true;
+            break;
+        }
+        std::memmove(_out + _size, data, n);
+        _size += n;
+        data += n;
+        length -= n;
+        _remaining = static_cast<uint8_t>(_remaining - n);
+    }
+    return !_failed;
+}
+
+size_t cobs_decode(const uint8_t* data, size_t length, uint8_t* out, size_t capacity) {
+    auto decoder = CobsDecoder(out, capacity);
+    decoder.feed(data, length);
+    return decoder.finish() ? decoder.size() : 0;
+}
+
+} // namespace spn::core::utils
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace spn::core::utils {
+
+// Consistent Overhead Byte Stuffing: encodes data such that it holds no zero bytes, which leaves the zero byte free to
+// delimit frames. The overhead is one byte per started block of 254 bytes.
+
+/// Returns the largest encoded size of `length` bytes (excluding the frame delimiter)
+constexpr size_t cobs_max_encoded_size(size_t length) { return length + length / 254 + 1; }
+
+/// Encode `length` bytes of `data` into `out`, which must hold `cobs_max_encoded_size(length)` bytes. Returns the
+/// encoded size. No frame delimiter is appended.
+size_t cobs_encode(const uint8_t* data, size_t length, uint8_t* out);
+
+/// Decoder that can be fed an encoded frame (excluding the delimiter) in pieces, such as the two spans of a ring
+/// buffer. Decoded bytes are written to a caller provided buffer; `out` may equal the start of the encoded data, as
+/// the output never overtakes the input.
+class CobsDecoder {
+public:
+    CobsDecoder(uint8_t* out, size_t capacity) : _out(out), _capacity(capacity) {}
+
+    /// Decode the next `length` encoded bytes. Returns false once the data is invalid or exceeds the capacity.
+    bool feed(const uint8_t* data, size_t length);
+
+    /// Returns true when all fed data formed a valid, complete frame
+    bool finish() const { return !_failed && _remaining == 0; }
+
+    /// Amount of decoded bytes
+    size_t size() const { return _size; }
+
+    void reset() {
+        _size = 0;
+        _remaining = 0;
+        _zero_pending = false;
+        _failed = false;
+    }
+
+private:
+    uint8_t* _out;
+    size_t _capacity;
+    size_t _size = 0;
+    uint8_t _remaining = 0; // bytes left in the current block
+    bool _zero_pending = false; // the current block ends in a zero, unless it is the last block
+    bool _failed = false;
+};
+
+/// Decode `length` bytes of `data` into `out` (which may equal `data`) holding `capacity` bytes. Returns the decoded
+/// size, or 0 when the data isn't valid COBS or doesn't fit.
+size_t cobs_decode(const uint8_t* data, size_t length, uint8_t* out, size_t capacity);
+
+} // namespace spn::core::utils
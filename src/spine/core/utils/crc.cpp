@@ -0,0 +1,64 @@
+#include "spine/core/utils/crc.hpp"
+
+#include <array>
+
+namespace spn::core::utils {
+
+namespace {
+
+constexpr std::array<uint16_t, 256> make_crc16_table() {
+    std::array<uint16_t, 256> table{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        auto crc = static_cast<uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit)
+            crc = static_cast<uint16_t>(crc & 0x8000 ? (crc << 1) ^ 0x1021 : crc << 1);
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr size_t crc32_slices = SPINE_CRC32_SLICING ? 4 : 1;
+
+/// Table `k` holds the CRC of a byte followed by `k` zero bytes, such that 4 bytes can be looked up at once
+constexpr std::array<std::array<uint32_t, 256>, crc32_slices> make_crc32_tables() {
+    std::array<std::array<uint32_t, 256>, crc32_slices> tables{};
+    for (uint32_t i = 0; i < 256; ++i) {
+        auto crc = i;
+        for (int bit = 0; bit < 8; ++bit)
+            crc = crc & 1 ? (crc >> 1) ^ 0xEDB88320u : crc >> 1;
+        tables[0][i] = crc;
+    }
+    for (size_t k = 1; k < crc32_slices; ++k) {
+        for (size_t i = 0; i < 256; ++i)
+            tables[k][i] = (tables[k - 1][i] >> 8) ^ tables[0][tables[k - 1][i] & 0xFF];
+    }
+    return tables;
+}
+
+constexpr auto g_crc16_table = make_crc16_table();
+constexpr auto g_crc32_tables = make_crc32_tables();
+
+} // namespace
+
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc) {
+    for (size_t i = 0; i < length; ++i)
+        crc = static_cast<uint16_t>((crc << 8) ^ g_crc16_table[((crc >> 8) ^ data[i]) & 0xFF]);
+    return crc;
+}
+
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc) {
+    crc = ~crc;
+#if SPINE_CRC32_SLICING
+    const auto& t = g_crc32_tables;
+    for (; length >= 4; length -= 4, data += 4) {
+        // little endian load, compilers turn this into a single load where possible
+        crc ^= uint32_t{data[0]} | uint32_t{data[1]} << 8 | uint32_t{data[2]} << 16 | uint32_t{data[3]} << 24;
+        crc = t[3][crc & 0xFF] ^ t[2][(crc >> 8) & 0xFF] ^ t[1][(crc >> 16) & 0xFF] ^ t[0][crc >> 24];
+    }
+#endif
+    for (size_t i = 0; i < length; ++i)
+        crc = (crc >> 8) ^ g_crc32_tables[0][(crc ^ data[i]) & 0xFF];
+    return ~crc;
+}
+
+} // namespace spn::core::utils
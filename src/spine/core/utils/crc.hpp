@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Table driven checksums for framing binary data. Both functions can be continued over multiple chunks by passing the
+// result of the previous call as `crc`.
+//
+// CRC-32 processes 4 bytes per step with four tables (slicing-by-4, 4 KiB of tables) unless SPINE_CRC32_SLICING is
+// defined as 0, which selects a single 1 KiB table. The default is 0 on 8-bit AVR and 1 elsewhere.
+
+#ifndef SPINE_CRC32_SLICING
+#    if defined(__AVR__)
+#        define SPINE_CRC32_SLICING 0
+#    else
+#        define SPINE_CRC32_SLICING 1
+#    endif
+#endif
+
+namespace spn::core::utils {
+
+constexpr uint16_t crc16_init = 0xFFFF;
+
+/// CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF, not reflected), e.g. "123456789" yields 0x29B1
+uint16_t crc16(const uint8_t* data, size_t length, uint16_t crc = crc16_init);
+
+/// CRC-32 (ISO-HDLC, as in zlib and Ethernet), e.g. "123456789" yields 0xCBF43926
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0);
+
+} // namespace spn::core::utils
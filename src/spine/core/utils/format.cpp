@@ -0,0 +1,85 @@
+#include "spine/core/utils/format.hpp"
+
+#include <cmath>
+#include <cstdio>
+
+namespace spn::core::utils {
+
+namespace {
+constexpr uint32_t powers_of_ten[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000};
+constexpr uint8_t max_precision = 9;
+
+/// Writes `value` as exactly `digits` digits (zero padded)
+char* format_padded(char* first, char* last, uint32_t value, uint8_t digits) {
+    if (static_cast<size_t>(last - first) < digits) return nullptr;
+    for (auto i = digits; i > 0; --i) {
+        first[i - 1] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    return first + digits;
+}
+} // namespace
+
+char* format_float(char* first, char* last, float value, uint8_t precision) {
+    if (precision > max_precision) precision = max_precision;
+    if (std::isnan(value)) return format_string(first, last, "nan");
+    if (std::isinf(value)) return format_string(first, last, value < 0 ? "-inf" : "inf");
+
+    auto magnitude = std::fabs(value);
+    if (magnitude >= 9.2e18f) { // beyond uint64_t
+        char buffer[32];
+        const auto length =
+            std::snprintf(buffer, sizeof(buffer), "%.*e", static_cast<int>(precision), static_cast<double>(value));
+        return length > 0 ? format_string(first, last, {buffer, static_cast<size_t>(length)}) : nullptr;
+    }
+
+    // split first: the fraction of a float is exact, so only the decimals are rounded
+    auto integer = static_cast<uint64_t>(magnitude);
+    const auto scale = powers_of_ten[precision];
+    auto decimals = static_cast<uint32_t>((magnitude - static_cast<float>(integer)) * static_cast<float>(scale) + 0.5f);
+    if (decimals >= scale) { // rounding carried into the integer part
+        decimals -= scale;
+        ++integer;
+    }
+
+    if (value < 0 && (integer != 0 || decimals != 0)) {
+        if (first == last) return nullptr;
+        *first++ = '-';
+    }
+    first = format_integer(first, last, integer);
+    if (first == nullptr || precision == 0) return first;
+    if (first == last) return nullptr;
+    *first++ = '.';
+    return format_padded(first, last, decimals, precision);
+}
+
+char* format_duration(char* first, char* last, k_time_us value) {
+    const auto print = [&](auto t) { return format_unit(first, last, t); };
+    // use seconds up to 900 s before switching to minutes, and minutes up to a day
+    if (k_time_us(value).raw() < 1000) return print(k_time_us(value));
+    if (k_time_ms(value).raw() < 1000) return print(k_time_ms(value));
+    if (k_time_s(value).raw() < 900) return print(k_time_s(value));
+    if (k_time_m(value).raw() < 1440) return print(k_time_m(value));
+    if (k_time_h(value).raw() < 24) return print(k_time_h(value));
+    return print(k_time_d(value));
+}
+
+namespace detail {
+char* format_dimension(char* first, char* last, const int (&exponents)[7]) {
+    constexpr std::string_view base_units[7] = {"m", "kg", "s", "A", "K", "mol", "cd"};
+    bool is_first = true;
+    for (size_t i = 0; i < 7; ++i) {
+        if (exponents[i] == 0) continue;
+        if (!is_first && (first = format_string(first, last, "*")) == nullptr) return nullptr;
+        if ((first = format_string(first, last, base_units[i])) == nullptr) return nullptr;
+        if (exponents[i] != 1) {
+            if ((first = format_string(first, last, "^")) == nullptr) return nullptr;
+            if ((first = format_integer(first, last, exponents[i])) == nullptr) return nullptr;
+        }
+        is_first = false;
+    }
+    return first;
+}
+} // namespace detail
+
+} // namespace spn::core::utils
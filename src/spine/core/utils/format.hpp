@@ -0,0 +1,258 @@
+#pragma once
+
+#include "spine/core/fixed.hpp"
+#include "spine/structure/units/primitives/symbols.hpp"
+#include "spine/structure/units/si.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace spn::core::utils {
+
+// Formatting without the heap. The `format_*` functions write a single value into [first, last) and return one past
+// the last written character, or nullptr when the value didn't fit (the range may then hold a partial value). On top of
+// those, `format_to(sink, args...)` appends any amount of values to a sink:
+// - a `BufferWriter` over a caller provided buffer
+// - anything with `append(std::string_view)`, such as `StaticString`
+// - anything with `write(const char*, size_t)`, such as `io::Stream`
+// - anything with `outgoing(const char*, size_t)`, such as `io::Transaction`
+
+template<typename T>
+/// Writes integer `value` in decimal
+char* format_integer(char* first, char* last, T value) {
+    static_assert(std::is_integral_v<T>, "format_integer requires an integer type");
+    using Unsigned = std::make_unsigned_t<T>;
+    auto magnitude = static_cast<Unsigned>(value);
+    if constexpr (std::is_signed_v<T>) {
+        if (value < 0) {
+            if (first == last) return nullptr;
+            *first++ = '-';
+            magnitude = static_cast<Unsigned>(Unsigned(0) - magnitude);
+        }
+    }
+
+    char digits[20]; // enough for 2^64
+    size_t count = 0;
+    do {
+        digits[count++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+    if (static_cast<size_t>(last - first) < count) return nullptr;
+    while (count > 0)
+        *first++ = digits[--count];
+    return first;
+}
+
+/// Writes `value` with exactly `precision` (at most 9) decimals, rounding half away from zero. Values beyond 2^63 are
+/// written in scientific notation.
+char* format_float(char* first, char* last, float value, uint8_t precision = 2);
+
+/// Writes `value` with the largest time unit that keeps it readable (us, ms, s up to 900 s, m, h or d), e.g. "15m"
+char* format_duration(char* first, char* last, k_time_us value);
+
+/// Writes `view`
+inline char* format_string(char* first, char* last, const std::string_view view) {
+    if (static_cast<size_t>(last - first) < view.size()) return nullptr;
+    std::memcpy(first, view.data(), view.size());
+    return first + view.size();
+}
+
+namespace detail {
+template<typename T>
+struct is_unit : std::false_type {};
+template<typename UT, typename MT, typename VT>
+struct is_unit<spnu::Unit<UT, MT, VT>> : std::true_type {};
+
+template<typename UT>
+struct is_derived_tag : std::false_type {};
+template<typename D>
+struct is_derived_tag<spnu::TagDerived<D>> : std::true_type {};
+
+/// Writes the SI base units of dimension `exponents` (length, mass, time, ...), e.g. "m*s^-1"
+char* format_dimension(char* first, char* last, const int (&exponents)[7]);
+
+template<int L, int M, int T, int I, int Th, int N, int J>
+char* format_dimension(char* first, char* last, spnu::Dimension<L, M, T, I, Th, N, J>) {
+    constexpr int exponents[7] = {L, M, T, I, Th, N, J};
+    return format_dimension(first, last, exponents);
+}
+
+template<typename Value>
+char* format_value(char* first, char* last, const Value& value, uint8_t precision) {
+    if constexpr (std::is_integral_v<Value>) return format_integer(first, last, value);
+    else return format_float(first, last, static_cast<float>(value), precision);
+}
+} // namespace detail
+
+template<typename UT, typename MT, typename VT>
+/// Writes a unit as its value followed by its symbol, e.g. "12.50mV" or "1500ms". Real values are written with
+/// `precision` decimals.
+char* format_unit(char* first, char* last, const spnu::Unit<UT, MT, VT>& unit, uint8_t precision = 2) {
+    using Ratio = typename MT::Ratio;
+    first = detail::format_value(first, last, unit.raw(), precision);
+    if (first == nullptr) return nullptr;
+
+    if constexpr (detail::is_derived_tag<UT>::value) {
+        static_assert(Ratio::num == 1 && Ratio::den == 1, "derived units only exist in their base magnitude");
+        return detail::format_dimension(first, last, typename spnu::Quantity<UT>::Dimension{});
+    } else if constexpr ((std::is_same_v<UT, spnu::TagTime> || std::is_same_v<UT, spnu::TagKernelTime>)
+                         && !spnu::time_symbol<Ratio>().empty()) {
+        return format_string(first, last, spnu::time_symbol<Ratio>());
+    } else {
+        constexpr auto prefix = spnu::si_prefix<Ratio>();
+        static_assert(!prefix.empty() || (Ratio::num == 1 && Ratio::den == 1), "no symbol for this magnitude");
+        first = format_string(first, last, prefix);
+        return first ? format_string(first, last, spnu::symbol_v<UT>) : nullptr;
+    }
+}
+
+template<typename T>
+/// A real value (float, Fixed or real Unit) that is to be written with a set amount of decimals
+struct WithPrecision {
+    const T& value;
+    uint8_t precision;
+};
+
+template<typename T>
+/// Write `value` with `precision` decimals when passed to `format_to`
+WithPrecision<T> with_precision(const T& value, uint8_t precision) {
+    return {value, precision};
+}
+
+/// A time that is to be written in its most readable unit (see `format_duration`) when passed to `format_to`
+struct Duration {
+    k_time_us value;
+};
+
+template<typename TimeType>
+Duration readable(const TimeType& t) {
+    return {k_time_us(t)};
+}
+
+/// Sink over a caller provided buffer. Keeps the buffer null terminated and drops what doesn't fit.
+class BufferWriter {
+public:
+    BufferWriter(char* buffer, size_t size)
+        : _buffer(size > 0 ? buffer : nullptr), _capacity(size > 0 ? size - 1 : 0) {
+        if (_buffer) _buffer[0] = '\0';
+    }
+    template<size_t N>
+    explicit BufferWriter(char (&buffer)[N]) : BufferWriter(buffer, N) {}
+
+    /// Append up to `length` bytes of `data`. Returns the amount of bytes written.
+    size_t write(const char* data, size_t length) {
+        const auto n = length <= _capacity - _size ? length : _capacity - _size;
+        _truncated |= n < length;
+        if (n == 0) return 0;
+        std::memcpy(_buffer + _size, data, n);
+        _size += n;
+        _buffer[_size] = '\0';
+        return n;
+    }
+
+    std::string_view view() const { return {_buffer, _size}; }
+    const char* c_str() const { return _buffer ? _buffer : ""; }
+    size_t size() const { return _size; }
+
+    /// Returns true if anything was dropped because the buffer was full
+    bool truncated() const { return _truncated; }
+
+    void clear() {
+        _size = 0;
+        _truncated = false;
+        if (_buffer) _buffer[0] = '\0';
+    }
+
+private:
+    char* _buffer;
+    size_t _capacity; // excluding the null character
+    size_t _size = 0;
+    bool _truncated = false;
+};
+
+/// Sink that only counts, e.g. to size a buffer up front
+class LengthCounter {
+public:
+    size_t write(const char*, size_t length) {
+        _size += length;
+        return length;
+    }
+    size_t size() const { return _size; }
+
+private:
+    size_t _size = 0;
+};
+
+namespace detail {
+template<typename Sink, typename = void>
+struct has_append : std::false_type {};
+template<typename Sink>
+struct has_append<Sink, std::void_t<decltype(std::declval<Sink&>().append(std::string_view()))>> : std::true_type {};
+
+template<typename Sink, typename = void>
+struct has_outgoing : std::false_type {};
+template<typename Sink>
+struct has_outgoing<Sink, std::void_t<decltype(std::declval<Sink&>().outgoing(std::declval<const char*>(), size_t()))>>
+    : std::true_type {};
+
+template<typename Sink>
+/// Hand `view` to the sink and return the amount of bytes it took
+size_t put(Sink& sink, const std::string_view view) {
+    if constexpr (has_append<Sink>::value) {
+        const auto before = sink.size();
+        sink.append(view);
+        return sink.size() - before;
+    } else if constexpr (has_outgoing<Sink>::value) {
+        return sink.outgoing(view.data(), view.size());
+    } else {
+        return sink.write(view.data(), view.size());
+    }
+}
+
+constexpr uint8_t default_precision = 2;
+
+template<typename T>
+/// Write a single argument of `format_to` into [first, last)
+char* format_argument(char* first, char* last, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) return format_string(first, last, value ? "true" : "false");
+    else if constexpr (std::is_same_v<T, char>) return first != last ? (*first = value, first + 1) : nullptr;
+    else if constexpr (std::is_enum_v<T>)
+        return format_integer(first, last, static_cast<std::underlying_type_t<T>>(value));
+    else if constexpr (std::is_integral_v<T>) return format_integer(first, last, value);
+    else if constexpr (std::is_floating_point_v<T> || is_fixed_v<T>)
+        return format_float(first, last, static_cast<float>(value), default_precision);
+    else if constexpr (is_unit<T>::value) return format_unit(first, last, value, default_precision);
+    else if constexpr (std::is_same_v<T, Duration>) return format_duration(first, last, value.value);
+    else return format_string(first, last, std::string_view(value));
+}
+
+template<typename T>
+char* format_argument(char* first, char* last, const WithPrecision<T>& value) {
+    if constexpr (is_unit<T>::value) return format_unit(first, last, value.value, value.precision);
+    else return format_float(first, last, static_cast<float>(value.value), value.precision);
+}
+
+template<typename Sink, typename T>
+size_t format_one(Sink& sink, const T& value) {
+    if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+        return put(sink, std::string_view(value));
+    } else {
+        char chunk[48]; // fits any number, including a unit symbol
+        const auto end = format_argument(chunk, chunk + sizeof(chunk), value);
+        return end ? put(sink, {chunk, static_cast<size_t>(end - chunk)}) : 0;
+    }
+}
+} // namespace detail
+
+template<typename Sink, typename... Args>
+/// Append all `args` to `sink`: strings, chars, integers, bools, floats (2 decimals, see `with_precision`), Fixed,
+/// any Unit and `readable(time)`. Returns the amount of bytes the sink took.
+size_t format_to(Sink& sink, const Args&... args) {
+    return (size_t{0} + ... + detail::format_one(sink, args));
+}
+
+} // namespace spn::core::utils
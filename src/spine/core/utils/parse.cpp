@@ -0,0 +1,118 @@
+#include "spine/core/utils/parse.hpp"
+
+#include <cmath>
+
+namespace spn::core::utils {
+
+namespace {
+
+constexpr int max_significant_digits = 9; // fits an uint32_t
+constexpr int max_exponent = 39; // beyond FLT_MAX
+constexpr int min_exponent = -55; // below the smallest denormal, even for 9 significant digits
+
+/// Powers of ten that are exact in a float
+constexpr float exact_powers_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f};
+constexpr int largest_exact_power = 10;
+
+bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+} // namespace
+
+ScanResult scan_float(const char* first, const char* last, float& value) {
+    auto it = first;
+    bool negative = false;
+    if (it != last && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+
+    uint32_t mantissa = 0;
+    int significant_digits = 0;
+    int exponent = 0;
+    bool has_digits = false;
+    const auto take_digit = [&](char c, bool is_fraction) {
+        has_digits = true;
+        if (significant_digits < max_significant_digits) {
+            mantissa = mantissa * 10 + static_cast<uint32_t>(c - '0');
+            if (mantissa != 0) ++significant_digits; // leading zeros aren't significant
+            if (is_fraction) --exponent;
+        } else if (!is_fraction) {
+            ++exponent; // dropped digit before the decimal point
+        }
+    };
+
+    for (; it != last && is_digit(*it); ++it)
+        take_digit(*it, false);
+    if (it != last && *it == '.') {
+        const auto fraction = it + 1;
+        auto fit = fraction;
+        for (; fit != last && is_digit(*fit); ++fit)
+            take_digit(*fit, true);
+        if (has_digits) it = fit; // a lone '.' is not part of the number
+    }
+    if (!has_digits) return {first, first == last ? ParseError::Empty : ParseError::InvalidCharacter};
+
+    // the exponent is only consumed when it has digits, like std::from_chars
+    if (it != last && (*it == 'e' || *it == 'E')) {
+        auto eit = it + 1;
+        bool negative_exponent = false;
+        if (eit != last && (*eit == '-' || *eit == '+')) {
+            negative_exponent = *eit == '-';
+            ++eit;
+        }
+        if (eit != last && is_digit(*eit)) {
+            int explicit_exponent = 0;
+            for (; eit != last && is_digit(*eit); ++eit) {
+                if (explicit_exponent < 10000) explicit_exponent = explicit_exponent * 10 + (*eit - '0');
+            }
+            exponent += negative_exponent ? -explicit_exponent : explicit_exponent;
+            it = eit;
+        }
+    }
+
+    if (mantissa == 0) {
+        value = negative ? -0.0f : 0.0f;
+        return {it, ParseError::None};
+    }
+    if (exponent + significant_digits > max_exponent || exponent < min_exponent) return {it, ParseError::OutOfRange};
+
+    auto result = static_cast<float>(mantissa);
+    for (; exponent > largest_exact_power; exponent -= largest_exact_power)
+        result *= exact_powers_of_ten[largest_exact_power];
+    for (; exponent < -largest_exact_power; exponent += largest_exact_power)
+        result /= exact_powers_of_ten[largest_exact_power];
+    result = exponent >= 0 ? result * exact_powers_of_ten[exponent] : result / exact_powers_of_ten[-exponent];
+
+    if (std::isinf(result) || result == 0.0f) return {it, ParseError::OutOfRange};
+    value = negative ? -result : result;
+    return {it, ParseError::None};
+}
+
+ParseResult<float> parse_float(const std::string_view sv) {
+    float value = {};
+    const auto [ptr, error] = scan_float(sv.data(), sv.data() + sv.size(), value);
+    if (error != ParseError::None) return ParseResult<float>::failed(error);
+    if (ptr != sv.data() + sv.size()) return ParseResult<float>::failed(ParseError::InvalidCharacter);
+    return value;
+}
+
+namespace detail {
+int64_t microseconds_per_unit(const std::string_view unit) {
+    if (unit.size() == 1) {
+        switch (unit[0]) {
+            case 's': return 1000000LL;
+            case 'm': return 60LL * 1000000LL;
+            case 'h': return 3600LL * 1000000LL;
+            case 'd': return 86400LL * 1000000LL;
+            default: return 0;
+        }
+    }
+    if (unit.size() == 2 && unit[1] == 's') {
+        if (unit[0] == 'u') return 1;
+        if (unit[0] == 'm') return 1000;
+    }
+    return 0;
+}
+} // namespace detail
+
+} // namespace spn::core::utils
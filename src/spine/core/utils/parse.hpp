@@ -0,0 +1,122 @@
+#pragma once
+
+#include "spine/structure/result.hpp"
+#include "spine/structure/units/si.hpp"
+
+#include <cstdint>
+#include <limits>
+#include <string_view>
+#include <type_traits>
+
+namespace spn::core::utils {
+
+// Single pass parsers that never allocate and never read beyond the given range, such that they can be used on a
+// string_view into a line buffer. The `scan_*` functions work like std::from_chars: they parse the longest valid
+// prefix of [first, last) and return where parsing stopped. The `parse_*` functions require the whole string_view to
+// be a single value and return a Result.
+//
+// Accepted syntax: an optional sign followed by decimal digits. Floats may contain a fraction and an exponent
+// (`-12.5e-3`). No whitespace, hexadecimal, inf or nan.
+
+enum class ParseError : uint8_t {
+    None,
+    Empty, // nothing to parse
+    InvalidCharacter, // no number at the start, or trailing characters
+    OutOfRange, // the value doesn't fit the requested type
+    UnknownUnit, // a duration with a missing or unsupported unit
+};
+
+struct ScanResult {
+    const char* ptr; // first character that was not parsed
+    ParseError error;
+};
+
+template<typename T>
+using ParseResult = spn::structure::Result<T, ParseError>;
+
+template<typename T>
+/// Scan an integer from the start of [first, last) into `value`. `value` is left untouched on failure.
+constexpr ScanResult scan_integer(const char* first, const char* last, T& value) {
+    static_assert(std::is_integral_v<T> && !std::is_same_v<T, bool>, "scan_integer requires an integer type");
+    using Unsigned = std::make_unsigned_t<T>;
+
+    auto it = first;
+    bool negative = false;
+    if (it != last && (*it == '-' || *it == '+')) {
+        negative = *it == '-';
+        ++it;
+    }
+    if (negative && std::is_unsigned_v<T>) return {first, ParseError::InvalidCharacter};
+
+    // accumulate the magnitude, the limit of a negative signed value is one larger than the positive limit
+    const auto limit = static_cast<Unsigned>(std::numeric_limits<T>::max()) + (negative ? 1u : 0u);
+    const auto digits = it;
+    Unsigned magnitude = 0;
+    bool overflow = false;
+    for (; it != last && *it >= '0' && *it <= '9'; ++it) {
+        const auto digit = static_cast<Unsigned>(*it - '0');
+        if (magnitude > (limit - digit) / 10) overflow = true;
+        else magnitude = static_cast<Unsigned>(magnitude * 10 + digit);
+    }
+    if (it == digits) return {first, first == last ? ParseError::Empty : ParseError::InvalidCharacter};
+    if (overflow) return {it, ParseError::OutOfRange};
+
+    value = negative ? static_cast<T>(Unsigned(0) - magnitude) : static_cast<T>(magnitude);
+    return {it, ParseError::None};
+}
+
+/// Scan a float from the start of [first, last) into `value`. At most 9 significant digits are taken into account;
+/// the result is within a few ulp of strtof. `value` is left untouched on failure.
+ScanResult scan_float(const char* first, const char* last, float& value);
+
+template<typename T>
+/// Parse `sv` as a single integer
+ParseResult<T> parse_integer(const std::string_view sv) {
+    T value = {};
+    const auto [ptr, error] = scan_integer(sv.data(), sv.data() + sv.size(), value);
+    if (error != ParseError::None) return ParseResult<T>::failed(error);
+    if (ptr != sv.data() + sv.size()) return ParseResult<T>::failed(ParseError::InvalidCharacter);
+    return value;
+}
+
+/// Parse `sv` as a single float
+ParseResult<float> parse_float(const std::string_view sv);
+
+namespace detail {
+/// Returns the length of a duration unit (us, ms, s, m, h or d) in microseconds, or 0 when unknown
+int64_t microseconds_per_unit(const std::string_view unit);
+} // namespace detail
+
+template<typename TimeType = k_time_ms>
+/// Parse a duration such as "10us", "500ms", "2h" or "1d" and convert it to `TimeType` (rounding to the nearest value
+/// when the unit is finer than `TimeType`)
+ParseResult<TimeType> parse_duration(const std::string_view sv) {
+    using Raw = typename TimeType::ValueType;
+    using Ratio = typename TimeType::Magnitude::Ratio; // in seconds
+    static_assert(Ratio::num * 1000000 % Ratio::den == 0, "parse_duration requires a whole amount of microseconds");
+    constexpr int64_t target_us = Ratio::num * 1000000 / Ratio::den;
+    constexpr auto max = static_cast<int64_t>(std::numeric_limits<Raw>::max());
+
+    const auto last = sv.data() + sv.size();
+    int64_t value = 0;
+    const auto [ptr, error] = scan_integer(sv.data(), last, value);
+    if (error != ParseError::None) return ParseResult<TimeType>::failed(error);
+
+    const auto unit_us = detail::microseconds_per_unit({ptr, static_cast<size_t>(last - ptr)});
+    if (unit_us == 0) return ParseResult<TimeType>::failed(ParseError::UnknownUnit);
+
+    // larger time units are whole multiples of smaller ones, so one of both divides the other
+    const auto in_range = [](int64_t v, int64_t limit) { return v <= limit && v >= -limit; };
+    if (unit_us >= target_us) {
+        const auto factor = unit_us / target_us;
+        if (!in_range(value, max / factor)) return ParseResult<TimeType>::failed(ParseError::OutOfRange);
+        return TimeType(static_cast<Raw>(value * factor));
+    }
+    const auto divisor = target_us / unit_us;
+    if (!in_range(value, INT64_MAX - divisor)) return ParseResult<TimeType>::failed(ParseError::OutOfRange);
+    const auto rounded = (value < 0 ? value - divisor / 2 : value + divisor / 2) / divisor;
+    if (!in_range(rounded, max)) return ParseResult<TimeType>::failed(ParseError::OutOfRange);
+    return TimeType(static_cast<Raw>(rounded));
+}
+
+} // namespace spn::core::utils
@@ -1,27 +1,81 @@
 #include "spine/core/utils/string.hpp"
 
-// #include <charconv>
+#include "spine/core/utils/parse.hpp"
+
+#include <cstring>
 #include <string>
 #include <string_view>
 
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#endif
+
 namespace spn::core::utils {
 
+namespace {
+
+/// Scalar scan through the bitmap
+size_t find_in_bitmap(const char* data, size_t begin, size_t size, const CharSet& set) {
+    for (size_t i = begin; i < size; ++i) {
+        if (set.contains(data[i])) return i;
+    }
+    return std::string::npos;
+}
+
+#if defined(__SSE2__) || defined(__ARM_NEON)
+/// Compares 16 chars at a time against up to four members of `set` (unused lanes repeat the first member)
+size_t find_vectorized(const char* data, size_t size, const CharSet& set) {
+    char m[CharSet::max_vector_members];
+    for (size_t k = 0; k < CharSet::max_vector_members; ++k)
+        m[k] = set.members()[k < set.size() ? k : 0];
+
+    size_t i = 0;
+#    if defined(__SSE2__)
+    const auto m0 = _mm_set1_epi8(m[0]), m1 = _mm_set1_epi8(m[1]);
+    const auto m2 = _mm_set1_epi8(m[2]), m3 = _mm_set1_epi8(m[3]);
+    for (; i + 16 <= size; i += 16) {
+        const auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+        const auto eq = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, m0), _mm_cmpeq_epi8(v, m1)),
+                                     _mm_or_si128(_mm_cmpeq_epi8(v, m2), _mm_cmpeq_epi8(v, m3)));
+        const auto mask = static_cast<unsigned>(_mm_movemask_epi8(eq));
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctz(mask));
+    }
+#    else
+    const auto m0 = vdupq_n_u8(static_cast<uint8_t>(m[0])), m1 = vdupq_n_u8(static_cast<uint8_t>(m[1]));
+    const auto m2 = vdupq_n_u8(static_cast<uint8_t>(m[2])), m3 = vdupq_n_u8(static_cast<uint8_t>(m[3]));
+    for (; i + 16 <= size; i += 16) {
+        const auto v = vld1q_u8(reinterpret_cast<const uint8_t*>(data + i));
+        const auto eq =
+            vorrq_u8(vorrq_u8(vceqq_u8(v, m0), vceqq_u8(v, m1)), vorrq_u8(vceqq_u8(v, m2), vceqq_u8(v, m3)));
+        // narrow every byte of the compare to a nibble, giving a 64 bit mask with 4 bits per char
+        const auto mask = vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(eq), 4)), 0);
+        if (mask != 0) return i + static_cast<size_t>(__builtin_ctzll(mask)) / 4;
+    }
+#    endif
+    return find_in_bitmap(data, i, size, set);
+}
+#endif
+
+} // namespace
+
 /// Returns a string_view with the beginning of the string `strv` stripped of any char in `delimiters`
 std::string_view lstrip(const std::string_view& strv, const std::string_view& delimiters) {
-    auto it = strv.begin();
-    while (delimiters.find(*it) != std::string::npos)
-        ++it;
-    const auto len = it - strv.begin();
-    return {strv.data() + len, strv.size() - len};
+    return lstrip(strv, CharSet(delimiters));
+}
+std::string_view lstrip(const std::string_view& strv, const CharSet& delimiters) {
+    const auto first = find_first_not_of(strv, delimiters);
+    return first == std::string::npos ? strv.substr(strv.size()) : strv.substr(first);
 }
 
 /// Returns a string_view with the end of the string `strv` stripped of any char in `delimiters`
 std::string_view rstrip(const std::string_view& strv, const std::string_view& delimiters) {
-    auto it = strv.rbegin();
-    while (delimiters.find(*it) != std::string::npos)
-        ++it;
-    const auto len = it - strv.rbegin();
-    return {strv.data() + len, strv.size() - len};
+    return rstrip(strv, CharSet(delimiters));
+}
+std::string_view rstrip(const std::string_view& strv, const CharSet& delimiters) {
+    const auto last = find_last_not_of(strv, delimiters);
+    return strv.substr(0, last == std::string::npos ? 0 : last + 1);
 }
 
 /// Returns true if string `strv` starts with `needle
@@ -31,40 +85,69 @@ bool starts_with(const std::string_view& strv, const std::string_view& needle) {
 
 /// Returns true if string `strv` ends with `needle
 bool ends_with(const std::string_view& strv, const std::string_view& needle) {
-    return strv.compare(strv.size() - needle.size(), strv.size(), needle) == 0;
+    return strv.size() >= needle.size() && strv.compare(strv.size() - needle.size(), needle.size(), needle) == 0;
 }
 
 /// Find the first occurence of any char in `delimiters` in the string `strv` or return std::string::npos when nothing
 /// was found
+std::size_t find_first_of(const std::string_view& strv, const CharSet& delimiters) {
+    if (strv.empty() || delimiters.empty()) return std::string::npos;
+    if (delimiters.size() == 1) {
+        const auto found = std::memchr(strv.data(), delimiters.members()[0], strv.size());
+        return found ? static_cast<size_t>(static_cast<const char*>(found) - strv.data()) : std::string::npos;
+    }
+#if defined(__SSE2__) || defined(__ARM_NEON)
+    if (delimiters.size() <= CharSet::max_vector_members) return find_vectorized(strv.data(), strv.size(), delimiters);
+#endif
+    return find_in_bitmap(strv.data(), 0, strv.size(), delimiters);
+}
 std::size_t find_first_of(const std::string_view& strv, const std::string_view& delimiters) {
+    return find_first_of(strv, CharSet(delimiters));
+}
+
+/// Find the first char in the string `strv` that is not in `delimiters` or return std::string::npos
+std::size_t find_first_not_of(const std::string_view& strv, const CharSet& delimiters) {
     for (std::size_t i = 0; i < strv.size(); ++i) {
-        if (delimiters.find(strv[i]) != std::string::npos) {
-            return i;
-        }
+        if (!delimiters.contains(strv[i])) return i;
     }
     return std::string::npos;
 }
 
-/// Returns a float read from a string_view, or 0 when no float could be found
-// float to_float(const std::string_view& sv) {
-//     float result;
-//
-//     auto [ptr, ec] = std::from_chars(sv.data(), sv.data() + sv.size(), result);
-//     if (ec == std::errc()) {
-//         return result;
-//     }
-//     return 0.0f;
-// }
-
-float to_float(const std::string_view& sv) {
-    char* end;
-    float result = std::strtof(sv.data(), &end);
-
-    if (end == sv.data() || *end != '\0') {
-        return 0.0f; // Handle conversion error
+/// Find the last char in the string `strv` that is not in `delimiters` or return std::string::npos
+std::size_t find_last_not_of(const std::string_view& strv, const CharSet& delimiters) {
+    for (std::size_t i = strv.size(); i > 0; --i) {
+        if (!delimiters.contains(strv[i - 1])) return i - 1;
     }
+    return std::string::npos;
+}
+
+/// Returns a float read from a string_view, or 0 when no float could be found
+float to_float(const std::string_view& sv) { return parse_float(sv).value_or(0.0f); }
 
-    return result;
+void Split::Iterator::advance() {
+    if (!_has_next) {
+        _done = true;
+        return;
+    }
+    const auto end = _split->_strv.data() + _split->_strv.size();
+    auto rest = std::string_view(_next, static_cast<size_t>(end - _next));
+    if (_split->_skip_empty) {
+        rest = lstrip(rest, _split->_delimiters);
+        if (rest.empty()) {
+            _has_next = false;
+            _done = true;
+            return;
+        }
+    }
+    const auto pos = find_first_of(rest, _split->_delimiters);
+    _done = false;
+    if (pos == std::string::npos) {
+        _part = rest;
+        _has_next = false;
+    } else {
+        _part = rest.substr(0, pos);
+        _next = rest.data() + pos + 1;
+    }
 }
 
 } // namespace spn::core::utils
@@ -1,14 +1,69 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <string_view>
 
 namespace spn::core::utils {
 
+/// Set of characters as a 256 bit bitmap, such that a membership test is a single lookup instead of a search through
+/// all delimiters. Build it once and reuse it for every scan over a string.
+class CharSet {
+public:
+    /// Amount of members that are kept to scan for with SIMD compares, larger sets are scanned through the bitmap
+    static constexpr size_t max_vector_members = 4;
+
+    constexpr CharSet() = default;
+    explicit constexpr CharSet(const std::string_view chars) {
+        for (const auto c : chars)
+            insert(c);
+    }
+
+    constexpr void insert(const char c) {
+        if (contains(c)) return;
+        if (_size < max_vector_members) _members[_size] = c;
+        const auto u = static_cast<uint8_t>(c);
+        _bits[u >> 5] |= uint32_t{1} << (u & 31u);
+        ++_size;
+    }
+
+    constexpr bool contains(const char c) const {
+        const auto u = static_cast<uint8_t>(c);
+        return (_bits[u >> 5] >> (u & 31u)) & 1u;
+    }
+
+    /// Returns the amount of distinct characters in the set
+    constexpr size_t size() const { return _size; }
+    constexpr bool empty() const { return _size == 0; }
+
+    /// Returns the first (up to `max_vector_members`) distinct members in order of insertion
+    constexpr const char* members() const { return _members; }
+
+private:
+    uint32_t _bits[8] = {};
+    char _members[max_vector_members] = {};
+    uint16_t _size = 0;
+};
+
+/// The delimiters `lstrip`, `rstrip` and `tokenize` default to
+inline constexpr std::string_view whitespace = " \f\n\r\t\v";
+
 /// Returns a string_view with the beginning of the string `strv` stripped of any char in `delimiters`
-std::string_view lstrip(const std::string_view& strv, const std::string_view& delimiters = " \f\n\r\t\v");
+std::string_view lstrip(const std::string_view& strv, const std::string_view& delimiters = whitespace);
+std::string_view lstrip(const std::string_view& strv, const CharSet& delimiters);
 
 /// Returns a string_view with the end of the string `strv` stripped of any char in `delimiters`
-std::string_view rstrip(const std::string_view& strv, const std::string_view& delimiters = " \f\n\r\t\v");
+std::string_view rstrip(const std::string_view& strv, const std::string_view& delimiters = whitespace);
+std::string_view rstrip(const std::string_view& strv, const CharSet& delimiters);
+
+/// Returns the total size of `count` segments, such as those of a scatter-gather write
+constexpr std::size_t total_size(const std::string_view* segments, std::size_t count) {
+    std::size_t size = 0;
+    for (std::size_t i = 0; i < count; ++i)
+        size += segments[i].size();
+    return size;
+}
 
 /// Returns true if string `strv` starts with `needle
 bool starts_with(const std::string_view& strv, const std::string_view& needle);
@@ -17,12 +72,88 @@ bool starts_with(const std::string_view& strv, const std::string_view& needle);
 bool ends_with(const std::string_view& strv, const std::string_view& needle);
 
 /// Find the first occurence of any char in `delimiters` in the string `strv` or return std::string::npos when nothing
-/// was found
+/// was found. A single delimiter is searched for with memchr, up to `CharSet::max_vector_members` with SSE2/NEON
+/// compares of 16 chars at a time where available, and larger sets through the bitmap.
+std::size_t find_first_of(const std::string_view& strv, const CharSet& delimiters);
 std::size_t find_first_of(const std::string_view& strv, const std::string_view& delimiters);
 
-/// Returns a float read from a string_view, or 0 when no float could be found
-// float to_float(const std::string_view& sv) ;
+/// Find the first char in the string `strv` that is not in `delimiters` or return std::string::npos
+std::size_t find_first_not_of(const std::string_view& strv, const CharSet& delimiters);
 
+/// Find the last char in the string `strv` that is not in `delimiters` or return std::string::npos
+std::size_t find_last_not_of(const std::string_view& strv, const CharSet& delimiters);
+
+/// Returns a float read from a string_view, or 0 when no float could be found (see `parse_float` in parse.hpp to tell
+/// both apart)
 float to_float(const std::string_view& sv);
 
+/// Range over the parts of a string_view separated by a set of delimiters, see `split` and `tokenize`. The parts are
+/// views into the original string; nothing is copied or allocated. Iterators refer to the range, so keep it alive while
+/// iterating (a range-based for loop does).
+class Split {
+public:
+    class Iterator {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::string_view;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const std::string_view*;
+        using reference = const std::string_view&;
+
+        Iterator() = default;
+        explicit Iterator(const Split* split) : _split(split), _next(split->_strv.data()), _has_next(true) {
+            advance();
+        }
+
+        reference operator*() const { return _part; }
+        pointer operator->() const { return &_part; }
+        Iterator& operator++() {
+            advance();
+            return *this;
+        }
+        Iterator operator++(int) {
+            auto previous = *this;
+            advance();
+            return previous;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return _done == other._done && (_done || _part.data() == other._part.data());
+        }
+        bool operator!=(const Iterator& other) const { return !(*this == other); }
+
+    private:
+        void advance();
+
+        const Split* _split = nullptr;
+        const char* _next = nullptr; // start of the remaining string
+        bool _has_next = false; // false once the last part was reached
+        std::string_view _part;
+        bool _done = true;
+    };
+
+    Split(const std::string_view strv, const CharSet& delimiters, bool skip_empty)
+        : _strv(strv), _delimiters(delimiters), _skip_empty(skip_empty) {}
+
+    Iterator begin() const { return Iterator(this); }
+    Iterator end() const { return {}; }
+
+private:
+    std::string_view _strv;
+    CharSet _delimiters;
+    bool _skip_empty;
+};
+
+/// Split `strv` at every char in `delimiters`, keeping empty parts: "a,,b" yields "a", "" and "b"
+inline Split split(const std::string_view strv, const std::string_view delimiters) {
+    return {strv, CharSet(delimiters), false};
+}
+inline Split split(const std::string_view strv, const CharSet& delimiters) { return {strv, delimiters, false}; }
+
+/// Split `strv` into the tokens between runs of `delimiters`: "  a  b " yields "a" and "b"
+inline Split tokenize(const std::string_view strv, const std::string_view delimiters = whitespace) {
+    return {strv, CharSet(delimiters), true};
+}
+inline Split tokenize(const std::string_view strv, const CharSet& delimiters) { return {strv, delimiters, true}; }
+
 } // namespace spn::core::utils
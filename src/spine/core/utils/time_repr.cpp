@@ -1,6 +1,7 @@
 #include "spine/core/utils/time_repr.hpp"
 
-// #include <charconv>
+#include "spine/core/utils/parse.hpp"
+
 #include <iterator>
 #include <numeric>
 #include <optional>
@@ -31,13 +32,12 @@ std::optional<std::variant<k_time_us, k_time_ms, k_time_s, k_time_m, k_time_h, k
 parse_time(const std::string_view input) {
     if (input.empty()) return std::nullopt;
 
-    // Find the position of the first non-digit character
-    std::size_t pos = input.find_first_not_of("0123456789");
-    if (pos == std::string_view::npos) return std::nullopt; // No unit found
-
     // Extract numeric value and unit
-    int value = std::stoi(std::string(input.substr(0, pos)));
-    std::string_view unit = input.substr(pos);
+    int value = 0;
+    const auto end = input.data() + input.size();
+    const auto [ptr, error] = scan_integer(input.data(), end, value);
+    if (error != ParseError::None) return std::nullopt;
+    std::string_view unit(ptr, static_cast<size_t>(end - ptr));
 
     if (unit == "us") return k_time_us(value);
     if (unit == "ms") return k_time_ms(value);
@@ -1,9 +1,9 @@
 #pragma once
 
+#include "spine/core/utils/format.hpp"
 #include "spine/structure/units/si.hpp"
 
 #include <array>
-#include <cinttypes>
 #include <optional>
 #include <string>
 #include <variant>
@@ -31,39 +31,13 @@ namespace spn::core::utils {
 /// Converts a time value to a string representation with the appropriate unit.
 /// Handles microseconds (us), milliseconds (ms), seconds (s), minutes (m),
 /// hours (h), and days (d). Uses 900 seconds as the cutoff for minutes.
+/// Use `format_duration` or `format_to(sink, readable(t))` (see format.hpp) to format without allocating.
 template<typename TimeType>
 inline std::string repr(const TimeType& t) {
-    auto buffer = std::array<char, 64>();
-    // std::string_view unit;
-
-    auto raw = (k_time_us(t).raw() < 1000)   ? k_time_us(t).raw()
-               : (k_time_ms(t).raw() < 1000) ? k_time_ms(t).raw()
-               : (k_time_s(t).raw() < 900)   ? k_time_s(t).raw() // use second up to 900s before switching to minute
-               : (k_time_m(t).raw() < 1440)  ? k_time_m(t).raw() // 1440 minutes = 24 hours
-               : (k_time_h(t).raw() < 24)    ? k_time_h(t).raw()
-               : (k_time_d(t).raw() > 0)     ? k_time_d(t).raw()
-                                             : 0;
-
-    auto unit = (k_time_us(t).raw() < 1000)   ? "us"
-                : (k_time_ms(t).raw() < 1000) ? "ms"
-                : (k_time_s(t).raw() < 900)   ? "s"
-                : (k_time_m(t).raw() < 1440)  ? "m"
-                : (k_time_h(t).raw() < 24)    ? "h"
-                : (k_time_d(t).raw() > 0)     ? "d"
-                                              : "unknown";
-
-    /// todo: this is a workaround, see issue with charconv: https://github.com/s-t-a-n/Spine/issues/21
-    auto size = std::snprintf(buffer.data(), buffer.size(), "%" PRId64 "%s", static_cast<int64_t>(raw), unit);
-    if (size < 0 || static_cast<size_t>(size) >= buffer.size()) {
-        return "Error";
-    }
-    return std::string(buffer.data(), size);
-
-    // auto [ptr, _] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), raw);
-    // std::string result(ptr - buffer.data() + unit.size(), '\0');
-    // std::memcpy(result.data(), buffer.data(), ptr - buffer.data());
-    // std::memcpy(result.data() + (ptr - buffer.data()), unit.data(), unit.size());
-    // return result;
+    auto buffer = std::array<char, 32>();
+    const auto end = format_duration(buffer.data(), buffer.data() + buffer.size(), k_time_us(t));
+    if (end == nullptr) return "Error";
+    return std::string(buffer.data(), static_cast<size_t>(end - buffer.data()));
 }
 
 /// Function to parse a string like "10us", "2h", or "1d" to a Time object
@@ -30,7 +30,10 @@ k_time_s Event::Data::s() const {
     return std::get<k_time_s>(*_value);
 }
 
-EventSystem::EventSystem(const EventSystem::Config& cfg) //
+EventSystem::EventSystem(const EventSystem::Config& cfg)
+    : EventSystem(cfg, memory::ScopedTag(memory::Subsystem::EVENTSYSTEM)) {}
+
+EventSystem::EventSystem(const EventSystem::Config& cfg, const memory::ScopedTag& tag) //
     : _cfg(cfg), //
       _map(Array<EventHandlerMap>(cfg.events_count)), //
       _pipeline(Pipeline(cfg.events_cap)), //
@@ -48,7 +51,7 @@ EventSystem::~EventSystem() {
     for (size_t i = 0; i < _map.size(); i++) {
         _map[i].reset();
     }
-    for (size_t i = 0; i < _store.size(); ++i) {
+    while (_store.size() > 0) {
         auto ev = _store.depopulate();
         ev.reset();
     }
@@ -71,19 +74,25 @@ void EventSystem::trigger(const Event& event) {
 }
 
 void EventSystem::loop() {
-    while (_pipeline.contains_expired_futures()) {
-        // we have futures ready to be processed
-        auto future = _pipeline.expire();
-        spn_assert(future != nullptr);
+    // all futures of this pass are compared against a single reading of the clock, which isn't held while the
+    // handlers run: they see the time move on, and what they schedule fires in a later pass, even when it's due
+    // right away
+    const auto now = spn::Clock::now();
+    for (auto pending = _pipeline.size(); pending > 0; --pending) {
+        auto future = _pipeline.expire(now);
+        if (!future) break;
         auto event = *reinterpret_cast<Event*>(future.get());
         trigger(event);
     }
 
     if (_cfg.delay_between_ticks) {
+        auto delay = k_time_ms(_cfg.min_delay_between_ticks);
         if (_pipeline.contains_futures())
-            HAL::delay_ms(std::min(_pipeline.time_until_next_future().raw(), _cfg.max_delay_between_ticks.raw()));
+            delay = k_time_ms(std::min(_pipeline.time_until_next_future().raw(), _cfg.max_delay_between_ticks.raw()));
+        if (_idle_waiter)
+            _idle_waiter->wait(delay);
         else
-            HAL::delay(_cfg.min_delay_between_ticks);
+            HAL::delay(delay);
     }
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/memory.hpp"
 #include "spine/eventsystem/pipeline.hpp"
 #include "spine/structure/array.hpp"
 #include "spine/structure/pool.hpp"
@@ -87,6 +88,16 @@ private:
     EventSystem* _evsys = nullptr;
 };
 
+/// Waits between the passes of `EventSystem::loop` in place of the platform's delay, such that it can wake the event
+/// system early, e.g. when input arrives
+class IdleWaiter {
+public:
+    virtual ~IdleWaiter() = default;
+
+    /// Return after at most `timeout`, or earlier when there's something to do
+    virtual void wait(k_time_ms timeout) = 0;
+};
+
 class EventSystem {
 public:
     struct Config {
@@ -157,9 +168,16 @@ public:
     /// Main loop of event system. It is crucial that this loop is called often enough to fire events in time
     void loop();
 
+    /// Wait between ticks through `waiter` instead of the platform's delay, or delay again when it's nullptr
+    void set_idle_waiter(IdleWaiter* waiter) { _idle_waiter = waiter; }
+
 private:
+    /// Constructs while `tag` charges all allocations to the eventsystem
+    EventSystem(const Config& cfg, const memory::ScopedTag& tag);
+
     const Config _cfg;
     Array<EventHandlerMap> _map;
+    IdleWaiter* _idle_waiter = nullptr;
 
 protected:
     Pipeline _pipeline; // caches all events queued for firing
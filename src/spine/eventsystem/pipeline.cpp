@@ -1,48 +1,22 @@
 #include "spine/eventsystem/pipeline.hpp"
 
-#include "spine/core/utils/time_repr.hpp"
-
 namespace spn::eventsystem {
 
 Future::Future(k_time_ms time_from_now) : _time_from_now(time_from_now), _timer(AlarmTimer(time_from_now)) {}
 
 void Future::reschedule(k_time_ms time_from_now) {
     _time_from_now = time_from_now != k_time_ms(0) ? time_from_now : _time_from_now;
-    spn_assert(_time_from_now > k_time_ms{});
+    spn_assert(_time_from_now >= k_time_ms{}); // a future due right away fires in the next pass
     _timer = AlarmTimer(_time_from_now);
 }
 
 std::string Pipeline::to_string() const {
-    auto pipeline_repr = [&](std::string* s, bool length_only) -> size_t {
-        size_t len = 0;
-        auto put = [&](std::string_view i) {
-            if (!length_only) {
-                *s += i;
-            }
-            len += i.size();
-        };
-        put("Pipeline: [");
-        for (auto it = _pipe.begin(); it != _pipe.end(); ++it) {
-            auto& future = *it;
-            put(utils::repr(future->time_until_future()));
-            if (it != _pipe.end()) put(", ");
-        }
-        put("]");
-        return len;
-    };
+    auto length = utils::LengthCounter();
+    format_to(length);
 
-    // First pass to calculate total length
-    size_t total_length = pipeline_repr(nullptr, true);
-
-    // Reserve capacity to avoid multiple allocations
     std::string result;
-    result.reserve(total_length);
-
-    // Second pass to build the string
-    pipeline_repr(&result, false);
-
-    spn_assert(result.size() <= total_length); // no reallocation
-    spn_assert(result.capacity() == total_length); // no reallocation
+    result.reserve(length.size());
+    format_to(result);
     return result;
 }
 
@@ -51,7 +25,7 @@ k_time_ms Pipeline::time_until_next_future() const {
         return k_time_ms(0);
     }
     k_time_ms future = _pipe.peek_front()->future();
-    k_time_ms current = HAL::millis();
+    k_time_ms current = spn::Clock::now();
     return future <= current ? k_time_ms(0) : future - current;
 }
 
@@ -66,13 +40,19 @@ std::shared_ptr<Future> Pipeline::expire() {
     return future;
 }
 
+std::shared_ptr<Future> Pipeline::expire(k_time_ms moment) {
+    if (_pipe.empty() || _pipe.peek_front()->future() > moment) return nullptr;
+    return _pipe.pop_front();
+}
+
 void Pipeline::push(std::shared_ptr<Future>&& future) {
     spn_assert(_pipe.size() < _pipe.max_size());
     future->reschedule();
 
+    // compare absolute moments, which orders the same as the time until each future without reading the clock
     size_t i = 0;
     for (auto& other_future : _pipe) {
-        if (future->time_until_future() < other_future->time_until_future()) {
+        if (*future < *other_future) {
             [[maybe_unused]] auto last_size = _pipe.size();
             _pipe.insert(i, std::move(future));
             spn_assert(last_size + 1 == _pipe.size());
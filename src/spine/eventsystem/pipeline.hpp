@@ -1,5 +1,7 @@
 #pragma once
 
+#include "spine/core/clock.hpp"
+#include "spine/core/utils/format.hpp"
 #include "spine/core/utils/string.hpp"
 #include "spine/core/utils/time_repr.hpp"
 #include "spine/platform/hal.hpp"
@@ -13,16 +15,16 @@ using namespace spn::core;
 // forward declaration
 class Pipeline;
 
-/// A moment in the future determined with time_from_now (relative to the system clock)
+/// A moment in the future determined with time_from_now (relative to spn::Clock)
 class Future {
 public:
     Future(k_time_ms time_from_now = k_time_ms{0});
 
-    bool operator<(const Future& other) const { return _timer.time_from_now() < other._timer.time_from_now(); }
-    bool operator==(const Future& other) const { return _timer.time_from_now() == other._timer.time_from_now(); }
+    bool operator<(const Future& other) const { return _timer.future() < other._timer.future(); }
+    bool operator==(const Future& other) const { return _timer.future() == other._timer.future(); }
 
     /// Reschedule a future to happen at a different moment (this has no effect when the future is already in the
-    /// pipeline)
+    /// pipeline). A zero `time_from_now` keeps the previous one; a future due right away fires in the next pass.
     void reschedule(k_time_ms time_from_now = k_time_ms{0});
 
     /// Returns true if the event is ready to fire
@@ -57,16 +59,35 @@ public:
     /// Takes the first next future to fire from the pipeline
     [[nodiscard]] std::shared_ptr<Future> expire();
 
+    /// Takes the first next future from the pipeline if it fires at or before `moment`, without reading the clock.
+    /// Returns nullptr otherwise.
+    [[nodiscard]] std::shared_ptr<Future> expire(k_time_ms moment);
+
     /// Returns true if the pipeline contains any futures that are ready to fire
     [[nodiscard]] bool contains_expired_futures() const { return contains_futures() && _pipe.peek_front()->expired(); }
 
     /// Returns true if the pipeline contains any futures whatsoever
     [[nodiscard]] bool contains_futures() const { return !_pipe.empty(); }
 
-    /// Returns the time (relative to the system clock) until the first next expirable future
+    /// Returns the amount of futures in the pipeline
+    [[nodiscard]] size_t size() const { return _pipe.size(); }
+
+    /// Returns the time (relative to spn::Clock) until the first next expirable future
     [[nodiscard]] k_time_ms time_until_next_future() const;
 
-    /// Returns a string representation of the Pipeline's content
+    template<typename Sink>
+    /// Write a representation of the Pipeline's content to `sink` (see `utils::format_to`), e.g.
+    /// `Pipeline: [150ms, 2s]`. Returns the amount of bytes the sink took.
+    size_t format_to(Sink& sink) const {
+        auto written = utils::format_to(sink, "Pipeline: [");
+        for (auto it = _pipe.begin(); it != _pipe.end(); ++it) {
+            if (it != _pipe.begin()) written += utils::format_to(sink, ", ");
+            written += utils::format_to(sink, utils::readable((*it)->time_until_future()));
+        }
+        return written + utils::format_to(sink, "]");
+    }
+
+    /// Returns a string representation of the Pipeline's content (prefer `format_to`, which doesn't allocate)
     std::string to_string() const;
 
     /// Returns the internal pipe for external inspection (probably only under testing)
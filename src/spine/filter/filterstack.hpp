@@ -2,6 +2,7 @@
 
 #include "spine/core/debugging.hpp"
 #include "spine/core/exception.hpp"
+#include "spine/core/memory.hpp"
 #include "spine/filter/filter.hpp"
 #include "spine/structure/vector.hpp"
 
@@ -13,7 +14,10 @@ template<typename ValueType = float>
 /// Stack of filters. Any value provided to this stack will pass through all filters in the stack
 class Stack {
 public:
-    Stack(uint8_t number_of_filters) : _filters() { _filters.reserve(number_of_filters); }
+    Stack(uint8_t number_of_filters) : _filters() {
+        const auto tag = memory::ScopedTag(memory::Subsystem::FILTER);
+        _filters.reserve(number_of_filters);
+    }
 
     /// Attach a filter to the provided slot's index
     void attach_filter(std::unique_ptr<Filter<ValueType>> filter) {
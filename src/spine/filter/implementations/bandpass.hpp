@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/fixed.hpp"
 #include "spine/filter/filter.hpp"
 
 #include <spine/platform/hal.hpp>
@@ -48,8 +49,8 @@ public:
                                                  .throw_on_rejection_limit = true});
     }
 
-    BandPass(const Config&& cfg) : _cfg(std::move(cfg)) {
-        static_assert(std::is_floating_point_v<ValueType>, "ValueType must be a floating point type");
+    BandPass(const Config&& cfg) : _cfg(std::move(cfg)), _band(band_of(_cfg)) {
+        static_assert(spn::is_real_v<ValueType>, "ValueType must be a floating point or fixed point type");
         spn_assert(_cfg.mantissa >= 1.0f && _cfg.mantissa < 10.0f); // sanity
         BandPass::update_limits();
     }
@@ -66,7 +67,8 @@ public:
         }
 
         SPN_DBG("--------------------------------------------------------------------------");
-        SPN_DBG("Bandpass rejected value of %f, limits: low: %f, high: %f", sample, _lower, _upper);
+        SPN_DBG("Bandpass rejected value of %f, limits: low: %f, high: %f", static_cast<double>(sample),
+                static_cast<double>(_lower), static_cast<double>(_upper));
         SPN_DBG("--------------------------------------------------------------------------");
 
         if (++_rejections > _cfg.rejection_limit) {
@@ -93,8 +95,14 @@ public:
 protected:
     void update_limits() {
         ValueType compensated_midpoint = _cfg.mode == Mode::RELATIVE ? _value + _cfg.offset : _cfg.offset;
-        _upper = compensated_midpoint + std::pow(_cfg.mantissa * 10, (_cfg.decades + 1));
-        _lower = compensated_midpoint - std::pow(_cfg.mantissa * 10, (_cfg.decades + 1));
+        _upper = compensated_midpoint + _band;
+        _lower = compensated_midpoint - _band;
+    }
+
+    /// Returns the distance of the limits to the midpoint. Computed once, since it only depends on the configuration.
+    static ValueType band_of(const Config& cfg) {
+        using Real = std::conditional_t<std::is_floating_point_v<ValueType>, ValueType, float>;
+        return ValueType(std::pow(static_cast<Real>(cfg.mantissa) * 10, static_cast<Real>(cfg.decades) + 1));
     }
 
     /// Arbitrary value to be used as a default value
@@ -102,6 +110,7 @@ protected:
 
 private:
     const Config _cfg;
+    const ValueType _band;
 
     ValueType _value = DefaultValue;
     ValueType _lower;
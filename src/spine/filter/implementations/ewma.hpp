@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/fixed.hpp"
 #include "spine/filter/filter.hpp"
 
 #include <cstdint>
@@ -17,7 +18,7 @@ public:
     };
 
     EWMA(const Config&& cfg) : _cfg(std::move(cfg)) {
-        static_assert(std::is_floating_point<ValueType>::value, "ValueType must be a floating point type");
+        static_assert(spn::is_real_v<ValueType>, "ValueType must be a floating point or fixed point type");
     }
     ~EWMA() override = default;
 
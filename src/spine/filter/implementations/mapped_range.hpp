@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/fixed.hpp"
 #include "spine/filter/filter.hpp"
 
 #include <cstdint>
@@ -22,7 +23,7 @@ public:
     };
 
     MappedRange(const Config&& cfg) : _cfg(std::move(cfg)) {
-        static_assert(std::is_floating_point<ValueType>::value, "ValueType must be a floating point type");
+        static_assert(spn::is_real_v<ValueType>, "ValueType must be a floating point or fixed point type");
     }
     ~MappedRange() override = default;
 
@@ -46,8 +47,8 @@ public:
     ValueType value(ValueType sample) override {
         if (sample < _cfg.input_lower_limit || sample > _cfg.input_upper_limit) {
             SPN_DBG("--------------------------------------------------------------------------");
-            SPN_DBG("MappedRange rejected value of %f, limits: lower: %f, upper: %f", sample, _cfg.input_lower_limit,
-                    _cfg.input_upper_limit);
+            SPN_DBG("MappedRange rejected value of %f, limits: lower: %f, upper: %f", static_cast<double>(sample),
+                    static_cast<double>(_cfg.input_lower_limit), static_cast<double>(_cfg.input_upper_limit));
             SPN_DBG("--------------------------------------------------------------------------");
             if (_cfg.throw_for_value_out_of_range) {
                 spn::throw_exception(spn::runtime_exception("MappedRange: Value out of range"));
@@ -1,10 +1,31 @@
 #include "spine/io/stream/buffered_stream.hpp"
 
+#include <algorithm>
+
 namespace spn::io {
 
+namespace {
+constexpr uint8_t xon = 0x11;
+constexpr uint8_t xoff = 0x13;
+
+constexpr std::array<OutputLane, output_lane_count> g_output_lanes = {OutputLane::Control, OutputLane::Log,
+                                                                      OutputLane::Bulk};
+} // namespace
+
 BufferedStream::BufferedStream(std::shared_ptr<Stream> stream, const BufferedStream::Config&& cfg)
+    : BufferedStream(std::move(stream), cfg, memory::ScopedTag(memory::Subsystem::IO)) {}
+
+BufferedStream::BufferedStream(std::shared_ptr<Stream>&& stream, const BufferedStream::Config& cfg,
+                               const memory::ScopedTag& tag)
     : _cfg(cfg), _input_buffer(cfg.input_buffer_size, cfg.delimiters),
-      _output_buffer(_cfg.output_buffer_size, cfg.delimiters), _stream(std::move(stream)) {}
+      _output_buffer(_cfg.output_buffer_size, cfg.delimiters),
+      _log_lane(std::max<size_t>(cfg.log_lane.size, 1), cfg.delimiters),
+      _bulk_lane(std::max<size_t>(cfg.bulk_lane.size, 1), cfg.delimiters), _in_flight(cfg.max_transactions),
+      _stream(std::move(stream)),
+      _high_watermark(cfg.high_watermark > 0 ? cfg.high_watermark : cfg.input_buffer_size * 3 / 4),
+      _low_watermark(cfg.low_watermark > 0 ? cfg.low_watermark : cfg.input_buffer_size / 4) {
+    spn_assert(_low_watermark < _high_watermark || _cfg.flow_control != FlowControl::XonXoff);
+}
 size_t BufferedStream::buffered_write(uint8_t value, bool rollover) { return _output_buffer.push(value, rollover); }
 size_t BufferedStream::buffered_write(const char* const buffer, size_t lenght, bool rollover) {
     return _output_buffer.push(buffer, lenght, rollover);
@@ -25,41 +46,262 @@ bool BufferedStream::drop_next_line(const std::optional<size_t>& discovered_leng
 size_t BufferedStream::length_of_next_line() const { return _input_buffer.length_of_next_line(); }
 size_t BufferedStream::pull_in_data() {
     size_t bytes_read = 0;
-    uint8_t last_char = '\0';
+    bool last_was_delimiter = false;
 
     while (_stream->available() > 0) {
-        // early break when a delimiter has been found, as to lose no input if possible
-        if (_input_buffer.full()) {
-            if (_input_buffer.delimiters().find(last_char) != std::string::npos)
-                break; // break when the last incoming was a delimiter
-            if (_input_buffer.overrun_space() == 0 && _input_buffer.has_line())
-                break; // break when the buffer just turned full and the buffer already contains a line
+        if (!_input_buffer.full()) {
+            // read straight into the free space of the ring, as much as fits in one piece
+            const auto spans = _input_buffer.free_spans();
+            const auto n = _stream->read(spans.first, std::min(spans.first_size, _stream->available()));
+            if (n == 0) break; // read failure
+            _input_counters.received_bytes += n;
+            const auto kept = take_flow_control(spans.first, n);
+            _input_buffer.commit(kept);
+            if (kept > 0) last_was_delimiter = _input_buffer.is_delimiter(spans.first[kept - 1]);
+            _is_overrunning = false;
+            _received += static_cast<uint32_t>(kept);
+            bytes_read += kept;
+            continue;
         }
 
-        if (!_stream->read(last_char)) {
-            return bytes_read; // read failure
+        // early break when a delimiter has been found, as to lose no input if possible
+        if (last_was_delimiter) break; // break when the last incoming was a delimiter
+        if (_input_buffer.overrun_space() == 0 && _input_buffer.has_line())
+            break; // break when the buffer just turned full and the buffer already contains a line
+        if (_claimed_bytes > 0) {
+            // overwriting would roll over into the lines of the transactions in flight: leave the input in the stream
+            _input_counters.overruns += _is_overrunning ? 0 : 1;
+            _is_overrunning = true;
+            break;
         }
+
+        // the line doesn't fit: overwrite the oldest bytes, one at a time
+        uint8_t value;
+        if (!_stream->read(value)) break; // read failure
+        auto last_char = static_cast<char>(value);
+        ++_input_counters.received_bytes;
+        if (take_flow_control(&last_char, 1) == 0) continue;
+        _input_counters.overruns += _is_overrunning ? 0 : 1;
+        ++_input_counters.overrun_bytes;
+        _is_overrunning = true;
         _input_buffer.push(last_char, true);
+        last_was_delimiter = _input_buffer.is_delimiter(last_char);
+        _is_overrunning = !last_was_delimiter; // the overrun ends with the line that didn't fit
+        ++_received;
         ++bytes_read;
     }
+    update_flow_control();
     return bytes_read;
 }
 
+size_t BufferedStream::take_flow_control(char* bytes, size_t length) {
+    if (_cfg.flow_control != FlowControl::XonXoff) return length;
+    size_t kept = 0;
+    for (size_t i = 0; i < length; ++i) {
+        const auto c = static_cast<uint8_t>(bytes[i]);
+        if (c == xon || c == xoff) {
+            _output_paused = c == xoff;
+            continue;
+        }
+        bytes[kept++] = bytes[i];
+    }
+    return kept;
+}
+
 size_t BufferedStream::push_out_data() {
     size_t bytes_written = 0;
+    update_flow_control();
+    if (_output_paused) return 0;
+    // the credit left, unlimited without credit flow control
+    auto credit = _cfg.flow_control == FlowControl::Credit ? static_cast<size_t>(_output_credit - _sent) : SIZE_MAX;
 
-    while (_stream->available_for_write() > 0) {
-        char v;
-        if (!_output_buffer.pop(v) || !_stream->write(v)) return bytes_written;
-        ++bytes_written;
+    while (_stream->available_for_write() > 0 && credit > 0) {
+        const auto lane = next_output_lane();
+        if (!lane) break;
+        auto& buffer = output_lane(*lane);
+        const auto record_length = buffer.length_of_next_line();
+        const auto length = record_length > 0 ? record_length : buffer.used_space();
+        if (!_unfinished_lane && *lane != _turn) {
+            _turn = *lane; // the lanes in between had nothing to push out, they pass their turn
+            _turn_records = 0;
+        }
+
+        const auto pushed = push_from(buffer, *_stream, std::min(length, credit));
+        bytes_written += pushed;
+        credit -= pushed;
+        _sent += static_cast<uint32_t>(pushed);
+        if (record_length == 0 || pushed < record_length) {
+            _unfinished_lane = lane;
+            if (pushed < length) break; // the stream takes no more
+            continue;
+        }
+
+        _unfinished_lane.reset();
+        ++_lane_counters[static_cast<size_t>(*lane)].records_sent;
+        if (_cfg.output_scheduling == OutputScheduling::WeightedFair && ++_turn_records >= output_lane_weight(_turn)) {
+            _turn = g_output_lanes[(static_cast<size_t>(_turn) + 1) % output_lane_count];
+            _turn_records = 0;
+        }
     }
     return bytes_written;
 }
 
+std::optional<uint32_t> BufferedStream::credit_update() const {
+    if (_cfg.flow_control != FlowControl::Credit) return std::nullopt;
+    const auto free = _input_buffer.free_space();
+    const auto window = free > _cfg.credit_reserve ? free - _cfg.credit_reserve : 0;
+    const auto limit = static_cast<uint32_t>(_received + window);
+    if (!_is_credit_announced) return limit;
+
+    // announce when the window grew by the headroom above the high watermark, or any growth when it's running out
+    const auto growth = static_cast<int32_t>(limit - _announced_credit);
+    const auto outstanding = static_cast<int32_t>(_announced_credit - _received);
+    const auto step = static_cast<int32_t>(std::max<size_t>(_input_buffer.capacity() - _high_watermark, 1));
+    if (growth >= step || (growth > 0 && outstanding < step)) return limit;
+    return std::nullopt;
+}
+
+void BufferedStream::credit_update_sent(uint32_t limit) {
+    _announced_credit = limit;
+    _is_credit_announced = true;
+}
+
+bool BufferedStream::is_output_paused() const {
+    return _output_paused || (_cfg.flow_control == FlowControl::Credit && _output_credit == _sent);
+}
+
+bool BufferedStream::write_out_of_band(const std::string_view& bytes) {
+    if (_unfinished_lane || _stream->available_for_write() < bytes.size()) return false;
+    return _stream->write(bytes) == bytes.size();
+}
+
+void BufferedStream::update_flow_control() {
+    if (_cfg.flow_control != FlowControl::XonXoff) return;
+    const auto used = _input_buffer.used_space();
+    if (!_peer_paused && used >= _high_watermark && _stream->write(xoff)) {
+        _peer_paused = true;
+        ++_input_counters.pause_requests;
+    } else if (_peer_paused && used <= _low_watermark && _stream->write(xon)) {
+        _peer_paused = false;
+    }
+}
+
+bool BufferedStream::write_record(OutputLane lane, const std::string_view& record) {
+    auto& buffer = output_lane(lane);
+    auto& counters = _lane_counters[static_cast<size_t>(lane)];
+    const auto drop_policy = lane == OutputLane::Log    ? _cfg.log_lane.drop_policy
+                             : lane == OutputLane::Bulk ? _cfg.bulk_lane.drop_policy
+                                                        : OutputDropPolicy::DropNewest;
+    const auto is_enabled = lane == OutputLane::Log    ? _cfg.log_lane.size > 0
+                            : lane == OutputLane::Bulk ? _cfg.bulk_lane.size > 0
+                                                       : !_output_owner.has_value();
+
+    const auto reject = [&counters, &record]() {
+        ++counters.dropped_records;
+        counters.dropped_bytes += record.size();
+        return false;
+    };
+    if (!is_enabled || record.size() > buffer.capacity()) return reject();
+    while (buffer.free_space() < record.size()) {
+        // a record that was partially pushed out can't be dropped anymore
+        const auto oldest = buffer.length_of_next_line();
+        if (drop_policy != OutputDropPolicy::DropOldest || oldest == 0 || _unfinished_lane == lane) return reject();
+        buffer.drop_first(oldest);
+        ++counters.dropped_records;
+        counters.dropped_bytes += oldest;
+    }
+    buffer.push(record.data(), record.size());
+    return true;
+}
+
+structure::LineBuffer& BufferedStream::output_lane(OutputLane lane) {
+    return const_cast<structure::LineBuffer&>(static_cast<const BufferedStream*>(this)->output_lane(lane));
+}
+
+const structure::LineBuffer& BufferedStream::output_lane(OutputLane lane) const {
+    switch (lane) {
+    case OutputLane::Log: return _log_lane;
+    case OutputLane::Bulk: return _bulk_lane;
+    case OutputLane::Control: break;
+    }
+    return _output_buffer;
+}
+
+uint8_t BufferedStream::output_lane_weight(OutputLane lane) const {
+    switch (lane) {
+    case OutputLane::Log: return _cfg.log_lane.weight;
+    case OutputLane::Bulk: return _cfg.bulk_lane.weight;
+    case OutputLane::Control: break;
+    }
+    return _cfg.control_weight;
+}
+
+bool BufferedStream::is_pushable(OutputLane lane) const {
+    const auto& buffer = output_lane(lane);
+    if (lane == OutputLane::Control && _is_partial_output_held) return buffer.has_line();
+    return !buffer.empty();
+}
+
+std::optional<OutputLane> BufferedStream::next_output_lane() const {
+    if (_unfinished_lane) {
+        // finish the record first, so records of different lanes never interleave
+        if (!is_pushable(*_unfinished_lane)) return std::nullopt;
+        return _unfinished_lane;
+    }
+
+    // complete records first: by strict priority, or starting from the lane whose turn it is
+    const auto first = _cfg.output_scheduling == OutputScheduling::WeightedFair ? static_cast<size_t>(_turn) : 0;
+    for (size_t i = 0; i < output_lane_count; ++i) {
+        const auto lane = g_output_lanes[(first + i) % output_lane_count];
+        if (output_lane(lane).has_line()) return lane;
+    }
+    for (const auto lane : g_output_lanes) {
+        if (is_pushable(lane)) return lane;
+    }
+    return std::nullopt;
+}
+
+char* BufferedStream::output_buffer_last() {
+    char* last = nullptr;
+    const auto used = _output_buffer.used_space();
+    return used > 0 && _output_buffer.peek_at(&last, used - 1) ? last : nullptr;
+}
+
 std::optional<Transaction> BufferedStream::new_transaction() {
-    const auto discovered_length = length_of_next_line();
+    if (_in_flight.full()) return std::nullopt;
+    const auto length = _input_buffer.length_of_next_line(_claimed_bytes);
+    if (length == 0) return std::nullopt;
+
+    auto line = _input_buffer.view_at(_claimed_bytes, length - 1); // ignore delimiter
+    if (!line) {
+        // the line wraps around the end of the ring, it can only be moved while no other transaction points into it
+        if (!_in_flight.empty()) return std::nullopt;
+        _input_buffer.linearize();
+        line = _input_buffer.view_at(0, length - 1);
+    }
+    const auto id = _next_transaction_id++;
+    _in_flight.push(InFlight{id, length, false});
+    _claimed_bytes += length;
+    return Transaction(this, id, *line);
+}
+
+void BufferedStream::finish_transaction(uint32_t id) {
+    InFlight* transaction = nullptr;
+    for (size_t i = 0; i < _in_flight.used_space(); ++i) {
+        if (_in_flight.peek_at(&transaction, i) && transaction->id == id) transaction->finalized = true;
+    }
+    while (_in_flight.peek_at(&transaction, 0) && transaction->finalized) {
+        _input_buffer.drop_first(transaction->length);
+        _claimed_bytes -= transaction->length;
+        _in_flight.pop();
+    }
+    if (_output_owner == id) _output_owner.reset();
+}
 
-    return length_of_next_line() > 0 ? std::make_optional(Transaction(this, discovered_length)) : std::nullopt;
+bool BufferedStream::acquire_output(uint32_t id) {
+    if (!output_available_to(id)) return false;
+    _output_owner = id;
+    return true;
 }
 
 } // namespace spn::io
\ No newline at end of file
@@ -1,21 +1,78 @@
 #pragma once
 
+#include "spine/core/memory.hpp"
+#include "spine/io/stream/static_stream.hpp"
 #include "spine/io/stream/stream.hpp"
 #include "spine/io/stream/transaction.hpp"
 #include "spine/structure/linebuffer.hpp"
+#include "spine/structure/ringbuffer.hpp"
 
+#include <array>
+#include <initializer_list>
 #include <memory>
 #include <optional>
 
 namespace spn::io {
 
+/// The output lanes of a `BufferedStream`, from highest to lowest priority
+enum class OutputLane : uint8_t {
+    Control, // the output buffer, which transactions reply into
+    Log,
+    Bulk,
+};
+constexpr size_t output_lane_count = 3;
+
+/// What happens to a record that doesn't fit its lane
+enum class OutputDropPolicy : uint8_t {
+    DropNewest, // the record is rejected
+    DropOldest, // whole records are dropped from the front of the lane to make room
+};
+
+/// How `push_out_data` picks the next record to push out
+enum class OutputScheduling : uint8_t {
+    StrictPriority, // always the highest priority lane with a complete record
+    WeightedFair, // round robin over the lanes, every lane pushes out up to its weight in records per turn
+};
+
+/// How the peer is kept from overrunning the input buffer
+enum class FlowControl : uint8_t {
+    None,
+    XonXoff, // in band XOFF (0x13) and XON (0x11) around the watermarks, for text; both are filtered from the input
+    Credit, // the peer may send up to a credit limit announced by `credit_update()`, for binary protocols
+};
+
 class BufferedStream {
 public:
     using Transaction = spn::io::Transaction;
+    struct OutputLaneConfig {
+        size_t size = 0; // 0 disables the lane
+        OutputDropPolicy drop_policy = OutputDropPolicy::DropNewest;
+        uint8_t weight = 1; // records per turn with `OutputScheduling::WeightedFair`
+    };
     struct Config {
         size_t input_buffer_size = 1;
-        size_t output_buffer_size = 1;
+        size_t output_buffer_size = 1; // of the control lane
         std::string_view delimiters = "\r\n";
+        size_t max_transactions = 1; // transactions that can be in flight at once
+        OutputLaneConfig log_lane = {};
+        OutputLaneConfig bulk_lane = {};
+        OutputScheduling output_scheduling = OutputScheduling::StrictPriority;
+        uint8_t control_weight = 1; // records per turn of the control lane with `OutputScheduling::WeightedFair`
+        FlowControl flow_control = FlowControl::None;
+        size_t high_watermark = 0; // input bytes at which the peer is paused, 0 for 3/4 of the input buffer
+        size_t low_watermark = 0; // input bytes at which a paused peer resumes, 0 for 1/4 of the input buffer
+        size_t credit_reserve = 0; // input bytes kept out of the credit window, e.g. for credit updates of the peer
+    };
+    struct InputCounters {
+        size_t received_bytes = 0;
+        size_t overrun_bytes = 0; // unread bytes that were overwritten, since a line didn't fit the input buffer
+        size_t overruns = 0; // times the input buffer started overwriting unread bytes
+        size_t pause_requests = 0; // XOFFs sent
+    };
+    struct OutputLaneCounters {
+        size_t records_sent = 0; // records pushed out up to and including their delimiter
+        size_t dropped_records = 0;
+        size_t dropped_bytes = 0;
     };
 
 public:
@@ -25,6 +82,15 @@ public:
     size_t buffered_write(uint8_t value, bool rollover = false);
     size_t buffered_write(const char* const buffer, size_t lenght, bool rollover = false);
 
+    /// Queue all `count` segments into the output buffer, e.g. a prefix, a formatted value, a unit and a delimiter, or
+    /// none of them when they don't fit at once. Returns the amount of bytes queued.
+    size_t buffered_writev(const std::string_view* segments, size_t count) {
+        return _output_buffer.pushv(segments, count);
+    }
+    size_t buffered_writev(std::initializer_list<std::string_view> segments) {
+        return buffered_writev(segments.begin(), segments.size());
+    }
+
     /// Returns true if a delimited line was found
     bool has_line() const { return _input_buffer.length_of_next_line() > 0; }
 
@@ -44,25 +110,141 @@ public:
     /// Populate the input buffer. Returns the amount of bytes read into the buffer.
     size_t pull_in_data();
 
-    /// Flush the output buffer. Returns the amount of bytes written from the buffer into the underlying stream.
+    /// Returns the counters of the input buffer
+    const InputCounters& input_counters() const { return _input_counters; }
+
+    /// Credit flow control, receiving side: returns the limit to announce to the peer (the total amount of bytes it
+    /// may have sent, modulo 2^32) when the window grew enough to be worth announcing or is running out. Confirm it
+    /// with `credit_update_sent` once it's sent.
+    std::optional<uint32_t> credit_update() const;
+    void credit_update_sent(uint32_t limit);
+
+    /// Credit flow control, sending side: the peer allows `limit` bytes in total (modulo 2^32) to be pushed out
+    void grant_output_credit(uint32_t limit) { _output_credit = limit; }
+
+    /// Returns true when the peer paused the output with an XOFF, or its credit ran out
+    bool is_output_paused() const;
+
+    /// Write `bytes` straight into the stream, bypassing the lanes and flow control, such as flow control messages.
+    /// Only happens between records and when the stream takes all bytes at once. Returns true if written.
+    bool write_out_of_band(const std::string_view& bytes);
+
+    /// Flush the output lanes. Records (the bytes up to and including a delimiter) are pushed out as a whole before
+    /// switching lanes, in the order of `Config::output_scheduling`. Bytes without a delimiter are only pushed out once
+    /// no lane holds a complete record, after which their lane keeps the stream until it completes the record. Returns
+    /// the amount of bytes written from the lanes into the underlying stream.
     size_t push_out_data();
 
+    /// Queue `record` (which should end with a delimiter) into `lane` as a whole or not at all, applying the lane's
+    /// drop policy when it doesn't fit. The control lane rejects records while a transaction holds the output. Returns
+    /// true if the record was queued.
+    bool write_record(OutputLane lane, const std::string_view& record);
+
+    /// Returns the counters of `lane`
+    const OutputLaneCounters& output_lane_counters(OutputLane lane) const {
+        return _lane_counters[static_cast<size_t>(lane)];
+    }
+
+    /// Returns the amount of bytes queued in `lane`
+    size_t output_lane_space_used(OutputLane lane) const { return output_lane(lane).used_space(); }
+
+    /// Start a transaction on the next line that isn't claimed by a transaction in flight. Returns nullopt when there
+    /// is no such line, when `max_transactions` are in flight or when the line wraps around the end of the input
+    /// buffer while other transactions are in flight (it's moved to the start once they are finalized). Lines are
+    /// released in order of arrival, so a finalized transaction keeps its line until all earlier ones are finalized
+    /// too. The line based functions above shouldn't be mixed with transactions in flight.
     std::optional<Transaction> new_transaction();
 
+    /// Amount of transactions holding a line, which includes finalized ones waiting for an earlier one to finalize
+    size_t transactions_in_flight() const { return _in_flight.used_space(); }
+
     size_t input_buffer_space_left() const { return _input_buffer.free_space(); }
     size_t input_buffer_space_used() const { return _input_buffer.used_space(); }
     size_t output_buffer_space_left() const { return _output_buffer.free_space(); }
     size_t output_buffer_space_used() const { return _output_buffer.used_space(); }
+    size_t output_buffer_capacity() const { return _output_buffer.capacity(); }
 
     size_t output_buffer_drop_last(const size_t n) { return _output_buffer.drop_last(n); }
     size_t output_buffer_drop_first(const size_t n) { return _output_buffer.drop_first(n); }
 
+    /// Returns the input buffer as (at most) two contiguous spans, e.g. to decode the next line without copying it
+    structure::LineBuffer::Spans input_buffer_spans() const { return _input_buffer.used_spans(); }
+
+    /// Returns the last byte queued in the output buffer, such that it can be patched until it's pushed out, or nullptr
+    char* output_buffer_last();
+
+    /// Hold the bytes queued in the output buffer after its last complete record back from `push_out_data`, e.g. while
+    /// they're patched through `output_buffer_last()`. Complete records before them are still pushed out.
+    void hold_partial_output(bool hold) { _is_partial_output_held = hold; }
+
 private:
+    friend class spn::io::Transaction;
+
+    /// Constructs while `tag` charges all allocations to io
+    BufferedStream(std::shared_ptr<Stream>&& stream, const Config& cfg, const memory::ScopedTag& tag);
+
+    /// Mark transaction `id` finalized and drop the lines of all finalized transactions at the front
+    void finish_transaction(uint32_t id);
+
+    /// Claim the output for transaction `id` until it's finalized, so replies don't interleave. Returns false when
+    /// another transaction holds the output.
+    bool acquire_output(uint32_t id);
+
+    /// Returns true if transaction `id` may write into the output buffer
+    bool output_available_to(uint32_t id) const { return !_output_owner || *_output_owner == id; }
+
+    structure::LineBuffer& output_lane(OutputLane lane);
+    const structure::LineBuffer& output_lane(OutputLane lane) const;
+    uint8_t output_lane_weight(OutputLane lane) const;
+
+    /// Returns the lane to push out from next, or nullopt if nothing can be pushed out
+    std::optional<OutputLane> next_output_lane() const;
+
+    /// Returns true if `lane` holds bytes that may be pushed out
+    bool is_pushable(OutputLane lane) const;
+
+    /// With `FlowControl::XonXoff`: take the XONs and XOFFs out of the `length` received `bytes`, pausing or resuming
+    /// the output. Returns the amount of bytes left.
+    size_t take_flow_control(char* bytes, size_t length);
+
+    /// Send an XOFF or XON when the input buffer crossed a watermark
+    void update_flow_control();
+
+    struct InFlight {
+        uint32_t id;
+        size_t length; // of the line, including its delimiter
+        bool finalized;
+    };
+
     Config _cfg;
     structure::LineBuffer _input_buffer;
     structure::LineBuffer _output_buffer;
+    structure::LineBuffer _log_lane;
+    structure::LineBuffer _bulk_lane;
+    std::array<OutputLaneCounters, output_lane_count> _lane_counters{};
+    std::optional<OutputLane> _unfinished_lane; // the lane whose record was partially pushed out
+    bool _is_partial_output_held = false; // see `hold_partial_output`
+    OutputLane _turn = OutputLane::Control; // weighted fair scheduling: the lane whose turn it is
+    uint8_t _turn_records = 0; // records pushed out during the current turn
+
+    structure::RingBuffer<InFlight> _in_flight;
+    size_t _claimed_bytes = 0; // input bytes held by transactions in flight
+    uint32_t _next_transaction_id = 0;
+    std::optional<uint32_t> _output_owner;
 
     std::shared_ptr<Stream> _stream;
+
+    size_t _high_watermark;
+    size_t _low_watermark;
+    InputCounters _input_counters{};
+    bool _is_overrunning = false;
+    bool _peer_paused = false; // we sent an XOFF
+    bool _output_paused = false; // the peer sent an XOFF
+    uint32_t _received = 0; // bytes that entered the input buffer, modulo 2^32
+    uint32_t _announced_credit = 0;
+    bool _is_credit_announced = false;
+    uint32_t _sent = 0; // bytes pushed out, modulo 2^32
+    uint32_t _output_credit = 0;
 };
 
 } // namespace spn::io
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "spine/core/debugging.hpp"
+#include "spine/core/utils/format.hpp"
+#include "spine/core/utils/parse.hpp"
+#include "spine/core/utils/string.hpp"
+#include "spine/io/stream/transaction.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace spn::io {
+
+// Dispatches the incoming line of a `Transaction` to a handler by its first word. The command names are placed in a
+// perfect hash table when the router is constructed (at compile time for a constexpr router), so a lookup costs one
+// hash of the command name and one string compare, regardless of the amount of commands. The line is tokenized in
+// place and the remaining words are parsed into the typed arguments of the handler, which replies through the
+// transaction:
+//
+//     void set_speed(Transaction& t, uint8_t motor, float rpm) { ...; t.reply("ok\n"); }
+//     void get_speed(Transaction& t, uint8_t motor) { t.reply(speed(motor), "\n"); }
+//
+//     constexpr auto router = CommandRouter{Command::of<&set_speed>("speed"), Command::of<&get_speed>("speed?")};
+//     if (auto t = buffered_stream.new_transaction(); t && router.dispatch(*t) != DispatchStatus::Handled) ...
+//
+// Supported argument types: integers, float, bool (1/0, true/false, on/off), std::string_view (the raw word), time
+// units such as k_time_ms (parsed with `utils::parse_duration`) and other units (parsed as a float in the unit's own
+// magnitude).
+
+enum class DispatchStatus : uint8_t {
+    Handled,
+    Empty, // the line holds no command
+    UnknownCommand,
+    InvalidArguments, // too many or too few arguments, or an argument that couldn't be parsed
+};
+
+namespace detail {
+inline constexpr auto command_delimiters = core::utils::CharSet(" \t\r\n");
+
+/// FNV-1a
+constexpr uint32_t command_hash(const std::string_view name) {
+    uint32_t h = 2166136261u;
+    for (const auto c : name) {
+        h ^= static_cast<uint8_t>(c);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/// Slot of a hash for a displacement: murmur3's finalizer over the hash offset by the displacement
+constexpr uint32_t command_slot(uint32_t h, uint32_t displacement) {
+    h += displacement * 0x9E3779B9u;
+    h ^= h >> 16;
+    h *= 0x85EBCA6Bu;
+    h ^= h >> 13;
+    h *= 0xC2B2AE35u;
+    h ^= h >> 16;
+    return h;
+}
+
+// Not constexpr, such that a router that can't be built fails to compile when constructed at compile time
+inline void duplicate_command_name() { spn_assert(!"duplicate command name"); }
+inline void perfect_hash_failed() { spn_assert(!"no perfect hash found for the command names"); }
+
+template<typename T>
+struct is_time_unit : std::false_type {};
+template<typename MT, typename VT>
+struct is_time_unit<spnu::Unit<spnu::TagTime, MT, VT>> : std::true_type {};
+template<typename MT, typename VT>
+struct is_time_unit<spnu::Unit<spnu::TagKernelTime, MT, VT>> : std::true_type {};
+
+template<typename T>
+/// Parse a single word into `value`, returns false when it isn't a valid `T`
+bool parse_argument(const std::string_view word, T& value) {
+    using namespace spn::core::utils;
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        value = word;
+        return true;
+    } else if constexpr (std::is_same_v<T, bool>) {
+        if (word == "1" || word == "true" || word == "on") value = true;
+        else if (word == "0" || word == "false" || word == "off") value = false;
+        else return false;
+        return true;
+    } else if constexpr (std::is_integral_v<T>) {
+        const auto result = parse_integer<T>(word);
+        if (result) value = result.value();
+        return result.is_success();
+    } else if constexpr (std::is_floating_point_v<T>) {
+        const auto result = parse_float(word);
+        if (result) value = static_cast<T>(result.value());
+        return result.is_success();
+    } else if constexpr (is_time_unit<T>::value) {
+        const auto result = parse_duration<T>(word);
+        if (result) value = result.value();
+        return result.is_success();
+    } else {
+        static_assert(spn::core::utils::detail::is_unit<T>::value, "unsupported command argument type");
+        const auto result = parse_float(word);
+        if (result) value = T(static_cast<typename T::ValueType>(result.value()));
+        return result.is_success();
+    }
+}
+
+template<typename Handler>
+struct handler_traits;
+template<typename... Args>
+struct handler_traits<void (*)(Transaction&, Args...)> {
+    using Arguments = std::tuple<std::decay_t<Args>...>;
+};
+
+template<typename Arguments, size_t... Is>
+bool parse_arguments(const std::array<std::string_view, sizeof...(Is)>& words, Arguments& arguments,
+                     std::index_sequence<Is...>) {
+    return (parse_argument(words[Is], std::get<Is>(arguments)) && ...);
+}
+} // namespace detail
+
+/// A command name and the handler it dispatches to
+struct Command {
+    using Invoke = DispatchStatus (*)(Transaction&, std::string_view);
+
+    std::string_view name;
+    Invoke invoke;
+
+    template<auto Handler>
+    /// Command `name` handled by `Handler`, a function taking a `Transaction&` followed by the typed arguments
+    static constexpr Command of(const std::string_view name) {
+        return {name, &invoke_handler<Handler>};
+    }
+
+private:
+    template<auto Handler>
+    static DispatchStatus invoke_handler(Transaction& transaction, std::string_view arguments) {
+        using Arguments = typename detail::handler_traits<decltype(Handler)>::Arguments;
+        constexpr auto count = std::tuple_size_v<Arguments>;
+
+        // split off exactly `count` words, more or fewer is an error
+        std::array<std::string_view, count> words{};
+        size_t found = 0;
+        for (const auto word : core::utils::tokenize(arguments, detail::command_delimiters)) {
+            if (found == count) return DispatchStatus::InvalidArguments;
+            words[found++] = word;
+        }
+        if (found != count) return DispatchStatus::InvalidArguments;
+
+        Arguments parsed{};
+        if (!detail::parse_arguments(words, parsed, std::make_index_sequence<count>{}))
+            return DispatchStatus::InvalidArguments;
+        std::apply([&](const auto&... args) { Handler(transaction, args...); }, parsed);
+        return DispatchStatus::Handled;
+    }
+};
+
+template<size_t N>
+/// Routes incoming lines to one of `N` commands through a perfect hash table of their names (see above)
+class CommandRouter {
+public:
+    static_assert(N > 0 && N < 0xFFFF, "a router holds between 1 and 65534 commands");
+
+    /// Amount of slots (at least twice the amount of commands) and of buckets (about the amount of commands)
+    static constexpr size_t table_size = [] {
+        size_t size = 2;
+        while (size < 2 * N)
+            size *= 2;
+        return size;
+    }();
+    static constexpr size_t bucket_count = table_size / 2;
+
+    template<typename... Commands>
+    constexpr CommandRouter(const Commands&... commands) : _commands{commands...} {
+        build();
+    }
+
+    /// Returns the command called `name` or nullptr
+    constexpr const Command* find(const std::string_view name) const {
+        const auto h = detail::command_hash(name);
+        const auto displacement = _displacements[h & (bucket_count - 1)];
+        const auto index = _slots[detail::command_slot(h, displacement) & (table_size - 1)];
+        if (index == empty_slot || _commands[index].name != name) return nullptr;
+        return &_commands[index];
+    }
+
+    /// Dispatch the incoming line of `transaction` to its command
+    DispatchStatus dispatch(Transaction& transaction) const { return dispatch(transaction, transaction.incoming()); }
+
+    /// Dispatch `line` to its command, replying through `transaction`
+    DispatchStatus dispatch(Transaction& transaction, const std::string_view line) const {
+        const auto trimmed = core::utils::lstrip(line, detail::command_delimiters);
+        if (trimmed.empty()) return DispatchStatus::Empty;
+        const auto end_of_name = core::utils::find_first_of(trimmed, detail::command_delimiters);
+        const auto command = find(trimmed.substr(0, end_of_name));
+        if (command == nullptr) return DispatchStatus::UnknownCommand;
+        const auto arguments = end_of_name == std::string_view::npos ? std::string_view() : trimmed.substr(end_of_name);
+        return command->invoke(transaction, arguments);
+    }
+
+    /// Returns the registered commands
+    constexpr const std::array<Command, N>& commands() const { return _commands; }
+
+private:
+    static constexpr uint16_t empty_slot = 0xFFFF;
+
+    /// Hash and displace: place the keys bucket by bucket (largest bucket first), searching for every bucket a
+    /// displacement that puts all of its keys in free slots
+    constexpr void build() {
+        for (size_t i = 0; i < N; ++i) {
+            for (size_t j = i + 1; j < N; ++j) {
+                if (_commands[i].name == _commands[j].name) return detail::duplicate_command_name();
+            }
+        }
+
+        std::array<uint32_t, N> hashes{};
+        std::array<size_t, bucket_count> bucket_sizes{};
+        for (size_t i = 0; i < N; ++i) {
+            hashes[i] = detail::command_hash(_commands[i].name);
+            ++bucket_sizes[hashes[i] & (bucket_count - 1)];
+        }
+        for (auto& slot : _slots)
+            slot = empty_slot;
+
+        std::array<bool, bucket_count> placed{};
+        for (size_t round = 0; round < bucket_count; ++round) {
+            size_t bucket = 0, largest = 0;
+            for (size_t b = 0; b < bucket_count; ++b) {
+                if (!placed[b] && bucket_sizes[b] > largest) {
+                    bucket = b;
+                    largest = bucket_sizes[b];
+                }
+            }
+            if (largest == 0) break;
+            placed[bucket] = true;
+
+            // with a load factor of 1/2 this takes a handful of attempts
+            uint32_t displacement = 0;
+            while (displacement <= 0xFFFF && !place(hashes, bucket, displacement))
+                ++displacement;
+            if (displacement > 0xFFFF) detail::perfect_hash_failed();
+            _displacements[bucket] = static_cast<uint16_t>(displacement);
+        }
+    }
+
+    /// Try to place all keys of `bucket` with `displacement`, leaving the slots untouched on failure
+    constexpr bool place(const std::array<uint32_t, N>& hashes, size_t bucket, uint32_t displacement) {
+        for (size_t i = 0; i < N; ++i) {
+            if ((hashes[i] & (bucket_count - 1)) != bucket) continue;
+            auto& slot = _slots[detail::command_slot(hashes[i], displacement) & (table_size - 1)];
+            if (slot == empty_slot) {
+                slot = static_cast<uint16_t>(i);
+                continue;
+            }
+            // roll back the keys of this bucket that were placed already
+            for (size_t j = 0; j < i; ++j) {
+                if ((hashes[j] & (bucket_count - 1)) == bucket)
+                    _slots[detail::command_slot(hashes[j], displacement) & (table_size - 1)] = empty_slot;
+            }
+            return false;
+        }
+        return true;
+    }
+
+    std::array<Command, N> _commands;
+    std::array<uint16_t, table_size> _slots{};
+    std::array<uint16_t, bucket_count> _displacements{};
+};
+
+template<typename... Commands>
+CommandRouter(const Commands&...) -> CommandRouter<sizeof...(Commands)>;
+
+} // namespace spn::io
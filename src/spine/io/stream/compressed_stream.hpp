@@ -0,0 +1,262 @@
+#pragma once
+
+#include "spine/io/stream/stream.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+namespace spn::io {
+
+template<uint8_t WindowBits = 8, uint8_t LookaheadBits = 4>
+/// A stream that LZSS compresses what's written into it before it passes it on to the wrapped stream, and decompresses
+/// what's read from the wrapped stream, in the style of heatshrink. Back references reach at most a window of
+/// 2^WindowBits - 1 bytes back and are 2 to 2^LookaheadBits + 1 bytes long. All state is held in place: about twice
+/// the window plus a few dozen bytes, no heap.
+///
+/// The compressed data is a stream of bits, most significant bit first, of tokens:
+/// - `1`, followed by 8 bits: a literal byte
+/// - `0`, followed by WindowBits of distance and LookaheadBits of length - 2: a back reference
+/// - `0`, followed by WindowBits and LookaheadBits of zeroes: a sync, after which the bits up to the next byte are
+///   padding. A sync makes all bytes written before it decodable on the other side, without resetting the window.
+///
+/// The compressor syncs after every sync delimiter, such that a line of telemetry goes out as soon as it's complete,
+/// and at the end of every write by default, such that nothing written is held back for a match: what a
+/// `BufferedStream` writes in between lines (XON/XOFF, credit updates) goes out right away as well. Without
+/// `sync_on_write`, the bytes after the last delimiter of a write are held until the next delimiter or `flush()`.
+class CompressedStream final : public Stream {
+    static_assert(WindowBits >= 4 && WindowBits <= 15 && LookaheadBits >= 2 && LookaheadBits < WindowBits,
+                  "the window must be larger than the longest back reference");
+    static_assert(WindowBits + LookaheadBits <= 24, "a token and a byte of the next must fit 32 bits");
+
+public:
+    struct Config {
+        std::string_view sync_delimiters = "\n"; // bytes after which the compressor syncs
+        bool sync_on_write = true; // sync at the end of every write, off to sync only on delimiters and `flush()`
+    };
+    struct Counters {
+        size_t bytes_in = 0; // uncompressed bytes written
+        size_t bytes_out = 0; // compressed bytes passed on to the wrapped stream
+        size_t syncs = 0;
+    };
+
+    static constexpr size_t window_size = size_t{1} << WindowBits;
+    static constexpr size_t max_match = (size_t{1} << LookaheadBits) + 1;
+
+    explicit CompressedStream(std::shared_ptr<Stream> stream, const Config&& cfg = {})
+        : _cfg(cfg), _stream(std::move(stream)) {}
+
+    void initialize() override {}
+
+    using Stream::read;
+    size_t read(uint8_t* buffer, size_t length) override {
+        size_t n = 0;
+        while (n < length) {
+            decode();
+            if (_unread == 0) break;
+            const auto chunk = std::min(length - n, _unread);
+            for (size_t i = 0; i < chunk; ++i)
+                buffer[n + i] = _rx_window[(_rx_pos - _unread + i) & mask];
+            _unread -= chunk;
+            n += chunk;
+        }
+        return n;
+    }
+    bool read(uint8_t& value) override { return read(&value, 1) == 1; }
+
+    /// Decompressed bytes that can be read right away
+    size_t available() const override {
+        decode();
+        return _unread;
+    }
+
+    /// Bytes that can be written without the compressed output overflowing the wrapped stream, assuming each takes a
+    /// literal (9 bits) and is a sync delimiter, followed by a sync. Short lines may take that much, so it's a lower
+    /// bound for text.
+    size_t available_for_write() const override {
+        const auto room_bits = (sizeof(_out) - _out_size) * 8 - _bit_count + _stream->available_for_write() * 8;
+        const auto reserved_bits = (_pending_size * 9) + sync_bits;
+        const auto byte_bits = 9 + (_cfg.sync_delimiters.empty() ? 0 : sync_bits);
+        return room_bits > reserved_bits ? (room_bits - reserved_bits) / byte_bits : 0;
+    }
+
+    using Stream::write;
+    size_t write(const uint8_t* const buffer, size_t length) override {
+        size_t n = 0;
+        for (; n < length; ++n) {
+            drain();
+            if (out_room_bits() < (_pending_size + 1) * 9 + sync_bits) break;
+            _pending[_pending_size++] = buffer[n];
+            if (_cfg.sync_delimiters.find(static_cast<char>(buffer[n])) != std::string_view::npos) {
+                sync();
+            } else if (_pending_size == max_match) {
+                encode_token();
+            }
+        }
+        if (_cfg.sync_on_write && _pending_size > 0) sync(); // room for it is kept at all times
+        _counters.bytes_in += n;
+        drain();
+        return n;
+    }
+    bool write(const uint8_t value) override { return write(&value, 1) == 1; }
+
+    /// Compress and sync out all bytes written so far, then flush the wrapped stream
+    void flush() override {
+        if (_pending_size > 0) sync();
+        drain();
+        _stream->flush();
+    }
+
+    const Counters& counters() const { return _counters; }
+
+private:
+    static constexpr size_t mask = window_size - 1;
+    static constexpr uint8_t token_bits = 1 + WindowBits + LookaheadBits;
+    static constexpr size_t sync_bits = token_bits + 7; // a sync token and its padding
+
+    // compression
+
+    size_t out_room_bits() const { return (sizeof(_out) - _out_size) * 8 - _bit_count; }
+
+    /// Returns the byte `offset` bytes into the match `distance` bytes back, which may run on into the pending bytes
+    uint8_t match_byte(size_t distance, size_t offset) const {
+        return offset < distance ? _tx_window[(_tx_pos - distance + offset) & mask] : _pending[offset - distance];
+    }
+
+    /// Encode the longest match in the window for the start of the pending bytes, or its first byte as a literal
+    void encode_token() {
+        size_t best_length = 1;
+        size_t best_distance = 0;
+        const auto first = _pending[0];
+        const auto reach = std::min(_history, mask);
+        for (size_t distance = 1; distance <= reach && best_length < _pending_size; ++distance) {
+            if (_tx_window[(_tx_pos - distance) & mask] != first) continue;
+            size_t length = 1;
+            while (length < _pending_size && match_byte(distance, length) == _pending[length])
+                ++length;
+            if (length > best_length) {
+                best_length = length;
+                best_distance = distance;
+            }
+        }
+
+        if (best_length >= 2) {
+            put_bits(0, 1);
+            put_bits(best_distance, WindowBits);
+            put_bits(best_length - 2, LookaheadBits);
+        } else {
+            best_length = 1;
+            put_bits(1, 1);
+            put_bits(first, 8);
+        }
+
+        for (size_t i = 0; i < best_length; ++i)
+            _tx_window[(_tx_pos + i) & mask] = _pending[i];
+        _tx_pos = (_tx_pos + best_length) & mask;
+        _history = std::min(_history + best_length, window_size);
+        _pending_size -= best_length;
+        std::memmove(_pending.data(), _pending.data() + best_length, _pending_size);
+    }
+
+    /// Encode all pending bytes, then a sync token padded up to the next byte
+    void sync() {
+        while (_pending_size > 0)
+            encode_token();
+        put_bits(0, 1);
+        put_bits(0, WindowBits);
+        put_bits(0, LookaheadBits);
+        if (_bit_count > 0) put_bits(0, 8 - _bit_count);
+        ++_counters.syncs;
+    }
+
+    void put_bits(size_t value, uint8_t bits) {
+        _bits = (_bits << bits) | (static_cast<uint32_t>(value) & ((uint32_t{1} << bits) - 1));
+        _bit_count += bits;
+        while (_bit_count >= 8) {
+            _bit_count -= 8;
+            _out[_out_size++] = static_cast<uint8_t>(_bits >> _bit_count);
+        }
+    }
+
+    /// Pass as much of the compressed output on to the wrapped stream as it takes
+    void drain() {
+        if (_out_size == 0) return;
+        const auto n = _stream->write(_out.data(), std::min(_out_size, _stream->available_for_write()));
+        _out_size -= n;
+        std::memmove(_out.data(), _out.data() + n, _out_size);
+        _counters.bytes_out += n;
+    }
+
+    // decompression
+
+    /// Decode tokens from the wrapped stream for as long as their bytes surely fit the window next to the unread bytes
+    void decode() const {
+        while (_unread + max_match <= window_size) {
+            if (!fill_bits(1)) return;
+            const bool literal = (_in_bits >> (_in_count - 1)) & 1;
+            if (!fill_bits(literal ? 9 : token_bits)) return;
+            _in_count -= 1;
+            if (literal) {
+                put_byte(take_bits(8));
+                continue;
+            }
+            const auto distance = take_bits(WindowBits);
+            const auto length = take_bits(LookaheadBits) + 2;
+            if (distance == 0) {
+                _in_count -= _in_count % 8; // sync: drop the padding
+                continue;
+            }
+            for (size_t i = 0; i < length; ++i)
+                put_byte(_rx_window[(_rx_pos - distance) & mask]);
+        }
+    }
+
+    /// Read bytes from the wrapped stream until `bits` bits are buffered. Returns false if it ran dry before.
+    bool fill_bits(uint8_t bits) const {
+        uint8_t value = 0;
+        while (_in_count < bits) {
+            if (!_stream->read(value)) return false;
+            _in_bits = (_in_bits << 8) | value;
+            _in_count += 8;
+        }
+        return true;
+    }
+
+    uint32_t take_bits(uint8_t bits) const {
+        _in_count -= bits;
+        return (_in_bits >> _in_count) & ((uint32_t{1} << bits) - 1);
+    }
+
+    void put_byte(uint8_t value) const {
+        _rx_window[_rx_pos] = value;
+        _rx_pos = (_rx_pos + 1) & mask;
+        ++_unread;
+    }
+
+    Config _cfg;
+    std::shared_ptr<Stream> _stream;
+    Counters _counters;
+
+    // compression: the window of bytes sent, the bytes held back for a match and the compressed output
+    std::array<uint8_t, window_size> _tx_window = {};
+    size_t _tx_pos = 0;
+    size_t _history = 0; // bytes in the window
+    std::array<uint8_t, max_match> _pending = {};
+    size_t _pending_size = 0;
+    uint32_t _bits = 0;
+    uint8_t _bit_count = 0; // bits in `_bits` that aren't in `_out` yet
+    std::array<uint8_t, 2 * max_match + 8> _out = {}; // holds the pending bytes as literals and a sync at all times
+    size_t _out_size = 0;
+
+    // decompression, which happens as bytes are asked for, from `available()` as well
+    mutable std::array<uint8_t, window_size> _rx_window = {};
+    mutable size_t _rx_pos = 0;
+    mutable size_t _unread = 0; // decoded bytes at the end of the window that weren't read yet
+    mutable uint32_t _in_bits = 0;
+    mutable uint8_t _in_count = 0;
+};
+
+} // namespace spn::io
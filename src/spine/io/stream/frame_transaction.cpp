@@ -0,0 +1,138 @@
+#include "spine/io/stream/frame_transaction.hpp"
+
+#include "spine/core/debugging.hpp"
+#include "spine/core/utils/crc.hpp"
+#include "spine/io/stream/framed_stream.hpp"
+
+#include <cstring>
+
+namespace spn::io {
+
+using core::utils::crc16;
+using core::utils::crc16_init;
+using core::utils::crc32;
+
+size_t FrameWriter::write(const char* data, size_t length) {
+    if (length > space_left()) return 0;
+    if (!is_started()) {
+        auto& buffered = _stream->buffered_stream();
+        buffered.hold_partial_output(true); // until the length bytes are patched
+        buffered.buffered_write(uint8_t{1}); // placeholder for the length of the first block
+        _code = buffered.output_buffer_last();
+        _run = 0;
+        _check = _stream->check() == FrameCheck::Crc16 ? crc16_init : 0;
+        _size = 0;
+        _queued = 1;
+    }
+    const auto bytes = reinterpret_cast<const uint8_t*>(data);
+    switch (_stream->check()) {
+    case FrameCheck::Crc16: _check = crc16(bytes, length, static_cast<uint16_t>(_check)); break;
+    case FrameCheck::Crc32: _check = crc32(bytes, length, _check); break;
+    case FrameCheck::None: break;
+    }
+    encode(bytes, length);
+    _size += length;
+    return length;
+}
+
+bool FrameWriter::finish() {
+    if (!is_started()) return false;
+    uint8_t check[4];
+    const auto check_size = _stream->check_size();
+    for (size_t i = 0; i < check_size; ++i)
+        check[i] = static_cast<uint8_t>(_check >> (8 * i)); // little endian
+    encode(check, check_size);
+    *_code = static_cast<char>(_run + 1);
+    _stream->buffered_stream().buffered_write(uint8_t{0});
+    _stream->buffered_stream().hold_partial_output(false);
+    _code = nullptr;
+    _queued = 0;
+    return true;
+}
+
+void FrameWriter::discard() {
+    if (!is_started()) return;
+    _stream->buffered_stream().output_buffer_drop_last(_queued);
+    _stream->buffered_stream().hold_partial_output(false);
+    _code = nullptr;
+    _queued = 0;
+    _size = 0;
+}
+
+size_t FrameWriter::space_left() const {
+    // keep room for a first length byte, the check value (which may start a block) and the delimiter
+    const auto reserved = (is_started() ? 0 : 1) + _stream->check_size() + 1 + 1;
+    const auto free = _stream->buffered_stream().output_buffer_space_left();
+    if (free <= reserved) return 0;
+    // every byte of payload may end up in the output, plus a length byte for every (started) block of 254 bytes
+    const auto available = free - reserved;
+    return available - (available + 254) / 255;
+}
+
+void FrameWriter::encode(const uint8_t* data, size_t length) {
+    auto& buffered = _stream->buffered_stream();
+    while (length > 0) {
+        const auto limit = std::min<size_t>(length, 254 - _run);
+        const auto zero = static_cast<const uint8_t*>(std::memchr(data, 0, limit));
+        const auto run = zero ? static_cast<size_t>(zero - data) : limit;
+        if (run > 0) buffered.buffered_write(reinterpret_cast<const char*>(data), run);
+        _run = static_cast<uint8_t>(_run + run);
+        _queued += run;
+        data += run;
+        length -= run;
+        if (zero) {
+            ++data; // the zero is implied by the block length
+            --length;
+            next_block();
+        } else if (_run == 254) {
+            next_block();
+        }
+    }
+}
+
+void FrameWriter::next_block() {
+    *_code = static_cast<char>(_run + 1);
+    auto& buffered = _stream->buffered_stream();
+    buffered.buffered_write(uint8_t{1});
+    _code = buffered.output_buffer_last();
+    _run = 0;
+    ++_queued;
+}
+
+FrameTransaction::FrameTransaction(FramedStream* stream, size_t frame_length, std::string_view payload)
+    : _stream(stream), _frame_length(frame_length), _incoming(payload), _writer(stream) {
+    spn_assert(_stream);
+    spn_assert(_frame_length > 0); // A transaction shouldn't be started without a frame ready to be read
+}
+const std::string_view& FrameTransaction::incoming() const {
+    spn_assert(!is_finalized());
+    return _incoming;
+}
+size_t FrameTransaction::outgoing(const char* buffer, size_t length) {
+    spn_assert(!is_finalized());
+    if (length == 0) return 0;
+    return _writer.write(buffer, length);
+}
+size_t FrameTransaction::outgoing_space_left() const { return _writer.space_left(); }
+size_t FrameTransaction::outgoing_space_used() const { return _writer.size(); }
+void FrameTransaction::commit() {
+    spn_assert(!is_finalized());
+    _writer.finish();
+    finalize();
+}
+void FrameTransaction::abort() {
+    spn_assert(!is_finalized());
+    _writer.discard();
+    finalize();
+}
+void FrameTransaction::finalize() {
+    spn_assert(!is_finalized());
+    if (!is_finalized()) {
+        _stream->buffered_stream().drop_next_line(_frame_length); // remove the frame from the incoming buffer
+        _incoming = {};
+        _is_finalized = true;
+    }
+}
+bool FrameTransaction::is_finalized() const { return _is_finalized; }
+
+} // namespace spn::io
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace spn::io {
+
+class FramedStream;
+
+/// Writes a single frame into the output buffer of a `FramedStream` piece by piece. The payload is COBS encoded and its
+/// check value computed while it is written, so it's never copied into an intermediate buffer. The length bytes of its
+/// blocks are patched in place, so the output buffer holds the frame back from `push_out_data` until it's finished or
+/// discarded.
+class FrameWriter {
+public:
+    explicit FrameWriter(FramedStream* stream) : _stream(stream) {}
+
+    /// Append `length` bytes of payload, either all of them or none. Returns the amount of bytes written.
+    size_t write(const char* data, size_t length);
+
+    /// Complete the frame with its check value and delimiter. Returns false when nothing was written.
+    bool finish();
+
+    /// Drop everything written for this frame from the output buffer
+    void discard();
+
+    /// Returns the amount of payload bytes that can still be written, such that the frame can always be finished
+    size_t space_left() const;
+
+    /// Returns the amount of payload bytes written
+    size_t size() const { return _size; }
+
+    /// Returns true once anything was written
+    bool is_started() const { return _code != nullptr; }
+
+private:
+    /// Queue encoded bytes without updating the check value
+    void encode(const uint8_t* data, size_t length);
+
+    /// Set the length of the current block and start a new one
+    void next_block();
+
+    FramedStream* _stream;
+    char* _code = nullptr; // the length byte of the current block, patched when the block ends
+    uint8_t _run = 0; // amount of bytes in the current block
+    uint32_t _check = 0;
+    size_t _size = 0;
+    size_t _queued = 0; // encoded bytes in the output buffer
+};
+
+/// A transaction in the form of a request response over frames: the incoming payload is the decoded frame and
+/// everything written to `outgoing` is sent as a single frame on commit.
+class FrameTransaction {
+public:
+    FrameTransaction(const FrameTransaction& other) = delete;
+    FrameTransaction(FrameTransaction&& other) noexcept
+        : _stream(other._stream), _frame_length(other._frame_length), _incoming(other._incoming),
+          _writer(other._writer), _is_finalized(other._is_finalized) {
+        other._stream = nullptr;
+        other._is_finalized = true;
+    }
+    FrameTransaction& operator=(const FrameTransaction& other) = delete;
+    FrameTransaction& operator=(FrameTransaction&& other) noexcept {
+        if (this == &other) return *this;
+        _stream = other._stream;
+        other._stream = nullptr;
+        _frame_length = other._frame_length;
+        _incoming = other._incoming;
+        _writer = other._writer;
+        _is_finalized = other._is_finalized;
+        other._is_finalized = true;
+        return *this;
+    }
+    FrameTransaction(FramedStream* stream, size_t frame_length, std::string_view payload);
+    ~FrameTransaction() {
+        if (!is_finalized()) commit(); // RAII
+    };
+
+    /// Returns the decoded payload of the frame that is the cause of this transaction
+    const std::string_view& incoming() const;
+
+    /// Push payload into the outgoing frame, either entirely or not at all. Returns the amount of bytes queued.
+    size_t outgoing(char value) { return outgoing(&value, 1); }
+    size_t outgoing(const char* buffer, size_t length);
+    size_t outgoing(const std::string_view& view) { return outgoing(view.data(), view.size()); }
+
+    /// Returns the amount of payload that can still be queued for the reply
+    size_t outgoing_space_left() const;
+
+    /// Returns the amount of payload currently queued up to reply
+    size_t outgoing_space_used() const;
+
+    /// Commit the transaction, sending the queued payload as a frame (if any was queued)
+    void commit();
+
+    /// Abort the transaction by dropping the queued frame
+    void abort();
+
+    /// Returns true if transaction was committed or aborted
+    bool is_finalized() const;
+
+private:
+    /// Finalizes this transaction by dropping the incoming frame
+    void finalize();
+
+    FramedStream* _stream;
+    size_t _frame_length; // including the delimiter
+
+    std::string_view _incoming;
+    FrameWriter _writer;
+
+    bool _is_finalized = false;
+};
+
+} // namespace spn::io
@@ -0,0 +1,130 @@
+#include "spine/io/stream/framed_stream.hpp"
+
+#include "spine/core/utils/cobs.hpp"
+#include "spine/core/utils/crc.hpp"
+
+namespace spn::io {
+
+namespace {
+size_t size_of_check(FrameCheck check) {
+    switch (check) {
+    case FrameCheck::Crc16: return 2;
+    case FrameCheck::Crc32: return 4;
+    case FrameCheck::None: return 0;
+    }
+    return 0;
+}
+
+constexpr size_t credit_payload_size = 5; // the tag and a little endian limit
+
+/// The largest credit update on the wire
+constexpr size_t credit_frame_size = core::utils::cobs_max_encoded_size(credit_payload_size + 4) + 1;
+} // namespace
+
+FramedStream::FramedStream(std::shared_ptr<Stream> stream, const FramedStream::Config&& cfg)
+    : FramedStream(std::move(stream), cfg, memory::ScopedTag(memory::Subsystem::IO)) {}
+
+FramedStream::FramedStream(std::shared_ptr<Stream>&& stream, const FramedStream::Config& cfg,
+                           const memory::ScopedTag& tag)
+    : _cfg(cfg),
+      _buffered_stream(std::move(stream), BufferedStream::Config{.input_buffer_size = cfg.input_buffer_size,
+                                                                 .output_buffer_size = cfg.output_buffer_size,
+                                                                 .delimiters = delimiter,
+                                                                 .flow_control = cfg.credit_tag ? FlowControl::Credit
+                                                                                                : FlowControl::None,
+                                                                 // room for the peer's credit updates
+                                                                 .credit_reserve = 2 * credit_frame_size}),
+      _payload(std::max(cfg.max_payload_size, cfg.credit_tag ? credit_payload_size : 0) + size_of_check(cfg.check)) {}
+
+size_t FramedStream::check_size() const { return size_of_check(_cfg.check); }
+
+std::optional<FrameTransaction> FramedStream::new_transaction() {
+    while (true) {
+        const auto length = _buffered_stream.length_of_next_line();
+        if (length == 0) return std::nullopt;
+        if (length > 1) {
+            const auto payload = decode_frame(length);
+            if (payload && !take_credit_update(*payload)) return FrameTransaction(this, length, *payload);
+            if (!payload) ++_dropped_frames;
+        } // else: consecutive delimiters form an empty frame, which is padding rather than corruption
+        _buffered_stream.drop_next_line(length);
+    }
+}
+
+size_t FramedStream::pull_in_data() {
+    const auto bytes_read = _buffered_stream.pull_in_data();
+    while (_cfg.credit_tag) {
+        const auto length = _buffered_stream.length_of_next_line();
+        if (length <= 1) break;
+        const auto payload = decode_frame(length);
+        if (!payload || !take_credit_update(*payload)) break;
+        _buffered_stream.drop_next_line(length);
+    }
+    return bytes_read;
+}
+
+size_t FramedStream::push_out_data() {
+    if (const auto limit = _buffered_stream.credit_update(); limit && _cfg.credit_tag) {
+        // credit updates bypass the output buffer and the peer's credit, else both sides could wait for each other
+        uint8_t payload[credit_payload_size + 4] = {*_cfg.credit_tag};
+        for (size_t i = 0; i < 4; ++i)
+            payload[1 + i] = static_cast<uint8_t>(*limit >> (8 * i));
+        const auto check = _cfg.check == FrameCheck::Crc32 ? core::utils::crc32(payload, credit_payload_size)
+                                                           : core::utils::crc16(payload, credit_payload_size);
+        for (size_t i = 0; i < check_size(); ++i)
+            payload[credit_payload_size + i] = static_cast<uint8_t>(check >> (8 * i));
+
+        uint8_t frame[credit_frame_size];
+        auto frame_size = core::utils::cobs_encode(payload, credit_payload_size + check_size(), frame);
+        frame[frame_size++] = 0;
+        if (_buffered_stream.write_out_of_band({reinterpret_cast<const char*>(frame), frame_size}))
+            _buffered_stream.credit_update_sent(*limit);
+    }
+    return _buffered_stream.push_out_data();
+}
+
+bool FramedStream::take_credit_update(const std::string_view& payload) {
+    if (!_cfg.credit_tag || payload.size() != credit_payload_size || uint8_t(payload[0]) != *_cfg.credit_tag)
+        return false;
+    uint32_t limit = 0;
+    for (size_t i = 0; i < 4; ++i)
+        limit |= uint32_t{static_cast<uint8_t>(payload[1 + i])} << (8 * i);
+    _buffered_stream.grant_output_credit(limit);
+    return true;
+}
+
+bool FramedStream::write_frame(const std::string_view& payload) {
+    auto writer = FrameWriter(this);
+    if (writer.write(payload.data(), payload.size()) != payload.size()) return false;
+    return writer.finish();
+}
+
+std::optional<std::string_view> FramedStream::decode_frame(size_t frame_length) {
+    // decode straight from the ring buffer, whose contents may wrap around
+    auto encoded_length = frame_length - 1; // ignore delimiter
+    const auto spans = _buffered_stream.input_buffer_spans();
+    auto decoder = core::utils::CobsDecoder(_payload.data(), _payload.size());
+    const auto first = std::min(encoded_length, spans.first_size);
+    decoder.feed(reinterpret_cast<const uint8_t*>(spans.first), first);
+    encoded_length -= first;
+    decoder.feed(reinterpret_cast<const uint8_t*>(spans.second), std::min(encoded_length, spans.second_size));
+    if (!decoder.finish() || decoder.size() < check_size()) return std::nullopt;
+
+    const auto payload_size = decoder.size() - check_size();
+    const auto payload = _payload.data();
+    uint32_t expected = 0;
+    for (size_t i = 0; i < check_size(); ++i)
+        expected |= uint32_t{payload[payload_size + i]} << (8 * i); // little endian
+    switch (_cfg.check) {
+    case FrameCheck::Crc16:
+        if (core::utils::crc16(payload, payload_size) != expected) return std::nullopt;
+        break;
+    case FrameCheck::Crc32:
+        if (core::utils::crc32(payload, payload_size) != expected) return std::nullopt;
+        break;
+    case FrameCheck::None: break;
+    }
+    return std::string_view(reinterpret_cast<const char*>(payload), payload_size);
+}
+
+} // namespace spn::io
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "spine/core/memory.hpp"
+#include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/frame_transaction.hpp"
+#include "spine/io/stream/stream.hpp"
+#include "spine/structure/array.hpp"
+
+#include <memory>
+#include <optional>
+#include <string_view>
+
+namespace spn::io {
+
+/// The check value appended to every frame (little endian)
+enum class FrameCheck : uint8_t {
+    None,
+    Crc16, // CRC-16/CCITT-FALSE
+    Crc32, // CRC-32 (ISO-HDLC)
+};
+
+/// A stream of binary frames, the binary counterpart of the lines of a `BufferedStream`. Every frame is its COBS
+/// encoded payload followed by its check value and terminated by a zero byte, such that a payload can hold any byte
+/// and a receiver resynchronizes on the next zero after corruption.
+class FramedStream {
+public:
+    using Transaction = spn::io::FrameTransaction;
+    struct Config {
+        size_t input_buffer_size = 1;
+        size_t output_buffer_size = 1;
+        size_t max_payload_size = 1; // incoming frames are decoded into a buffer of this size
+        FrameCheck check = FrameCheck::Crc16;
+        // enables credit flow control: frames holding this tag followed by a 4 byte credit limit carry credit updates
+        std::optional<uint8_t> credit_tag = std::nullopt;
+    };
+
+    /// The zero byte that terminates every frame
+    static constexpr std::string_view delimiter = std::string_view("\0", 1);
+
+public:
+    explicit FramedStream(std::shared_ptr<Stream> stream, const Config&& cfg);
+
+    /// Returns true if a complete frame was received (it may still turn out to be corrupt)
+    bool has_frame() const { return _buffered_stream.has_line(); }
+
+    /// Decode the next valid frame into a transaction. Corrupt frames (invalid COBS, a check value mismatch or too
+    /// large for `max_payload_size`) are dropped on the way and counted in `dropped_frames()`.
+    std::optional<FrameTransaction> new_transaction();
+
+    /// Queue `payload` as a single frame. Returns false (queueing nothing) when it doesn't fit the output buffer.
+    bool write_frame(const std::string_view& payload);
+
+    /// Populate the input buffer. Returns the amount of bytes read into the buffer. Credit updates at the front of
+    /// the buffer are taken in right away.
+    size_t pull_in_data();
+
+    /// Flush the output buffer, preceded by a credit update when one is due. Returns the amount of bytes written from
+    /// the buffer into the underlying stream.
+    size_t push_out_data();
+
+    /// Amount of received frames that were dropped as corrupt
+    size_t dropped_frames() const { return _dropped_frames; }
+
+    /// Size of the check value of every frame
+    size_t check_size() const;
+
+    FrameCheck check() const { return _cfg.check; }
+
+    /// The byte level buffers underneath, delimited by the zero byte
+    BufferedStream& buffered_stream() { return _buffered_stream; }
+    const BufferedStream& buffered_stream() const { return _buffered_stream; }
+
+private:
+    /// Constructs while `tag` charges all allocations to io
+    FramedStream(std::shared_ptr<Stream>&& stream, const Config& cfg, const memory::ScopedTag& tag);
+
+    /// Decode the next frame of `frame_length` bytes into the payload buffer, returns its payload or nullopt if corrupt
+    std::optional<std::string_view> decode_frame(size_t frame_length);
+
+    /// Takes in `payload` if it's a credit update, returns true if it was
+    bool take_credit_update(const std::string_view& payload);
+
+    Config _cfg;
+    BufferedStream _buffered_stream;
+    structure::Array<uint8_t> _payload;
+    size_t _dropped_frames = 0;
+};
+
+} // namespace spn::io
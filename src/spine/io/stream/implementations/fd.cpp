@@ -0,0 +1,196 @@
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/io/stream/implementations/fd.hpp"
+
+#    include <algorithm>
+#    include <cerrno>
+#    include <cstdlib>
+#    include <cstring>
+#    include <fcntl.h>
+#    include <poll.h>
+#    include <sys/epoll.h>
+#    include <sys/eventfd.h>
+#    include <sys/ioctl.h>
+#    include <sys/uio.h>
+#    include <termios.h>
+#    include <unistd.h>
+
+namespace spn::io {
+
+namespace {
+constexpr size_t max_iovecs = 16; // segments gathered per writev(2)
+constexpr uint64_t wake_marker = UINT64_MAX;
+
+/// Returns true if `fd` polls for `events` within `timeout_ms`
+bool poll_for(int fd, short events, int timeout_ms) {
+    auto pfd = pollfd{fd, events, 0};
+    return ::poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & events);
+}
+} // namespace
+
+FdStream::FdStream(const Config&& cfg) : FdStream(cfg, memory::ScopedTag(memory::Subsystem::IO)) {}
+
+FdStream::FdStream(const Config& cfg, const memory::ScopedTag& tag) : _cfg(cfg), _remainder(cfg.write_window) {}
+
+FdStream::~FdStream() {
+    if (_cfg.close_on_destruction && _cfg.fd >= 0) ::close(_cfg.fd);
+}
+
+void FdStream::initialize() {
+    spn_assert(_cfg.fd >= 0);
+    const auto flags = ::fcntl(_cfg.fd, F_GETFL);
+    spn_assert(flags >= 0);
+    const auto result = ::fcntl(_cfg.fd, F_SETFL, flags | O_NONBLOCK);
+    spn_assert(result == 0);
+}
+
+size_t FdStream::read(uint8_t* buffer, size_t length) {
+    if (length == 0) return 0;
+    const auto n = ::read(_cfg.fd, buffer, length);
+    if (n > 0) return static_cast<size_t>(n);
+    // end of file, or a failed descriptor (a pseudo terminal whose other side closed fails with EIO)
+    if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) _eof = true;
+    return 0;
+}
+
+size_t FdStream::available() const {
+    int n = 0;
+    return ::ioctl(_cfg.fd, FIONREAD, &n) == 0 && n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+size_t FdStream::available_for_write() const { return poll_for(_cfg.fd, POLLOUT, 0) ? _cfg.write_window : 0; }
+
+size_t FdStream::write(const uint8_t* const buffer, size_t length) {
+    if (!write_remainder()) return 0;
+    const auto n = ::write(_cfg.fd, buffer, length);
+    return n > 0 ? static_cast<size_t>(n) : 0;
+}
+
+size_t FdStream::writev(const std::string_view* segments, size_t count) {
+    const auto size = core::utils::total_size(segments, count);
+    if (!write_remainder() || size > available_for_write()) return 0;
+
+    for (size_t first = 0; first < count; first += max_iovecs) {
+        iovec iov[max_iovecs];
+        const auto n_iov = std::min(max_iovecs, count - first);
+        size_t batch = 0;
+        for (size_t i = 0; i < n_iov; ++i) {
+            iov[i] = {const_cast<char*>(segments[first + i].data()), segments[first + i].size()};
+            batch += segments[first + i].size();
+        }
+        const auto n = ::writev(_cfg.fd, iov, static_cast<int>(n_iov));
+        auto written = n > 0 ? static_cast<size_t>(n) : 0;
+        if (written == batch) continue;
+
+        // the descriptor took part of the segments: keep the rest of them to write ahead of the next write
+        for (size_t i = first; i < count; ++i) {
+            const auto skip = std::min(written, segments[i].size());
+            written -= skip;
+            if (skip == segments[i].size()) continue; // an empty segment may well have no data
+            std::memcpy(_remainder.data() + _remainder_size, segments[i].data() + skip, segments[i].size() - skip);
+            _remainder_size += segments[i].size() - skip;
+        }
+        write_remainder();
+        break;
+    }
+    return size;
+}
+
+bool FdStream::write_remainder() {
+    while (_remainder_size > 0) {
+        const auto n = ::write(_cfg.fd, _remainder.data(), _remainder_size);
+        if (n > 0) {
+            _remainder_size -= static_cast<size_t>(n);
+            std::memmove(_remainder.data(), _remainder.data() + n, _remainder_size);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            return false;
+        } else {
+            _remainder_size = 0; // a failed descriptor takes nothing more
+        }
+    }
+    return true;
+}
+
+void FdStream::flush() {
+    while (!write_remainder())
+        poll_for(_cfg.fd, POLLOUT, -1);
+    if (::isatty(_cfg.fd)) ::tcdrain(_cfg.fd);
+}
+
+std::optional<std::pair<int, int>> open_pty_pair() {
+    const auto master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    if (master < 0) return std::nullopt;
+    const char* name = nullptr;
+    if (::grantpt(master) != 0 || ::unlockpt(master) != 0 || (name = ::ptsname(master)) == nullptr) {
+        ::close(master);
+        return std::nullopt;
+    }
+    const auto slave = ::open(name, O_RDWR | O_NOCTTY);
+    if (slave < 0) {
+        ::close(master);
+        return std::nullopt;
+    }
+    termios tio{};
+    ::tcgetattr(slave, &tio);
+    ::cfmakeraw(&tio);
+    ::tcsetattr(slave, TCSANOW, &tio);
+    return std::make_pair(master, slave);
+}
+
+EpollNotifier::EpollNotifier(const EpollNotifier::Config&& cfg)
+    : _cfg(cfg), _epoll_fd(::epoll_create1(EPOLL_CLOEXEC)), _wake_fd(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) {
+    spn_assert(_cfg.event_system);
+    spn_assert(_epoll_fd >= 0 && _wake_fd >= 0);
+    auto event = epoll_event{};
+    event.events = EPOLLIN;
+    event.data.u64 = wake_marker;
+    ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _wake_fd, &event);
+}
+
+EpollNotifier::~EpollNotifier() {
+    ::close(_wake_fd);
+    ::close(_epoll_fd);
+}
+
+bool EpollNotifier::watch_fd(int fd, core::Event::Id id) {
+    spn_assert(fd >= 0 && id <= UINT32_MAX);
+    auto event = epoll_event{};
+    event.events = EPOLLIN;
+    event.data.u64 = static_cast<uint64_t>(id) << 32 | static_cast<uint32_t>(fd);
+    return ::epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &event) == 0;
+}
+
+bool EpollNotifier::unwatch(int fd) { return ::epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, fd, nullptr) == 0; }
+
+size_t EpollNotifier::poll(k_time_ms timeout) {
+    constexpr int max_events = 16;
+    epoll_event events[max_events];
+    const auto n = ::epoll_wait(_epoll_fd, events, max_events, static_cast<int>(timeout.raw()));
+    size_t scheduled = 0;
+    for (int i = 0; i < n; ++i) {
+        if (events[i].data.u64 == wake_marker) {
+            uint64_t value;
+            [[maybe_unused]] const auto r = ::read(_wake_fd, &value, sizeof(value)); // rearm
+            continue;
+        }
+        _cfg.event_system->schedule(static_cast<core::Event::Id>(events[i].data.u64 >> 32), k_time_ms(0)); // next pass
+        ++scheduled;
+        if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+            // level triggered, a hung up descriptor would be reported on every poll from now on
+            unwatch(static_cast<int>(events[i].data.u64 & UINT32_MAX));
+            ++_hangups;
+        }
+    }
+    return scheduled;
+}
+
+void EpollNotifier::wake() {
+    const uint64_t one = 1;
+    [[maybe_unused]] const auto r = ::write(_wake_fd, &one, sizeof(one));
+}
+
+} // namespace spn::io
+
+#endif
@@ -0,0 +1,128 @@
+#pragma once
+
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/core/memory.hpp"
+#    include "spine/eventsystem/eventsystem.hpp"
+#    include "spine/io/stream/stream.hpp"
+#    include "spine/structure/array.hpp"
+
+#    include <climits>
+#    include <cstdint>
+#    include <optional>
+#    include <utility>
+
+namespace spn::io {
+
+/// A stream over a file descriptor, such as a serial port, a pipe or a pseudo terminal. Reads and writes never block:
+/// `available()` is what `FIONREAD` reports, `available_for_write()` is a window of `Config::write_window` bytes when
+/// the descriptor polls writable (and 0 otherwise) and a write that the descriptor doesn't take in full returns a
+/// partial count. Only `flush()` waits.
+class FdStream final : public Stream {
+public:
+    struct Config {
+        int fd = -1;
+        bool close_on_destruction = true;
+        size_t write_window = PIPE_BUF; // bytes a writable descriptor is assumed to take at once
+    };
+
+    explicit FdStream(const Config&& cfg);
+    FdStream(const FdStream&) = delete;
+    FdStream& operator=(const FdStream&) = delete;
+    ~FdStream() override;
+
+    /// Put the descriptor in non-blocking mode
+    void initialize() override;
+
+    using Stream::read;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool read(uint8_t& value) override { return read(&value, 1) == 1; }
+
+    size_t available() const override;
+    size_t available_for_write() const override;
+
+    using Stream::write;
+    size_t write(const uint8_t* const buffer, size_t length) override;
+    bool write(const uint8_t value) override { return write(&value, 1) == 1; }
+
+    /// Gathers the segments into a single writev(2). When the descriptor takes only part of them, the rest is kept
+    /// (at most a write window) to keep the write all or nothing. It's written ahead of the next `write` or `writev`,
+    /// which take nothing else until it's out, or by `flush()`.
+    using Stream::writev;
+    size_t writev(const std::string_view* segments, size_t count) override;
+
+    /// Wait until the rest of a partial `writev` is written and a terminal transmitted all output
+    void flush() override;
+
+    int fd() const { return _cfg.fd; }
+
+    /// Returns true once a read found the other side hung up (end of file) or the descriptor failed, as opposed to
+    /// there being nothing to read yet
+    bool eof() const { return _eof; }
+
+private:
+    /// Constructs while `tag` charges the allocation of the remainder to io
+    FdStream(const Config& cfg, const memory::ScopedTag& tag);
+
+    /// Write as much of the rest of a partial `writev` as the descriptor takes. Returns true once none is left.
+    bool write_remainder();
+
+    Config _cfg;
+    bool _eof = false;
+    structure::Array<uint8_t> _remainder; // the rest of a partial `writev`, a write window
+    size_t _remainder_size = 0;
+};
+
+/// Open a pseudo terminal pair in raw mode, returns the descriptors of its master and slave side or nullopt. What's
+/// written into one side is read from the other, as over a serial line.
+std::optional<std::pair<int, int>> open_pty_pair();
+
+/// Waits on epoll for file descriptors to become readable in between the passes of an `EventSystem`, which wakes it
+/// as soon as input arrives instead of after its delay. Every descriptor is watched with an event id, which is
+/// scheduled to fire in the next pass once it's readable. When the other side hangs up or the descriptor fails, the
+/// event is scheduled a last time and the descriptor is no longer watched: its handler reads what's left until the
+/// stream reports `eof()`.
+class EpollNotifier final : public core::IdleWaiter {
+public:
+    struct Config {
+        core::EventSystem* event_system = nullptr;
+    };
+
+    explicit EpollNotifier(const Config&& cfg);
+    EpollNotifier(const EpollNotifier&) = delete;
+    EpollNotifier& operator=(const EpollNotifier&) = delete;
+    ~EpollNotifier() override;
+
+    template<typename IdType>
+    /// Fire event `id` whenever `fd` is readable. Returns false if epoll doesn't take the descriptor.
+    bool watch(int fd, IdType id) {
+        return watch_fd(fd, static_cast<core::Event::Id>(id));
+    }
+
+    /// Stop watching `fd`
+    bool unwatch(int fd);
+
+    /// Wait up to `timeout` for a watched descriptor to become readable, or for `wake()`. Returns the amount of events
+    /// that were scheduled.
+    size_t poll(k_time_ms timeout);
+
+    void wait(k_time_ms timeout) override { poll(timeout); }
+
+    /// Wake a `poll` in progress, e.g. from another thread
+    void wake();
+
+    /// Returns the amount of descriptors that hung up or failed, and are no longer watched
+    size_t hangups() const { return _hangups; }
+
+private:
+    bool watch_fd(int fd, core::Event::Id id);
+
+    Config _cfg;
+    int _epoll_fd;
+    int _wake_fd;
+    size_t _hangups = 0;
+};
+
+} // namespace spn::io
+
+#endif
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/io/stream/static_stream.hpp"
 #include "spine/io/stream/stream.hpp"
 #include "spine/structure/ringbuffer.hpp"
 
@@ -8,34 +9,37 @@
 
 namespace spn::io {
 
-class MockStream final : public Stream {
+/// A stream over an input and an output ring buffer, which a test feeds and drains. Its calls resolve at compile time,
+/// see `MockStream` for the same behind the virtual `Stream` interface.
+class StaticMockStream final : public StaticStream<StaticMockStream> {
 public:
     struct Config {
         size_t input_buffer_size;
         size_t output_buffer_size;
     };
 
-    MockStream(const Config&& cfg);
-    ~MockStream() override = default;
+    StaticMockStream(const Config&& cfg);
 
 public:
-    void initialize() override {}
+    void initialize() {}
 
+    /// Push `byte_stream` into the input, dropping what doesn't fit
     void inject_bytestream(const std::vector<uint8_t>& byte_stream);
 
+    /// Pop all bytes from the output
     std::optional<std::vector<uint8_t>> extract_bytestream();
 
-    using Stream::write;
-    bool write(const uint8_t value) override { return _active_out->push(value); }
-    size_t write(const uint8_t* const buffer, size_t length) override { return _active_out->push(buffer, length); }
+    using StaticStream::write;
+    bool write(const uint8_t value) { return _active_out->push(value); }
+    size_t write(const uint8_t* const buffer, size_t length) { return _active_out->push(buffer, length); }
 
-    using Stream::read;
-    bool read(uint8_t& value) override { return _active_in->pop(value); }
-    size_t read(uint8_t* buffer, size_t length) override { return _active_in->pop(buffer, length); }
+    using StaticStream::read;
+    bool read(uint8_t& value) { return _active_in->pop(value); }
+    size_t read(uint8_t* buffer, size_t length) { return _active_in->pop(buffer, length); }
 
-    size_t available() const override { return _active_in->used_space(); }
-    size_t available_for_write() const override { return _active_out->free_space(); }
-    void flush() override {}
+    size_t available() const { return _active_in->used_space(); }
+    size_t available_for_write() const { return _active_out->free_space(); }
+    void flush() {}
 
 protected:
     void swap_streams();
@@ -49,4 +53,16 @@ private:
     structure::RingBuffer<uint8_t>* _active_in;
     structure::RingBuffer<uint8_t>* _active_out;
 };
+
+/// A `StaticMockStream` behind the virtual `Stream` interface
+class MockStream final : public StreamAdapter<StaticMockStream> {
+public:
+    using Config = StaticMockStream::Config;
+
+    MockStream(const Config&& cfg) : StreamAdapter(std::move(cfg)) {}
+
+    void inject_bytestream(const std::vector<uint8_t>& byte_stream) { stream().inject_bytestream(byte_stream); }
+    std::optional<std::vector<uint8_t>> extract_bytestream() { return stream().extract_bytestream(); }
+};
+
 } // namespace spn::io
@@ -0,0 +1,190 @@
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/io/stream/implementations/shared_memory.hpp"
+
+#    include <algorithm>
+#    include <atomic>
+#    include <chrono>
+#    include <climits>
+#    include <cstring>
+#    include <ctime>
+#    include <fcntl.h>
+#    include <linux/futex.h>
+#    include <new>
+#    include <sched.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <sys/syscall.h>
+#    include <unistd.h>
+
+namespace spn::io {
+
+namespace detail {
+
+/// One direction: the writer owns `head`, the reader owns `tail` and `waiting`. Both count bytes since the start and
+/// wrap around, the ring holds `head - tail` bytes.
+struct SharedMemoryRing {
+    alignas(64) std::atomic<uint32_t> head; // also the futex word a waiting reader sleeps on
+    alignas(64) std::atomic<uint32_t> tail;
+    std::atomic<uint32_t> waiting; // the reader is about to sleep on, or sleeps on, the doorbell
+};
+
+/// Start of the file, the data of both rings follows it
+struct SharedMemoryLayout {
+    std::atomic<uint32_t> magic; // written last by the primary side
+    uint32_t capacity;
+    SharedMemoryRing rings[2];
+};
+
+static_assert(std::atomic<uint32_t>::is_always_lock_free && sizeof(std::atomic<uint32_t>) == sizeof(uint32_t),
+              "the rings are shared between processes and the head doubles as a futex word");
+
+} // namespace detail
+
+namespace {
+constexpr uint32_t magic = 0x53504e31; // "SPN1"
+
+long futex(std::atomic<uint32_t>& word, int op, uint32_t value, const timespec* timeout = nullptr) {
+    return ::syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), op, value, timeout, nullptr, 0);
+}
+} // namespace
+
+SharedMemoryStream::~SharedMemoryStream() {
+    if (_layout) ::munmap(_layout, _mapped_size);
+    if (_layout && _cfg.side == Side::Primary) ::unlink(_cfg.path);
+}
+
+void SharedMemoryStream::initialize() {
+    spn_assert(_cfg.path);
+    spn_assert(!_layout);
+    const bool primary = _cfg.side == Side::Primary;
+    const auto fd = primary ? ::open(_cfg.path, O_RDWR | O_CREAT | O_TRUNC, 0600) : ::open(_cfg.path, O_RDWR);
+    if (fd < 0) return;
+
+    if (primary) {
+        spn_assert(_cfg.capacity > 0 && (_cfg.capacity & (_cfg.capacity - 1)) == 0 && _cfg.capacity <= INT32_MAX);
+        _mapped_size = sizeof(detail::SharedMemoryLayout) + 2 * _cfg.capacity;
+        if (::ftruncate(fd, static_cast<off_t>(_mapped_size)) != 0) {
+            ::close(fd);
+            return;
+        }
+    } else {
+        struct stat st {};
+        if (::fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(detail::SharedMemoryLayout)) {
+            ::close(fd);
+            return;
+        }
+        _mapped_size = static_cast<size_t>(st.st_size);
+    }
+
+    auto* const mapping = ::mmap(nullptr, _mapped_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd); // the mapping keeps the file open
+    if (mapping == MAP_FAILED) return;
+
+    if (primary) {
+        auto* const layout = new (mapping) detail::SharedMemoryLayout{}; // the file is zero-filled already
+        layout->capacity = static_cast<uint32_t>(_cfg.capacity);
+        layout->magic.store(magic, std::memory_order_release);
+    } else {
+        const auto* const layout = static_cast<const detail::SharedMemoryLayout*>(mapping);
+        if (layout->magic.load(std::memory_order_acquire) != magic
+            || _mapped_size != sizeof(detail::SharedMemoryLayout) + 2 * size_t{layout->capacity}) {
+            ::munmap(mapping, _mapped_size);
+            return;
+        }
+    }
+
+    _layout = static_cast<detail::SharedMemoryLayout*>(mapping);
+    _capacity = _layout->capacity;
+    auto* const data = reinterpret_cast<uint8_t*>(_layout + 1);
+    const size_t tx_index = primary ? 0 : 1;
+    _tx = &_layout->rings[tx_index];
+    _rx = &_layout->rings[1 - tx_index];
+    _tx_data = data + tx_index * _capacity;
+    _rx_data = data + (1 - tx_index) * _capacity;
+}
+
+size_t SharedMemoryStream::read(uint8_t* buffer, size_t length) {
+    if (!is_open()) return 0;
+    const auto tail = _rx->tail.load(std::memory_order_relaxed);
+    const auto n = std::min<size_t>(length, _rx->head.load(std::memory_order_acquire) - tail);
+    const auto offset = tail & (_capacity - 1);
+    const auto first = std::min(n, _capacity - offset);
+    std::memcpy(buffer, _rx_data + offset, first);
+    std::memcpy(buffer + first, _rx_data, n - first);
+    _rx->tail.store(tail + static_cast<uint32_t>(n), std::memory_order_release);
+    return n;
+}
+
+size_t SharedMemoryStream::available() const {
+    if (!is_open()) return 0;
+    return _rx->head.load(std::memory_order_acquire) - _rx->tail.load(std::memory_order_relaxed);
+}
+
+size_t SharedMemoryStream::available_for_write() const {
+    if (!is_open()) return 0;
+    return _capacity - (_tx->head.load(std::memory_order_relaxed) - _tx->tail.load(std::memory_order_acquire));
+}
+
+size_t SharedMemoryStream::write(const uint8_t* const buffer, size_t length) {
+    if (!is_open()) return 0;
+    const auto n = std::min(length, available_for_write());
+    stage(buffer, n, 0);
+    publish(n);
+    return n;
+}
+
+size_t SharedMemoryStream::writev(const std::string_view* segments, size_t count) {
+    if (!is_open()) return 0;
+    const auto size = core::utils::total_size(segments, count);
+    if (size > available_for_write()) return 0;
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        stage(reinterpret_cast<const uint8_t*>(segments[i].data()), segments[i].size(), offset);
+        offset += segments[i].size();
+    }
+    publish(size);
+    return size;
+}
+
+void SharedMemoryStream::stage(const uint8_t* buffer, size_t length, size_t offset) {
+    if (length == 0) return; // an empty segment may well have no data
+    const auto start = (_tx->head.load(std::memory_order_relaxed) + offset) & (_capacity - 1);
+    const auto first = std::min(length, _capacity - start);
+    std::memcpy(_tx_data + start, buffer, first);
+    std::memcpy(_tx_data, buffer + first, length - first);
+}
+
+void SharedMemoryStream::publish(size_t length) {
+    if (length == 0) return;
+    // sequentially consistent against the reader, which raises `waiting` before it checks the head
+    _tx->head.fetch_add(static_cast<uint32_t>(length), std::memory_order_seq_cst);
+    if (_cfg.doorbell && _tx->waiting.load(std::memory_order_seq_cst)) futex(_tx->head, FUTEX_WAKE, INT_MAX);
+}
+
+bool SharedMemoryStream::wait_for_input(k_time_ms timeout) {
+    if (!is_open()) return false;
+    using namespace std::chrono;
+    const auto deadline = steady_clock::now() + milliseconds(timeout.raw());
+    while (available() == 0) {
+        const auto remaining = deadline - steady_clock::now();
+        if (remaining <= steady_clock::duration::zero()) return false;
+        if (!_cfg.doorbell) {
+            ::sched_yield();
+            continue;
+        }
+        _rx->waiting.store(1, std::memory_order_seq_cst);
+        const auto head = _rx->head.load(std::memory_order_seq_cst);
+        if (head == _rx->tail.load(std::memory_order_relaxed)) {
+            const auto ns = duration_cast<nanoseconds>(remaining).count();
+            const auto ts = timespec{static_cast<time_t>(ns / 1000000000), static_cast<long>(ns % 1000000000)};
+            futex(_rx->head, FUTEX_WAIT, head, &ts); // returns right away if the head moved on since
+        }
+        _rx->waiting.store(0, std::memory_order_relaxed);
+    }
+    return true;
+}
+
+} // namespace spn::io
+
+#endif
@@ -0,0 +1,88 @@
+#pragma once
+
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/io/stream/stream.hpp"
+#    include "spine/structure/units/time.hpp"
+
+#    include <cstdint>
+
+namespace spn::io {
+
+namespace detail {
+struct SharedMemoryLayout;
+struct SharedMemoryRing;
+} // namespace detail
+
+/// A stream between two native processes over a memory mapped file, which holds a lock-free single producer, single
+/// consumer byte ring for either direction. Bytes are copied into and out of the mapping only, no syscall is made to
+/// move them. Optionally, a writer rings a futex doorbell in the mapping to wake a reader blocked in `wait_for_input`.
+///
+/// The primary side creates (and on destruction removes) the file, the secondary side maps the file the primary
+/// created. The primary writes into the first ring and reads from the second, the secondary the other way around.
+class SharedMemoryStream final : public Stream {
+public:
+    enum class Side { Primary, Secondary };
+
+    struct Config {
+        const char* path = nullptr; // e.g. a file in /dev/shm
+        Side side = Side::Primary;
+        size_t capacity = 4096; // bytes per ring, a power of two; taken from the file by the secondary side
+        bool doorbell = true; // wake a reader waiting on the futex after a write, or let it spin
+    };
+
+    explicit SharedMemoryStream(const Config&& cfg) : _cfg(cfg) {}
+    SharedMemoryStream(const SharedMemoryStream&) = delete;
+    SharedMemoryStream& operator=(const SharedMemoryStream&) = delete;
+    ~SharedMemoryStream() override;
+
+    /// Create or map the file. When that fails (e.g. the secondary side finds no file, or one that isn't a mapping of
+    /// the primary side), the stream stays closed: it reads, writes and waits for nothing.
+    void initialize() override;
+
+    /// Returns true once the file is mapped
+    bool is_open() const { return _layout != nullptr; }
+
+    using Stream::read;
+    size_t read(uint8_t* buffer, size_t length) override;
+    bool read(uint8_t& value) override { return read(&value, 1) == 1; }
+
+    size_t available() const override;
+    size_t available_for_write() const override;
+
+    using Stream::write;
+    size_t write(const uint8_t* const buffer, size_t length) override;
+    bool write(const uint8_t value) override { return write(&value, 1) == 1; }
+
+    /// Copies all segments into the ring and publishes them at once, with a single ring of the doorbell
+    using Stream::writev;
+    size_t writev(const std::string_view* segments, size_t count) override;
+
+    /// Nothing to flush, written bytes are visible to the other side right away
+    void flush() override {}
+
+    /// Block up to `timeout` until there's something to read, on the doorbell or spinning without it. Returns true if
+    /// there is.
+    bool wait_for_input(k_time_ms timeout);
+
+    size_t capacity() const { return _capacity; }
+
+private:
+    /// Copy `length` bytes into the outgoing ring at `offset` past its head, without publishing them
+    void stage(const uint8_t* buffer, size_t length, size_t offset);
+    /// Make `length` staged bytes visible to the reader
+    void publish(size_t length);
+
+    Config _cfg;
+    detail::SharedMemoryLayout* _layout = nullptr;
+    size_t _mapped_size = 0;
+    size_t _capacity = 0;
+    detail::SharedMemoryRing* _rx = nullptr;
+    detail::SharedMemoryRing* _tx = nullptr;
+    uint8_t* _rx_data = nullptr;
+    uint8_t* _tx_data = nullptr;
+};
+
+} // namespace spn::io
+
+#endif
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "spine/io/stream/stream.hpp"
+#include "spine/structure/ringbuffer.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace spn::io {
+
+namespace detail {
+template<typename T, typename = void>
+struct is_stream : std::false_type {};
+
+template<typename T>
+struct is_stream<T, std::void_t<decltype(std::declval<T&>().read(std::declval<uint8_t&>())),
+                                decltype(std::declval<T&>().read(std::declval<uint8_t*>(), size_t{})),
+                                decltype(std::declval<T&>().write(uint8_t{})),
+                                decltype(std::declval<T&>().write(std::declval<const uint8_t*>(), size_t{})),
+                                decltype(std::declval<const T&>().available()),
+                                decltype(std::declval<const T&>().available_for_write())>> : std::true_type {};
+} // namespace detail
+
+/// True if `T` can be used as a stream: it reads and writes single bytes and spans of bytes and tells how many bytes
+/// are available to read and to write. Both `Stream` and the implementations of `StaticStream` are streams.
+template<typename T>
+constexpr bool is_stream_v = detail::is_stream<T>::value;
+
+template<typename StreamImp>
+/// CRTP base of a stream whose calls are resolved at compile time, such that code templated over the stream type
+/// inlines them. `StreamImp` implements `initialize`, `read` and `write` (of a byte and of a span), `available`,
+/// `available_for_write` and `flush`, and brings the convenience overloads below into scope with `using`. Wrap it in a
+/// `StreamAdapter` where a `Stream` is expected.
+class StaticStream {
+public:
+    size_t read(char* const buffer, size_t length) { return self().read(reinterpret_cast<uint8_t*>(buffer), length); }
+
+    size_t write(const std::string_view& view) { return write(view.data(), view.size()); }
+    size_t write(const char* const buffer, size_t length) {
+        return self().write(reinterpret_cast<const uint8_t*>(buffer), length);
+    }
+    bool write(const char value) { return self().write(static_cast<uint8_t>(value)); }
+
+    /// Write all `count` segments or none of them, see `Stream::writev`
+    size_t writev(const std::string_view* segments, size_t count) {
+        return detail::write_segments(self(), segments, count);
+    }
+    size_t writev(std::initializer_list<std::string_view> segments) {
+        return writev(segments.begin(), segments.size());
+    }
+
+protected:
+    StreamImp& self() { return static_cast<StreamImp&>(*this); }
+};
+
+template<typename StreamImp>
+/// Adapts a static stream to the virtual `Stream` interface, for code that picks its stream at runtime (such as
+/// `BufferedStream`). Every call costs an indirect call into the static stream, which is inlined behind it.
+class StreamAdapter : public Stream {
+public:
+    template<typename... Args>
+    explicit StreamAdapter(Args&&... args) : _stream(std::forward<Args>(args)...) {}
+
+    void initialize() final { _stream.initialize(); }
+
+    using Stream::read;
+    size_t read(uint8_t* buffer, size_t length) final { return _stream.read(buffer, length); }
+    bool read(uint8_t& value) final { return _stream.read(value); }
+
+    size_t available() const final { return _stream.available(); }
+    size_t available_for_write() const final { return _stream.available_for_write(); }
+
+    using Stream::write;
+    size_t write(const uint8_t* const buffer, size_t length) final { return _stream.write(buffer, length); }
+    bool write(const uint8_t value) final { return _stream.write(value); }
+
+    using Stream::writev;
+    size_t writev(const std::string_view* segments, size_t count) final { return _stream.writev(segments, count); }
+
+    void flush() final { _stream.flush(); }
+
+    /// Returns the adapted stream, whose calls resolve at compile time
+    StreamImp& stream() { return _stream; }
+    const StreamImp& stream() const { return _stream; }
+
+private:
+    StreamImp _stream;
+};
+
+template<typename StreamT, typename T>
+/// Read what `stream` has available into the free space of `buffer`, straight into the ring with at most two reads.
+/// Returns the amount of elements read.
+size_t pull_into(structure::RingBuffer<T>& buffer, StreamT& stream) {
+    static_assert(is_stream_v<StreamT> && sizeof(T) == 1, "pulls bytes from a stream");
+    const auto spans = buffer.free_spans();
+    size_t total = 0;
+    const auto read = [&](T* span, size_t size) {
+        const auto length = std::min(size, stream.available());
+        const auto n = length > 0 ? stream.read(reinterpret_cast<uint8_t*>(span), length) : 0;
+        buffer.commit(n);
+        total += n;
+        return n == size;
+    };
+    if (read(spans.first, spans.first_size)) read(spans.second, spans.second_size);
+    return total;
+}
+
+template<typename StreamT, typename T>
+/// Write the elements of `buffer` into `stream`, as far as it takes them, straight from the ring with at most two
+/// writes. Returns the amount of elements written.
+size_t push_from(structure::RingBuffer<T>& buffer, StreamT& stream, size_t max_length = SIZE_MAX) {
+    static_assert(is_stream_v<StreamT> && sizeof(T) == 1, "pushes bytes into a stream");
+    const auto spans = buffer.used_spans();
+    size_t total = 0;
+    const auto write = [&](const T* span, size_t size) {
+        const auto length = std::min({size, max_length - total, stream.available_for_write()});
+        const auto n = length > 0 ? stream.write(reinterpret_cast<const uint8_t*>(span), length) : 0;
+        total += n;
+        return n == size;
+    };
+    if (write(spans.first, spans.first_size)) write(spans.second, spans.second_size);
+    buffer.drop_first(total);
+    return total;
+}
+
+} // namespace spn::io
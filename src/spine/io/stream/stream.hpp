@@ -1,13 +1,30 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/utils/string.hpp"
 #include "spine/structure/linebuffer.hpp"
 
+#include <cstdint>
+#include <initializer_list>
 #include <memory>
 #include <optional>
+#include <string_view>
 
 namespace spn::io {
 
+namespace detail {
+template<typename StreamType>
+/// Write all `count` segments to `stream` one after the other or, when they don't fit its `available_for_write()` at
+/// once, none of them. Returns the amount of bytes written. Backs both `Stream::writev` and `StaticStream::writev`.
+size_t write_segments(StreamType& stream, const std::string_view* segments, size_t count) {
+    if (core::utils::total_size(segments, count) > stream.available_for_write()) return 0;
+    size_t bytes_written = 0;
+    for (size_t i = 0; i < count; ++i)
+        bytes_written += stream.write(reinterpret_cast<const uint8_t*>(segments[i].data()), segments[i].size());
+    return bytes_written;
+}
+} // namespace detail
+
 /// A basic stream
 class Stream {
 public:
@@ -46,6 +63,15 @@ public:
         return false;
     };
 
+    /// Write all `count` segments one after the other or, when they don't fit `available_for_write()` at once, none of
+    /// them. Returns the amount of bytes written. Streams that can gather the segments into a single write override it.
+    virtual size_t writev(const std::string_view* segments, size_t count) {
+        return detail::write_segments(*this, segments, count);
+    }
+    size_t writev(std::initializer_list<std::string_view> segments) {
+        return writev(segments.begin(), segments.size());
+    }
+
     virtual void flush() { spn_assert(!"Virtual base function called"); }
 };
 
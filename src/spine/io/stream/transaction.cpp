@@ -3,36 +3,43 @@
 #include "spine/io/stream/buffered_stream.hpp"
 
 namespace spn::io {
-Transaction::Transaction(BufferedStream* stream, std::optional<size_t> discovered_length) : _stream(stream) {
+Transaction::Transaction(BufferedStream* stream, uint32_t id, std::string_view incoming_line)
+    : _stream(stream), _id(id), _incoming_line(incoming_line) {
     spn_assert(_stream);
-    const auto length = discovered_length ? *discovered_length : _stream->length_of_next_line();
-    spn_assert(length > 0); // A transaction shouldn't be started without a line ready to be read
-    const auto next_line_view = _stream->get_next_line_view(length);
-    spn_assert(next_line_view); // catch this because it could get nasty if left unhandled
-    if (next_line_view) _incoming_line = *next_line_view;
 }
 const std::string_view& Transaction::incoming() const {
     spn_assert(!is_finalized());
     return _incoming_line;
 }
-size_t Transaction::outgoing(char value) {
+size_t Transaction::outgoing(const char* buffer, size_t length) {
     spn_assert(!is_finalized());
-    spn_assert(outgoing_space_left() > 0);
-    if (outgoing_space_left() == 0) return 0;
-    const auto bytes_written = _stream->buffered_write(value);
+    _would_block = !_stream->acquire_output(_id);
+    if (_would_block) return 0;
+
+    size_t bytes_written = 0;
+    while (true) {
+        bytes_written += _stream->buffered_write(buffer + bytes_written, length - bytes_written);
+        if (bytes_written == length) break;
+        if (_stream->push_out_data() == 0) { // make room by pushing out the queue
+            _would_block = true;
+            break;
+        }
+    }
     _outgoing_queued_bytes += bytes_written;
     return bytes_written;
 }
-size_t Transaction::outgoing(const char* buffer, size_t length) {
+
+size_t Transaction::outgoingv(const std::string_view* segments, size_t count) {
     spn_assert(!is_finalized());
-    spn_assert(outgoing_space_left() > length); // todo: instead make it optional to flush out bytes in between
-    length = std::min(outgoing_space_left(), length);
-    size_t bytes_written = _stream->buffered_write(buffer, length);
+    if (!reserve(core::utils::total_size(segments, count))) return 0;
+    const auto bytes_written = _stream->buffered_writev(segments, count);
     _outgoing_queued_bytes += bytes_written;
     return bytes_written;
 }
 
-size_t Transaction::outgoing_space_left() const { return _stream->output_buffer_space_left(); }
+size_t Transaction::outgoing_space_left() const {
+    return _stream->output_available_to(_id) ? _stream->output_buffer_space_left() : 0;
+}
 size_t Transaction::outgoing_space_used() const { return _outgoing_queued_bytes; }
 void Transaction::commit() {
     spn_assert(!is_finalized());
@@ -47,7 +54,7 @@ void Transaction::abort() {
 void Transaction::finalize() {
     spn_assert(!is_finalized());
     if (!is_finalized()) {
-        _stream->drop_next_line(); // remove the line from the incoming buffer
+        _stream->finish_transaction(_id); // release the line from the incoming buffer
         _incoming_line = {};
         _outgoing_queued_bytes = 0;
         _is_finalized = true;
@@ -55,8 +62,18 @@ void Transaction::finalize() {
 }
 bool Transaction::is_finalized() const { return _is_finalized; }
 void Transaction::undo(size_t n_bytes) const {
-    n_bytes = n_bytes > 0 ? std::min(n_bytes, _outgoing_queued_bytes) : _outgoing_queued_bytes;
+    // queued bytes are the last in the output buffer, up to those that were pushed out already
+    const auto buffered = std::min(_outgoing_queued_bytes, _stream->output_buffer_space_used());
+    n_bytes = n_bytes > 0 ? std::min(n_bytes, buffered) : buffered;
     _stream->output_buffer_drop_last(n_bytes);
 }
+bool Transaction::reserve(size_t length) {
+    _would_block = false;
+    if (length > _stream->output_buffer_capacity()) return false;
+    _would_block = !_stream->acquire_output(_id);
+    while (!_would_block && _stream->output_buffer_space_left() < length)
+        _would_block = _stream->push_out_data() == 0;
+    return !_would_block;
+}
 
 } // namespace spn::io
@@ -1,5 +1,10 @@
 #pragma once
 
+#include "spine/core/utils/format.hpp"
+#include "spine/structure/static_string.hpp"
+
+#include <cstdint>
+#include <initializer_list>
 #include <optional>
 #include <string_view>
 
@@ -7,41 +12,78 @@ namespace spn::io {
 
 class BufferedStream;
 
-/// A transaction in the form of a request response
+/// A transaction in the form of a request response. Several transactions can be in flight at once (see
+/// `BufferedStream::new_transaction`); the first one to write holds the output until it's finalized, so replies never
+/// interleave.
 class Transaction {
 public:
     Transaction(const Transaction& other) = delete;
     Transaction(Transaction&& other) noexcept
-        : _stream(other._stream), _incoming_line(std::move(other._incoming_line)),
-          _outgoing_queued_bytes(other._outgoing_queued_bytes), _is_finalized(other._is_finalized) {
+        : _stream(other._stream), _id(other._id), _incoming_line(std::move(other._incoming_line)),
+          _outgoing_queued_bytes(other._outgoing_queued_bytes), _would_block(other._would_block),
+          _is_finalized(other._is_finalized) {
         other._stream = nullptr;
         other._is_finalized = true;
     }
     Transaction& operator=(const Transaction& other) = delete;
     Transaction& operator=(Transaction&& other) noexcept {
         if (this == &other) return *this;
+        if (!is_finalized()) finalize();
         _stream = other._stream;
         other._stream = nullptr;
+        _id = other._id;
         _incoming_line = std::move(other._incoming_line);
         _outgoing_queued_bytes = other._outgoing_queued_bytes;
+        _would_block = other._would_block;
         _is_finalized = other._is_finalized;
         other._is_finalized = true;
         return *this;
     }
-    explicit Transaction(BufferedStream* stream, std::optional<size_t> discovered_length = {});
+    Transaction(BufferedStream* stream, uint32_t id, std::string_view incoming_line);
     ~Transaction() {
         if (!is_finalized()) finalize(); // RAII
     };
 
-    /// Returns a string_view of the next incoming line in the buffer that is the cause of this transaction
+    /// Returns a string_view of the incoming line in the buffer that is the cause of this transaction
     const std::string_view& incoming() const;
 
-    /// Push a byte in the outgoing queue
-    size_t outgoing(char value);
+    /// Returns the correlation id of this transaction: the sequence number of its line, counting from the first line
+    /// the stream handed out. Pipelined replies can carry it to be matched with their request.
+    uint32_t id() const { return _id; }
+
+    /// Push bytes into the outgoing queue. When the queue is full it's pushed out into the stream to make room, so a
+    /// reply can be larger than the output buffer. Returns the amount of bytes queued, which is less than `length`
+    /// (see `would_block()`) when the stream takes no more or another transaction holds the output.
+    size_t outgoing(char value) { return outgoing(&value, 1); }
     size_t outgoing(const char* buffer, size_t length);
     size_t outgoing(const std::string_view& view) { return outgoing(view.data(), view.size()); }
 
-    /// Returns the amount of space left for a reply
+    /// Queue all `count` segments as a whole, pushing out the outgoing queue to make room if needed. Nothing is queued
+    /// when they don't fit the outgoing buffer at all or when it would block. Returns the amount of bytes queued.
+    size_t outgoingv(const std::string_view* segments, size_t count);
+    size_t outgoingv(std::initializer_list<std::string_view> segments) {
+        return outgoingv(segments.begin(), segments.size());
+    }
+
+    template<size_t N = 64, typename... Args>
+    /// Format `args` (see `utils::format_to`) into a StaticString of at most `N` chars and queue it as a whole, pushing
+    /// out the outgoing queue to make room if needed. Nothing is queued when the reply is longer than `N` chars,
+    /// doesn't fit the outgoing buffer at all or when it would block. Returns the amount of bytes queued.
+    size_t reply(const Args&... args) {
+        auto length = spn::core::utils::LengthCounter();
+        spn::core::utils::format_to(length, args...);
+        if (length.size() > N) return 0; // a truncated reply would be a partial record
+        auto msg = spn::structure::StaticString<N>();
+        msg.format(args...);
+        if (!reserve(msg.size())) return 0;
+        return outgoing(msg);
+    }
+
+    /// Returns true when the last call to `outgoing` or `reply` couldn't queue all of its bytes because the stream
+    /// takes no more or another transaction holds the output. Retry the remainder after `push_out_data`.
+    bool would_block() const { return _would_block; }
+
+    /// Returns the amount of space left for a reply without pushing out the outgoing queue
     size_t outgoing_space_left() const;
 
     /// Returns the amount of space currently queued up to reply
@@ -50,25 +92,32 @@ public:
     /// Commit the transaction
     void commit();
 
-    /// Abort the transaction by dropping queued outgoing bytes
+    /// Abort the transaction by dropping queued outgoing bytes that weren't pushed out yet
     void abort();
 
     /// Returns true if transaction was committed or aborted
     bool is_finalized() const;
 
 protected:
-    /// Finalizes this transaction by dropping the incoming line and comitting all queued bytes
+    /// Finalizes this transaction by releasing the incoming line and the output, comitting all queued bytes
     void finalize();
 
-    /// Undo the last `n_bytes` queued up for a reply or all queued bytes if 'n_bytes' is left at 0
+    /// Undo the last `n_bytes` queued up for a reply or all queued bytes if 'n_bytes' is left at 0. Bytes that were
+    /// pushed out already can't be undone.
     void undo(size_t n_bytes = 0) const;
 
+    /// Make room for `length` outgoing bytes, pushing out the outgoing queue if needed. Returns false if that's not
+    /// possible now (see `would_block()`) or ever.
+    bool reserve(size_t length);
+
 private:
     BufferedStream* _stream;
+    uint32_t _id;
 
     std::string_view _incoming_line;
     size_t _outgoing_queued_bytes{0};
 
+    bool _would_block = false;
     bool _is_finalized = false;
 };
 
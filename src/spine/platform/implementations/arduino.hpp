@@ -229,7 +229,7 @@ private:
 #    define UART_T ::HardwareSerial
 #endif
 
-class ArduinoUART : public UART<ArduinoUART> {
+class ArduinoUART final : public UART<ArduinoUART> {
 public:
     struct Config {
         ::Stream* stream; // Arduino HardwareSerial stream, typically 'Serial'
@@ -146,7 +146,7 @@ public:
     virtual size_t write(const uint8_t* buffer, size_t size) = 0;
 };
 
-class MockUART : public UART<MockUART> {
+class MockUART final : public UART<MockUART> {
 public:
     struct Config {
         io::Stream* stream;
@@ -159,6 +159,10 @@ public:
     bool read(uint8_t& value) override { return _stream_ref->read(value); }
     size_t write(const uint8_t* const buffer, size_t length) override { return _stream_ref->write(buffer, length); }
     bool write(uint8_t value) override { return _stream_ref->write(value); }
+    using UART::writev;
+    size_t writev(const std::string_view* segments, size_t count) override {
+        return _stream_ref->writev(segments, count);
+    }
     size_t available() const override { return _stream_ref->available(); }
     size_t available_for_write() const override { return _stream_ref->available_for_write(); }
     void flush() override { _stream_ref->flush(); }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "spine/core/memory.hpp"
+
 #include <algorithm>
 #include <cstdint>
 #include <cstdlib>
@@ -113,6 +115,7 @@ protected:
 
 private:
     bool m_store_is_internal;
+    memory::Subsystem m_subsystem = memory::active_subsystem(); // accounts the internal store
 };
 
 template<typename T>
@@ -127,7 +130,8 @@ Array<T>::Array(uint8_t* buffer, Size buffer_length)
 
 template<typename T>
 Array<T>::Array(Size max_size)
-    : m_store(static_cast<T*>(std::malloc(max_size * sizeof(T)))), m_max_size(max_size), m_store_is_internal(true) {
+    : m_store(static_cast<T*>(memory::allocate(max_size * sizeof(T)))), m_max_size(max_size),
+      m_store_is_internal(true) {
     memset((char*)m_store, '\0', m_max_size * sizeof(T));
 }
 
@@ -148,7 +152,7 @@ Array<T>::Array(const std::initializer_list<T>& init_values) : Array(init_values
 template<typename T>
 Array<T>::~Array() {
     if (m_store_is_internal) {
-        std::free(m_store);
+        memory::deallocate(m_store, m_max_size * sizeof(T), m_subsystem);
         m_store = nullptr;
     }
 }
@@ -162,7 +166,7 @@ Array<T>::Array(const Array& other)
 template<typename T>
 Array<T>::Array(Array&& other) noexcept
     : ArrayBase(std::move(other)), m_store(other.m_store), m_max_size(other.m_max_size),
-      m_store_is_internal(other.m_store_is_internal) {
+      m_store_is_internal(other.m_store_is_internal), m_subsystem(other.m_subsystem) {
     other.m_store = nullptr;
 }
 
@@ -184,13 +188,14 @@ Array<T>& Array<T>::operator=(Array&& other) noexcept {
     other.m_store = nullptr;
     m_max_size = other.m_max_size;
     m_store_is_internal = other.m_store_is_internal;
+    m_subsystem = other.m_subsystem;
     return *this;
 }
 
 template<typename T>
 Array<T>& Array<T>::operator=(const std::initializer_list<T>& value_list) noexcept {
     if (m_store_is_internal) {
-        std::free(m_store);
+        memory::deallocate(m_store, m_max_size * sizeof(T), m_subsystem);
     }
     *this = Array<T>(value_list);
     return *this;
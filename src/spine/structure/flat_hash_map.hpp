@@ -0,0 +1,209 @@
+#pragma once
+
+#include "spine/core/debugging.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace spn::structure {
+
+namespace detail {
+/// Returns the smallest power of two equal or larger than `n`
+constexpr size_t next_power_of_two(size_t n) {
+    size_t p = 1;
+    while (p < n)
+        p <<= 1;
+    return p;
+}
+} // namespace detail
+
+template<typename K, typename V, size_t N, typename Hash = std::hash<K>, typename KeyEqual = std::equal_to<K>>
+/// Fixed capacity hash map holding at most `N` entries inline (no heap). Uses open addressing with linear probing and
+/// backward shift deletion, so lookups never have to skip over tombstones. The slots are the next power of two above
+/// 1.5 N, which keeps the load factor at most 2/3 and the clusters short, even for the lookups of absent keys.
+class FlatHashMap {
+public:
+    static_assert(N > 0, "FlatHashMap must have a capacity");
+    static_assert(std::is_default_constructible_v<K> && std::is_default_constructible_v<V>,
+                  "FlatHashMap requires default constructible keys and values");
+
+    using key_type = K;
+    using mapped_type = V;
+
+private:
+    struct Slot {
+        K key{};
+        V value{};
+        bool occupied = false;
+    };
+
+public:
+    template<bool IsConst>
+    /// Iterates over occupied slots only, yielding `std::pair<const K&, V&>` so that the keys (and with them the
+    /// slot's position) can't be changed through an iterator
+    class Iterator {
+        using SlotType = std::conditional_t<IsConst, const Slot, Slot>;
+        using ValueRef = std::conditional_t<IsConst, const V&, V&>;
+
+    public:
+        using reference = std::pair<const K&, ValueRef>;
+
+        /// Holds the entry `operator->` points to
+        class Arrow {
+        public:
+            explicit Arrow(reference entry) : _entry(entry) {}
+            const reference* operator->() const { return &_entry; }
+
+        private:
+            reference _entry;
+        };
+
+        Iterator(SlotType* slots, size_t index) : _slots(slots), _index(index) { skip_empty(); }
+
+        bool operator!=(const Iterator& other) const { return _index != other._index; }
+        bool operator==(const Iterator& other) const { return _index == other._index; }
+        Iterator& operator++() {
+            ++_index;
+            skip_empty();
+            return *this;
+        }
+        reference operator*() const { return {_slots[_index].key, _slots[_index].value}; }
+        Arrow operator->() const { return Arrow(**this); }
+
+    private:
+        void skip_empty() {
+            while (_index < Slots && !_slots[_index].occupied)
+                ++_index;
+        }
+
+        SlotType* _slots;
+        size_t _index;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+public:
+    FlatHashMap() = default;
+    FlatHashMap(std::initializer_list<std::pair<K, V>> entries) {
+        for (const auto& [k, v] : entries)
+            insert_or_assign(k, v);
+    }
+
+    /// Insert `value` under `key`, or overwrite the value if `key` already exists. Returns false if the map is full.
+    bool insert_or_assign(const K& key, const V& value) {
+        if (auto* slot = find_slot(key)) {
+            slot->value = value;
+            return true;
+        }
+        return emplace_new(key, value) != nullptr;
+    }
+
+    /// Insert `value` under `key` only if `key` doesn't exist. Returns false if the key existed or the map is full.
+    bool insert(const K& key, const V& value) {
+        if (find_slot(key) != nullptr) return false;
+        return emplace_new(key, value) != nullptr;
+    }
+
+    /// Returns a reference to the value under `key`, default constructing it when absent (asserts on a full map)
+    V& operator[](const K& key) {
+        if (auto* slot = find_slot(key)) return slot->value;
+        auto* slot = emplace_new(key, V{});
+        spn_assert(slot != nullptr);
+        return slot != nullptr ? slot->value : _slots[0].value;
+    }
+
+    /// Returns a pointer to the value under `key` or nullptr when absent
+    V* find(const K& key) {
+        auto* slot = find_slot(key);
+        return slot ? &slot->value : nullptr;
+    }
+    const V* find(const K& key) const { return const_cast<FlatHashMap*>(this)->find(key); }
+
+    /// Returns true if `key` is present
+    bool contains(const K& key) const { return find(key) != nullptr; }
+
+    /// Remove `key` from the map. Returns true if it was present.
+    bool erase(const K& key) {
+        auto* slot = find_slot(key);
+        if (slot == nullptr) return false;
+
+        // backward shift deletion (Knuth's algorithm R): move every successor in the cluster that may no longer be
+        // reachable from its home slot into the hole, until an empty slot ends the cluster
+        size_t hole = static_cast<size_t>(slot - _slots);
+        _slots[hole] = Slot{};
+        for (size_t next = (hole + 1) & Mask; _slots[next].occupied; next = (next + 1) & Mask) {
+            const auto home = home_of(_slots[next].key);
+            const auto reachable = hole <= next ? (hole < home && home <= next) : (hole < home || home <= next);
+            if (reachable) continue;
+            _slots[hole] = std::move(_slots[next]);
+            _slots[next] = Slot{};
+            hole = next;
+        }
+        --_size;
+        return true;
+    }
+
+    /// Remove all entries
+    void clear() {
+        for (auto& slot : _slots)
+            slot = Slot{};
+        _size = 0;
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == N; }
+    static constexpr size_t capacity() { return N; }
+
+    iterator begin() { return iterator(_slots, 0); }
+    iterator end() { return iterator(_slots, Slots); }
+    const_iterator begin() const { return const_iterator(_slots, 0); }
+    const_iterator end() const { return const_iterator(_slots, Slots); }
+
+private:
+    static constexpr size_t Slots = detail::next_power_of_two(N + N / 2 + 1);
+    static constexpr size_t Mask = Slots - 1;
+
+    /// Returns the preferred slot of `key`. The hash is scrambled (fibonacci hashing) since std::hash is the identity
+    /// for integers on most standard libraries.
+    static size_t home_of(const K& key) {
+        constexpr auto golden_ratio = sizeof(size_t) == 8 ? static_cast<size_t>(0x9E3779B97F4A7C15ull) : 0x9E3779B9u;
+        constexpr auto bits = sizeof(size_t) * 8;
+        const size_t h = Hash{}(key) * golden_ratio;
+        return Slots == 1 ? 0 : (h >> (bits - log2(Slots))) & Mask;
+    }
+
+    static constexpr size_t log2(size_t n) { return n <= 1 ? 0 : 1 + log2(n >> 1); }
+
+    Slot* find_slot(const K& key) {
+        size_t idx = home_of(key);
+        for (size_t probes = 0; probes < Slots && _slots[idx].occupied; ++probes) {
+            if (KeyEqual{}(_slots[idx].key, key)) return &_slots[idx];
+            idx = (idx + 1) & Mask;
+        }
+        return nullptr;
+    }
+
+    Slot* emplace_new(const K& key, V&& value) {
+        if (full()) return nullptr;
+        size_t idx = home_of(key);
+        while (_slots[idx].occupied)
+            idx = (idx + 1) & Mask;
+        _slots[idx].key = key;
+        _slots[idx].value = std::move(value);
+        _slots[idx].occupied = true;
+        ++_size;
+        return &_slots[idx];
+    }
+    Slot* emplace_new(const K& key, const V& value) { return emplace_new(key, V(value)); }
+
+    Slot _slots[Slots] = {};
+    size_t _size = 0;
+};
+
+} // namespace spn::structure
@@ -3,19 +3,38 @@
 namespace spn::structure {
 
 LineBuffer::LineBuffer(size_t capacity, const std::string_view delimiters)
-    : RingBuffer<char>(capacity), _delimiters(delimiters) {}
+    : RingBuffer<char>(capacity), _delimiters(delimiters), _delimiter_set(delimiters) {}
 
 size_t LineBuffer::push(const std::string_view& buffer) { return RingBuffer<char>::push(buffer.data(), buffer.size()); }
 
-void LineBuffer::set_delimiters(const std::string_view delimiters) { _delimiters = delimiters; }
+size_t LineBuffer::pushv(const std::string_view* segments, size_t count) {
+    const auto size = spn::core::utils::total_size(segments, count);
+    if (size > free_space()) return 0;
+    for (size_t i = 0; i < count; ++i)
+        RingBuffer<char>::push(segments[i].data(), segments[i].size());
+    return size;
+}
+
+void LineBuffer::set_delimiters(const std::string_view delimiters) {
+    _delimiters = delimiters;
+    _delimiter_set = spn::core::utils::CharSet(delimiters);
+}
 
 std::optional<std::string_view> LineBuffer::get_next_line_view(const std::optional<size_t>& discovered_length) {
     auto length = discovered_length.value_or(length_of_next_line());
     if (length == 0) return {};
     length -= 1; // ignore delimiter
-    char* str;
-    if (peek_at(&str, 0) == false) return std::nullopt;
-    return std::string_view(str, length);
+    if (const auto view = view_at(0, length)) return view;
+    linearize();
+    return view_at(0, length);
+}
+
+std::optional<std::string_view> LineBuffer::view_at(size_t offset, size_t length) const {
+    const auto spans = used_spans();
+    if (offset + length <= spans.first_size) return std::string_view(spans.first + offset, length);
+    if (offset >= spans.first_size && offset + length <= spans.first_size + spans.second_size)
+        return std::string_view(spans.second + (offset - spans.first_size), length);
+    return std::nullopt;
 }
 
 size_t LineBuffer::get_next_line(char* buffer, size_t max_length, const std::optional<size_t>& discovered_length) { //
@@ -42,17 +61,18 @@ bool LineBuffer::drop_next_line(const std::optional<size_t>& discovered_length)
     return true;
 }
 
-size_t LineBuffer::length_of_next_line() const {
-    size_t length = 0;
-    char v;
-
-    for (size_t i = 0; i < used_space(); ++i) {
-        if (!peek_at(v, i))
-            return 0; // todo: this is problematic as there is no way to distinguish between no line and a read
-        // error
-        ++length;
-        if (_delimiters.find(v) != std::string::npos) return length;
+size_t LineBuffer::length_of_next_line(size_t offset) const {
+    using spn::core::utils::find_first_of;
+    const auto spans = used_spans();
+    if (offset < spans.first_size) {
+        const auto first = std::string_view(spans.first + offset, spans.first_size - offset);
+        if (const auto pos = find_first_of(first, _delimiter_set); pos != std::string::npos) return pos + 1;
     }
+    const auto skip = offset > spans.first_size ? offset - spans.first_size : 0;
+    if (skip >= spans.second_size) return 0;
+    const auto second = std::string_view(spans.second + skip, spans.second_size - skip);
+    if (const auto pos = find_first_of(second, _delimiter_set); pos != std::string::npos)
+        return spans.first_size + skip + pos + 1 - offset;
     return 0;
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "spine/core/utils/string.hpp"
 #include "spine/structure/ringbuffer.hpp"
 
 #include <optional>
@@ -15,18 +16,29 @@ public:
     size_t push(const std::string_view& buffer);
     using RingBuffer::push;
 
+    /// Push all `count` segments one after the other or, when they don't fit the free space at once, none of them.
+    /// Every segment is copied in at most two pieces. Returns the amount of bytes pushed.
+    size_t pushv(const std::string_view* segments, size_t count);
+
     /// Set's the delimiters that determine a line
     void set_delimiters(const std::string_view delimiters = "\r\n");
 
     /// The delimiters that determine a line
     const std::string_view& delimiters() const { return _delimiters; }
 
+    /// Returns true if `c` is one of the delimiters
+    bool is_delimiter(char c) const { return _delimiter_set.contains(c); }
+
     /// Returns true if a delimited line was found
     bool has_line() const { return length_of_next_line() > 0; }
 
-    /// Returns a std::string_view of the next available line or nullopt if no line is present in the buffer.
+    /// Returns a std::string_view of the next available line or nullopt if no line is present in the buffer. A line
+    /// that wraps around the end of the ring is moved to its start first, which invalidates earlier views.
     std::optional<std::string_view> get_next_line_view(const std::optional<size_t>& discovered_length = std::nullopt);
 
+    /// Returns a std::string_view of the `length` bytes starting at `offset`, or nullopt if they aren't contiguous
+    std::optional<std::string_view> view_at(size_t offset, size_t length) const;
+
     /// Writes the next available line into `buffer` and returns the amount of bytes read
     size_t get_next_line(char* buffer, size_t max_length,
                          const std::optional<size_t>& discovered_length = std::nullopt);
@@ -34,11 +46,12 @@ public:
     /// Drop the next available line from the buffer. Returns `true` when a message was succesfully dropped
     bool drop_next_line(const std::optional<size_t>& discovered_length = std::nullopt);
 
-    /// Returns length of line if found or 0
-    size_t length_of_next_line() const;
+    /// Returns length of the first line starting at `offset` (including its delimiter) if found or 0
+    size_t length_of_next_line(size_t offset = 0) const;
 
 private:
     std::string_view _delimiters{"\r\n"};
+    spn::core::utils::CharSet _delimiter_set{_delimiters};
 };
 
 } // namespace spn::structure
@@ -1,5 +1,8 @@
 #pragma once
 
+#include <cmath>
+#include <type_traits>
+
 namespace spn::structure {
 
 /*
@@ -36,14 +39,19 @@ struct XYZPoint {
         y *= s;
         z *= s;
     }
-    T mag() const { return sqrt(pow(x, 2) + pow(y, 2) + pow(z, 2)); }
+    T mag() const { return static_cast<T>(std::sqrt(x * x + y * y + z * z)); }
     void normalize() {
-        T mag = this->mag();
-        x /= mag;
-        y /= mag;
-        z /= mag;
+        const T mag = this->mag();
+        if constexpr (std::is_floating_point_v<T>) {
+            scalar_multiplication(T(1) / mag);
+        } else {
+            x /= mag;
+            y /= mag;
+            z /= mag;
+        }
     }
-    XYZPoint dot(const XYZPoint& other) const { return XYZPoint<T>(x * other.x, y * other.y, z * other.z); }
+    /// Returns the scalar (inner) product. Use operator* for the component-wise product.
+    T dot(const XYZPoint& other) const { return x * other.x + y * other.y + z * other.z; }
 };
 
 /*
@@ -77,13 +85,18 @@ struct XYPoint {
         x *= s;
         y *= s;
     }
-    T mag() const { return sqrt(pow(x, 2) + pow(y, 2)); }
+    T mag() const { return static_cast<T>(std::sqrt(x * x + y * y)); }
     void normalize() {
-        T mag = this->mag();
-        x /= mag;
-        y /= mag;
+        const T mag = this->mag();
+        if constexpr (std::is_floating_point_v<T>) {
+            scalar_multiplication(T(1) / mag);
+        } else {
+            x /= mag;
+            y /= mag;
+        }
     }
-    XYPoint dot(const XYPoint& other) const { return XYPoint<T>(x * other.x, y * other.y); }
+    /// Returns the scalar (inner) product. Use operator* for the component-wise product.
+    T dot(const XYPoint& other) const { return x * other.x + y * other.y; }
 };
 
 } // namespace spn::structure
@@ -0,0 +1,364 @@
+#pragma once
+
+#include "spine/core/debugging.hpp"
+#include "spine/structure/point.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <type_traits>
+
+#if defined(__SSE2__)
+#    include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#    include <arm_neon.h>
+#elif defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2)
+#    include <arm_mve.h>
+#endif
+
+namespace spn::structure {
+
+namespace detail::simd {
+
+// Four lane float vectors on the instruction sets spine knows about: SSE2 (x86), NEON (Cortex-A) and Helium (MVE with
+// floating point, Cortex-M55/M85). Instruction sets without a vector square root or division fall back to scalar
+// lanes for just those operations.
+
+#if defined(__SSE2__)
+constexpr bool available = true;
+using f32x4 = __m128;
+inline f32x4 load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, f32x4 v) { _mm_storeu_ps(p, v); }
+inline f32x4 broadcast(float v) { return _mm_set1_ps(v); }
+inline f32x4 add(f32x4 a, f32x4 b) { return _mm_add_ps(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return _mm_sub_ps(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return _mm_mul_ps(a, b); }
+inline f32x4 div(f32x4 a, f32x4 b) { return _mm_div_ps(a, b); }
+inline f32x4 sqrt(f32x4 a) { return _mm_sqrt_ps(a); }
+#elif defined(__ARM_NEON) || (defined(__ARM_FEATURE_MVE) && (__ARM_FEATURE_MVE & 2))
+constexpr bool available = true;
+using f32x4 = float32x4_t;
+inline f32x4 load(const float* p) { return vld1q_f32(p); }
+inline void store(float* p, f32x4 v) { vst1q_f32(p, v); }
+inline f32x4 broadcast(float v) { return vdupq_n_f32(v); }
+inline f32x4 add(f32x4 a, f32x4 b) { return vaddq_f32(a, b); }
+inline f32x4 sub(f32x4 a, f32x4 b) { return vsubq_f32(a, b); }
+inline f32x4 mul(f32x4 a, f32x4 b) { return vmulq_f32(a, b); }
+#    if defined(__aarch64__)
+inline f32x4 div(f32x4 a, f32x4 b) { return vdivq_f32(a, b); }
+inline f32x4 sqrt(f32x4 a) { return vsqrtq_f32(a); }
+#    else
+inline f32x4 div(f32x4 a, f32x4 b) {
+    float lhs[4], rhs[4];
+    store(lhs, a);
+    store(rhs, b);
+    for (size_t i = 0; i < 4; ++i)
+        lhs[i] /= rhs[i];
+    return load(lhs);
+}
+inline f32x4 sqrt(f32x4 a) {
+    float lanes[4];
+    store(lanes, a);
+    for (auto& lane : lanes)
+        lane = std::sqrt(lane);
+    return load(lanes);
+}
+#    endif
+#else
+constexpr bool available = false;
+/// Placeholder such that the kernels compile without SIMD support; never used
+struct f32x4 {};
+inline f32x4 load(const float*) { return {}; }
+inline void store(float*, f32x4) {}
+inline f32x4 broadcast(float) { return {}; }
+inline f32x4 add(f32x4, f32x4) { return {}; }
+inline f32x4 sub(f32x4, f32x4) { return {}; }
+inline f32x4 mul(f32x4, f32x4) { return {}; }
+inline f32x4 div(f32x4, f32x4) { return {}; }
+inline f32x4 sqrt(f32x4) { return {}; }
+#endif
+
+constexpr size_t lanes = 4;
+
+template<typename T>
+/// True when the kernels use intrinsics for `T`, otherwise they are plain loops left to the auto-vectorizer
+constexpr bool enabled = available && std::is_same_v<T, float>;
+
+} // namespace detail::simd
+
+namespace detail::kernels {
+
+// Kernels over the component arrays of a batch of `n` points. Every kernel handles whole vectors first (when
+// intrinsics are available for T) and finishes the remainder with a plain loop.
+
+template<typename T>
+void add(T* dst, const T* src, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        for (; i + simd::lanes <= n; i += simd::lanes)
+            simd::store(dst + i, simd::add(simd::load(dst + i), simd::load(src + i)));
+    }
+    for (; i < n; ++i)
+        dst[i] += src[i];
+}
+
+template<typename T>
+void add(T* dst, T value, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        const auto v = simd::broadcast(value);
+        for (; i + simd::lanes <= n; i += simd::lanes)
+            simd::store(dst + i, simd::add(simd::load(dst + i), v));
+    }
+    for (; i < n; ++i)
+        dst[i] += value;
+}
+
+template<typename T>
+void subtract(T* dst, const T* src, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        for (; i + simd::lanes <= n; i += simd::lanes)
+            simd::store(dst + i, simd::sub(simd::load(dst + i), simd::load(src + i)));
+    }
+    for (; i < n; ++i)
+        dst[i] -= src[i];
+}
+
+template<typename T>
+void multiply(T* dst, T value, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        const auto v = simd::broadcast(value);
+        for (; i + simd::lanes <= n; i += simd::lanes)
+            simd::store(dst + i, simd::mul(simd::load(dst + i), v));
+    }
+    for (; i < n; ++i)
+        dst[i] *= value;
+}
+
+template<size_t Dims, typename T>
+/// out[i] = sum over the components of a[d][i] * b[d][i]
+void dot(const T* const* a, const T* const* b, T* out, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            auto acc = simd::mul(simd::load(a[0] + i), simd::load(b[0] + i));
+            for (size_t d = 1; d < Dims; ++d)
+                acc = simd::add(acc, simd::mul(simd::load(a[d] + i), simd::load(b[d] + i)));
+            simd::store(out + i, acc);
+        }
+    }
+    for (; i < n; ++i) {
+        T acc = a[0][i] * b[0][i];
+        for (size_t d = 1; d < Dims; ++d)
+            acc += a[d][i] * b[d][i];
+        out[i] = acc;
+    }
+}
+
+template<size_t Dims, typename T>
+void mag(const T* const* c, T* out, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            auto acc = simd::mul(simd::load(c[0] + i), simd::load(c[0] + i));
+            for (size_t d = 1; d < Dims; ++d)
+                acc = simd::add(acc, simd::mul(simd::load(c[d] + i), simd::load(c[d] + i)));
+            simd::store(out + i, simd::sqrt(acc));
+        }
+    }
+    for (; i < n; ++i) {
+        T acc = c[0][i] * c[0][i];
+        for (size_t d = 1; d < Dims; ++d)
+            acc += c[d][i] * c[d][i];
+        out[i] = static_cast<T>(std::sqrt(acc));
+    }
+}
+
+template<size_t Dims, typename T>
+/// Normalizes every point; a single division per point for floating point types
+void normalize(T* const* c, size_t n) {
+    size_t i = 0;
+    if constexpr (simd::enabled<T>) {
+        const auto one = simd::broadcast(1.0f);
+        for (; i + simd::lanes <= n; i += simd::lanes) {
+            auto acc = simd::mul(simd::load(c[0] + i), simd::load(c[0] + i));
+            for (size_t d = 1; d < Dims; ++d)
+                acc = simd::add(acc, simd::mul(simd::load(c[d] + i), simd::load(c[d] + i)));
+            const auto inverse = simd::div(one, simd::sqrt(acc));
+            for (size_t d = 0; d < Dims; ++d)
+                simd::store(c[d] + i, simd::mul(simd::load(c[d] + i), inverse));
+        }
+    }
+    for (; i < n; ++i) {
+        T acc = c[0][i] * c[0][i];
+        for (size_t d = 1; d < Dims; ++d)
+            acc += c[d][i] * c[d][i];
+        const auto mag = static_cast<T>(std::sqrt(acc));
+        if constexpr (std::is_floating_point_v<T>) {
+            const T inverse = T(1) / mag;
+            for (size_t d = 0; d < Dims; ++d)
+                c[d][i] *= inverse;
+        } else {
+            for (size_t d = 0; d < Dims; ++d)
+                c[d][i] /= mag;
+        }
+    }
+}
+
+} // namespace detail::kernels
+
+template<typename T, size_t N, size_t Dims = 3>
+/// Fixed capacity batch of at most `N` points stored inline as a structure of arrays: all x components are contiguous,
+/// followed by all y (and z) components. This lets the batch kernels process several points per instruction, which
+/// an array of XYZPoint can't since its components are interleaved. Use for streams of sensor readings (e.g. IMU or
+/// magnetometer samples) that are processed in bulk.
+class PointBatch {
+public:
+    static_assert(Dims == 2 || Dims == 3, "PointBatch supports XY and XYZ points");
+    static_assert(N > 0, "PointBatch must have a capacity");
+
+    using Point = std::conditional_t<Dims == 2, XYPoint<T>, XYZPoint<T>>;
+
+public:
+    PointBatch() = default;
+
+    /// Append `point`. Returns false if the batch is full.
+    bool push_back(const Point& point) {
+        if (full()) return false;
+        set(_size++, point);
+        return true;
+    }
+
+    /// Returns the point at `idx`
+    Point at(size_t idx) const {
+        spn_assert(idx < _size);
+        if constexpr (Dims == 2) return Point(_c[0][idx], _c[1][idx]);
+        else return Point(_c[0][idx], _c[1][idx], _c[2][idx]);
+    }
+
+    /// Overwrite the point at `idx`
+    void set(size_t idx, const Point& point) {
+        spn_assert(idx < _size);
+        _c[0][idx] = point.x;
+        _c[1][idx] = point.y;
+        if constexpr (Dims == 3) _c[2][idx] = point.z;
+    }
+
+    /// Returns the contiguous array holding component `dim` (0: x, 1: y, 2: z) of all points
+    T* component(size_t dim) {
+        spn_assert(dim < Dims);
+        return _c[dim];
+    }
+    const T* component(size_t dim) const {
+        spn_assert(dim < Dims);
+        return _c[dim];
+    }
+    T* x() { return _c[0]; }
+    const T* x() const { return _c[0]; }
+    T* y() { return _c[1]; }
+    const T* y() const { return _c[1]; }
+    template<size_t D = Dims, typename = std::enable_if_t<D == 3>>
+    T* z() {
+        return _c[2];
+    }
+    template<size_t D = Dims, typename = std::enable_if_t<D == 3>>
+    const T* z() const {
+        return _c[2];
+    }
+
+    /// Add the points of `other` point-wise (batches must be of the same size)
+    void add(const PointBatch& other) {
+        spn_assert(other._size == _size);
+        for (size_t d = 0; d < Dims; ++d)
+            detail::kernels::add(_c[d], other._c[d], _size);
+    }
+    /// Add `offset` to every point
+    void add(const Point& offset) {
+        const T components[] = {offset.x, offset.y, third_of(offset)};
+        for (size_t d = 0; d < Dims; ++d)
+            detail::kernels::add(_c[d], components[d], _size);
+    }
+
+    /// Subtract the points of `other` point-wise (batches must be of the same size)
+    void subtract(const PointBatch& other) {
+        spn_assert(other._size == _size);
+        for (size_t d = 0; d < Dims; ++d)
+            detail::kernels::subtract(_c[d], other._c[d], _size);
+    }
+    /// Subtract `offset` from every point (e.g. a calibration bias)
+    void subtract(const Point& offset) {
+        const T components[] = {offset.x, offset.y, third_of(offset)};
+        for (size_t d = 0; d < Dims; ++d)
+            detail::kernels::add(_c[d], static_cast<T>(-components[d]), _size);
+    }
+
+    void scalar_multiplication(T s) {
+        for (size_t d = 0; d < Dims; ++d)
+            detail::kernels::multiply(_c[d], s, _size);
+    }
+
+    /// Write the scalar product of every point with the point at the same index in `other` to `out`, which must hold
+    /// `size()` values
+    void dot(const PointBatch& other, T* out) const {
+        spn_assert(other._size == _size);
+        spn_assert(out != nullptr);
+        const T* a[Dims];
+        const T* b[Dims];
+        for (size_t d = 0; d < Dims; ++d) {
+            a[d] = _c[d];
+            b[d] = other._c[d];
+        }
+        detail::kernels::dot<Dims>(a, b, out, _size);
+    }
+
+    /// Write the magnitude of every point to `out`, which must hold `size()` values
+    void mag(T* out) const {
+        spn_assert(out != nullptr);
+        const T* c[Dims];
+        for (size_t d = 0; d < Dims; ++d)
+            c[d] = _c[d];
+        detail::kernels::mag<Dims>(c, out, _size);
+    }
+
+    /// Normalize every point. Like XYZPoint::normalize, the result for a point of magnitude zero is undefined.
+    void normalize() {
+        T* c[Dims];
+        for (size_t d = 0; d < Dims; ++d)
+            c[d] = _c[d];
+        detail::kernels::normalize<Dims>(c, _size);
+    }
+
+    /// Set the amount of points, clamped to `capacity()`; new points are zero
+    void resize(size_t size) {
+        size = std::min(size, N);
+        for (size_t d = 0; d < Dims; ++d)
+            for (size_t i = _size; i < size; ++i)
+                _c[d][i] = 0;
+        _size = size;
+    }
+    void clear() { _size = 0; }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == N; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static T third_of(const Point& p) {
+        if constexpr (Dims == 3) return p.z;
+        else return T(0);
+    }
+
+    alignas(16) T _c[Dims][N] = {};
+    size_t _size = 0;
+};
+
+template<typename T, size_t N>
+using XYZPointBatch = PointBatch<T, N, 3>;
+
+template<typename T, size_t N>
+using XYPointBatch = PointBatch<T, N, 2>;
+
+} // namespace spn::structure
@@ -1,24 +1,114 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
-#include "spine/core/meta/unique_type_variant.hpp"
 
-#include <optional>
+#include <algorithm>
+#include <cstdint>
+#include <new>
 #include <type_traits>
-#include <variant>
+#include <utility>
 
 namespace spn::structure {
 
-namespace uv = spn::core::meta::unique_variant;
-
 // Only slightly inspired on Rust's Result structure.
 // Kudos to Ryan Lucas @ github.com/rlucas585 for the inspiration
 
-/// Container for function-driven processing with safety by default
+namespace detail {
+
+enum class ResultType : uint8_t { NO_VALUE, OK, INTERMEDIARY, FAILED };
+
+template<typename T, typename E, typename I>
+constexpr bool result_is_trivial =
+    std::is_trivially_copyable_v<T> && std::is_trivially_copyable_v<E> && std::is_trivially_copyable_v<I>;
+
+template<typename T, typename E, typename I, bool Trivial = result_is_trivial<T, E, I>>
+/// Tagged union backing Result. The tag is the only discriminator; the union members are selected by it.
+struct ResultStorage;
+
+template<typename T, typename E, typename I>
+/// Storage for trivially copyable T/E/I: copies are plain memcpy's and destruction is a no-op
+struct ResultStorage<T, E, I, true> {
+    ResultStorage() : none() {}
+
+    union {
+        char none;
+        T ok;
+        E error;
+        I intermediary;
+    };
+    ResultType type = ResultType::NO_VALUE;
+};
+
+template<typename T, typename E, typename I>
+/// Storage for T/E/I that require their constructors and destructors to be run
+struct ResultStorage<T, E, I, false> {
+    ResultStorage() : none() {}
+    ResultStorage(const ResultStorage& other) : none() { construct_from(other); }
+    ResultStorage(ResultStorage&& other) noexcept : none() { construct_from(std::move(other)); }
+    ResultStorage& operator=(const ResultStorage& other) {
+        if (this != &other) {
+            destroy();
+            construct_from(other);
+        }
+        return *this;
+    }
+    ResultStorage& operator=(ResultStorage&& other) noexcept {
+        if (this != &other) {
+            destroy();
+            construct_from(std::move(other));
+        }
+        return *this;
+    }
+    ~ResultStorage() { destroy(); }
+
+    union {
+        char none;
+        T ok;
+        E error;
+        I intermediary;
+    };
+    ResultType type = ResultType::NO_VALUE;
+
+private:
+    template<typename Other>
+    void construct_from(Other&& other) {
+        switch (other.type) {
+        case ResultType::OK: new (&ok) T(std::forward<Other>(other).ok); break;
+        case ResultType::FAILED: new (&error) E(std::forward<Other>(other).error); break;
+        case ResultType::INTERMEDIARY: new (&intermediary) I(std::forward<Other>(other).intermediary); break;
+        default: break;
+        }
+        type = other.type;
+    }
+
+    void destroy() {
+        switch (type) {
+        case ResultType::OK: ok.~T(); break;
+        case ResultType::FAILED: error.~E(); break;
+        case ResultType::INTERMEDIARY: intermediary.~I(); break;
+        default: break;
+        }
+        type = ResultType::NO_VALUE;
+    }
+};
+
+/// Returns the size a Result<T, E, I> is guaranteed to have: the largest of T/E/I followed by a single byte tag,
+/// rounded up to the alignment of the most strictly aligned of T/E/I
+template<typename T, typename E, typename I>
+constexpr size_t result_size() {
+    constexpr size_t align = std::max({alignof(T), alignof(E), alignof(I)});
+    constexpr size_t payload = std::max({sizeof(T), sizeof(E), sizeof(I)});
+    return (payload + 1 + align - 1) / align * align;
+}
+
+} // namespace detail
+
+/// Container for function-driven processing with safety by default. Stored as a tagged union with a single byte tag,
+/// see `detail::result_size`; trivially copyable when T, E and I are.
 template<typename T, typename E = T, typename I = T>
 class Result {
 public:
-    Result() : _type(Type::NO_VALUE) {}
+    Result() = default;
 
     Result(const Result& other) = default;
     Result(Result&& other) noexcept = default;
@@ -26,61 +116,81 @@ public:
     Result& operator=(Result&& other) noexcept = default;
     ~Result() = default;
 
-    Result(const T& v) : _v(std::in_place, WrappedT(v)), _type(Type::OK) {}
-    Result(T&& v) : _v(std::in_place, WrappedT(std::move(v))), _type(Type::OK) {}
+    Result(const T& v) { emplace_value(v); }
+    Result(T&& v) { emplace_value(std::move(v)); }
 
-    static Result intermediary(const I& v) { return Result(Type::INTERMEDIARY, WrappedI(v)); }
-    static Result intermediary(I&& v) { return Result(Type::INTERMEDIARY, WrappedI(std::move(v))); }
+    static Result intermediary(const I& v) {
+        Result r;
+        r.emplace_intermediary(v);
+        return r;
+    }
+    static Result intermediary(I&& v) {
+        Result r;
+        r.emplace_intermediary(std::move(v));
+        return r;
+    }
 
-    static Result failed(const E& v) { return Result(Type::FAILED, WrappedE(v)); }
-    static Result failed(E&& v) { return Result(Type::FAILED, WrappedE(std::move(v))); }
+    static Result failed(const E& v) {
+        Result r;
+        r.emplace_error(v);
+        return r;
+    }
+    static Result failed(E&& v) {
+        Result r;
+        r.emplace_error(std::move(v));
+        return r;
+    }
 
     template<typename U = E, typename = std::enable_if_t<std::is_convertible_v<U, E> && !std::is_same_v<E, T>>>
-    Result(const U& error) : _v(std::in_place, WrappedE(error)), _type(Type::FAILED) {}
+    Result(const U& error) {
+        emplace_error(error);
+    }
 
     template<typename U = E, typename = std::enable_if_t<std::is_convertible_v<U, E> && !std::is_same_v<E, T>>>
-    Result(U&& error) : _v(std::in_place, WrappedE(std::forward<U>(error))), _type(Type::FAILED) {}
+    Result(U&& error) {
+        emplace_error(std::forward<U>(error));
+    }
 
-    bool is_success() const { return _type == Type::OK; }
-    bool is_intermediary() const { return _type == Type::INTERMEDIARY; }
-    bool is_failed() const { return _type == Type::FAILED; }
+    bool is_success() const { return _s.type == Type::OK; }
+    bool is_intermediary() const { return _s.type == Type::INTERMEDIARY; }
+    bool is_failed() const { return _s.type == Type::FAILED; }
 
-    operator bool() const { return _type == Type::OK; }
+    operator bool() const { return _s.type == Type::OK; }
 
     const E& error_value() const {
         spn_assert(is_failed());
-        spn_assert(_v && std::holds_alternative<WrappedE>(*_v));
-        return std::get<WrappedE>(*_v);
+        return _s.error;
     }
 
     const I& intermediary_value() const {
         spn_assert(is_intermediary());
-        spn_assert(_v && std::holds_alternative<WrappedI>(*_v));
-        return std::get<WrappedI>(*_v);
+        return _s.intermediary;
     }
 
     const T& value() const {
         spn_assert(is_success());
-        spn_assert(_v && std::holds_alternative<WrappedT>(*_v));
-        return std::get<WrappedT>(*_v);
+        return _s.ok;
     }
 
     E unwrap_error_value() {
         spn_assert(is_failed());
-        spn_assert(_v && std::holds_alternative<WrappedE>(*_v));
-        return std::move(std::get<WrappedE>(*_v));
+        return std::move(_s.error);
     }
 
     I unwrap_intermediary_value() {
         spn_assert(is_intermediary());
-        spn_assert(_v && std::holds_alternative<WrappedI>(*_v));
-        return std::move(std::get<WrappedI>(*_v));
+        return std::move(_s.intermediary);
     }
 
+    /// Take the value. An intermediary value may be taken as well when it has the same type as the value.
     T unwrap() {
-        spn_assert(is_success() || is_intermediary());
-        spn_assert(_v && std::holds_alternative<WrappedT>(*_v));
-        return std::move(std::get<WrappedT>(*_v));
+        if constexpr (std::is_same_v<T, I>) {
+            spn_assert(is_success() || is_intermediary());
+            if (is_intermediary()) return std::move(_s.intermediary);
+        } else {
+            spn_assert(is_success());
+        }
+        return std::move(_s.ok);
     }
 
     const T* operator->() const { return &value(); }
@@ -169,23 +279,38 @@ public:
 protected:
     I& intermediary_value_mut() {
         spn_assert(is_intermediary());
-        return std::get<WrappedI>(*_v);
+        return _s.intermediary;
     }
 
 private:
-    enum class Type : uint8_t { NO_VALUE, OK, INTERMEDIARY, FAILED };
-
-    using WrappedT = uv::Wrapper<T>;
-    using WrappedE = uv::Wrapper<E>;
-    using WrappedI = uv::Wrapper<I>;
-
-    using Value = typename uv::ToVariant<uv::Unique<WrappedT, WrappedE, WrappedI>>::type;
+    using Type = detail::ResultType;
 
-    Result(Type type, const Value& v) : _v(v), _type(type) {}
-    Result(Type type, Value&& v) : _v(std::move(v)), _type(type) {}
+    // only called on a freshly constructed (NO_VALUE) result
+    template<typename U>
+    void emplace_value(U&& v) {
+        new (&_s.ok) T(std::forward<U>(v));
+        _s.type = Type::OK;
+    }
+    template<typename U>
+    void emplace_error(U&& v) {
+        new (&_s.error) E(std::forward<U>(v));
+        _s.type = Type::FAILED;
+    }
+    template<typename U>
+    void emplace_intermediary(U&& v) {
+        new (&_s.intermediary) I(std::forward<U>(v));
+        _s.type = Type::INTERMEDIARY;
+    }
 
-    std::optional<Value> _v;
-    Type _type;
+    detail::ResultStorage<T, E, I> _s;
 };
 
+// The footprint of a Result is the largest of its types plus a single byte tag (rounded up to alignment)
+static_assert(sizeof(Result<uint8_t>) == 2);
+static_assert(sizeof(Result<uint16_t, uint8_t>) == 4);
+static_assert(sizeof(Result<uint32_t, uint8_t>) == 8);
+static_assert(sizeof(Result<float, uint8_t, uint16_t>) == detail::result_size<float, uint8_t, uint16_t>());
+static_assert(sizeof(Result<uint64_t, uint32_t, uint8_t>) == detail::result_size<uint64_t, uint32_t, uint8_t>());
+static_assert(std::is_trivially_copyable_v<Result<uint32_t, uint8_t, float>>);
+
 } // namespace spn::structure
@@ -3,6 +3,8 @@
 #include "spine/core/debugging.hpp"
 #include "spine/structure/array.hpp"
 
+#include <algorithm>
+
 namespace spn::structure {
 
 template<typename T>
@@ -60,6 +62,50 @@ public:
     /// Total amount of bytes that the buffer can hold without overrun
     size_t capacity() const { return m_buffer.max_size(); }
 
+    /// The elements in the buffer as (at most) two contiguous spans, first inserted first
+    struct Spans {
+        const T* first;
+        size_t first_size;
+        const T* second;
+        size_t second_size;
+    };
+    Spans used_spans() const {
+        const auto used = used_space();
+        const auto first_size = std::min(used, m_buffer.size() - m_tail);
+        return {m_buffer.data() + m_tail, first_size, m_buffer.data(), used - first_size};
+    }
+
+    /// The free space of the buffer as (at most) two contiguous spans, to be written in order and claimed by `commit`
+    struct FreeSpans {
+        T* first;
+        size_t first_size;
+        T* second;
+        size_t second_size;
+    };
+    FreeSpans free_spans() {
+        const auto free = free_space();
+        const auto first_size = std::min(free, m_buffer.size() - m_head);
+        return {m_buffer.data() + m_head, first_size, m_buffer.data(), free - first_size};
+    }
+
+    /// Claim the first `n` elements of `free_spans()` as written
+    void commit(size_t n) {
+        spn_assert(n <= free_space());
+        if (n == 0) return;
+        m_head = (m_head + n) % m_buffer.size();
+        m_is_full = m_head == m_tail;
+    }
+
+    /// Move the elements to the start of the storage such that they're a single contiguous span. Invalidates pointers
+    /// into the buffer.
+    void linearize() {
+        if (m_tail == 0) return;
+        const auto used = used_space();
+        std::rotate(m_buffer.data(), m_buffer.data() + m_tail, m_buffer.data() + m_buffer.size());
+        m_tail = 0;
+        m_head = used % m_buffer.size();
+    }
+
 protected:
     /// Push the reading head forwards by `n`, effectively dropping `n` first inserted  elements
     void advance_tail(size_t n) { m_tail = (m_tail + n) % m_buffer.size(); }
@@ -68,6 +114,9 @@ protected:
     void retract_head(size_t n) { m_head = (m_head + m_buffer.size() - (n % m_buffer.size())) % m_buffer.size(); }
 
 private:
+    /// Returns the index after `index`, without the division of a modulo
+    size_t next(size_t index) const { return index + 1 == m_buffer.size() ? 0 : index + 1; }
+
     Array<T> m_buffer;
     size_t m_head{0};
     size_t m_tail{0};
@@ -80,11 +129,11 @@ template<typename T>
 bool RingBuffer<T>::push(const T& value, bool rollover) {
     if (m_is_full && !rollover) return false;
     m_buffer[m_head] = value;
-    m_head = (m_head + 1) % m_buffer.size();
+    m_head = next(m_head);
     if (m_head == m_tail) {
         m_is_full = true;
     } else if (m_is_full) {
-        m_tail = (m_tail + 1) % m_buffer.size();
+        m_tail = next(m_tail);
         ++m_overwritten;
     }
     return true;
@@ -92,6 +141,16 @@ bool RingBuffer<T>::push(const T& value, bool rollover) {
 
 template<typename T>
 size_t RingBuffer<T>::push(const T* buffer, size_t length, bool rollover) {
+    if (!rollover) {
+        // copy into the free spans at once
+        const auto spans = free_spans();
+        const auto first = std::min(length, spans.first_size);
+        const auto second = std::min(length - first, spans.second_size);
+        std::copy(buffer, buffer + first, spans.first);
+        std::copy(buffer + first, buffer + first + second, spans.second);
+        commit(first + second);
+        return first + second;
+    }
     size_t values_written = 0;
     for (size_t i = 0; i < length; ++i) {
         if (!push(buffer[i], rollover)) return values_written;
@@ -111,7 +170,7 @@ bool RingBuffer<T>::pop(T& value) {
     if (empty()) return false;
 
     value = m_buffer[m_tail];
-    m_tail = (m_tail + 1) % m_buffer.size();
+    m_tail = next(m_tail);
     m_is_full = false;
     m_overwritten = 0;
     return true;
@@ -119,16 +178,17 @@ bool RingBuffer<T>::pop(T& value) {
 
 template<typename T>
 size_t RingBuffer<T>::pop(T* buffer, size_t length) {
-    size_t bytes_read = 0;
-
-    if (used_space() < length) return 0;
-
-    for (size_t i = 0; i < length; ++i) {
-        pop(buffer[i]);
-        ++bytes_read;
-    }
-
-    return bytes_read;
+    if (length == 0 || used_space() < length) return 0;
+
+    // copy out of the used spans at once
+    const auto spans = used_spans();
+    const auto first = std::min(length, spans.first_size);
+    std::copy(spans.first, spans.first + first, buffer);
+    std::copy(spans.second, spans.second + (length - first), buffer + first);
+    advance_tail(length);
+    m_is_full = false;
+    m_overwritten = 0;
+    return length;
 }
 
 template<typename T>
@@ -0,0 +1,142 @@
+#pragma once
+
+#include "spine/core/debugging.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <type_traits>
+#include <utility>
+
+namespace spn::structure {
+
+template<typename K, typename V, size_t N, typename Compare = std::less<K>>
+/// Fixed capacity map holding at most `N` entries inline (no heap). Keys are kept sorted in their own contiguous array
+/// such that lookups are a cache friendly binary search. Insertion and removal are O(n) because of shifting, which
+/// makes this map a good fit for tables that are filled once and looked up often (e.g. command tables).
+class SortedFlatMap {
+public:
+    static_assert(N > 0, "SortedFlatMap must have a capacity");
+    static_assert(std::is_default_constructible_v<K> && std::is_default_constructible_v<V>,
+                  "SortedFlatMap requires default constructible keys and values");
+
+    using key_type = K;
+    using mapped_type = V;
+
+public:
+    SortedFlatMap() = default;
+    SortedFlatMap(std::initializer_list<std::pair<K, V>> entries) {
+        for (const auto& [k, v] : entries)
+            insert_or_assign(k, v);
+    }
+
+    /// Insert `value` under `key`, or overwrite the value if `key` already exists. Returns false if the map is full.
+    bool insert_or_assign(const K& key, const V& value) {
+        const auto idx = lower_bound(key);
+        if (idx < _size && equal(_keys[idx], key)) {
+            _values[idx] = value;
+            return true;
+        }
+        return insert_at(idx, key, value);
+    }
+
+    /// Insert `value` under `key` only if `key` doesn't exist. Returns false if the key existed or the map is full.
+    bool insert(const K& key, const V& value) {
+        const auto idx = lower_bound(key);
+        if (idx < _size && equal(_keys[idx], key)) return false;
+        return insert_at(idx, key, value);
+    }
+
+    /// Returns a reference to the value under `key`, default constructing it when absent (asserts on a full map)
+    V& operator[](const K& key) {
+        const auto idx = lower_bound(key);
+        if (idx < _size && equal(_keys[idx], key)) return _values[idx];
+        const auto inserted = insert_at(idx, key, V{});
+        spn_assert(inserted);
+        return inserted ? _values[idx] : _values[0];
+    }
+
+    /// Returns a pointer to the value under `key` or nullptr when absent
+    V* find(const K& key) {
+        const auto idx = index_of(key);
+        return idx < _size ? _values + idx : nullptr;
+    }
+    const V* find(const K& key) const {
+        const auto idx = index_of(key);
+        return idx < _size ? _values + idx : nullptr;
+    }
+
+    /// Returns true if `key` is present
+    bool contains(const K& key) const { return index_of(key) < _size; }
+
+    /// Remove `key` from the map. Returns true if it was present.
+    bool erase(const K& key) {
+        const auto idx = index_of(key);
+        if (idx >= _size) return false;
+        std::move(_keys + idx + 1, _keys + _size, _keys + idx);
+        std::move(_values + idx + 1, _values + _size, _values + idx);
+        --_size;
+        _keys[_size] = K{};
+        _values[_size] = V{};
+        return true;
+    }
+
+    /// Remove all entries
+    void clear() {
+        std::fill(_keys, _keys + _size, K{});
+        std::fill(_values, _values + _size, V{});
+        _size = 0;
+    }
+
+    /// Returns the key at sorted position `idx`
+    const K& key_at(size_t idx) const {
+        spn_assert(idx < _size);
+        return _keys[idx];
+    }
+
+    /// Returns the value at sorted position `idx`
+    V& value_at(size_t idx) {
+        spn_assert(idx < _size);
+        return _values[idx];
+    }
+    const V& value_at(size_t idx) const {
+        spn_assert(idx < _size);
+        return _values[idx];
+    }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == N; }
+    static constexpr size_t capacity() { return N; }
+
+private:
+    static bool equal(const K& a, const K& b) { return !Compare{}(a, b) && !Compare{}(b, a); }
+
+    /// Returns the position of the first key not ordered before `key`
+    size_t lower_bound(const K& key) const {
+        return static_cast<size_t>(std::lower_bound(_keys, _keys + _size, key, Compare{}) - _keys);
+    }
+
+    /// Returns the position of `key` or `size()` when absent
+    size_t index_of(const K& key) const {
+        const auto idx = lower_bound(key);
+        return idx < _size && equal(_keys[idx], key) ? idx : _size;
+    }
+
+    bool insert_at(size_t idx, const K& key, const V& value) {
+        if (full()) return false;
+        std::move_backward(_keys + idx, _keys + _size, _keys + _size + 1);
+        std::move_backward(_values + idx, _values + _size, _values + _size + 1);
+        _keys[idx] = key;
+        _values[idx] = value;
+        ++_size;
+        return true;
+    }
+
+    K _keys[N] = {};
+    V _values[N] = {};
+    size_t _size = 0;
+};
+
+} // namespace spn::structure
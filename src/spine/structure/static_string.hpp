@@ -1,56 +1,166 @@
 #pragma once
 
 #include "spine/core/debugging.hpp"
+#include "spine/core/utils/format.hpp"
 #include "spine/core/utils/string.hpp"
 
+#include <algorithm>
+#include <cstdarg>
+#include <cstddef>
+#include <cstdio>
 #include <cstring>
-#include <string>
 #include <string_view>
 
 namespace spn::structure {
 
-/// String wrapper for a statically allocated string with some C++23 sugar
+template<size_t N>
+/// String of at most `N` characters stored inline (plus a null character), such that it never touches the heap.
+/// Appending beyond the capacity truncates; `full()` tells when that may have happened.
 class StaticString {
 public:
-    explicit StaticString(size_t buffer_length);
-    StaticString& operator=(const StaticString& other) = delete;
-    StaticString& operator=(StaticString&& other) = delete;
-
-    /// Returns the size of the string (this is not the same as the capacity!).
-    size_t size() const { return _buffer.size(); }
-
-    /// Set the size of the string (this is not the same as the capacity!).
-    void set_size(size_t size);
-
-    /// Returns the total memory space allocated for this string.
-    size_t capacity() const { return _buffer.capacity(); }
-
-    /// Returns data pointer. When writing to this pointer, make sure to announce the size through
-    /// `expected_bytes_written`. See comment below.
-    char* data(const size_t expected_bytes_written = 0);
-
-    /// Return C style string.
-    const char* c_str() const { return _buffer.c_str(); }
-
-    /// Returns a std::string_view of the string.
-    std::string_view view() const { return {_buffer.data(), _buffer.size()}; }
-
-    // todo : these are duplicates from core/utils/string
-
-    /// Strip the characters specified by `delimiters` from the front of the string.
-    StaticString& lstrip(std::string_view delimiters = " \f\n\r\t\v");
-
-    /// Strip the characters specified by `delimiters` from the back of the string.
-    StaticString& rstrip(std::string_view delimiters = " \f\n\r\t\v");
+    static_assert(N > 0, "StaticString must have a capacity");
+
+    StaticString() = default;
+    StaticString(const std::string_view view) { append(view); }
+    StaticString(const char* str) : StaticString(std::string_view(str)) {}
+
+    template<size_t M>
+    StaticString(const StaticString<M>& other) : StaticString(other.view()) {}
+
+    StaticString& operator=(const std::string_view view) {
+        clear();
+        return append(view);
+    }
+    StaticString& operator=(const char* str) { return *this = std::string_view(str); }
+
+    /// Returns the size of the string (this is not the same as the capacity!)
+    size_t size() const { return _size; }
+    size_t length() const { return _size; }
+
+    /// Returns the maximal amount of characters the string can hold
+    static constexpr size_t capacity() { return N; }
+
+    /// Returns the amount of characters that can still be appended
+    size_t space_left() const { return N - _size; }
+
+    bool empty() const { return _size == 0; }
+    bool full() const { return _size == N; }
+
+    /// Returns the data pointer. After writing into it directly (at most `capacity()` chars), announce the new size
+    /// with `resize()`.
+    char* data() { return _data; }
+    const char* data() const { return _data; }
+
+    /// Return C style string
+    const char* c_str() const { return _data; }
+
+    /// Returns a std::string_view of the string
+    std::string_view view() const { return {_data, _size}; }
+    operator std::string_view() const { return view(); }
+
+    char& operator[](size_t idx) {
+        spn_assert(idx < _size);
+        return _data[idx];
+    }
+    const char& operator[](size_t idx) const {
+        spn_assert(idx < _size);
+        return _data[idx];
+    }
+
+    char* begin() { return _data; }
+    char* end() { return _data + _size; }
+    const char* begin() const { return _data; }
+    const char* end() const { return _data + _size; }
+
+    /// Set the size of the string, e.g. after writing through `data()`. Growing keeps what was written there.
+    void resize(size_t size) {
+        spn_assert(size <= N); // do not allow overflowing the inline storage
+        _size = std::min(size, N);
+        _data[_size] = '\0';
+    }
+
+    void clear() { resize(0); }
+
+    /// Append `value` if there is space for it
+    StaticString& push_back(char value) {
+        if (_size < N) {
+            _data[_size++] = value;
+            _data[_size] = '\0';
+        }
+        return *this;
+    }
+
+    /// Append `view` for as far as the capacity allows
+    StaticString& append(const std::string_view view) {
+        const auto n = std::min(view.size(), space_left());
+        std::memcpy(_data + _size, view.data(), n);
+        _size += n;
+        _data[_size] = '\0';
+        return *this;
+    }
+
+    StaticString& operator+=(const std::string_view view) { return append(view); }
+    StaticString& operator+=(char value) { return push_back(value); }
+
+    template<typename... Args>
+    /// Append all `args` formatted as by `utils::format_to` (numbers, units, strings, ...)
+    StaticString& format(const Args&... args) {
+        core::utils::format_to(*this, args...);
+        return *this;
+    }
+
+    /// Append printf-style formatted text for as far as the capacity allows
+    StaticString& append_vprintf(const char* fmt, va_list args) {
+        const auto written = std::vsnprintf(_data + _size, space_left() + 1, fmt, args);
+        if (written > 0) _size += std::min(static_cast<size_t>(written), space_left());
+        _data[_size] = '\0';
+        return *this;
+    }
+
+    /// Append printf-style formatted text for as far as the capacity allows
+    StaticString& append_printf(const char* fmt, ...) {
+        va_list args;
+        va_start(args, fmt);
+        append_vprintf(fmt, args);
+        va_end(args);
+        return *this;
+    }
+
+    /// Strip the characters specified by `delimiters` from the front of the string
+    StaticString& lstrip(const std::string_view delimiters = " \f\n\r\t\v") {
+        const auto stripped = core::utils::lstrip(view(), delimiters);
+        std::memmove(_data, stripped.data(), stripped.size());
+        resize(stripped.size());
+        return *this;
+    }
+
+    /// Strip the characters specified by `delimiters` from the back of the string
+    StaticString& rstrip(const std::string_view delimiters = " \f\n\r\t\v") {
+        resize(core::utils::rstrip(view(), delimiters).size());
+        return *this;
+    }
+
+    /// Strip the characters specified by `delimiters` from both ends of the string
+    StaticString& strip(const std::string_view delimiters = " \f\n\r\t\v") {
+        return rstrip(delimiters).lstrip(delimiters);
+    }
 
     /// Returns true if the string starts with `needle`
-    bool starts_with(const std::string_view needle) const;
+    bool starts_with(const std::string_view needle) const { return core::utils::starts_with(view(), needle); }
 
     /// Returns true if the string ends with `needle`
-    bool ends_with(const std::string_view needle) const;
+    bool ends_with(const std::string_view needle) const { return core::utils::ends_with(view(), needle); }
+
+    /// Compares like std::string_view::compare
+    int compare(const std::string_view other) const { return view().compare(other); }
+
+    friend bool operator==(const StaticString& a, const std::string_view b) { return a.view() == b; }
+    friend bool operator!=(const StaticString& a, const std::string_view b) { return a.view() != b; }
+    friend bool operator<(const StaticString& a, const std::string_view b) { return a.view() < b; }
 
 private:
-    std::string _buffer;
+    char _data[N + 1] = {};
+    size_t _size = 0;
 };
 
 } // namespace spn::structure
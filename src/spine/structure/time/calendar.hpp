@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+
+namespace spn::structure::time {
+
+// Proleptic gregorian calendar arithmetic on days since the unix epoch (1970-01-01), after Howard Hinnant's
+// 'chrono-compatible low-level date algorithms'. Eras of 400 years make the calendar repeat, so every conversion is a
+// handful of integer operations without tables, loops or libc.
+
+/// A date in the proleptic gregorian calendar
+struct CivilDate {
+    int32_t year;
+    uint8_t month; // 1...12
+    uint8_t day; // 1...31
+
+    constexpr bool operator==(const CivilDate& other) const {
+        return year == other.year && month == other.month && day == other.day;
+    }
+    constexpr bool operator!=(const CivilDate& other) const { return !(*this == other); }
+};
+
+constexpr int32_t seconds_per_day = 86400;
+
+/// Returns true if `year` has 366 days
+constexpr bool is_leap_year(int32_t year) { return year % 4 == 0 && (year % 100 != 0 || year % 400 == 0); }
+
+/// Returns the days since 1970-01-01 of the given date
+constexpr int32_t days_from_civil(int32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    const int32_t era = (year >= 0 ? year : year - 399) / 400;
+    const auto year_of_era = static_cast<uint32_t>(year - era * 400); // [0, 399]
+    const uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1; // [0, 365], from March
+    const uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year; // [0, 146096]
+    return era * 146097 + static_cast<int32_t>(day_of_era) - 719468;
+}
+
+/// Returns the date of `days` since 1970-01-01
+constexpr CivilDate civil_from_days(int32_t days) {
+    days += 719468; // shift the epoch to 0000-03-01
+    const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const auto day_of_era = static_cast<uint32_t>(days - era * 146097); // [0, 146096]
+    const uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+    const uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100); // [0, 365]
+    const uint32_t month_from_march = (5 * day_of_year + 2) / 153; // [0, 11]
+    const auto day = static_cast<uint8_t>(day_of_year - (153 * month_from_march + 2) / 5 + 1);
+    const auto month = static_cast<uint8_t>(month_from_march < 10 ? month_from_march + 3 : month_from_march - 9);
+    const auto year = static_cast<int32_t>(year_of_era) + era * 400 + (month <= 2);
+    return {year, month, day};
+}
+
+/// Returns the weekday of `days` since 1970-01-01, where sunday is 0
+constexpr uint8_t weekday_from_days(int32_t days) {
+    return static_cast<uint8_t>(days >= -4 ? (days + 4) % 7 : (days + 5) % 7 + 6);
+}
+
+/// Returns the days since january 1st of the given date (0...365)
+constexpr uint16_t day_of_year(int32_t year, uint32_t month, uint32_t day) {
+    return static_cast<uint16_t>(days_from_civil(year, month, day) - days_from_civil(year, 1, 1));
+}
+
+/// Returns the day boundary at or before `timestamp` (seconds since the unix epoch) as days since 1970-01-01
+constexpr int32_t days_from_timestamp(int64_t timestamp) {
+    return static_cast<int32_t>(timestamp >= 0 ? timestamp / seconds_per_day
+                                               : (timestamp - (seconds_per_day - 1)) / seconds_per_day);
+}
+
+} // namespace spn::structure::time
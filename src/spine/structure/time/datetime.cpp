@@ -8,6 +8,7 @@
  *
  * Modifications by Stan:
  * - Removed unneeded functionality
+ * - Calendar math without mktime/gmtime (see calendar.hpp) and an ISO-8601 writer without strftime
  *********************************************************************************************/
 
 #include "datetime.hpp"
@@ -35,46 +36,30 @@
 #    define NTP_OFFSET 3155673600UL
 #endif
 
-static constexpr uint8_t daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
-
-/**
- * @brief function which calculates if a year is a leap year
- *
- * @param year
- * @return true
- * @return false
- */
-static bool isleapYear(const int year) {
-    // check if divisible by 4
-    if (year % 4) {
-        return false;
+namespace {
+
+using namespace spn::structure::time;
+
+/// Fields of the most recently converted day. Consecutive timestamps mostly fall on the same day, which then only
+/// costs the split of the time of day.
+struct DayCache {
+    int32_t days = INT32_MIN; // days since 1970-01-01
+    CivilDate date = {};
+    uint8_t weekday = 0;
+    uint16_t year_day = 0;
+};
+DayCache g_day_cache;
+
+/// Writes `value` as `digits` decimal digits (zero padded)
+char* write_digits(char* out, uint32_t value, int digits) {
+    for (int i = digits - 1; i >= 0; --i) {
+        out[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
     }
-    // only check other, when first failed
-    return (year % 100 || year % 400 == 0);
-}
-
-/**
- * @brief calculate the days since January 1 (0...365)
- *
- * @param year e.g.: 2022
- * @param month 1...12
- * @param day 1...31
- * @return int16_t
- */
-static int calcYearDay(const int year, const int month, const int day) {
-    auto days = day - 1;
-    for (uint8_t i = 1; i < month; ++i)
-        days += daysInMonth[i - 1];
-    if (month > 2 && isleapYear(year)) ++days;
-    return days;
+    return out + digits;
 }
 
-// Slightly modified from JeeLabs / Ladyada
-// Get all date/time at once to avoid rollover (e.g., minute/second don't match)
-// Commented to avoid compiler warnings, but keeping in case we want this
-// eventually
-// static uint8_t bin2bcd (uint8_t val) { return val + 6 * (val / 10); }
-static uint8_t bcd2bin(uint8_t val) { return static_cast<uint8_t>(val - 6 * (val >> 4)); }
+} // namespace
 
 // *****************************************
 //   Member functions for DateTime object
@@ -84,11 +69,7 @@ static uint8_t bcd2bin(uint8_t val) { return static_cast<uint8_t>(val - 6 * (val
  *
  * @param unix_timestamp
  */
-DateTime::DateTime(time_t unix_timestamp)
-    : _unix_timestamp{unix_timestamp}, _y2k_timestamp{static_cast<time_t>(unix_timestamp - UNIX_OFFSET)} {
-    spn_assert(unix_timestamp - UNIX_OFFSET <= LONG_MAX);
-    gmtime_r(&_unix_timestamp, &_tm);
-}
+DateTime::DateTime(time_t unix_timestamp) { set_unix_time(unix_timestamp); }
 
 /**
  * @brief Construct a new Date Time:: Date Time object
@@ -99,21 +80,19 @@ DateTime::DateTime(time_t unix_timestamp)
  * @param hour hours since midnight - [ 0...23 ]
  * @param min inutes after the hour - [ 0...59 ]
  * @param sec seconds after the minute - [ 0...59 ]
- * @param wday wdays since Sunday - [ 1...7 ]
- * @param dst Daylight Saving Time flag
+ * @param wday ignored, the weekday follows from the date
+ * @param yday ignored, the day of the year follows from the date
+ * @param dst Daylight Saving Time flag (informational, all times are UTC)
+ *
+ * Out of range fields are normalized like mktime does (e.g. month 13 is january of the next year)
  */
 DateTime::DateTime(int year, int month, int day, int hour, int min, int sec, int wday, int yday, int dst) {
-    _tm.tm_sec = sec;
-    _tm.tm_min = min;
-    _tm.tm_hour = hour;
-    _tm.tm_mday = day;
-    _tm.tm_mon = month - 1;
-    _tm.tm_year = year - 1900;
-    _tm.tm_wday = wday - 1;
-    _tm.tm_yday = yday;
+    const auto months = static_cast<int64_t>(year) * 12 + (month - 1);
+    const auto normalized_year = static_cast<int32_t>(months >= 0 ? months / 12 : (months - 11) / 12);
+    const auto normalized_month = static_cast<uint32_t>(months - static_cast<int64_t>(normalized_year) * 12 + 1);
+    const auto days = static_cast<int64_t>(days_from_civil(normalized_year, normalized_month, 1)) + day - 1;
+    set_unix_time(days * seconds_per_day + static_cast<int64_t>(hour) * 3600 + min * 60 + sec);
     _tm.tm_isdst = dst;
-
-    set_timestamps();
 }
 
 /**
@@ -129,30 +108,36 @@ DateTime::DateTime(const char* date, const char* time) {
     int year, day;
     sscanf(date, "%4s %2d %4d", month_buff, &day, &year);
     int month = (strstr(month_names, month_buff) - month_names) / 3 + 1;
-    _tm.tm_year = year - 1900;
-    _tm.tm_mon = month - 1;
-    _tm.tm_mday = day;
     int hour, min, sec;
     sscanf(time, "%i:%i:%i", &hour, &min, &sec);
-    _tm.tm_hour = hour;
-    _tm.tm_min = min;
-    _tm.tm_sec = sec;
-    _tm.tm_yday = calcYearDay(year, month, day);
-    set_timestamps();
+    *this = DateTime(year, month, day, hour, min, sec);
 }
 
 /**
- * @brief Set the timestamps by using struct tm entries
+ * @brief Set the timestamps and all fields of the broken down time
  *
+ * @param unix_timestamp seconds since 1/1/1970
  */
-void DateTime::set_timestamps() {
-#if defined(__AVR__)
-    _y2k_timestamp = mktime(&_tm);
-    _unix_timestamp = _y2k_timestamp + UNIX_OFFSET;
-#else
-    _unix_timestamp = mktime(&_tm);
-    _y2k_timestamp = _unix_timestamp - UNIX_OFFSET;
-#endif
+void DateTime::set_unix_time(int64_t unix_timestamp) {
+    _unix_timestamp = static_cast<time_t>(unix_timestamp);
+    _y2k_timestamp = static_cast<time_t>(unix_timestamp - static_cast<int64_t>(UNIX_OFFSET));
+
+    const auto days = days_from_timestamp(unix_timestamp);
+    if (days != g_day_cache.days) {
+        const auto date = civil_from_days(days);
+        g_day_cache = {days, date, weekday_from_days(days), day_of_year(date.year, date.month, date.day)};
+    }
+
+    const auto seconds = static_cast<int32_t>(unix_timestamp - static_cast<int64_t>(days) * seconds_per_day);
+    _tm.tm_sec = seconds % 60;
+    _tm.tm_min = seconds / 60 % 60;
+    _tm.tm_hour = seconds / 3600;
+    _tm.tm_mday = g_day_cache.date.day;
+    _tm.tm_mon = g_day_cache.date.month - 1;
+    _tm.tm_year = g_day_cache.date.year - 1900;
+    _tm.tm_wday = g_day_cache.weekday;
+    _tm.tm_yday = g_day_cache.year_day;
+    _tm.tm_isdst = 0;
 }
 
 /**
@@ -170,3 +155,30 @@ size_t DateTime::strf_DateTime(char* buffer, size_t buffersize, const char* form
     size_t len{strftime(buffer, buffersize, formatSpec, &_tm)};
     return len;
 }
+
+/**
+ * @brief Write the datetime in the extended ISO-8601 format for UTC: YYYY-MM-DDThh:mm:ssZ
+ *
+ * @param buffer buffer for the time string
+ * @param buffersize size of buffer, at least iso8601_length + 1
+ * @return size_t length of the written string (excluding the null character), or 0 when it didn't fit
+ */
+size_t DateTime::to_iso8601(char* buffer, size_t buffersize) const {
+    const auto year = getYear();
+    if (buffersize < iso8601_length + 1 || year < 0 || year > 9999) return 0;
+
+    auto out = write_digits(buffer, static_cast<uint32_t>(year), 4);
+    *out++ = '-';
+    out = write_digits(out, static_cast<uint32_t>(getMonth()), 2);
+    *out++ = '-';
+    out = write_digits(out, static_cast<uint32_t>(getDay()), 2);
+    *out++ = 'T';
+    out = write_digits(out, static_cast<uint32_t>(getHour()), 2);
+    *out++ = ':';
+    out = write_digits(out, static_cast<uint32_t>(getMinute()), 2);
+    *out++ = ':';
+    out = write_digits(out, static_cast<uint32_t>(getSecond()), 2);
+    *out++ = 'Z';
+    *out = '\0';
+    return iso8601_length;
+}
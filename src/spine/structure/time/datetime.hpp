@@ -8,16 +8,25 @@
  *
  * Modifications by Stan:
  * - Removed unneeded functionality
+ * - Calendar math without mktime/gmtime (see calendar.hpp) and an ISO-8601 writer without strftime
  *********************************************************************************************/
 
+#pragma once
+
+#include "spine/structure/time/calendar.hpp"
 #include "spine/structure/units/si.hpp"
 
 #include <climits>
+#include <cstddef>
 #include <cstdint>
+#include <ctime>
 
-// DateTime class restructured by using standardized time functions
+// DateTime class restructured by using standardized time functions. All times are UTC.
 class DateTime {
 public:
+    /// Length of `to_iso8601()`'s output, excluding the terminating null character
+    static constexpr size_t iso8601_length = 20;
+
     DateTime(time_t unix_timestamp = 0);
 
     DateTime(int year, int month, int mday, int hour = 0, int min = 0, int sec = 0, int wday = 0, int yday = 0,
@@ -36,20 +45,22 @@ public:
     int getDST() const { return _tm.tm_isdst; }
     size_t strf_DateTime(char* buffer, size_t buffersize, const char* formatSpec = "%a %h %d %T %Y");
 
+    /// Writes the datetime as `YYYY-MM-DDThh:mm:ssZ` followed by a null character. Returns the length of the written
+    /// string, or 0 when the buffer is too small or the year has more than 4 digits.
+    size_t to_iso8601(char* buffer, size_t buffersize) const;
+
     // time_t value as seconds since 1/1/2000
     time_t getY2kTime() const { return _y2k_timestamp; }
 
-    // time_t value as seconds since 1/1/1970
-    // THE ABOVE COMMENT IS CORRECT FOR LOCAL TIME; TO USE THIS COMMAND TO
-    // OBTAIN TRUE UNIX TIME SINCE EPOCH, YOU MUST CALL THIS COMMAND AFTER
-    // SETTING YOUR CLOCK TO UTC
+    // time_t value as seconds since 1/1/1970 (UTC)
     time_t getUnixTime() const { return _unix_timestamp; }
 
 private:
-    void set_timestamps();
+    /// Set the timestamps and all fields from a unix timestamp
+    void set_unix_time(int64_t unix_timestamp);
 
 protected:
     time_t _unix_timestamp;
     time_t _y2k_timestamp;
-    tm _tm;
-};
\ No newline at end of file
+    tm _tm = {};
+};
@@ -1,32 +1,116 @@
 #include "spine/structure/time/schedule.hpp"
 
+#include <algorithm>
+
 namespace spn::structure::time {
 
-Schedule::Schedule(const Schedule::Config&& cfg) : Schedule(cfg.blocks) {}
+Schedule::Schedule(const Schedule::Config&& cfg) : Schedule(cfg.blocks.begin(), cfg.blocks.size(), cfg.period) {}
+
+Schedule::Schedule(const std::initializer_list<Block>& blocks) : Schedule(blocks.begin(), blocks.size(), day) {}
+
+Schedule::Schedule(const Block* blocks, size_t count, const k_time_s period)
+    : _period(static_cast<Offset>(period.raw())), _starts(count), _transitions(2 * count + 1) {
+    spn_assert(period > k_time_s(0) && period.raw() <= static_cast<spnu::KernelTimeRawType>(UINT32_MAX));
+
+    // blocks as intervals within the period; a block extending beyond the period is split at the end of the period
+    struct Interval {
+        Offset start;
+        Offset end;
+        float value;
+    };
+    auto intervals = Array<Interval>(2 * count);
+    size_t interval_count = 0;
 
-Schedule::Schedule(const std::initializer_list<Block>& blocks) : _blocks(blocks) {
     k_time_s total_time = {};
-    for (auto& b : _blocks) {
-        spn_assert(k_time_s(b.duration) > k_time_s(0));
+    for (size_t i = 0; i < count; ++i) {
+        const auto& b = blocks[i];
+        spn_assert(b.duration > k_time_s(0));
+        spn_assert(b.start >= k_time_s(0) && b.start < period);
         total_time += b.duration;
+
+        const auto start = static_cast<Offset>(b.start.raw());
+        const auto end = b.start.raw() + b.duration.raw();
+        _starts[i] = start;
+        if (end > period.raw()) {
+            intervals[interval_count++] = {0, static_cast<Offset>(end - period.raw()), b.value};
+            intervals[interval_count++] = {start, _period, b.value};
+        } else {
+            intervals[interval_count++] = {start, static_cast<Offset>(end), b.value};
+        }
     }
-    spn_assert(total_time <= k_time_h(24));
+    spn_assert(total_time <= period);
+
+    std::sort(_starts.data(), _starts.data() + count);
+    std::sort(intervals.data(), intervals.data() + interval_count,
+              [](const Interval& a, const Interval& b) { return a.start < b.start; });
+
+    if (interval_count == 0) return;
+
+    // collapse the intervals into the points at which the value changes; gaps between blocks have a value of 0
+    const auto& first = intervals[0];
+    const auto& last = intervals[interval_count - 1];
+    _base_value = first.start == 0 ? first.value : float{};
+    const auto value_before_end = last.end == _period ? last.value : float{};
+
+    auto emit = [this](Offset at, float value) { _transitions[_transition_count++] = {at, value}; };
+    if (value_before_end != _base_value) emit(0, _base_value);
+
+    auto value = _base_value;
+    Offset end = 0;
+    for (size_t i = 0; i < interval_count; ++i) {
+        const auto& interval = intervals[i];
+        spn_assert(interval.start >= end); // blocks may not overlap
+        if (interval.start > end && value != float{}) {
+            value = {};
+            emit(end, value);
+        }
+        if (interval.value != value) {
+            value = interval.value;
+            emit(interval.start, value);
+        }
+        end = interval.end;
+    }
+    if (end < _period && value != float{}) emit(end, float{});
+}
+
+Schedule::Offset Schedule::offset_of(const k_time_s t) const {
+    const auto offset = t.raw() % static_cast<spnu::KernelTimeRawType>(_period);
+    return static_cast<Offset>(offset < 0 ? offset + _period : offset);
+}
+
+size_t Schedule::transition_before(Offset offset) const {
+    const auto begin = _transitions.data();
+    const auto next = std::upper_bound(begin, begin + _transition_count, offset,
+                                       [](Offset o, const Transition& transition) { return o < transition.at; });
+    return next == begin ? _transition_count : static_cast<size_t>(next - begin) - 1;
 }
 
 float Schedule::value_at(const k_time_s t) const {
-    for (auto& b : _blocks) {
-        const auto is_today = t >= b.start && t < b.start + b.duration;
-        const auto is_after_midnight = b.start + b.duration > k_time_h(24) && t < b.start + b.duration - k_time_h(24);
-        if (is_today || is_after_midnight) return b.value;
-    }
-    return {};
+    const auto idx = transition_before(offset_of(t));
+    return idx < _transition_count ? _transitions[idx].value : _base_value;
 }
 
 k_time_s Schedule::start_of_next_block(const k_time_s t) const {
-    for (auto& b : _blocks) {
-        if (t < b.start) return b.start;
+    const auto offset = offset_of(t);
+    const auto begin = _starts.data();
+    const auto end = begin + _starts.size();
+    const auto next = std::upper_bound(begin, end, offset);
+    return k_time_s(next != end ? *next : _period);
+}
+
+Schedule::Cursor Schedule::cursor(const k_time_s t) const {
+    const auto start_of_period = t - k_time_s(offset_of(t));
+    if (_transition_count == 0) return {_base_value, start_of_period + period(), _base_value};
+
+    const auto idx = transition_before(offset_of(t));
+    const auto value = idx < _transition_count ? _transitions[idx].value : _base_value;
+    const auto next = idx < _transition_count ? idx + 1 : 0;
+    if (next < _transition_count) {
+        const auto& transition = _transitions[next];
+        return {value, start_of_period + k_time_s(transition.at), transition.value};
     }
-    return k_time_h(24);
+    const auto& wrapped = _transitions[0]; // the first change of the next period
+    return {value, start_of_period + period() + k_time_s(wrapped.at), wrapped.value};
 }
 
 } // namespace spn::structure::time
@@ -5,38 +5,85 @@
 #include "spine/structure/array.hpp"
 #include "spine/structure/units/si.hpp"
 
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
 #include <type_traits>
 
 namespace spn::structure::time {
 
-/// A 24hr schedule containing set values for set times
+/// A repeating schedule containing set values for set times. The schedule repeats every `period`, which defaults to
+/// 24 hours; use `Schedule::week` (or any multiple of a day) for weekly or multi-day programs.
+///
+/// Times passed to the schedule are absolute: the offset into the period is `t % period`, so `t == 0` is the start of
+/// a period (e.g. midnight, or monday midnight for a weekly schedule). On construction the blocks are sorted into an
+/// index of value transitions, which makes every lookup a binary search.
 class Schedule {
 public:
     struct Block {
-        k_time_s start; // start time of block
+        k_time_s start; // start time of block within the period
         k_time_s duration; // length of block
         float value; // active value for block
     };
 
     struct Config {
         const std::initializer_list<Block> blocks;
+        const k_time_s period = day;
     };
 
+    /// The value at some time and the first change after it
+    struct Cursor {
+        float value; // value active at the queried time
+        k_time_s next_transition; // absolute time at which the value changes
+        float next_value; // value from `next_transition` onwards
+    };
+
+    static constexpr auto day = k_time_s(k_time_d(1));
+    static constexpr auto week = k_time_s(k_time_d(7));
+
     Schedule(const Config&& cfg);
 
-    /// Create a schedule from a list of blocks (note: total time should not exceed 24hrs)
+    /// Create a daily schedule from a list of blocks (note: total time should not exceed 24hrs)
     Schedule(const std::initializer_list<Block>& blocks);
 
+    /// Create a schedule from `count` blocks that repeats every `period`. Blocks may not overlap and a block that
+    /// extends beyond the end of the period wraps around to its start.
+    Schedule(const Block* blocks, size_t count, const k_time_s period = day);
+
     /// Returns the value in the block of `t` or 0
     float value_at(const k_time_s t) const;
 
-    /// Returns the start of the block after time `t` or the maximum length of 24 hours
+    /// Returns the start of the block after time `t` or the end of the period (both relative to the start of the
+    /// period of `t`)
     k_time_s start_of_next_block(const k_time_s t) const;
 
+    /// Returns the value at `t` and the absolute time of the next change in value. Schedule an event at
+    /// `next_transition` to act on the change instead of polling `value_at`. When the value never changes, the cursor
+    /// points to the start of the next period.
+    Cursor cursor(const k_time_s t) const;
+
+    /// Returns the length after which the schedule repeats
+    k_time_s period() const { return k_time_s(_period); }
+
 private:
-    spn::structure::Array<Block> _blocks;
+    using Offset = uint32_t; // seconds since the start of the period
+
+    struct Transition {
+        Offset at; // offset at which `value` becomes active
+        float value;
+    };
+
+    /// Returns the offset of `t` within its period
+    Offset offset_of(const k_time_s t) const;
+
+    /// Returns the index of the last transition at or before `offset`, or `_transition_count` when there is none
+    size_t transition_before(Offset offset) const;
+
+    Offset _period;
+    float _base_value = {}; // value at the start of the period
+    Array<Offset> _starts; // sorted block starts
+    Array<Transition> _transitions; // sorted changes in value
+    size_t _transition_count = 0;
 };
 
 } // namespace spn::structure::time
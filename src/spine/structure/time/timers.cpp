@@ -5,8 +5,9 @@ namespace spn::structure::time {
 Timer::Timer(k_time_ms millis_epoch) : _last(millis_epoch) {}
 
 k_time_ms Timer::time_since_last(bool reset) {
-    k_time_ms time_expired = HAL::millis() - _last;
-    if (reset) this->reset();
+    const auto now = Clock::now();
+    const k_time_ms time_expired = now - _last;
+    if (reset) this->reset(now);
     return time_expired;
 }
 
@@ -16,8 +17,8 @@ void Timer::reset(k_time_ms millis_epoch) { _last = millis_epoch; }
  * TIMER: ALARM
  */
 
-AlarmTimer::AlarmTimer(k_time_ms future, bool absolute) : _future(absolute ? future : HAL::millis() + future) {
-    spn_assert(!absolute || future > HAL::millis());
+AlarmTimer::AlarmTimer(k_time_ms future, bool absolute) : _future(absolute ? future : Clock::now() + future) {
+    spn_assert(!absolute || future > Clock::now());
 }
 
 bool AlarmTimer::expired() {
@@ -25,24 +26,24 @@ bool AlarmTimer::expired() {
         return true;
     }
 
-    if (_future <= HAL::millis()) {
+    if (_future <= Clock::now()) {
         _expired = true;
         return true;
     }
     return false;
 }
 
-k_time_ms AlarmTimer::time_from_now() const { return future() - HAL::millis(); }
+k_time_ms AlarmTimer::time_from_now() const { return future() - Clock::now(); }
 
 /*
  * TIMER: INTERVAL
  */
 
 IntervalTimer::IntervalTimer(k_time_ms sampling_interval, bool allow_catch_up)
-    : _previous(HAL::millis()), _interval(sampling_interval), _allow_catch_up(allow_catch_up) {}
+    : _previous(Clock::now()), _interval(sampling_interval), _allow_catch_up(allow_catch_up) {}
 
 bool IntervalTimer::expired() {
-    const k_time_ms current = HAL::millis();
+    const k_time_ms current = Clock::now();
 
     if (current - _previous > _interval) {
         if (_allow_catch_up) {
@@ -55,9 +56,9 @@ bool IntervalTimer::expired() {
     return false;
 }
 
-void IntervalTimer::reset() { _previous = HAL::millis(); }
+void IntervalTimer::reset() { _previous = Clock::now(); }
 
 k_time_ms IntervalTimer::future() const { return _previous + _interval; }
 
-k_time_ms IntervalTimer::time_until_next() const { return future() - HAL::millis(); }
+k_time_ms IntervalTimer::time_until_next() const { return future() - Clock::now(); }
 } // namespace spn::structure::time
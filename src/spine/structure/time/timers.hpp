@@ -1,24 +1,26 @@
 #pragma once
 
-#include "spine/platform/hal.hpp"
+#include "spine/core/clock.hpp"
 #include "spine/structure/units/si.hpp"
 #include "spine/structure/vector.hpp"
 
 namespace spn::structure::time {
 
+// All timers read the time through spn::Clock, such that timers consulted within one tick agree on the time
+
 /// Keeps track of time since last check
 class Timer {
 public:
     static constexpr auto NoReset = false;
 
 public:
-    Timer(k_time_ms millis_epoch = HAL::millis());
+    Timer(k_time_ms millis_epoch = spn::Clock::now());
 
     /// Returns time since last poll. If reset is true, the timer will reset.
     k_time_ms time_since_last(bool reset = true);
 
     /// Reset the timer
-    void reset(k_time_ms millis_epoch = HAL::millis());
+    void reset(k_time_ms millis_epoch = spn::Clock::now());
 
 private:
     k_time_ms _last;
@@ -4,7 +4,7 @@
 #include "spine/structure/units/primitives/raw_types.hpp"
 #include "spine/structure/units/primitives/unit.hpp"
 
-#include <cmath>
+#include <algorithm>
 #include <cstdint>
 #include <numeric>
 #include <type_traits>
@@ -69,41 +69,45 @@ public:
                   "Numerator and denominator must have same value type");
 
     constexpr CompoundUnit() = default;
-    CompoundUnit(const NumeratorUnit& numerator, const DenominatorUnit& denominator)
+    constexpr CompoundUnit(const NumeratorUnit& numerator, const DenominatorUnit& denominator)
         : _numerator(numerator), _denominator(denominator) {}
-    CompoundUnit(const CompoundUnit&) = default;
-    CompoundUnit& operator=(const CompoundUnit&) = default;
-    CompoundUnit(CompoundUnit&& other) noexcept = default;
-    CompoundUnit& operator=(CompoundUnit&& other) noexcept = default;
+    constexpr CompoundUnit(const CompoundUnit&) = default;
+    constexpr CompoundUnit& operator=(const CompoundUnit&) = default;
+    constexpr CompoundUnit(CompoundUnit&& other) noexcept = default;
+    constexpr CompoundUnit& operator=(CompoundUnit&& other) noexcept = default;
 
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit,
              std::enable_if_t<detail::are_interchangeable<NumeratorUnit, DenominatorUnit, OtherNumeratorUnit,
                                                           OtherDenominatorUnit>(),
                               int> = 0>
-    CompoundUnit(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other)
+    constexpr CompoundUnit(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other)
         : _numerator(other.numerator()), _denominator(other.denominator()) {}
 
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit,
              std::enable_if_t<detail::are_interchangeable<NumeratorUnit, DenominatorUnit, OtherNumeratorUnit,
                                                           OtherDenominatorUnit>(),
                               int> = 0>
-    CompoundUnit& operator=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
+    constexpr CompoundUnit& operator=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
         _numerator = NumeratorUnit(other.numerator());
         _denominator = DenominatorUnit(other.denominator());
         return *this;
     }
 
-    const NumeratorUnit& numerator() const { return _numerator; }
-    const DenominatorUnit& denominator() const { return _denominator; }
+    constexpr const NumeratorUnit& numerator() const { return _numerator; }
+    constexpr const DenominatorUnit& denominator() const { return _denominator; }
 
     [[nodiscard]] constexpr ValueType raw() const {
         if (_denominator.raw() == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
         return _numerator.raw() / _denominator.raw();
     }
 
+    /// Collapse into a single derived unit (e.g. litre_ml / time_s into m^3/s) that holds one value instead of two,
+    /// which is what hot math should use
+    [[nodiscard]] constexpr auto collapse() const { return _numerator / _denominator; }
+
     /// Simplify compound by reducing numerator and denominator by greatest common denominator. Provided
     /// `scaling_factor` determines precision. A `scaling_factor` of 1e6 makes 6 decimals of precision.
-    void simplify(RealRawType scaling_factor = 1e6) {
+    constexpr void simplify(RealRawType scaling_factor = 1e6) {
         const auto gcd = compute_gcd(_numerator.raw(), _denominator.raw(), scaling_factor);
         _numerator /= gcd;
         _denominator /= gcd;
@@ -113,7 +117,7 @@ public:
              std::enable_if_t<detail::are_interchangeable<NumeratorUnit, DenominatorUnit, OtherNumeratorUnit,
                                                           OtherDenominatorUnit>(),
                               int> = 0>
-    CompoundUnit& operator+=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
+    constexpr CompoundUnit& operator+=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
         static_assert(std::is_constructible_v<NumeratorUnit, OtherNumeratorUnit>,
                       "NumeratorUnit must be constructible from OtherNumeratorUnit");
         static_assert(std::is_constructible_v<DenominatorUnit, OtherDenominatorUnit>,
@@ -130,7 +134,7 @@ public:
     }
 
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    auto operator+(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr auto operator+(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         CompoundUnit result = *this;
         result += other;
         return result;
@@ -140,7 +144,7 @@ public:
              std::enable_if_t<detail::are_interchangeable<NumeratorUnit, DenominatorUnit, OtherNumeratorUnit,
                                                           OtherDenominatorUnit>(),
                               int> = 0>
-    CompoundUnit& operator-=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
+    constexpr CompoundUnit& operator-=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) {
         static_assert(std::is_constructible_v<NumeratorUnit, OtherNumeratorUnit>,
                       "NumeratorUnit must be constructible from OtherNumeratorUnit");
         static_assert(std::is_constructible_v<DenominatorUnit, OtherDenominatorUnit>,
@@ -156,73 +160,79 @@ public:
     }
 
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    auto operator-(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr auto operator-(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         CompoundUnit result = *this;
         result -= other;
         return result;
     }
-    [[nodiscard]] CompoundUnit operator-() const { return CompoundUnit(numerator(), -denominator()); }
+    [[nodiscard]] constexpr CompoundUnit operator-() const { return CompoundUnit(numerator(), -denominator()); }
 
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit> operator*(const AT& scalar) const {
+    constexpr std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit> operator*(const AT& scalar) const {
         return CompoundUnit{_numerator * scalar, _denominator};
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit&> operator*=(const AT& scalar) {
+    constexpr std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit&> operator*=(const AT& scalar) {
         _numerator *= scalar;
         return *this;
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit> operator/(const AT& scalar) const {
+    constexpr std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit> operator/(const AT& scalar) const {
         if (scalar == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
         return CompoundUnit{_numerator / scalar, _denominator};
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit&> operator/=(const AT& scalar) {
+    constexpr std::enable_if_t<std::is_arithmetic_v<AT>, CompoundUnit&> operator/=(const AT& scalar) {
         if (scalar == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
         _numerator /= scalar;
         return *this;
     }
 
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator==(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator==(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         if constexpr (std::is_integral_v<ValueType>) return raw() == other.raw();
-        return approximately_equal(raw(), other.raw());
+        else return approximately_equal(raw(), other.raw());
     }
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator!=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator!=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         return !(*this == other);
     }
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator<(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator<(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         return raw() < other.raw();
     }
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator>(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator>(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         return raw() > other.raw();
     }
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator<=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator<=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         return raw() <= other.raw();
     }
     template<typename OtherNumeratorUnit, typename OtherDenominatorUnit>
-    bool operator>=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
+    constexpr bool operator>=(const CompoundUnit<OtherNumeratorUnit, OtherDenominatorUnit>& other) const {
         return raw() >= other.raw();
     }
 
 private:
     static constexpr ValueType epsilon = std::numeric_limits<ValueType>::epsilon();
 
-    bool approximately_equal(ValueType a, ValueType b) const {
-        return std::fabs(a - b) <= epsilon * std::max(std::fabs(a), std::fabs(b));
+    static constexpr bool approximately_equal(ValueType a, ValueType b) {
+        return detail::abs(a - b) <= epsilon * std::max(detail::abs(a), detail::abs(b));
     }
 
-    inline unsigned long scale_to_integer(ValueType num, RealRawType scaling_factor) {
-        return static_cast<unsigned long>(std::round(num * scaling_factor));
+    /// Scale `num` to an integer, rounding half away from zero (std::round is not constexpr). The sign is dropped since
+    /// it doesn't affect the gcd.
+    static constexpr unsigned long scale_to_integer(ValueType num, RealRawType scaling_factor) {
+        return static_cast<unsigned long>(detail::abs(num) * scaling_factor + RealRawType(0.5));
     }
-    unsigned long compute_gcd(ValueType numerator, ValueType denominator, RealRawType scaling_factor) {
-        if constexpr (std::is_integral_v<ValueType>) return std::gcd(numerator, denominator);
-        return std::gcd(scale_to_integer(numerator, scaling_factor), scale_to_integer(denominator, scaling_factor));
+    static constexpr unsigned long compute_gcd(ValueType numerator, ValueType denominator,
+                                               RealRawType scaling_factor) {
+        if constexpr (std::is_integral_v<ValueType>) {
+            return std::gcd(numerator, denominator);
+        } else {
+            return std::gcd(scale_to_integer(numerator, scaling_factor), scale_to_integer(denominator, scaling_factor));
+        }
     }
 
 private:
@@ -0,0 +1,239 @@
+#pragma once
+
+#include <ratio>
+
+namespace spn::structure::units {
+
+template<int L = 0, int M = 0, int T = 0, int I = 0, int Th = 0, int N = 0, int J = 0>
+/// Physical dimension as exponents of the SI base quantities: length, mass, time, current, temperature, amount of
+/// substance and luminous intensity
+struct Dimension {};
+
+namespace dimension {
+using Dimensionless = Dimension<>;
+using Length = Dimension<1>;
+using Mass = Dimension<0, 1>;
+using Time = Dimension<0, 0, 1>;
+using Current = Dimension<0, 0, 0, 1>;
+using Temperature = Dimension<0, 0, 0, 0, 1>;
+using AmountOfSubstance = Dimension<0, 0, 0, 0, 0, 1>;
+using LuminousIntensity = Dimension<0, 0, 0, 0, 0, 0, 1>;
+
+template<typename A, typename B>
+struct Product;
+template<int L1, int M1, int T1, int I1, int Th1, int N1, int J1, int L2, int M2, int T2, int I2, int Th2, int N2,
+         int J2>
+struct Product<Dimension<L1, M1, T1, I1, Th1, N1, J1>, Dimension<L2, M2, T2, I2, Th2, N2, J2>> {
+    using type = Dimension<L1 + L2, M1 + M2, T1 + T2, I1 + I2, Th1 + Th2, N1 + N2, J1 + J2>;
+};
+
+template<typename A, typename B>
+struct Quotient;
+template<int L1, int M1, int T1, int I1, int Th1, int N1, int J1, int L2, int M2, int T2, int I2, int Th2, int N2,
+         int J2>
+struct Quotient<Dimension<L1, M1, T1, I1, Th1, N1, J1>, Dimension<L2, M2, T2, I2, Th2, N2, J2>> {
+    using type = Dimension<L1 - L2, M1 - M2, T1 - T2, I1 - I2, Th1 - Th2, N1 - N2, J1 - J2>;
+};
+
+/// Dimension of `A * B`
+template<typename A, typename B>
+using product_t = typename Product<A, B>::type;
+
+/// Dimension of `A / B`
+template<typename A, typename B>
+using quotient_t = typename Quotient<A, B>::type;
+
+using Frequency = quotient_t<Dimensionless, Time>;
+using Velocity = quotient_t<Length, Time>;
+using Acceleration = quotient_t<Velocity, Time>;
+using Force = product_t<Mass, Acceleration>;
+using Pressure = quotient_t<Force, product_t<Length, Length>>;
+using Energy = product_t<Force, Length>;
+using Power = quotient_t<Energy, Time>;
+using Charge = product_t<Current, Time>;
+using Potential = quotient_t<Power, Current>;
+using Capacitance = quotient_t<Charge, Potential>;
+using Resistance = quotient_t<Potential, Current>;
+using Conductance = quotient_t<Current, Potential>;
+using MagneticFlux = product_t<Potential, Time>;
+using MagneticFluxDensity = quotient_t<MagneticFlux, product_t<Length, Length>>;
+using Inductance = quotient_t<MagneticFlux, Current>;
+using AbsorbedDose = quotient_t<Energy, Mass>;
+using CatalyticActivity = quotient_t<AmountOfSubstance, Time>;
+using LuminousFlux = LuminousIntensity; // candela times steradian, which is dimensionless
+using Illuminance = quotient_t<LuminousFlux, product_t<Length, Length>>;
+using Volume = product_t<Length, product_t<Length, Length>>;
+} // namespace dimension
+
+template<typename D, typename S = std::ratio<1>>
+/// Describes the quantity behind a unit tag: its dimension and the size of the tag's base magnitude expressed in the
+/// coherent SI unit (e.g. 1/1000 for gram, since kilogram is coherent)
+struct QuantityOf {
+    using Dimension = D;
+    using Scale = S;
+};
+
+template<typename UnitTag>
+/// Quantity of a unit tag. Left undefined for tags that don't take part in dimensional analysis (e.g. celsius).
+struct Quantity {};
+
+template<typename D>
+/// Tag for derived units that have no named unit tag (e.g. m^2 or m/s)
+struct TagDerived {};
+
+template<typename D>
+/// Unit tag that represents dimension `D`. Dimensions shared by multiple tags map to one of them: 1/s maps to
+/// frequency (not radioactivity) and J/kg to absorbed dose (not dose equivalent).
+struct TagOf {
+    using type = TagDerived<D>;
+};
+
+template<typename Tag>
+/// Helper to specialize TagOf
+struct TagIs {
+    using type = Tag;
+};
+
+template<typename D>
+using tag_of_t = typename TagOf<D>::type;
+
+template<typename D>
+struct Quantity<TagDerived<D>> : QuantityOf<D> {};
+
+// Quantities of the tags shipped with spine. The tags are declared here, such that the result type of unit arithmetic
+// never depends on which unit headers happen to be included.
+
+struct TagAbsorbedDose;
+struct TagAmountOfSubstance;
+struct TagCapacitance;
+struct TagCatalyticActivity;
+struct TagCharge;
+struct TagConductance;
+struct TagCurrent;
+struct TagDoseEquivalent;
+struct TagEnergy;
+struct TagForce;
+struct TagFrequency;
+struct TagIlluminance;
+struct TagInductance;
+struct TagKernelTime;
+struct TagLength;
+struct TagLuminousFlux;
+struct TagMagneticFlux;
+struct TagMagneticFluxDensity;
+struct TagMass;
+struct TagPotential;
+struct TagPower;
+struct TagPressure;
+struct TagRadioactivity;
+struct TagResistance;
+struct TagTemperatureKelvin;
+struct TagTime;
+struct TagVolume;
+
+template<>
+struct Quantity<TagLength> : QuantityOf<dimension::Length> {};
+template<>
+struct Quantity<TagMass> : QuantityOf<dimension::Mass, std::ratio<1, 1000>> {}; // gram
+template<>
+struct Quantity<TagTime> : QuantityOf<dimension::Time> {};
+template<>
+struct Quantity<TagKernelTime> : QuantityOf<dimension::Time> {};
+template<>
+struct Quantity<TagCurrent> : QuantityOf<dimension::Current> {};
+template<>
+struct Quantity<TagTemperatureKelvin> : QuantityOf<dimension::Temperature> {};
+template<>
+struct Quantity<TagAmountOfSubstance> : QuantityOf<dimension::AmountOfSubstance> {};
+template<>
+struct Quantity<TagLuminousFlux> : QuantityOf<dimension::LuminousFlux> {};
+template<>
+struct Quantity<TagIlluminance> : QuantityOf<dimension::Illuminance> {};
+template<>
+struct Quantity<TagFrequency> : QuantityOf<dimension::Frequency> {};
+template<>
+struct Quantity<TagRadioactivity> : QuantityOf<dimension::Frequency> {};
+template<>
+struct Quantity<TagForce> : QuantityOf<dimension::Force> {};
+template<>
+struct Quantity<TagPressure> : QuantityOf<dimension::Pressure> {};
+template<>
+struct Quantity<TagEnergy> : QuantityOf<dimension::Energy> {};
+template<>
+struct Quantity<TagPower> : QuantityOf<dimension::Power> {};
+template<>
+struct Quantity<TagCharge> : QuantityOf<dimension::Charge> {};
+template<>
+struct Quantity<TagPotential> : QuantityOf<dimension::Potential> {};
+template<>
+struct Quantity<TagCapacitance> : QuantityOf<dimension::Capacitance> {};
+template<>
+struct Quantity<TagResistance> : QuantityOf<dimension::Resistance> {};
+template<>
+struct Quantity<TagConductance> : QuantityOf<dimension::Conductance> {};
+template<>
+struct Quantity<TagMagneticFlux> : QuantityOf<dimension::MagneticFlux> {};
+template<>
+struct Quantity<TagMagneticFluxDensity> : QuantityOf<dimension::MagneticFluxDensity> {};
+template<>
+struct Quantity<TagInductance> : QuantityOf<dimension::Inductance> {};
+template<>
+struct Quantity<TagAbsorbedDose> : QuantityOf<dimension::AbsorbedDose> {};
+template<>
+struct Quantity<TagDoseEquivalent> : QuantityOf<dimension::AbsorbedDose> {};
+template<>
+struct Quantity<TagCatalyticActivity> : QuantityOf<dimension::CatalyticActivity> {};
+template<>
+struct Quantity<TagVolume> : QuantityOf<dimension::Volume, std::ratio<1, 1000>> {}; // litre
+
+// Canonical tag per dimension
+template<>
+struct TagOf<dimension::Length> : TagIs<TagLength> {};
+template<>
+struct TagOf<dimension::Mass> : TagIs<TagMass> {};
+template<>
+struct TagOf<dimension::Time> : TagIs<TagTime> {};
+template<>
+struct TagOf<dimension::Current> : TagIs<TagCurrent> {};
+template<>
+struct TagOf<dimension::Temperature> : TagIs<TagTemperatureKelvin> {};
+template<>
+struct TagOf<dimension::AmountOfSubstance> : TagIs<TagAmountOfSubstance> {};
+template<>
+struct TagOf<dimension::LuminousFlux> : TagIs<TagLuminousFlux> {};
+template<>
+struct TagOf<dimension::Illuminance> : TagIs<TagIlluminance> {};
+template<>
+struct TagOf<dimension::Frequency> : TagIs<TagFrequency> {};
+template<>
+struct TagOf<dimension::Force> : TagIs<TagForce> {};
+template<>
+struct TagOf<dimension::Pressure> : TagIs<TagPressure> {};
+template<>
+struct TagOf<dimension::Energy> : TagIs<TagEnergy> {};
+template<>
+struct TagOf<dimension::Power> : TagIs<TagPower> {};
+template<>
+struct TagOf<dimension::Charge> : TagIs<TagCharge> {};
+template<>
+struct TagOf<dimension::Potential> : TagIs<TagPotential> {};
+template<>
+struct TagOf<dimension::Capacitance> : TagIs<TagCapacitance> {};
+template<>
+struct TagOf<dimension::Resistance> : TagIs<TagResistance> {};
+template<>
+struct TagOf<dimension::Conductance> : TagIs<TagConductance> {};
+template<>
+struct TagOf<dimension::MagneticFlux> : TagIs<TagMagneticFlux> {};
+template<>
+struct TagOf<dimension::MagneticFluxDensity> : TagIs<TagMagneticFluxDensity> {};
+template<>
+struct TagOf<dimension::Inductance> : TagIs<TagInductance> {};
+template<>
+struct TagOf<dimension::AbsorbedDose> : TagIs<TagAbsorbedDose> {};
+template<>
+struct TagOf<dimension::CatalyticActivity> : TagIs<TagCatalyticActivity> {};
+template<>
+struct TagOf<dimension::Volume> : TagIs<TagVolume> {};
+
+} // namespace spn::structure::units
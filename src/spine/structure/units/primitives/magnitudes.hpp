@@ -1,79 +1,43 @@
 #pragma once
 
+#include <cstdint>
+#include <ratio>
+
 namespace spn::structure::units {
 
-// SI magnitude tags
-struct Atto {
-    static constexpr float Magnitude = 1e-18f;
-};
-struct Femto {
-    static constexpr float Magnitude = 1e-15f;
-};
-struct Pico {
-    static constexpr float Magnitude = 1e-12f;
-};
-struct Nano {
-    static constexpr float Magnitude = 1e-9f;
-};
-struct Micro {
-    static constexpr float Magnitude = 1e-6f;
-};
-struct Milli {
-    static constexpr float Magnitude = 1e-3f;
-};
-struct Centi {
-    static constexpr float Magnitude = 1e-2f;
-};
-struct Deci {
-    static constexpr float Magnitude = 1e-1f;
-};
-struct Deca {
-    static constexpr float Magnitude = 1e1f;
-};
-struct Hecto {
-    static constexpr float Magnitude = 1e2f;
-};
-struct Kilo {
-    static constexpr float Magnitude = 1e3f;
-};
-struct Mega {
-    static constexpr float Magnitude = 1e6f;
-};
-struct Giga {
-    static constexpr float Magnitude = 1e9f;
-};
-struct Tera {
-    static constexpr float Magnitude = 1e12f;
-};
-struct Peta {
-    static constexpr float Magnitude = 1e15f;
-};
-struct Exa {
-    static constexpr float Magnitude = 1e18f;
+template<intmax_t Num, intmax_t Den = 1>
+/// Magnitude tag holding the exact ratio `Num/Den` relative to the base unit, such that conversions between
+/// magnitudes can be done with integer arithmetic (for integral units) and a single constant (for real units)
+struct MagnitudeRatio {
+    using Ratio = typename std::ratio<Num, Den>::type;
 };
 
-struct Base {
-    static constexpr float Magnitude = 1.0f;
-};
+// SI magnitude tags
+struct Atto : MagnitudeRatio<1, 1000000000000000000> {};
+struct Femto : MagnitudeRatio<1, 1000000000000000> {};
+struct Pico : MagnitudeRatio<1, 1000000000000> {};
+struct Nano : MagnitudeRatio<1, 1000000000> {};
+struct Micro : MagnitudeRatio<1, 1000000> {};
+struct Milli : MagnitudeRatio<1, 1000> {};
+struct Centi : MagnitudeRatio<1, 100> {};
+struct Deci : MagnitudeRatio<1, 10> {};
+struct Deca : MagnitudeRatio<10> {};
+struct Hecto : MagnitudeRatio<100> {};
+struct Kilo : MagnitudeRatio<1000> {};
+struct Mega : MagnitudeRatio<1000000> {};
+struct Giga : MagnitudeRatio<1000000000> {};
+struct Tera : MagnitudeRatio<1000000000000> {};
+struct Peta : MagnitudeRatio<1000000000000000> {};
+struct Exa : MagnitudeRatio<1000000000000000000> {};
+
+struct Base : MagnitudeRatio<1> {};
 
 // time types
-struct Minute {
-    static constexpr float Magnitude = 60.0f;
-};
-struct Hour {
-    static constexpr float Magnitude = 60.0f * 60.0f;
-};
-struct Day {
-    static constexpr float Magnitude = 60.0f * 60.0f * 24.0f;
-};
-struct Week {
-    static constexpr float Magnitude = Day::Magnitude * 7.0f;
-};
-struct Month {
-    static constexpr float Magnitude = Week::Magnitude * 4.0f;
-};
-struct Year {
-    static constexpr float Magnitude = Day::Magnitude * 365.0f;
-};
+struct Minute : MagnitudeRatio<60> {};
+struct Hour : MagnitudeRatio<60 * 60> {};
+struct Day : MagnitudeRatio<60 * 60 * 24> {};
+struct Week : MagnitudeRatio<60 * 60 * 24 * 7> {};
+struct Month : MagnitudeRatio<60 * 60 * 24 * 7 * 4> {};
+struct Year : MagnitudeRatio<60 * 60 * 24 * 365> {};
 
 } // namespace spn::structure::units
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "spine/structure/units/primitives/dimension.hpp"
+
+#include <cstdint>
+#include <ratio>
+#include <string_view>
+
+namespace spn::structure::units {
+
+struct TagTemperatureCelsius;
+
+template<typename UnitTag>
+/// Symbol of the base magnitude of a unit tag, empty for tags without one
+struct Symbol {
+    static constexpr std::string_view value = {};
+};
+
+template<typename UnitTag>
+constexpr std::string_view symbol_v = Symbol<UnitTag>::value;
+
+#define SPN_UNIT_SYMBOL(Tag, Text)                                                                                     \
+    template<>                                                                                                         \
+    struct Symbol<Tag> {                                                                                               \
+        static constexpr std::string_view value = Text;                                                                \
+    };
+
+SPN_UNIT_SYMBOL(TagAbsorbedDose, "Gy")
+SPN_UNIT_SYMBOL(TagAmountOfSubstance, "mol")
+SPN_UNIT_SYMBOL(TagCapacitance, "F")
+SPN_UNIT_SYMBOL(TagCatalyticActivity, "kat")
+SPN_UNIT_SYMBOL(TagCharge, "C")
+SPN_UNIT_SYMBOL(TagConductance, "S")
+SPN_UNIT_SYMBOL(TagCurrent, "A")
+SPN_UNIT_SYMBOL(TagDoseEquivalent, "Sv")
+SPN_UNIT_SYMBOL(TagEnergy, "J")
+SPN_UNIT_SYMBOL(TagForce, "N")
+SPN_UNIT_SYMBOL(TagFrequency, "Hz")
+SPN_UNIT_SYMBOL(TagIlluminance, "lx")
+SPN_UNIT_SYMBOL(TagInductance, "H")
+SPN_UNIT_SYMBOL(TagKernelTime, "s")
+SPN_UNIT_SYMBOL(TagLength, "m")
+SPN_UNIT_SYMBOL(TagLuminousFlux, "lm")
+SPN_UNIT_SYMBOL(TagMagneticFlux, "Wb")
+SPN_UNIT_SYMBOL(TagMagneticFluxDensity, "T")
+SPN_UNIT_SYMBOL(TagMass, "g")
+SPN_UNIT_SYMBOL(TagPotential, "V")
+SPN_UNIT_SYMBOL(TagPower, "W")
+SPN_UNIT_SYMBOL(TagPressure, "Pa")
+SPN_UNIT_SYMBOL(TagRadioactivity, "Bq")
+SPN_UNIT_SYMBOL(TagResistance, "Ohm")
+SPN_UNIT_SYMBOL(TagTemperatureCelsius, "degC")
+SPN_UNIT_SYMBOL(TagTemperatureKelvin, "K")
+SPN_UNIT_SYMBOL(TagTime, "s")
+SPN_UNIT_SYMBOL(TagVolume, "L")
+
+#undef SPN_UNIT_SYMBOL
+
+template<typename Ratio>
+/// Returns the SI prefix of a magnitude ratio, or an empty view when the ratio isn't a power of 1000 (or c, d, da, h)
+constexpr std::string_view si_prefix() {
+    constexpr auto num = Ratio::num;
+    constexpr auto den = Ratio::den;
+    if constexpr (num == 1 && den == 1) return "";
+    else if constexpr (num == 1 && den == 1000000000000000000) return "a";
+    else if constexpr (num == 1 && den == 1000000000000000) return "f";
+    else if constexpr (num == 1 && den == 1000000000000) return "p";
+    else if constexpr (num == 1 && den == 1000000000) return "n";
+    else if constexpr (num == 1 && den == 1000000) return "u";
+    else if constexpr (num == 1 && den == 1000) return "m";
+    else if constexpr (num == 1 && den == 100) return "c";
+    else if constexpr (num == 1 && den == 10) return "d";
+    else if constexpr (num == 10 && den == 1) return "da";
+    else if constexpr (num == 100 && den == 1) return "h";
+    else if constexpr (num == 1000 && den == 1) return "k";
+    else if constexpr (num == 1000000 && den == 1) return "M";
+    else if constexpr (num == 1000000000 && den == 1) return "G";
+    else if constexpr (num == 1000000000000 && den == 1) return "T";
+    else if constexpr (num == 1000000000000000 && den == 1) return "P";
+    else if constexpr (num == 1000000000000000000 && den == 1) return "E";
+    else return {};
+}
+
+template<typename Ratio>
+/// Returns the symbol of a time magnitude that has no SI prefix (minute, hour, day, ...), or an empty view. The
+/// symbols match what `utils::parse_duration` accepts where possible.
+constexpr std::string_view time_symbol() {
+    constexpr auto seconds = Ratio::num / Ratio::den;
+    if constexpr (Ratio::den != 1) return {};
+    else if constexpr (seconds == 60) return "m";
+    else if constexpr (seconds == 60 * 60) return "h";
+    else if constexpr (seconds == 60 * 60 * 24) return "d";
+    else if constexpr (seconds == 60 * 60 * 24 * 7) return "w";
+    else if constexpr (seconds == 60 * 60 * 24 * 7 * 4) return "mo";
+    else if constexpr (seconds == 60 * 60 * 24 * 365) return "y";
+    else return {};
+}
+
+} // namespace spn::structure::units
@@ -1,145 +1,317 @@
 #pragma once
 
 #include "spine/core/exception.hpp"
+#include "spine/core/fixed.hpp"
+#include "spine/structure/units/primitives/dimension.hpp"
+#include "spine/structure/units/primitives/magnitudes.hpp"
 
-#include <cmath>
+#include <algorithm>
 #include <cstdint>
+#include <limits>
+#include <ratio>
 #include <type_traits>
 
 namespace spn::structure::units {
 
+template<typename UT, typename MT, typename VT>
+class Unit;
+
+namespace detail {
+
+template<typename Tag, typename = void>
+/// True when `Tag` has a Quantity (dimension) and can thus take part in unit multiplication and division
+struct has_dimension : std::false_type {};
+template<typename Tag>
+struct has_dimension<Tag, std::void_t<typename Quantity<Tag>::Dimension>> : std::true_type {};
+
+/// True for values a unit can be scaled by
+template<typename T>
+constexpr bool is_scalar_v = std::is_arithmetic_v<T> || is_fixed_v<T>;
+
+template<typename T>
+/// constexpr replacement for std::fabs/std::abs
+constexpr T abs(T value) {
+    return value < 0 ? -value : value;
+}
+
+template<typename A, typename B>
+using enable_if_dimensional_t = std::enable_if_t<has_dimension<A>::value && has_dimension<B>::value>;
+
+template<typename D, typename VT>
+/// Type of a value with dimension `D`: a unit in the base magnitude of the dimension's tag, or VT when dimensionless
+struct UnitOfDimension {
+    using type = Unit<tag_of_t<D>, Base, VT>;
+};
+template<typename VT>
+struct UnitOfDimension<dimension::Dimensionless, VT> {
+    using type = VT;
+};
+
+template<typename D, typename VT>
+using unit_of_dimension_t = typename UnitOfDimension<D, VT>::type;
+
+template<typename U>
+/// Scale of the tag of unit `U` (1 for plain values)
+struct ScaleOf {
+    using type = std::ratio<1>;
+};
+template<typename UT, typename MT, typename VT>
+struct ScaleOf<Unit<UT, MT, VT>> {
+    using type = typename Quantity<UT>::Scale;
+};
+
+} // namespace detail
+
 /// Abstract unit with UnitTag U, Magnitude tag M, and ValueType T
 template<typename UT, typename MT, typename VT>
 class Unit {
 public:
     using UnitTag = UT;
+    using Magnitude = MT;
     using ValueType = VT;
 
-    static_assert(std::is_arithmetic_v<VT>, "ValueType T must be an arithmetic type.");
+    static_assert(detail::is_scalar_v<VT>, "ValueType T must be an arithmetic or fixed point type.");
 
     constexpr Unit() = default;
     constexpr explicit Unit(const VT length) : _value(length) {}
 
-    Unit(const Unit&) = default;
-    Unit& operator=(const Unit&) = default;
-    Unit(Unit&&) = default;
-    Unit& operator=(Unit&&) = default;
+    constexpr Unit(const Unit&) = default;
+    constexpr Unit& operator=(const Unit&) = default;
+    constexpr Unit(Unit&&) = default;
+    constexpr Unit& operator=(Unit&&) = default;
 
     template<typename T = ValueType>
     constexpr T raw() const {
         return static_cast<T>(_value);
     }
 
-    bool is_negative() const { return _value < 0; }
+    constexpr bool is_negative() const { return _value < 0; }
     static constexpr bool is_integral() { return std::is_integral_v<VT>; }
 
     template<typename MOther>
-    Unit(const Unit<UT, MOther, VT>& other) : _value(from_other(other)) {}
+    constexpr Unit(const Unit<UT, MOther, VT>& other) : _value(from_other(other)) {}
 
     template<typename MOther>
-    Unit<UT, MT, VT>& operator=(const Unit<UT, MOther, VT>& other) {
+    constexpr Unit<UT, MT, VT>& operator=(const Unit<UT, MOther, VT>& other) {
         _value = from_other(other);
         return *this;
     }
     template<typename MOther>
-    Unit<UT, MT, VT>& operator=(Unit<UT, MOther, VT>&& other) {
+    constexpr Unit<UT, MT, VT>& operator=(Unit<UT, MOther, VT>&& other) {
         _value = from_other(other);
         return *this;
     }
 
     template<typename MOther>
-    [[nodiscard]] Unit<UT, MT, VT> operator+(const Unit<UT, MOther, VT>& other) const {
+    [[nodiscard]] constexpr Unit<UT, MT, VT> operator+(const Unit<UT, MOther, VT>& other) const {
         return Unit<UT, MT, VT>{_value + from_other(other)};
     }
     template<typename MOther>
-    [[nodiscard]] Unit<UT, MT, VT> operator-(const Unit<UT, MOther, VT>& other) const {
+    [[nodiscard]] constexpr Unit<UT, MT, VT> operator-(const Unit<UT, MOther, VT>& other) const {
         return Unit<UT, MT, VT>{_value - from_other(other)};
     }
-    [[nodiscard]] Unit operator-() const { return Unit(-_value); }
+    [[nodiscard]] constexpr Unit operator-() const { return Unit(-_value); }
     template<typename MOther>
-    Unit<UT, MT, VT>& operator-=(const Unit<UT, MOther, VT>& other) {
+    constexpr Unit<UT, MT, VT>& operator-=(const Unit<UT, MOther, VT>& other) {
         _value -= from_other(other);
         return *this;
     }
     template<typename MOther>
-    Unit<UT, MT, VT>& operator+=(const Unit<UT, MOther, VT>& other) {
+    constexpr Unit<UT, MT, VT>& operator+=(const Unit<UT, MOther, VT>& other) {
         _value += from_other(other);
         return *this;
     }
-    template<typename MOther>
-    /// Unstable API: todo: this should return an area
-    [[nodiscard]] Unit<UT, MT, VT> operator*(const Unit<UT, MOther, VT>& other) const {
-        return Unit<UT, MT, VT>{_value * from_other(other)};
+    template<typename UTOther, typename MOther, typename = detail::enable_if_dimensional_t<UT, UTOther>>
+    /// Returns the product in the derived unit (e.g. newton * meter yields joule), or a plain value when dimensionless
+    [[nodiscard]] constexpr auto operator*(const Unit<UTOther, MOther, VT>& other) const {
+        return combine<false>(other);
     }
-    template<typename MOther>
-    [[nodiscard]] Unit<UT, MT, VT> operator/(const Unit<UT, MOther, VT>& other) const {
-        const auto other_value = from_other(other);
-        if (other_value == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
-        return Unit<UT, MT, VT>{_value / other_value};
+    template<typename UTOther, typename MOther, typename = detail::enable_if_dimensional_t<UT, UTOther>>
+    /// Returns the quotient in the derived unit (e.g. joule / second yields watt), or a plain value when dimensionless
+    [[nodiscard]] constexpr auto operator/(const Unit<UTOther, MOther, VT>& other) const {
+        if (other.raw() == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
+        return combine<true>(other);
     }
 
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, Unit> operator*(const AT& scalar) const {
+    constexpr std::enable_if_t<detail::is_scalar_v<AT>, Unit> operator*(const AT& scalar) const {
         return Unit{_value * scalar};
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, Unit&> operator*=(const AT& scalar) {
+    constexpr std::enable_if_t<detail::is_scalar_v<AT>, Unit&> operator*=(const AT& scalar) {
         _value *= scalar;
         return *this;
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, Unit> operator/(const AT& scalar) const {
+    constexpr std::enable_if_t<detail::is_scalar_v<AT>, Unit> operator/(const AT& scalar) const {
         if (scalar == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
         return Unit{_value / scalar};
     }
     template<typename AT>
-    std::enable_if_t<std::is_arithmetic_v<AT>, Unit&> operator/=(const AT& scalar) {
+    constexpr std::enable_if_t<detail::is_scalar_v<AT>, Unit&> operator/=(const AT& scalar) {
         if (scalar == 0) spn::throw_exception(runtime_exception("tried to divide by zero"));
         _value /= scalar;
         return *this;
     }
 
     template<typename MOther>
-    bool operator==(const Unit<UT, MOther, VT>& other) const {
-        if constexpr (std::is_integral_v<VT>) return _value == from_other(other);
-        return approximately_equal(_value, from_other(other));
+    constexpr bool operator==(const Unit<UT, MOther, VT>& other) const {
+        if constexpr (!std::is_floating_point_v<VT>) return compare(other) == 0;
+        else return approximately_equal(_value, from_other(other));
     }
     template<typename MOther>
-    bool operator!=(const Unit<UT, MOther, VT>& other) const {
+    constexpr bool operator!=(const Unit<UT, MOther, VT>& other) const {
         return !(*this == other);
     }
     template<typename MOther>
-    bool operator<(const Unit<UT, MOther, VT>& other) const {
-        return _value < from_other(other);
+    constexpr bool operator<(const Unit<UT, MOther, VT>& other) const {
+        return compare(other) < 0;
     }
     template<typename MOther>
-    bool operator>(const Unit<UT, MOther, VT>& other) const {
-        return _value > from_other(other);
+    constexpr bool operator>(const Unit<UT, MOther, VT>& other) const {
+        return compare(other) > 0;
     }
     template<typename MOther>
-    bool operator<=(const Unit<UT, MOther, VT>& other) const {
-        return _value <= from_other(other);
+    constexpr bool operator<=(const Unit<UT, MOther, VT>& other) const {
+        return compare(other) <= 0;
     }
     template<typename MOther>
-    bool operator>=(const Unit<UT, MOther, VT>& other) const {
-        return _value >= from_other(other);
+    constexpr bool operator>=(const Unit<UT, MOther, VT>& other) const {
+        return compare(other) >= 0;
     }
 
 private:
     static constexpr ValueType epsilon = std::numeric_limits<ValueType>::epsilon();
 
-    bool approximately_equal(ValueType a, ValueType b) const {
-        return std::fabs(a - b) <= epsilon * std::max(std::fabs(a), std::fabs(b));
+    static constexpr bool approximately_equal(ValueType a, ValueType b) {
+        return detail::abs(a - b) <= epsilon * std::max(detail::abs(a), detail::abs(b));
     }
 
 private:
     ValueType _value = 0;
 
+    template<typename R>
+    static constexpr long double to_real() {
+        return static_cast<long double>(R::num) / static_cast<long double>(R::den);
+    }
+
+    template<bool Divide, typename UTOther, typename MOther>
+    /// Multiply or divide by `other`. The result is expressed in the base magnitude of the tag belonging to the
+    /// resulting dimension; all magnitudes and scales fold into a single compile-time factor (skipped when it is 1).
+    constexpr auto combine(const Unit<UTOther, MOther, VT>& other) const {
+        using DThis = typename Quantity<UT>::Dimension;
+        using DOther = typename Quantity<UTOther>::Dimension;
+        using D = std::conditional_t<Divide, dimension::quotient_t<DThis, DOther>, dimension::product_t<DThis, DOther>>;
+        using Result = detail::unit_of_dimension_t<D, VT>;
+        using ResultScale = typename detail::ScaleOf<Result>::type;
+
+        using ScaleThis = std::ratio_multiply<typename MT::Ratio, typename Quantity<UT>::Scale>;
+        using ScaleOther = std::ratio_multiply<typename MOther::Ratio, typename Quantity<UTOther>::Scale>;
+
+        if constexpr (is_integral()) {
+            using Combined = std::conditional_t<Divide, std::ratio_divide<ScaleThis, ScaleOther>,
+                                                std::ratio_multiply<ScaleThis, ScaleOther>>;
+            using F = std::ratio_divide<Combined, ResultScale>;
+            if constexpr (Divide) {
+                return Result((_value * static_cast<VT>(F::num)) / (other.raw() * static_cast<VT>(F::den)));
+            } else {
+                return Result(_value * other.raw() * static_cast<VT>(F::num) / static_cast<VT>(F::den));
+            }
+        } else {
+            constexpr auto combined = Divide ? to_real<ScaleThis>() / to_real<ScaleOther>()
+                                             : to_real<ScaleThis>() * to_real<ScaleOther>();
+            constexpr auto factor = static_cast<VT>(combined / to_real<ResultScale>());
+            const auto value = Divide ? _value / other.raw() : _value * other.raw();
+            if constexpr (factor == VT(1)) return Result(value);
+            return Result(value * factor);
+        }
+    }
+
+    template<typename MOther>
+    /// Exact ratio by which a raw value in magnitude `MOther` is multiplied to express it in this unit's magnitude.
+    /// Only used for integral units: real units may span ratios (e.g. giga to pico) that don't fit in an intmax_t.
+    using RatioFrom = std::ratio_divide<typename MOther::Ratio, typename MT::Ratio>;
+
+    template<typename MOther>
+    /// Returns true when magnitude `MOther` equals this unit's magnitude
+    static constexpr bool is_same_magnitude() {
+        return std::ratio_equal_v<typename MOther::Ratio, typename MT::Ratio>;
+    }
+
+    /// Divide `value` by `divisor`, rounding half away from zero (like std::round)
+    static constexpr ValueType divide_rounded(ValueType value, ValueType divisor) {
+        const auto half = divisor / 2;
+        return value < 0 ? -((-value + half) / divisor) : (value + half) / divisor;
+    }
+
+    template<typename MOther>
+    /// Convert the raw value of `other` to this unit's magnitude. Same-magnitude conversions are a no-op, integral
+    /// conversions use integer multiplication/division only and real conversions multiply by a single constant.
+    static constexpr ValueType from_other(const Unit<UT, MOther, VT>& other) {
+        if constexpr (is_same_magnitude<MOther>()) {
+            return other.raw();
+        } else if constexpr (is_integral()) {
+            using R = RatioFrom<MOther>;
+            if constexpr (R::den == 1) return other.raw() * static_cast<VT>(R::num);
+            return divide_rounded(other.raw() * static_cast<VT>(R::num), static_cast<VT>(R::den));
+        } else {
+            using RO = typename MOther::Ratio;
+            using RT = typename MT::Ratio;
+            constexpr auto ratio =
+                (static_cast<long double>(RO::num) * RT::den) / (static_cast<long double>(RO::den) * RT::num);
+            // fixed point can't represent small ratios accurately (1/1000 is off by 0.7% in Q15.16), so divide by the
+            // inverse instead
+            if constexpr (is_fixed_v<VT> && ratio < 1) return other.raw() / static_cast<VT>(1 / ratio);
+            else return static_cast<VT>(ratio) * other.raw();
+        }
+    }
+
     template<typename MOther>
-    ValueType from_other(const Unit<UT, MOther, VT>& other) const {
-        constexpr float ratio = MOther::Magnitude / MT::Magnitude;
-        if constexpr (is_integral()) return std::round(ratio * other.raw());
-        return ratio * other.raw();
+    /// Returns <0, 0 or >0 when this unit is smaller, equal or larger than `other`. Integral units are compared
+    /// exactly for any pair of magnitudes: `a` and `b` are cross-multiplied by the ratio between them, so that e.g.
+    /// `k_time_s(1) < k_time_ms(1400)` holds and a year isn't rounded to 13 months. Products that overflow are compared
+    /// by quotient and remainder instead.
+    constexpr int compare(const Unit<UT, MOther, VT>& other) const {
+        if constexpr (is_integral() && !is_same_magnitude<MOther>()) {
+            // `other` is `b * num / den` in this magnitude, so compare `a * den` with `b * num`
+            using R = RatioFrom<MOther>;
+            constexpr auto max = static_cast<uintmax_t>(std::numeric_limits<VT>::max());
+            static_assert(static_cast<uintmax_t>(R::num) <= max / static_cast<uintmax_t>(R::den),
+                          "the magnitudes' ratio must fit the unit's value type");
+            constexpr auto num = static_cast<VT>(R::num);
+            constexpr auto den = static_cast<VT>(R::den);
+            VT a = _value;
+            VT b = other.raw();
+            VT lhs{};
+            VT rhs{};
+            if (!__builtin_mul_overflow(a, den, &lhs) && !__builtin_mul_overflow(b, num, &rhs)) {
+                return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+            }
+            // a / num <=> b / den: floored quotients first, then the remainders (ra < num and rb < den, so their
+            // products fit by the assertion above)
+            VT qa = a / num;
+            VT ra = a % num;
+            VT qb = b / den;
+            VT rb = b % den;
+            if constexpr (std::is_signed_v<VT>) {
+                if (ra < 0) {
+                    ra += num;
+                    --qa;
+                }
+                if (rb < 0) {
+                    rb += den;
+                    --qb;
+                }
+            }
+            if (qa != qb) return qa < qb ? -1 : 1;
+            lhs = ra * den;
+            rhs = rb * num;
+            return lhs < rhs ? -1 : (lhs > rhs ? 1 : 0);
+        } else {
+            const ValueType a = _value;
+            const ValueType b = from_other(other);
+            return a < b ? -1 : (a > b ? 1 : 0);
+        }
     }
 };
 
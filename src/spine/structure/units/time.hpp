@@ -5,6 +5,7 @@
 #include "spine/structure/units/primitives/unit.hpp"
 
 #include <cmath>
+#include <limits>
 
 namespace spn::structure::units {
 struct TagTime {};
@@ -23,7 +24,8 @@ using time_M = spnu::Unit<spnu::TagTime, spnu::Month, spnu::TimeRawType>;
 using time_Y = spnu::Unit<spnu::TagTime, spnu::Year, spnu::TimeRawType>;
 
 // Kernel time, with unit: second
-// Pay attention: `k_time_s(k_time_ms(500) == 0` holds true, since kernel time works on an int64
+// Pay attention: `k_time_s(k_time_ms(500)) == k_time_s(1)` holds true, since kernel time works on an integer and
+// conversions to a coarser magnitude round to the nearest value. Comparisons between magnitudes are exact.
 using k_time_us = spnu::Unit<spnu::TagKernelTime, spnu::Micro, spnu::KernelTimeRawType>;
 using k_time_ms = spnu::Unit<spnu::TagKernelTime, spnu::Milli, spnu::KernelTimeRawType>;
 using k_time_s = spnu::Unit<spnu::TagKernelTime, spnu::Base, spnu::KernelTimeRawType>;
@@ -31,18 +33,31 @@ using k_time_m = spnu::Unit<spnu::TagKernelTime, spnu::Minute, spnu::KernelTimeR
 using k_time_h = spnu::Unit<spnu::TagKernelTime, spnu::Hour, spnu::KernelTimeRawType>;
 using k_time_d = spnu::Unit<spnu::TagKernelTime, spnu::Day, spnu::KernelTimeRawType>;
 
+namespace spn::structure::units::detail {
+/// constexpr replacement for std::ceil
+constexpr TimeRawType ceil(TimeRawType value) {
+    // values of this size have no fractional part (and may not fit the integer type)
+    constexpr auto integral_from = static_cast<TimeRawType>(1ull << (std::numeric_limits<TimeRawType>::digits - 1));
+    if (!(value < integral_from && value > -integral_from)) return value;
+    const auto truncated = static_cast<TimeRawType>(static_cast<KernelTimeRawType>(value));
+    return truncated < value ? truncated + 1 : truncated;
+}
+} // namespace spn::structure::units::detail
+
 template<typename M>
 /// Returns a kernel_time for a provided time. Second argument is a rounding function such as std::floor, std::round or
-/// std::ceil. Defaults to std::ceil such that a time_ms(1.5) returns k_time_ms(2) as that is considered safest.
-inline spnu::Unit<spnu::TagKernelTime, M, spnu::KernelTimeRawType>
+/// std::ceil. Defaults to ceiling (constexpr evaluable) such that a time_ms(1.5) returns k_time_ms(2) as that is
+/// considered safest.
+constexpr spnu::Unit<spnu::TagKernelTime, M, spnu::KernelTimeRawType>
 to_kernel_time(const spnu::Unit<spnu::TagTime, M, spnu::TimeRawType> other,
-               spnu::TimeRawType (*rounding_func)(spnu::TimeRawType) = std::ceil) {
-    return spnu::Unit<spnu::TagKernelTime, M, spnu::KernelTimeRawType>(rounding_func(other.raw())); // bankers' rounding
+               spnu::TimeRawType (*rounding_func)(spnu::TimeRawType) = nullptr) {
+    const auto rounded = rounding_func ? rounding_func(other.raw()) : spnu::detail::ceil(other.raw());
+    return spnu::Unit<spnu::TagKernelTime, M, spnu::KernelTimeRawType>(rounded);
 }
 
 template<typename M>
 /// Returns a real `time` for a kernel time `k_time`.
-inline spnu::Unit<spnu::TagTime, M, spnu::TimeRawType>
+constexpr spnu::Unit<spnu::TagTime, M, spnu::TimeRawType>
 to_real_time(const spnu::Unit<spnu::TagKernelTime, M, spnu::KernelTimeRawType> other) {
     return spnu::Unit<spnu::TagTime, M, spnu::TimeRawType>(other.raw());
 }
\ No newline at end of file
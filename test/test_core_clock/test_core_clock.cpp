@@ -0,0 +1,193 @@
+#include "spine/controller/pid.hpp"
+#include "spine/core/clock.hpp"
+#include "spine/eventsystem/eventsystem.hpp"
+#include "spine/structure/time/timers.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+
+using spn::Clock;
+using namespace spn::core;
+
+namespace {
+
+uint32_t g_simulated_ms = 0;
+uint32_t simulated_source() { return g_simulated_ms; }
+
+enum class Events { EventA, Size };
+
+class CountingHandler : public EventHandler {
+public:
+    CountingHandler(EventSystem* evsys) : EventHandler(evsys) {}
+    void handle_event(const Event& event) override { ++count; }
+
+    int count = 0;
+};
+
+void ut_clock_injectable_source() {
+    const auto before = Clock::now();
+    g_simulated_ms = 1000;
+    Clock::set_source(simulated_source);
+    TEST_ASSERT_EQUAL(true, Clock::now() == before); // continues from the current time
+
+    g_simulated_ms += 250;
+    TEST_ASSERT_EQUAL(true, Clock::now() == before + k_time_ms(250));
+
+    Clock::set_source(nullptr);
+    TEST_ASSERT_EQUAL(true, Clock::now() >= before + k_time_ms(250));
+    HAL::delay(k_time_ms(10));
+    TEST_ASSERT_EQUAL(true, Clock::now() >= before + k_time_ms(260));
+}
+
+void ut_clock_does_not_wrap() {
+    g_simulated_ms = UINT32_MAX - 100;
+    Clock::set_source(simulated_source);
+    const auto before = Clock::now();
+
+    g_simulated_ms += 200; // the source wraps around
+    const auto after = Clock::now();
+    TEST_ASSERT_EQUAL(200, (after - before).raw());
+    TEST_ASSERT_EQUAL(true, after > before);
+
+    // beyond 2^32 ms (~49.7 days)
+    for (int i = 0; i < 3; ++i) {
+        g_simulated_ms += UINT32_MAX / 2;
+        Clock::now();
+    }
+    TEST_ASSERT_EQUAL(true, Clock::now().raw() > static_cast<spnu::KernelTimeRawType>(UINT32_MAX));
+
+    Clock::set_source(nullptr);
+}
+
+void ut_clock_tick_snapshot() {
+    g_simulated_ms = 0;
+    Clock::set_source(simulated_source);
+
+    const auto snapshot = Clock::tick();
+    TEST_ASSERT_EQUAL(true, Clock::is_ticking());
+    const auto reads = Clock::reads();
+    g_simulated_ms += 100;
+    TEST_ASSERT_EQUAL(true, Clock::now() == snapshot);
+    TEST_ASSERT_EQUAL(reads, Clock::reads());
+
+    Clock::release();
+    TEST_ASSERT_EQUAL(false, Clock::is_ticking());
+    TEST_ASSERT_EQUAL(true, Clock::now() == snapshot + k_time_ms(100));
+
+    {
+        const auto outer = Clock::ScopedTick();
+        const auto held = Clock::now();
+        g_simulated_ms += 100;
+        {
+            const auto inner = Clock::ScopedTick(); // nested: doesn't read the clock again
+            TEST_ASSERT_EQUAL(true, Clock::now() == held);
+        }
+        TEST_ASSERT_EQUAL(true, Clock::is_ticking());
+        TEST_ASSERT_EQUAL(true, Clock::now() == held);
+    }
+    TEST_ASSERT_EQUAL(false, Clock::is_ticking());
+
+    Clock::set_source(nullptr);
+}
+
+void ut_clock_timers_consult_clock() {
+    using spn::structure::time::AlarmTimer;
+    using spn::structure::time::IntervalTimer;
+
+    g_simulated_ms = 0;
+    Clock::set_source(simulated_source);
+
+    auto alarm = AlarmTimer(k_time_ms(50));
+    auto interval = IntervalTimer(k_time_ms(20));
+    g_simulated_ms += 60;
+    {
+        const auto tick = Clock::ScopedTick();
+        const auto reads = Clock::reads();
+        TEST_ASSERT_EQUAL(true, alarm.expired());
+        TEST_ASSERT_EQUAL(true, interval.expired());
+        TEST_ASSERT_EQUAL(-10, alarm.time_from_now().raw());
+        TEST_ASSERT_EQUAL(20, interval.time_until_next().raw());
+        TEST_ASSERT_EQUAL(reads, Clock::reads());
+    }
+
+    Clock::set_source(nullptr);
+}
+
+void ut_clock_one_read_per_loop() {
+    g_simulated_ms = 0;
+    Clock::set_source(simulated_source);
+
+    auto evsys = EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                              .events_cap = 32,
+                              .handler_cap = 1,
+                              .delay_between_ticks = false});
+    auto handler = CountingHandler(&evsys);
+    evsys.attach(Events::EventA, &handler);
+    for (int i = 1; i <= 16; ++i) {
+        evsys.schedule(Events::EventA, k_time_ms(i));
+    }
+
+    g_simulated_ms += 100;
+    const auto reads = Clock::reads();
+    evsys.loop();
+    TEST_ASSERT_EQUAL(16, handler.count);
+    TEST_ASSERT_EQUAL(reads + 1, Clock::reads());
+
+    Clock::set_source(nullptr);
+}
+
+void ut_clock_pid_consults_clock() {
+    g_simulated_ms = 0;
+    Clock::set_source(simulated_source);
+
+    auto pid = spn::controller::PID({.sample_interval = k_time_ms(100)});
+    pid.initialize();
+    pid.set_target_setpoint(10);
+    const auto reads = Clock::reads();
+    pid.new_reading(0); // the first reading is due right away
+    TEST_ASSERT_EQUAL(reads + 1, Clock::reads());
+    const auto response = pid.response();
+    TEST_ASSERT_TRUE(response > 0);
+
+    // simulated time stands still, so no update is due however long it really takes
+    HAL::delay(k_time_ms(150));
+    pid.new_reading(0);
+    TEST_ASSERT_EQUAL_FLOAT(response, pid.response());
+
+    g_simulated_ms += 100;
+    pid.new_reading(0);
+    TEST_ASSERT_TRUE(pid.response() != response);
+
+    Clock::set_source(nullptr);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_clock_injectable_source);
+    RUN_TEST(ut_clock_does_not_wrap);
+    RUN_TEST(ut_clock_tick_snapshot);
+    RUN_TEST(ut_clock_timers_consult_clock);
+    RUN_TEST(ut_clock_one_read_per_loop);
+    RUN_TEST(ut_clock_pid_consults_clock);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,165 @@
+#include "spine/controller/implementations/pid/pid_controller.hpp"
+#include "spine/core/fixed.hpp"
+#include "spine/filter/implementations/bandpass.hpp"
+#include "spine/filter/implementations/ewma.hpp"
+#include "spine/filter/implementations/mapped_range.hpp"
+#include "spine/structure/units/si.hpp"
+
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+
+using spn::Fixed;
+using Q16 = spn::fixed_q16;
+
+namespace {
+
+void ut_fixed_conversions() {
+    static_assert(sizeof(Q16) == sizeof(int32_t));
+    static_assert(sizeof(Fixed<3, 4>) == sizeof(int8_t));
+    static_assert(sizeof(Fixed<7, 8>) == sizeof(int16_t));
+    static_assert(Q16(1.5f).raw() == 3 * (1 << 15));
+    static_assert(std::is_trivially_copyable_v<Q16>);
+
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, static_cast<float>(Q16(1.5f)));
+    TEST_ASSERT_EQUAL_FLOAT(-2.25f, static_cast<float>(Q16(-2.25)));
+    TEST_ASSERT_EQUAL(3, static_cast<int>(Q16(3.75f)));
+    TEST_ASSERT_EQUAL(-3, static_cast<int>(Q16(-3.75f)));
+    TEST_ASSERT_EQUAL(42, static_cast<int>(Q16(42)));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 65536, 0.1f, static_cast<float>(Q16(0.1f)));
+    TEST_ASSERT_EQUAL(1, Q16::resolution().raw());
+}
+
+void ut_fixed_arithmetic() {
+    TEST_ASSERT_EQUAL(true, Q16(1.5f) + Q16(2.25f) == Q16(3.75f));
+    TEST_ASSERT_EQUAL(true, Q16(1.5f) - Q16(2.25f) == Q16(-0.75f));
+    TEST_ASSERT_EQUAL(true, Q16(1.5f) * Q16(-2) == Q16(-3));
+    TEST_ASSERT_EQUAL(true, Q16(3) / Q16(2) == Q16(1.5f));
+    TEST_ASSERT_EQUAL(true, Q16(-3) / Q16(4) == Q16(-0.75f));
+    TEST_ASSERT_EQUAL(true, -Q16(2) == Q16(-2));
+    TEST_ASSERT_EQUAL(true, Q16(2) * 3 == Q16(6));
+    TEST_ASSERT_EQUAL(true, Q16(1) < Q16(1.001f));
+    TEST_ASSERT_EQUAL(true, Q16(0) > -Q16::resolution());
+
+    auto v = Q16(1);
+    v += 1;
+    v *= Q16(2.5f);
+    v /= 5;
+    ++v;
+    TEST_ASSERT_EQUAL(true, v == Q16(2));
+
+    // results are rounded to the nearest representable value
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 65536, 1.0f / 3, static_cast<float>(Q16(1) / Q16(3)));
+    TEST_ASSERT_FLOAT_WITHIN(1.0f / 65536, 0.01f, static_cast<float>(Q16(0.1f) * Q16(0.1f)));
+}
+
+void ut_fixed_saturation() {
+    const auto max = Q16::max();
+    const auto lowest = Q16::lowest();
+    TEST_ASSERT_EQUAL(true, max + Q16(1) == max);
+    TEST_ASSERT_EQUAL(true, lowest - Q16(1) == lowest);
+    TEST_ASSERT_EQUAL(true, Q16(30000) * Q16(2) == max);
+    TEST_ASSERT_EQUAL(true, Q16(-30000) * Q16(2) == lowest);
+    TEST_ASSERT_EQUAL(true, -lowest == max);
+    TEST_ASSERT_EQUAL(true, Q16(1e9f) == max);
+    TEST_ASSERT_EQUAL(true, Q16(-1e9) == lowest);
+    TEST_ASSERT_EQUAL(true, Q16(100000) == max);
+    TEST_ASSERT_EQUAL(true, Q16(1) / Q16(0) == max);
+    TEST_ASSERT_EQUAL(true, Q16(-1) / Q16(0) == lowest);
+    TEST_ASSERT_EQUAL(true, Q16(20000) / Q16(0.5f) == max);
+    using Q4 = Fixed<3, 4>;
+    TEST_ASSERT_EQUAL(true, Q4(100) == Q4::max());
+    TEST_ASSERT_EQUAL_FLOAT(7.9375f, static_cast<float>(Q4::max()));
+}
+
+void ut_fixed_units() {
+    using meter_q = spnu::Unit<spnu::TagLength, spnu::Base, Q16>;
+    using meter_m_q = spnu::Unit<spnu::TagLength, spnu::Milli, Q16>;
+    using second_q = spnu::Unit<spnu::TagTime, spnu::Base, Q16>;
+
+    TEST_ASSERT_EQUAL(true, meter_q(1.5f) + meter_m_q(500) == meter_q(2));
+    TEST_ASSERT_EQUAL(true, meter_m_q(meter_q(1.25f)) == meter_m_q(1250));
+    TEST_ASSERT_EQUAL(true, meter_q(3) * 2 > meter_q(5));
+    TEST_ASSERT_EQUAL(true, (meter_q(6) / second_q(4)).raw() == Q16(1.5f));
+    TEST_ASSERT_EQUAL(false, meter_q(1).is_integral());
+}
+
+void ut_fixed_filters() {
+    auto ewma = spn::filter::EWMA<Q16>({.K = 4});
+    auto ewma_float = spn::filter::EWMA<float>({.K = 4});
+    for (int i = 0; i < 50; ++i) {
+        const auto sample = 10.0f + static_cast<float>(i % 5);
+        ewma.new_sample(Q16(sample));
+        ewma_float.new_sample(sample);
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.001f, ewma_float.value(), static_cast<float>(ewma.value()));
+
+    auto range = spn::filter::MappedRange<Q16>({.input_lower_limit = 0,
+                                                .input_upper_limit = 5,
+                                                .output_lower_limit = 0,
+                                                .output_upper_limit = 100,
+                                                .throw_for_value_out_of_range = false});
+    TEST_ASSERT_EQUAL(true, range.value(Q16(2.5f)) == Q16(50));
+    TEST_ASSERT_EQUAL(true, range.value(Q16(10)) == Q16(100));
+
+    auto bandpass = spn::filter::BandPass<Q16>(
+        {.mantissa = 1, .decades = 0, .offset = 0, .rejection_limit = 2, .throw_on_rejection_limit = false});
+    bandpass.reset_to(Q16(100));
+    TEST_ASSERT_EQUAL(true, bandpass.value(Q16(105)) == Q16(105));
+    TEST_ASSERT_EQUAL(true, bandpass.value(Q16(200)) == Q16(105));
+}
+
+void ut_fixed_pid() {
+    using PIDFixed = spn::controller::BasicPIDController<Q16>;
+    using PIDFloat = spn::controller::BasicPIDController<float>;
+
+    Q16 input_q = 0, output_q = 0, setpoint_q = 50;
+    float input_f = 0, output_f = 0, setpoint_f = 50;
+    auto pid_q = PIDFixed(&input_q, &output_q, &setpoint_q, 2, 0.5f, 0.1f, PIDFixed::Direction::FORWARD);
+    auto pid_f = PIDFloat(&input_f, &output_f, &setpoint_f, 2, 0.5f, 0.1f, PIDFloat::Direction::FORWARD);
+    pid_q.initialize();
+    pid_f.initialize();
+
+    auto now = HAL::millis();
+    for (int i = 0; i < 100; ++i) {
+        now += k_time_ms(100);
+        TEST_ASSERT_EQUAL(true, pid_q.update(now));
+        TEST_ASSERT_EQUAL(true, pid_f.update(now));
+        // simple first order plant
+        input_q += (output_q - input_q) / 10;
+        input_f += (output_f - input_f) / 10;
+    }
+    TEST_ASSERT_FLOAT_WITHIN(0.05f, input_f, static_cast<float>(input_q));
+    TEST_ASSERT_FLOAT_WITHIN(0.1f, output_f, static_cast<float>(output_q));
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_fixed_conversions);
+    RUN_TEST(ut_fixed_arithmetic);
+    RUN_TEST(ut_fixed_saturation);
+    RUN_TEST(ut_fixed_units);
+    RUN_TEST(ut_fixed_filters);
+    RUN_TEST(ut_fixed_pid);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,217 @@
+#include "spine/core/memory.hpp"
+#include "spine/eventsystem/eventsystem.hpp"
+#include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+#include "spine/structure/array.hpp"
+
+#include <unity.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
+#include <memory>
+#include <new>
+#if defined(NATIVE)
+#    include <thread>
+#endif
+
+using namespace spn::core;
+namespace memory = spn::memory;
+
+namespace {
+
+enum class Events { EventA, Size };
+
+class CountingHandler : public EventHandler {
+public:
+    CountingHandler(EventSystem* evsys) : EventHandler(evsys) {}
+    void handle_event(const Event& event) override { ++count; }
+
+    int count = 0;
+};
+
+void ut_memory_scoped_tag() {
+    TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::UNTAGGED);
+    {
+        const auto outer = memory::ScopedTag(memory::Subsystem::USER);
+        TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::USER);
+        {
+            const auto inner = memory::ScopedTag(memory::Subsystem::IO);
+            TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::IO);
+        }
+        TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::USER);
+    }
+    TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::UNTAGGED);
+    TEST_ASSERT_EQUAL_STRING("eventsystem", memory::to_string(memory::Subsystem::EVENTSYSTEM));
+}
+
+void ut_memory_container_accounting() {
+    const auto before = memory::usage(memory::Subsystem::USER);
+    {
+        const auto tag = memory::ScopedTag(memory::Subsystem::USER);
+        memory::reset_peak(memory::Subsystem::USER);
+
+        auto array = spn::structure::Array<uint32_t>(100);
+        const auto& during = memory::usage(memory::Subsystem::USER);
+        TEST_ASSERT_EQUAL(before.current_bytes + 100 * sizeof(uint32_t), during.current_bytes);
+        TEST_ASSERT_EQUAL(before.allocations + 1, during.allocations);
+        TEST_ASSERT_EQUAL(during.current_bytes, during.peak_bytes);
+    }
+    // the array was destroyed outside of the tag, but should still be released from the subsystem that allocated it
+    const auto& after = memory::usage(memory::Subsystem::USER);
+    TEST_ASSERT_EQUAL(before.current_bytes, after.current_bytes);
+    TEST_ASSERT_EQUAL(before.deallocations + 1, after.deallocations);
+    TEST_ASSERT_EQUAL(before.current_bytes + 100 * sizeof(uint32_t), after.peak_bytes);
+}
+
+void ut_memory_subsystem_accounting() {
+    const auto evsys_before = memory::usage(memory::Subsystem::EVENTSYSTEM).current_bytes;
+    const auto io_before = memory::usage(memory::Subsystem::IO).current_bytes;
+    {
+        auto evsys = EventSystem({.events_count = 1, .events_cap = 16, .handler_cap = 2, .delay_between_ticks = false});
+        TEST_ASSERT_GREATER_THAN(evsys_before, memory::usage(memory::Subsystem::EVENTSYSTEM).current_bytes);
+
+        auto stream = std::make_shared<spn::io::MockStream>(
+            spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 64});
+        auto buffered_stream =
+            spn::io::BufferedStream(stream, {.input_buffer_size = 32, .output_buffer_size = 32, .delimiters = "\n"});
+        TEST_ASSERT_GREATER_OR_EQUAL(io_before + 64, memory::usage(memory::Subsystem::IO).current_bytes);
+    }
+    TEST_ASSERT_EQUAL(evsys_before, memory::usage(memory::Subsystem::EVENTSYSTEM).current_bytes);
+    TEST_ASSERT_EQUAL(io_before, memory::usage(memory::Subsystem::IO).current_bytes);
+    TEST_ASSERT_EQUAL(true, memory::active_subsystem() == memory::Subsystem::UNTAGGED);
+}
+
+void ut_memory_hot_paths_do_not_allocate() {
+    if (!memory::heap_is_instrumented) return;
+
+    auto evsys = EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                              .events_cap = 16,
+                              .handler_cap = 2,
+                              .delay_between_ticks = false});
+    auto handler = CountingHandler(&evsys);
+    evsys.attach(Events::EventA, &handler);
+
+    auto stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 128, .output_buffer_size = 128});
+    auto buffered_stream =
+        spn::io::BufferedStream(stream, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+    stream->inject_bytestream({'p', 'i', 'n', 'g', '\n'});
+
+    const auto allocations_before = memory::total_usage().allocations;
+
+    for (int i = 0; i < 8; ++i) {
+        evsys.schedule(Events::EventA, k_time_ms(10));
+    }
+    evsys.trigger(Events::EventA);
+    HAL::delay(k_time_ms(20));
+    evsys.loop();
+    TEST_ASSERT_EQUAL(9, handler.count);
+
+    buffered_stream.pull_in_data();
+    if (auto transaction = buffered_stream.new_transaction()) {
+        transaction->outgoing("pong\n");
+        transaction->commit();
+    }
+    buffered_stream.push_out_data();
+
+    TEST_ASSERT_EQUAL(allocations_before, memory::total_usage().allocations);
+}
+
+void ut_memory_aligned_allocations() {
+    if (!memory::heap_is_instrumented) return;
+
+    struct alignas(64) CacheLine {
+        uint8_t bytes[64];
+    };
+    const auto before = memory::usage(memory::Subsystem::USER);
+    {
+        const auto tag = memory::ScopedTag(memory::Subsystem::USER);
+        auto line = std::make_unique<CacheLine>();
+        auto lines = std::make_unique<CacheLine[]>(3);
+        TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(line.get()) % 64);
+        TEST_ASSERT_EQUAL(0, reinterpret_cast<uintptr_t>(lines.get()) % 64);
+        TEST_ASSERT_EQUAL(before.allocations + 2, memory::usage(memory::Subsystem::USER).allocations);
+        TEST_ASSERT_GREATER_OR_EQUAL(before.current_bytes + 4 * 64,
+                                     memory::usage(memory::Subsystem::USER).current_bytes);
+    }
+    TEST_ASSERT_EQUAL(before.current_bytes, memory::usage(memory::Subsystem::USER).current_bytes);
+    TEST_ASSERT_EQUAL(before.deallocations + 2, memory::usage(memory::Subsystem::USER).deallocations);
+}
+
+int g_new_handler_calls = 0;
+
+void ut_memory_new_handler() {
+#if !defined(__SANITIZE_ADDRESS__) // ASan aborts on an allocation it can't serve instead of returning nullptr
+    if (!memory::heap_is_instrumented) return;
+
+    // the handler is called until it gives up by uninstalling itself, only then the allocation throws
+    g_new_handler_calls = 0;
+    std::set_new_handler([] {
+        if (++g_new_handler_calls == 3) std::set_new_handler(nullptr);
+    });
+    bool thrown = false;
+    try {
+        ::operator delete(::operator new(std::numeric_limits<size_t>::max() / 4));
+    } catch (const std::bad_alloc&) {
+        thrown = true;
+    }
+    std::set_new_handler(nullptr);
+    TEST_ASSERT_TRUE(thrown);
+    TEST_ASSERT_EQUAL(3, g_new_handler_calls);
+#endif
+}
+
+void ut_memory_concurrent_accounting() {
+#if defined(NATIVE)
+    constexpr int rounds = 100000;
+    const auto before = memory::usage(memory::Subsystem::FILTER);
+    const auto churn = [] {
+        for (int i = 0; i < rounds; ++i) {
+            memory::record_allocation(8, memory::Subsystem::FILTER);
+            memory::record_deallocation(8, memory::Subsystem::FILTER);
+        }
+    };
+    auto other = std::thread(churn);
+    churn();
+    other.join();
+
+    const auto after = memory::usage(memory::Subsystem::FILTER);
+    TEST_ASSERT_EQUAL(before.allocations + 2 * rounds, after.allocations);
+    TEST_ASSERT_EQUAL(before.deallocations + 2 * rounds, after.deallocations);
+    TEST_ASSERT_EQUAL(before.current_bytes, after.current_bytes);
+    TEST_ASSERT_TRUE(after.peak_bytes <= std::max(before.peak_bytes, before.current_bytes + 16)); // 8 bytes a thread
+#endif
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_memory_scoped_tag);
+    RUN_TEST(ut_memory_container_accounting);
+    RUN_TEST(ut_memory_subsystem_accounting);
+    RUN_TEST(ut_memory_hot_paths_do_not_allocate);
+    RUN_TEST(ut_memory_aligned_allocations);
+    RUN_TEST(ut_memory_new_handler);
+    RUN_TEST(ut_memory_concurrent_accounting);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,149 @@
+#include "spine/core/memory.hpp"
+#include "spine/core/utils/format.hpp"
+#include "spine/core/utils/time_repr.hpp"
+#include "spine/eventsystem/pipeline.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+#include "spine/structure/static_string.hpp"
+
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+
+using namespace spn::core::utils;
+
+namespace {
+
+template<typename... Args>
+std::string formatted(const Args&... args) {
+    char buffer[128];
+    auto writer = BufferWriter(buffer);
+    format_to(writer, args...);
+    return std::string(writer.view());
+}
+
+void ut_format_integers() {
+    TEST_ASSERT_EQUAL_STRING("0", formatted(0).c_str());
+    TEST_ASSERT_EQUAL_STRING("-42", formatted(-42).c_str());
+    TEST_ASSERT_EQUAL_STRING("18446744073709551615", formatted(std::numeric_limits<uint64_t>::max()).c_str());
+    TEST_ASSERT_EQUAL_STRING("-9223372036854775808", formatted(std::numeric_limits<int64_t>::min()).c_str());
+    TEST_ASSERT_EQUAL_STRING("x=5, ok=true", formatted("x=", 5, ", ok=", true).c_str());
+}
+
+void ut_format_floats() {
+    TEST_ASSERT_EQUAL_STRING("1.50", formatted(1.5f).c_str());
+    TEST_ASSERT_EQUAL_STRING("-0.13", formatted(-0.125f).c_str()); // half away from zero
+    TEST_ASSERT_EQUAL_STRING("10.00", formatted(9.999f).c_str()); // rounding carries into the integer
+    TEST_ASSERT_EQUAL_STRING("0.00", formatted(-0.001f).c_str());
+    TEST_ASSERT_EQUAL_STRING("3", formatted(with_precision(2.5f, 0)).c_str());
+    TEST_ASSERT_EQUAL_STRING("3.14159", formatted(with_precision(3.14159265f, 5)).c_str());
+    TEST_ASSERT_EQUAL_STRING("273.15", formatted(273.15).c_str());
+    TEST_ASSERT_EQUAL_STRING("nan", formatted(std::nanf("")).c_str());
+    TEST_ASSERT_EQUAL_STRING("-inf", formatted(-std::numeric_limits<float>::infinity()).c_str());
+    TEST_ASSERT_EQUAL_STRING("1.00e+20", formatted(1e20f).c_str());
+    TEST_ASSERT_EQUAL_STRING("-1.25", formatted(spn::fixed_q16(-1.25)).c_str());
+}
+
+void ut_format_units() {
+    TEST_ASSERT_EQUAL_STRING("12.50mV", formatted(volt_m(12.5)).c_str());
+    TEST_ASSERT_EQUAL_STRING("2.00kg", formatted(gram_k(2)).c_str());
+    TEST_ASSERT_EQUAL_STRING("21.5degC", formatted(with_precision(celsius(21.5), 1)).c_str());
+    TEST_ASSERT_EQUAL_STRING("1500ms", formatted(k_time_ms(1500)).c_str());
+    TEST_ASSERT_EQUAL_STRING("3h", formatted(k_time_h(3)).c_str());
+    TEST_ASSERT_EQUAL_STRING("2.00m^2", formatted(meter(1) * meter(2)).c_str());
+    TEST_ASSERT_EQUAL_STRING("0.50m*s^-1", formatted(meter(1) / time_s(2)).c_str());
+
+    // readable time: the unit is picked like utils::repr does
+    TEST_ASSERT_EQUAL_STRING("150ms", formatted(readable(k_time_ms(150))).c_str());
+    TEST_ASSERT_EQUAL_STRING("899s", formatted(readable(k_time_s(899))).c_str());
+    TEST_ASSERT_EQUAL_STRING("15m", formatted(readable(k_time_s(900))).c_str());
+    TEST_ASSERT_EQUAL_STRING("2d", formatted(readable(k_time_h(48))).c_str());
+    TEST_ASSERT_EQUAL_STRING("15m", repr(k_time_s(900)).c_str());
+}
+
+void ut_format_sinks() {
+    // a full buffer truncates and stays terminated
+    char small[8];
+    auto writer = BufferWriter(small);
+    TEST_ASSERT_EQUAL(7, format_to(writer, "value: ", 1234));
+    TEST_ASSERT_EQUAL(true, writer.truncated());
+    TEST_ASSERT_EQUAL_STRING("value: ", small);
+
+    auto counter = LengthCounter();
+    TEST_ASSERT_EQUAL(11, format_to(counter, "value: ", 1234));
+
+    auto s = spn::structure::StaticString<16>();
+    format_to(s, "t=", k_time_ms(20), ", v=", volt(3.3));
+    TEST_ASSERT_EQUAL_STRING("t=20ms, v=3.30V", s.c_str());
+
+    auto mock = spn::io::MockStream({.input_buffer_size = 32, .output_buffer_size = 32});
+    mock.initialize();
+    spn::io::Stream& stream = mock;
+    TEST_ASSERT_EQUAL(7, format_to(stream, "x=", -1.5f));
+    const auto bytes = mock.extract_bytestream();
+    TEST_ASSERT_EQUAL(true, bytes && std::string(bytes->begin(), bytes->end()) == "x=-1.50");
+}
+
+uint32_t g_simulated_ms = 0;
+uint32_t simulated_source() { return g_simulated_ms; }
+
+void ut_format_pipeline() {
+    spn::Clock::set_source(simulated_source);
+    auto pipeline = spn::eventsystem::Pipeline(4);
+    pipeline.push(std::make_shared<spn::eventsystem::Future>(k_time_s(10)));
+    pipeline.push(std::make_shared<spn::eventsystem::Future>(k_time_h(2)));
+    TEST_ASSERT_EQUAL_STRING("Pipeline: [10s, 120m]", pipeline.to_string().c_str());
+    TEST_ASSERT_EQUAL_STRING("Pipeline: []", spn::eventsystem::Pipeline(4).to_string().c_str());
+
+    char buffer[32];
+    auto writer = BufferWriter(buffer);
+    g_simulated_ms += 9500;
+    pipeline.format_to(writer);
+    TEST_ASSERT_EQUAL_STRING("Pipeline: [500ms, 120m]", buffer);
+    spn::Clock::set_source(nullptr);
+}
+
+void ut_format_does_not_allocate() {
+    char buffer[64];
+    auto writer = BufferWriter(buffer);
+    const auto before = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    for (int i = 0; i < 100; ++i) {
+        writer.clear();
+        format_to(writer, "t=", readable(k_time_ms(i)), " v=", volt_m(12.5f * static_cast<float>(i)), " n=", i);
+    }
+    TEST_ASSERT_EQUAL(before, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+    TEST_ASSERT_EQUAL_STRING("t=99ms v=1237.50mV n=99", buffer);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_format_integers);
+    RUN_TEST(ut_format_floats);
+    RUN_TEST(ut_format_units);
+    RUN_TEST(ut_format_sinks);
+    RUN_TEST(ut_format_pipeline);
+    RUN_TEST(ut_format_does_not_allocate);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
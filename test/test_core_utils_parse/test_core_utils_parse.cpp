@@ -0,0 +1,136 @@
+#include "spine/core/memory.hpp"
+#include "spine/core/utils/parse.hpp"
+#include "spine/core/utils/string.hpp"
+#include "spine/core/utils/time_repr.hpp"
+
+#include <unity.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string_view>
+
+using namespace spn::core::utils;
+
+namespace {
+
+void ut_parse_integer() {
+    TEST_ASSERT_EQUAL(123, parse_integer<int>("123").value());
+    TEST_ASSERT_EQUAL(-42, parse_integer<int>("-42").value());
+    TEST_ASSERT_EQUAL(7, parse_integer<int>("+7").value());
+    TEST_ASSERT_EQUAL(INT32_MIN, parse_integer<int32_t>("-2147483648").value());
+    TEST_ASSERT_EQUAL(INT32_MAX, parse_integer<int32_t>("2147483647").value());
+    TEST_ASSERT_EQUAL(255, parse_integer<uint8_t>("255").value());
+
+    TEST_ASSERT_EQUAL(true, ParseError::OutOfRange == parse_integer<int32_t>("2147483648").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::OutOfRange == parse_integer<uint8_t>("256").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_integer<uint8_t>("-1").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_integer<int>("12a").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_integer<int>("-").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::Empty == parse_integer<int>("").error_value());
+
+    // from_chars style: stops at the first character that isn't part of the number
+    const auto text = std::string_view("1234 rest");
+    int value = 0;
+    const auto [ptr, error] = scan_integer(text.data(), text.data() + text.size(), value);
+    TEST_ASSERT_EQUAL(true, error == ParseError::None);
+    TEST_ASSERT_EQUAL(1234, value);
+    TEST_ASSERT_EQUAL(4, ptr - text.data());
+}
+
+void ut_parse_float() {
+    TEST_ASSERT_EQUAL_FLOAT(1.5f, parse_float("1.5").value());
+    TEST_ASSERT_EQUAL_FLOAT(-0.25f, parse_float("-.25").value());
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, parse_float("3.").value());
+    TEST_ASSERT_EQUAL_FLOAT(12.5e-3f, parse_float("12.5e-3").value());
+    TEST_ASSERT_EQUAL_FLOAT(2e20f, parse_float("2E+20").value());
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, parse_float("0.000").value());
+
+    TEST_ASSERT_EQUAL(true, ParseError::OutOfRange == parse_float("1e39").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::OutOfRange == parse_float("1e-60").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_float(".").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_float("1e").error_value()); // 'e' isn't consumed
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_float("1.5.").error_value());
+
+    // stays within a few ulp of strtof
+    char buffer[32];
+    for (int i = 1; i < 20000; ++i) {
+        const auto expected = static_cast<float>(i) * 1.2345679f * std::pow(10.0f, static_cast<float>(i % 60 - 30));
+        std::snprintf(buffer, sizeof(buffer), "%.9g", static_cast<double>(expected));
+        const auto reference = std::strtof(buffer, nullptr);
+        const auto parsed = parse_float(buffer);
+        TEST_ASSERT_EQUAL(true, parsed.is_success());
+        TEST_ASSERT_FLOAT_WITHIN(std::fabs(reference) * 4e-7f, reference, parsed.value());
+    }
+}
+
+void ut_parse_does_not_read_beyond_view() {
+    // the digits after the view must be ignored
+    const char line[] = "12.5e3";
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, parse_float(std::string_view(line, 4)).value());
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, to_float(std::string_view(line, 4)));
+    TEST_ASSERT_EQUAL_FLOAT(12.0f, to_float(std::string_view(line, 2)));
+    TEST_ASSERT_EQUAL_FLOAT(0.0f, to_float(std::string_view(line, 0)));
+    TEST_ASSERT_EQUAL(12, parse_integer<int>(std::string_view(line, 2)).value());
+}
+
+void ut_parse_duration() {
+    TEST_ASSERT_EQUAL(true, parse_duration("500ms").value() == k_time_ms(500));
+    TEST_ASSERT_EQUAL(true, parse_duration("2h").value() == k_time_h(2));
+    TEST_ASSERT_EQUAL(true, parse_duration<k_time_s>("1d").value() == k_time_d(1));
+    TEST_ASSERT_EQUAL(true, parse_duration<k_time_us>("10us").value() == k_time_us(10));
+    TEST_ASSERT_EQUAL(true, parse_duration<k_time_s>("1500ms").value() == k_time_s(2)); // rounds like unit conversion
+    TEST_ASSERT_EQUAL(true, parse_duration<k_time_s>("-1500ms").value() == k_time_s(-2));
+
+    TEST_ASSERT_EQUAL(true, ParseError::UnknownUnit == parse_duration("10").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::UnknownUnit == parse_duration("10w").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::UnknownUnit == parse_duration("10 s").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::InvalidCharacter == parse_duration("ms").error_value());
+    TEST_ASSERT_EQUAL(true, ParseError::OutOfRange == parse_duration<k_time_us>("9223372036854775807d").error_value());
+
+    // the variant returning parse_time no longer throws on missing digits
+    TEST_ASSERT_EQUAL(true, parse_time("h") == std::nullopt);
+    TEST_ASSERT_EQUAL(true, std::get<k_time_m>(*parse_time("15m")) == k_time_m(15));
+}
+
+void ut_parse_does_not_allocate() {
+    const auto before = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    for (int i = 0; i < 100; ++i) {
+        (void)parse_integer<int>("-12345");
+        (void)parse_float("-1.2345e-3");
+        (void)parse_duration("250ms");
+        (void)parse_time("250ms");
+        (void)to_float("1.5");
+    }
+    TEST_ASSERT_EQUAL(before, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_parse_integer);
+    RUN_TEST(ut_parse_float);
+    RUN_TEST(ut_parse_does_not_read_beyond_view);
+    RUN_TEST(ut_parse_duration);
+    RUN_TEST(ut_parse_does_not_allocate);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
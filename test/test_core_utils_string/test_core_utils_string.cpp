@@ -0,0 +1,131 @@
+#include "spine/core/memory.hpp"
+#include "spine/core/utils/string.hpp"
+
+#include <unity.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace spn::core::utils;
+
+namespace {
+
+std::vector<std::string> collect(const Split& parts) {
+    auto result = std::vector<std::string>();
+    for (const auto part : parts)
+        result.emplace_back(part);
+    return result;
+}
+
+void ut_string_charset() {
+    constexpr auto set = CharSet("\r\n\r");
+    static_assert(set.size() == 2);
+    static_assert(set.contains('\n') && !set.contains('a'));
+
+    auto high = CharSet();
+    high.insert(static_cast<char>(0xFF));
+    high.insert('\0');
+    TEST_ASSERT_EQUAL(true, high.contains(static_cast<char>(0xFF)));
+    TEST_ASSERT_EQUAL(true, high.contains('\0'));
+    TEST_ASSERT_EQUAL(false, high.contains(static_cast<char>(0xFE)));
+}
+
+void ut_string_find_first_of() {
+    // long enough to cover the vectorized loop and the scalar tail, with a match in every position
+    const auto text = std::string(40, 'x');
+    for (const auto delimiters : {std::string_view(";"), std::string_view(";,"), std::string_view(";,:!"),
+                                  std::string_view(";,:!?")}) {
+        TEST_ASSERT_EQUAL(std::string::npos, find_first_of(text, delimiters));
+        for (size_t i = 0; i < text.size(); ++i) {
+            auto s = text;
+            s[i] = delimiters.back();
+            if (i + 1 < s.size()) s[i + 1] = delimiters.front();
+            TEST_ASSERT_EQUAL(i, find_first_of(s, delimiters));
+        }
+    }
+    TEST_ASSERT_EQUAL(std::string::npos, find_first_of("", ";"));
+    TEST_ASSERT_EQUAL(std::string::npos, find_first_of("abc", ""));
+    TEST_ASSERT_EQUAL(2, find_first_of(std::string_view("ab\0c", 4), std::string_view("\0", 1)));
+
+    const auto set = CharSet(" \t");
+    TEST_ASSERT_EQUAL(2, find_first_not_of("\t value ", set));
+    TEST_ASSERT_EQUAL(6, find_last_not_of("\t value ", set));
+    TEST_ASSERT_EQUAL(std::string::npos, find_first_not_of(" \t ", set));
+    TEST_ASSERT_EQUAL(std::string::npos, find_last_not_of("", set));
+}
+
+void ut_string_strip() {
+    TEST_ASSERT_EQUAL(true, lstrip("  value ") == "value ");
+    TEST_ASSERT_EQUAL(true, rstrip("  value \r\n") == "  value");
+    TEST_ASSERT_EQUAL(true, rstrip("value--", "-") == "value");
+    TEST_ASSERT_EQUAL(true, lstrip("   ").empty());
+    TEST_ASSERT_EQUAL(true, rstrip("   ").empty());
+    TEST_ASSERT_EQUAL(true, lstrip("").empty());
+    TEST_ASSERT_EQUAL(true, starts_with("value", "val"));
+    TEST_ASSERT_EQUAL(true, ends_with("value", "lue"));
+    TEST_ASSERT_EQUAL(false, ends_with("lue", "value"));
+}
+
+void ut_string_split() {
+    TEST_ASSERT(collect(split("a,b,c", ",")) == (std::vector<std::string>{"a", "b", "c"}));
+    TEST_ASSERT(collect(split("a,,b,", ",")) == (std::vector<std::string>{"a", "", "b", ""}));
+    TEST_ASSERT(collect(split("a;b,c", ";,")) == (std::vector<std::string>{"a", "b", "c"}));
+    TEST_ASSERT(collect(split("abc", ",")) == (std::vector<std::string>{"abc"}));
+    TEST_ASSERT(collect(split("", ",")) == (std::vector<std::string>{""}));
+
+    TEST_ASSERT(collect(tokenize("  set  speed\t12 \n")) == (std::vector<std::string>{"set", "speed", "12"}));
+    TEST_ASSERT(collect(tokenize("a,,b,", ",")) == (std::vector<std::string>{"a", "b"}));
+    TEST_ASSERT(collect(tokenize("   ")).empty());
+    TEST_ASSERT(collect(tokenize("")).empty());
+
+    // parts are views into the original string
+    const auto line = std::string_view("key=value");
+    const auto parts = split(line, "=");
+    auto it = parts.begin();
+    TEST_ASSERT_EQUAL(line.data(), it->data());
+    TEST_ASSERT_EQUAL(line.data() + 4, (++it)->data());
+    TEST_ASSERT(++it == parts.end());
+}
+
+void ut_string_does_not_allocate() {
+    const auto before = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    size_t count = 0, length = 0;
+    for (int i = 0; i < 100; ++i) {
+        for (const auto token : tokenize(" set pid.kp 1.5\r\n", CharSet(" .\r\n"))) {
+            ++count;
+            length += rstrip(lstrip(token)).size() + find_first_of(token, "k");
+        }
+    }
+    TEST_ASSERT_EQUAL(before, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+    TEST_ASSERT_EQUAL(500, count);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_string_charset);
+    RUN_TEST(ut_string_find_first_of);
+    RUN_TEST(ut_string_strip);
+    RUN_TEST(ut_string_split);
+    RUN_TEST(ut_string_does_not_allocate);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -1,8 +1,12 @@
+#include "spine/core/clock.hpp"
+#include "spine/core/exception.hpp"
 #include "spine/eventsystem/eventsystem.hpp"
+#include "spine/structure/time/timers.hpp"
 
 #include <unity.h>
 
 #include <limits>
+#include <memory>
 
 using namespace spn::core;
 
@@ -175,10 +179,95 @@ void ut_ev_repeat_use() {
     }
 }
 
+uint32_t g_advancing_ms = 0;
+uint32_t advancing_source() { return g_advancing_ms++; } // a millisecond passes with every read
+
+/// Waits in its handler on a timer, as e.g. `PID::autotune` does, then schedules itself again
+class WaitingHandler : public EventHandler {
+public:
+    WaitingHandler(EventSystem* evsys) : EventHandler(evsys) {};
+
+    void handle_event(const Event& event) override {
+        auto alarm = spn::structure::time::AlarmTimer(k_time_ms(10));
+        int polls = 0;
+        while (!alarm.expired() && polls < 1000)
+            ++polls;
+        waited_out += polls < 1000 ? 1 : 0;
+        ++calls;
+        evsys()->schedule(Events::EventA, k_time_ms(1));
+    }
+
+    int calls = 0;
+    int waited_out = 0;
+};
+
+void ut_ev_handler_waits_on_timer() {
+    spn::Clock::set_source(advancing_source);
+    auto sc = EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                           .events_cap = 8,
+                           .handler_cap = 1,
+                           .delay_between_ticks = false});
+    auto handler = WaitingHandler(&sc);
+    sc.attach(Events::EventA, &handler);
+    sc.schedule(Events::EventA, k_time_ms(1));
+
+    // the clock moves on while the handler runs, and what it schedules fires in the next pass
+    for (int pass = 0; pass < 10; ++pass)
+        sc.loop();
+    TEST_ASSERT_TRUE(handler.calls > 0 && handler.calls <= 10);
+    TEST_ASSERT_EQUAL(handler.calls, handler.waited_out);
+
+    spn::Clock::set_source(nullptr);
+}
+
+uint32_t g_frozen_ms = 0;
+uint32_t frozen_source() { return g_frozen_ms; }
+
+/// Schedules itself again, due right away
+class ImmediateHandler : public EventHandler {
+public:
+    ImmediateHandler(EventSystem* evsys) : EventHandler(evsys) {};
+
+    void handle_event(const Event& event) override {
+        ++calls;
+        evsys()->schedule(Events::EventA, k_time_ms(0));
+    }
+
+    int calls = 0;
+};
+
+void ut_ev_immediate_events() {
+    struct EH : public ExceptionHandler {
+        void handle_exception(const spn::core::Exception& e) override { ++exceptions; }
+        int exceptions = 0;
+    };
+    auto original_handler = set_machine_exception_handler(std::make_unique<EH>());
+    spn::Clock::set_source(frozen_source);
+    auto sc = EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                           .events_cap = 8,
+                           .handler_cap = 1,
+                           .delay_between_ticks = false});
+    auto handler = ImmediateHandler(&sc);
+    sc.attach(Events::EventA, &handler);
+
+    // an event due right away is legal, it fires in the next pass even while the clock stands still
+    sc.schedule(Events::EventA, k_time_ms(0));
+    sc.loop();
+    TEST_ASSERT_EQUAL(1, handler.calls);
+    sc.loop();
+    TEST_ASSERT_EQUAL(2, handler.calls);
+    TEST_ASSERT_EQUAL(0, static_cast<EH*>(machine_exception_handler())->exceptions);
+
+    spn::Clock::set_source(nullptr);
+    set_machine_exception_handler(std::move(original_handler));
+}
+
 int run_all_tests() {
     UNITY_BEGIN();
     RUN_TEST(ut_ev_basics);
     RUN_TEST(ut_ev_repeat_use);
+    RUN_TEST(ut_ev_handler_waits_on_timer);
+    RUN_TEST(ut_ev_immediate_events);
     return UNITY_END();
 }
 
@@ -1,3 +1,4 @@
+#include "spine/core/utils/format.hpp"
 #include "spine/io/stream/buffered_stream.hpp"
 #include "spine/io/stream/implementations/mock.hpp"
 #include "spine/io/stream/stream.hpp"
@@ -8,6 +9,7 @@
 #include <climits>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <vector>
 
 using namespace spn::structure;
@@ -123,6 +125,250 @@ void ut_buffered_stream_transaction() {
         TEST_ASSERT_EQUAL(0, buffered_stream.output_buffer_space_used());
         TEST_ASSERT_EQUAL(0, transaction->outgoing_space_used());
     }
+
+    { // a transaction with a formatted reply
+        auto transaction = buffered_stream.new_transaction();
+        TEST_ASSERT_EQUAL(true, std::string_view("ghi") == transaction->incoming());
+
+        const auto line = StaticString<8>(transaction->incoming());
+        TEST_ASSERT_EQUAL(7, transaction->reply(line, "=", 42, "\n"));
+        TEST_ASSERT_EQUAL(0, transaction->reply<200>(std::string(150, 'x'))); // doesn't fit the outgoing buffer
+        TEST_ASSERT_EQUAL(0, transaction->reply<4>(line, "=", 42, "\n")); // longer than the StaticString, not cut off
+        TEST_ASSERT_EQUAL(7, transaction->outgoing_space_used());
+        transaction->commit();
+
+        TEST_ASSERT_EQUAL(7, buffered_stream.push_out_data());
+        const auto reply = mock_stream->extract_bytestream();
+        TEST_ASSERT_EQUAL(true, reply && std::string(reply->begin(), reply->end()) == "ghi=42\n");
+    }
+}
+
+void ut_buffered_stream_pipelined_transactions() {
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 128, .output_buffer_size = 128});
+    auto buffered_stream = spn::io::BufferedStream(mock_stream, {.input_buffer_size = 16,
+                                                                 .output_buffer_size = 32,
+                                                                 .delimiters = "\n",
+                                                                 .max_transactions = 2});
+    mock_stream->initialize();
+    const auto input = std::string("abc\ndef\nghi\n");
+    mock_stream->inject_bytestream(std::vector<uint8_t>(input.begin(), input.end()));
+    buffered_stream.pull_in_data();
+
+    auto first = buffered_stream.new_transaction();
+    auto second = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(true, first && first->incoming() == "abc");
+    TEST_ASSERT_EQUAL(true, second && second->incoming() == "def");
+    TEST_ASSERT_EQUAL(1, second->id() - first->id());
+    TEST_ASSERT_FALSE(buffered_stream.new_transaction().has_value()); // max_transactions are in flight
+
+    // the first transaction to write holds the output until it's finalized
+    TEST_ASSERT_EQUAL(4, second->outgoing(std::string_view("DEF\n")));
+    TEST_ASSERT_EQUAL(0, first->outgoing(std::string_view("ABC\n")));
+    TEST_ASSERT_TRUE(first->would_block());
+    TEST_ASSERT_EQUAL(0, first->outgoing_space_left());
+    second->commit();
+    TEST_ASSERT_EQUAL(4, first->outgoing(std::string_view("ABC\n")));
+    TEST_ASSERT_FALSE(first->would_block());
+
+    // lines are released in order, the second line stays claimed until the first is finalized
+    TEST_ASSERT_EQUAL(2, buffered_stream.transactions_in_flight());
+    TEST_ASSERT_FALSE(buffered_stream.new_transaction().has_value());
+    first->commit();
+    TEST_ASSERT_EQUAL(0, buffered_stream.transactions_in_flight());
+    TEST_ASSERT_EQUAL(4, buffered_stream.input_buffer_space_used());
+    auto third = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(true, third && third->incoming() == "ghi");
+    third->commit();
+    TEST_ASSERT_EQUAL(0, buffered_stream.input_buffer_space_used());
+
+    buffered_stream.push_out_data();
+    const auto replies = mock_stream->extract_bytestream();
+    TEST_ASSERT_EQUAL(true, replies && std::string(replies->begin(), replies->end()) == "DEF\nABC\n");
+
+    // a line wrapping around the end of the input buffer is moved to its start
+    const auto wrapped = std::string("0123456789\n");
+    mock_stream->inject_bytestream(std::vector<uint8_t>(wrapped.begin(), wrapped.end()));
+    buffered_stream.pull_in_data();
+    auto transaction = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "0123456789");
+}
+
+void ut_buffered_stream_overrun_while_in_flight() {
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 64});
+    auto buffered_stream =
+        spn::io::BufferedStream(mock_stream, {.input_buffer_size = 16, .output_buffer_size = 16, .delimiters = "\n"});
+    mock_stream->initialize();
+    const auto too_long = std::string(20, 'x') + "\n";
+    mock_stream->inject_bytestream(std::vector<uint8_t>(too_long.begin(), too_long.end()));
+    buffered_stream.pull_in_data();
+    const auto overruns = buffered_stream.input_counters().overruns;
+
+    auto first = buffered_stream.new_transaction();
+    TEST_ASSERT_TRUE(first.has_value());
+    const auto claimed = std::string(first->incoming());
+
+    // the input buffer is full of a claimed line: what comes in stays in the stream instead of overwriting it
+    const auto input = std::string("abcdefgh\nijkl\n");
+    mock_stream->inject_bytestream(std::vector<uint8_t>(input.begin(), input.end()));
+    buffered_stream.pull_in_data();
+    TEST_ASSERT_EQUAL(true, first->incoming() == claimed);
+    TEST_ASSERT_EQUAL(overruns + 1, buffered_stream.input_counters().overruns);
+    first->commit();
+
+    buffered_stream.pull_in_data();
+    auto second = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(true, second && second->incoming() == "abcdefgh");
+    second->commit();
+    auto third = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(true, third && third->incoming() == "ijkl");
+}
+
+void ut_buffered_stream_chunked_reply() {
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 40});
+    auto buffered_stream =
+        spn::io::BufferedStream(mock_stream, {.input_buffer_size = 16, .output_buffer_size = 16, .delimiters = "\n"});
+    mock_stream->initialize();
+    mock_stream->inject_bytestream({'d', 'u', 'm', 'p', '\n'});
+    buffered_stream.pull_in_data();
+
+    auto reply = std::string();
+    for (int i = 0; i < 10; ++i)
+        reply += "line " + std::to_string(i) + "\n";
+    TEST_ASSERT_EQUAL(70, reply.size());
+
+    auto transaction = buffered_stream.new_transaction();
+    // the reply is larger than the output buffer, it's pushed out until the stream takes no more
+    auto queued = transaction->outgoing(reply);
+    TEST_ASSERT_EQUAL(56, queued); // 40 taken by the stream, 16 in the output buffer
+    TEST_ASSERT_TRUE(transaction->would_block());
+    TEST_ASSERT_EQUAL(0, transaction->reply("x")); // would block as well
+    TEST_ASSERT_TRUE(transaction->would_block());
+
+    // the consumer catches up, the remainder is queued
+    auto received = *mock_stream->extract_bytestream();
+    queued += transaction->outgoing(reply.data() + queued, reply.size() - queued);
+    TEST_ASSERT_EQUAL(70, queued);
+    TEST_ASSERT_FALSE(transaction->would_block());
+    TEST_ASSERT_EQUAL(70, transaction->outgoing_space_used());
+    transaction->commit();
+
+    buffered_stream.push_out_data();
+    const auto rest = *mock_stream->extract_bytestream();
+    received.insert(received.end(), rest.begin(), rest.end());
+    TEST_ASSERT_EQUAL(true, std::string(received.begin(), received.end()) == reply);
+}
+
+std::string drain(spn::io::BufferedStream& buffered_stream, spn::io::MockStream& mock_stream) {
+    buffered_stream.push_out_data();
+    const auto bytes = mock_stream.extract_bytestream();
+    return bytes ? std::string(bytes->begin(), bytes->end()) : std::string();
+}
+
+void ut_buffered_stream_output_lanes() {
+    using spn::io::OutputLane;
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 8});
+    auto buffered_stream = spn::io::BufferedStream(
+        mock_stream,
+        {.input_buffer_size = 16,
+         .output_buffer_size = 16,
+         .delimiters = "\n",
+         .log_lane = {.size = 12, .drop_policy = spn::io::OutputDropPolicy::DropOldest},
+         .bulk_lane = {.size = 32}});
+    mock_stream->initialize();
+
+    // a reply overtakes queued telemetry, but not the record that is being pushed out
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Bulk, "telemetry 1\n"));
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Bulk, "telemetry 2\n"));
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "telemetr");
+    buffered_stream.buffered_write("reply\n");
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "y 1\nrepl");
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "y\nteleme");
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "try 2\n");
+    TEST_ASSERT_EQUAL(2, buffered_stream.output_lane_counters(OutputLane::Bulk).records_sent);
+    TEST_ASSERT_EQUAL(1, buffered_stream.output_lane_counters(OutputLane::Control).records_sent);
+
+    // drop policies
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Log, "log a\n"));
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Log, "log b\n"));
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Log, "log c\n")); // drops the oldest
+    TEST_ASSERT_FALSE(buffered_stream.write_record(OutputLane::Log, "too long for the lane\n"));
+    TEST_ASSERT_EQUAL(2, buffered_stream.output_lane_counters(OutputLane::Log).dropped_records);
+    TEST_ASSERT_EQUAL(28, buffered_stream.output_lane_counters(OutputLane::Log).dropped_bytes);
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Bulk, std::string(30, 'x') + "\n"));
+    TEST_ASSERT_FALSE(buffered_stream.write_record(OutputLane::Bulk, "new\n")); // drops the newest
+    TEST_ASSERT_EQUAL(1, buffered_stream.output_lane_counters(OutputLane::Bulk).dropped_records);
+
+    auto output = std::string();
+    for (int i = 0; i < 8; ++i)
+        output += drain(buffered_stream, *mock_stream);
+    TEST_ASSERT_EQUAL(0, buffered_stream.output_lane_space_used(OutputLane::Bulk));
+    TEST_ASSERT_EQUAL(true, output == "log b\nlog c\n" + std::string(30, 'x') + "\n");
+}
+
+void ut_buffered_stream_weighted_output_lanes() {
+    using spn::io::OutputLane;
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 64});
+    auto buffered_stream =
+        spn::io::BufferedStream(mock_stream, {.input_buffer_size = 16,
+                                              .output_buffer_size = 16,
+                                              .delimiters = "\n",
+                                              .bulk_lane = {.size = 32, .weight = 2},
+                                              .output_scheduling = spn::io::OutputScheduling::WeightedFair});
+    mock_stream->initialize();
+
+    for (const auto record : {"b1\n", "b2\n", "b3\n", "b4\n"})
+        buffered_stream.write_record(OutputLane::Bulk, record);
+    for (const auto record : {"c1\n", "c2\n", "c3\n"})
+        buffered_stream.write_record(OutputLane::Control, record);
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "c1\nb1\nb2\nc2\nb3\nb4\nc3\n");
+
+    // the control lane is held by a transaction that is writing a reply
+    mock_stream->inject_bytestream({'x', '\n'});
+    buffered_stream.pull_in_data();
+    auto transaction = buffered_stream.new_transaction();
+    transaction->outgoing(std::string_view("reply\n"));
+    TEST_ASSERT_FALSE(buffered_stream.write_record(OutputLane::Control, "c4\n"));
+    transaction->commit();
+    TEST_ASSERT_TRUE(buffered_stream.write_record(OutputLane::Control, "c4\n"));
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "reply\nc4\n");
+}
+
+void ut_buffered_stream_scatter_gather() {
+    auto mock_stream = std::make_shared<spn::io::MockStream>(
+        spn::io::MockStream::Config{.input_buffer_size = 64, .output_buffer_size = 64});
+    auto buffered_stream =
+        spn::io::BufferedStream(mock_stream, {.input_buffer_size = 16, .output_buffer_size = 16, .delimiters = "\n"});
+    mock_stream->initialize();
+
+    // a reply assembled from a prefix, a formatted value, a unit and a delimiter
+    char number[8];
+    const auto value = std::string_view(number, spn::core::utils::format_integer(number, number + 8, 42) - number);
+    TEST_ASSERT_EQUAL(9, buffered_stream.buffered_writev({"temp ", value, "C", "\n"}));
+    TEST_ASSERT_EQUAL(0, buffered_stream.buffered_writev({"0123", "456789"})); // all or nothing
+    TEST_ASSERT_EQUAL(9, buffered_stream.output_buffer_space_used());
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "temp 42C\n");
+
+    // a transaction pushes out the queue to make room for all segments at once
+    mock_stream->inject_bytestream({'x', '\n'});
+    buffered_stream.pull_in_data();
+    auto transaction = buffered_stream.new_transaction();
+    TEST_ASSERT_EQUAL(12, transaction->outgoingv({"first ", "reply", "\n"}));
+    TEST_ASSERT_EQUAL(13, transaction->outgoingv({"second", " reply\n"}));
+    TEST_ASSERT_EQUAL(0, transaction->outgoingv({std::string_view("too large for the buffer\n")}));
+    transaction->commit();
+    TEST_ASSERT_EQUAL(true, drain(buffered_stream, *mock_stream) == "first reply\nsecond reply\n");
+
+    // the stream writes all segments or none
+    TEST_ASSERT_EQUAL(0, mock_stream->writev({std::string(60, 'x'), "more than fits"}));
+    TEST_ASSERT_EQUAL(64, mock_stream->available_for_write());
+    TEST_ASSERT_EQUAL(6, mock_stream->writev({"ab", "cd", "ef"}));
+    const auto wire = *mock_stream->extract_bytestream();
+    TEST_ASSERT_EQUAL(true, std::string(wire.begin(), wire.end()) == "abcdef");
 }
 
 } // namespace
@@ -131,6 +377,12 @@ int run_all_tests() {
     UNITY_BEGIN();
     RUN_TEST(ut_buffered_stream_basics);
     RUN_TEST(ut_buffered_stream_transaction);
+    RUN_TEST(ut_buffered_stream_pipelined_transactions);
+    RUN_TEST(ut_buffered_stream_overrun_while_in_flight);
+    RUN_TEST(ut_buffered_stream_chunked_reply);
+    RUN_TEST(ut_buffered_stream_output_lanes);
+    RUN_TEST(ut_buffered_stream_weighted_output_lanes);
+    RUN_TEST(ut_buffered_stream_scatter_gather);
     return UNITY_END();
 }
 
@@ -0,0 +1,166 @@
+#include "spine/core/memory.hpp"
+#include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/command_router.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+#include "spine/io/stream/transaction.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+using namespace spn::io;
+
+namespace {
+
+struct State {
+    int motor = 0;
+    float rpm = 0;
+    bool enabled = false;
+    k_time_ms interval = k_time_ms(0);
+    std::string_view name;
+    int pings = 0;
+};
+State g_state;
+
+void set_speed(Transaction& t, uint8_t motor, float rpm) {
+    g_state.motor = motor;
+    g_state.rpm = rpm;
+    t.reply("ok\n");
+}
+void get_speed(Transaction& t, uint8_t motor) { t.reply("speed ", motor, ' ', g_state.rpm, '\n'); }
+void enable(Transaction& t, bool enabled) { g_state.enabled = enabled; }
+void set_interval(Transaction& t, k_time_ms interval) { g_state.interval = interval; }
+void set_name(Transaction& t, std::string_view name) { g_state.name = name; }
+void ping(Transaction& t) {
+    ++g_state.pings;
+    t.reply("pong\n");
+}
+
+constexpr auto router = CommandRouter{
+    Command::of<&set_speed>("speed"), Command::of<&get_speed>("speed?"),       Command::of<&enable>("enable"),
+    Command::of<&set_interval>("interval"), Command::of<&set_name>("name"), Command::of<&ping>("ping"),
+};
+
+/// A buffered stream over a mock with `lines` waiting to be read
+struct Fixture {
+    std::shared_ptr<MockStream> mock =
+        std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 256, .output_buffer_size = 256});
+    BufferedStream stream = BufferedStream(
+        mock, BufferedStream::Config{.input_buffer_size = 128, .output_buffer_size = 128, .delimiters = "\n"});
+
+    explicit Fixture(const std::string& lines) {
+        mock->initialize();
+        mock->inject_bytestream(std::vector<uint8_t>(lines.begin(), lines.end()));
+        stream.pull_in_data();
+    }
+
+    DispatchStatus dispatch_next() {
+        auto transaction = stream.new_transaction();
+        TEST_ASSERT(transaction);
+        const auto status = router.dispatch(*transaction);
+        transaction->commit();
+        return status;
+    }
+
+    std::string replies() {
+        stream.push_out_data();
+        const auto bytes = mock->extract_bytestream();
+        return bytes ? std::string(bytes->begin(), bytes->end()) : std::string();
+    }
+};
+
+void ut_command_router_lookup() {
+    static_assert(router.commands().size() == 6);
+    static_assert(router.find("speed") != nullptr && router.find("speed")->name == "speed");
+    static_assert(router.find("speed?")->name == "speed?");
+    static_assert(router.find("sped") == nullptr && router.find("") == nullptr);
+
+    for (const auto& command : router.commands())
+        TEST_ASSERT_EQUAL(&command, router.find(command.name));
+    TEST_ASSERT_NULL(router.find("pingg"));
+    TEST_ASSERT_NULL(router.find("Ping"));
+}
+
+void ut_command_router_dispatch() {
+    g_state = {};
+    auto fixture = Fixture("speed 2 1500.5\nspeed? 2\n  enable on \ninterval 2s\nname pump\nping\n");
+
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(2, g_state.motor);
+    TEST_ASSERT_EQUAL_FLOAT(1500.5f, g_state.rpm);
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(true, g_state.enabled);
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(2000, g_state.interval.raw());
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(true, g_state.name == "pump");
+    TEST_ASSERT_EQUAL(DispatchStatus::Handled, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(1, g_state.pings);
+
+    TEST_ASSERT_EQUAL_STRING("ok\nspeed 2 1500.50\npong\n", fixture.replies().c_str());
+}
+
+void ut_command_router_errors() {
+    g_state = {};
+    auto fixture = Fixture("  \nhalt\nspeed 1\nspeed 1 2 3\nspeed 300 1\nenable maybe\ninterval 5\nping now\n");
+
+    TEST_ASSERT_EQUAL(DispatchStatus::Empty, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(DispatchStatus::UnknownCommand, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next()); // too few
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next()); // too many
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next()); // out of range for uint8_t
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next());
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next()); // a duration needs a unit
+    TEST_ASSERT_EQUAL(DispatchStatus::InvalidArguments, fixture.dispatch_next());
+
+    // no handler ran
+    TEST_ASSERT_EQUAL(0, g_state.motor);
+    TEST_ASSERT_EQUAL(0, g_state.pings);
+    TEST_ASSERT_EQUAL_STRING("", fixture.replies().c_str());
+}
+
+void ut_command_router_does_not_allocate() {
+    g_state = {};
+    auto fixture = Fixture("speed 1 20\nspeed? 1\nping\n");
+    const auto before = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    for (int i = 0; i < 3; ++i) {
+        auto transaction = fixture.stream.new_transaction();
+        router.dispatch(*transaction);
+        transaction->commit();
+    }
+    TEST_ASSERT_EQUAL(before, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+    TEST_ASSERT_EQUAL_STRING("ok\nspeed 1 20.00\npong\n", fixture.replies().c_str());
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_command_router_lookup);
+    RUN_TEST(ut_command_router_dispatch);
+    RUN_TEST(ut_command_router_errors);
+    RUN_TEST(ut_command_router_does_not_allocate);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
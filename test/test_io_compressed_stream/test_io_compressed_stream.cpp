@@ -0,0 +1,235 @@
+#include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/compressed_stream.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace spn::io;
+
+namespace {
+
+/// Move what `from` wrote into the input of `to`
+void carry(MockStream& from, MockStream& to) {
+    if (auto bytes = from.extract_bytestream()) to.inject_bytestream(*bytes);
+}
+
+std::string telemetry_line(int i) {
+    return "{\"temperature\":" + std::to_string(200 + i % 7) + ",\"humidity\":" + std::to_string(40 + i % 3)
+           + ",\"state\":\"heating\"}\n";
+}
+
+void ut_compressed_stream_round_trip() {
+    auto tx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 1, .output_buffer_size = 4096});
+    auto rx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 4096, .output_buffer_size = 1});
+    auto tx = CompressedStream<>(tx_mock);
+    auto rx = CompressedStream<>(rx_mock);
+
+    std::string sent;
+    for (int i = 0; i < 40; ++i) {
+        const auto line = telemetry_line(i);
+        TEST_ASSERT_EQUAL(line.size(), tx.write(std::string_view(line)));
+        sent += line;
+    }
+    TEST_ASSERT_EQUAL(sent.size(), tx.counters().bytes_in);
+    TEST_ASSERT_EQUAL(40, tx.counters().syncs);
+
+    // repeated keys and slowly changing values compress well
+    TEST_ASSERT_TRUE(tx.counters().bytes_out * 3 < sent.size());
+    carry(*tx_mock, *rx_mock);
+
+    // what's available at once is bounded by the window, a read decodes on as it goes
+    TEST_ASSERT_TRUE(rx.available() > 0 && rx.available() <= CompressedStream<>::window_size);
+    std::string received(sent.size() + 8, '\0');
+    TEST_ASSERT_EQUAL(sent.size(), rx.read(received.data(), received.size()));
+    received.resize(sent.size());
+    TEST_ASSERT_EQUAL(true, received == sent);
+    TEST_ASSERT_EQUAL(0, rx.available());
+}
+
+void ut_compressed_stream_syncs() {
+    auto tx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 1, .output_buffer_size = 256});
+    auto rx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 256, .output_buffer_size = 1});
+    auto tx = CompressedStream<>(tx_mock, {.sync_on_write = false});
+    auto rx = CompressedStream<>(rx_mock);
+
+    // without a delimiter the compressor holds on to the bytes for a match, until flushed
+    TEST_ASSERT_EQUAL(6, tx.write(std::string_view("abcabc")));
+    carry(*tx_mock, *rx_mock);
+    TEST_ASSERT_EQUAL(0, rx.available());
+    tx.flush();
+    carry(*tx_mock, *rx_mock);
+    TEST_ASSERT_EQUAL(6, rx.available());
+
+    // the compressed bytes of a line trickle in one by one: tokens decode as they complete
+    TEST_ASSERT_EQUAL(12, tx.write(std::string_view("abcabcabcab\n")));
+    const auto compressed = *tx_mock->extract_bytestream();
+    TEST_ASSERT_TRUE(compressed.size() < 12);
+    size_t decoded = rx.available();
+    for (size_t i = 0; i < compressed.size(); ++i) {
+        rx_mock->inject_bytestream({compressed[i]});
+        TEST_ASSERT_TRUE(rx.available() >= decoded && rx.available() <= 18);
+        decoded = rx.available();
+    }
+    TEST_ASSERT_EQUAL(18, rx.available());
+    char buffer[32] = {};
+    TEST_ASSERT_EQUAL(18, rx.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 18) == "abcabcabcabcabcab\n");
+}
+
+template<uint8_t WindowBits, uint8_t LookaheadBits>
+/// Write `sent` through a wrapped stream that takes only a few bytes at a time, as much as `available_for_write()`
+/// promises at once
+void round_trip_in_pieces(const std::vector<uint8_t>& sent,
+                          typename CompressedStream<WindowBits, LookaheadBits>::Config cfg) {
+    auto tx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 1, .output_buffer_size = 8});
+    auto rx_mock = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 8, .output_buffer_size = 1});
+    auto tx = CompressedStream<WindowBits, LookaheadBits>(tx_mock, std::move(cfg));
+    auto rx = CompressedStream<WindowBits, LookaheadBits>(rx_mock);
+
+    std::vector<uint8_t> received;
+    size_t written = 0;
+    for (int rounds = 0; rounds < 100000 && received.size() < sent.size(); ++rounds) {
+        const auto room = tx.available_for_write();
+        const auto n = tx.write(sent.data() + written, std::min(room, sent.size() - written));
+        TEST_ASSERT_EQUAL(std::min(room, sent.size() - written), n); // what's available is taken in full
+        written += n;
+        if (written == sent.size()) tx.flush();
+        carry(*tx_mock, *rx_mock);
+        uint8_t value = 0;
+        while (rx.read(value))
+            received.push_back(value);
+    }
+    TEST_ASSERT_EQUAL(sent.size(), received.size());
+    TEST_ASSERT_EQUAL(true, sent == received);
+}
+
+void ut_compressed_stream_binary() {
+    // runs and noise
+    std::vector<uint8_t> sent(4000);
+    std::srand(42);
+    for (size_t i = 0; i < sent.size(); ++i)
+        sent[i] = (i / 300) % 2 ? static_cast<uint8_t>(std::rand()) : static_cast<uint8_t>(i / 50);
+
+    round_trip_in_pieces<8, 4>(sent, {.sync_delimiters = "", .sync_on_write = false});
+    round_trip_in_pieces<4, 2>(sent, {.sync_delimiters = "", .sync_on_write = false});
+    round_trip_in_pieces<10, 5>(sent, {.sync_delimiters = "", .sync_on_write = false});
+    round_trip_in_pieces<8, 4>(sent, {.sync_delimiters = ""});
+}
+
+void ut_compressed_stream_short_lines() {
+    // every line, and most writes, end with a sync that takes more than its bytes
+    std::vector<uint8_t> sent;
+    for (int i = 0; i < 300; ++i) {
+        const std::string line = i % 3 ? "ok\n" : "\n";
+        sent.insert(sent.end(), line.begin(), line.end());
+    }
+    round_trip_in_pieces<8, 4>(sent, {});
+    round_trip_in_pieces<4, 2>(sent, {.sync_on_write = false});
+}
+
+void ut_compressed_stream_flow_control() {
+    // a BufferedStream pauses its peer through the compressor: the XOFF isn't held back for a match
+    auto device_wire = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, //
+                                                                       .output_buffer_size = 64});
+    auto device = BufferedStream(std::make_shared<CompressedStream<>>(device_wire),
+                                 {.input_buffer_size = 16,
+                                  .output_buffer_size = 16,
+                                  .delimiters = "\n",
+                                  .flow_control = FlowControl::XonXoff});
+    auto peer_wire = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, //
+                                                                     .output_buffer_size = 64});
+    auto peer = CompressedStream<>(peer_wire);
+
+    TEST_ASSERT_EQUAL(14, peer.write(std::string_view("0123456789abcd")));
+    carry(*peer_wire, *device_wire);
+    device.pull_in_data();
+    device.push_out_data();
+    TEST_ASSERT_EQUAL(1, device.input_counters().pause_requests);
+    carry(*device_wire, *peer_wire);
+    uint8_t value = 0;
+    TEST_ASSERT_TRUE(peer.read(value));
+    TEST_ASSERT_EQUAL(0x13, value);
+
+    // the line completes and the device drops it: the XON follows right away as well
+    TEST_ASSERT_EQUAL(1, peer.write(std::string_view("\n")));
+    carry(*peer_wire, *device_wire);
+    device.pull_in_data();
+    TEST_ASSERT_TRUE(device.has_line());
+    device.drop_next_line();
+    device.push_out_data();
+    carry(*device_wire, *peer_wire);
+    TEST_ASSERT_TRUE(peer.read(value));
+    TEST_ASSERT_EQUAL(0x11, value);
+}
+
+void ut_compressed_stream_buffered() {
+    // between a BufferedStream and the wire on both ends
+    auto device_wire = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, //
+                                                                       .output_buffer_size = 64});
+    auto peer_wire = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, //
+                                                                     .output_buffer_size = 64});
+    auto device = BufferedStream(std::make_shared<CompressedStream<>>(device_wire),
+                                 {.input_buffer_size = 128, .output_buffer_size = 128, .delimiters = "\n"});
+    auto peer = BufferedStream(std::make_shared<CompressedStream<>>(peer_wire),
+                               {.input_buffer_size = 128, .output_buffer_size = 128, .delimiters = "\n"});
+
+    for (int i = 0; i < 100; ++i) {
+        const auto request = "get sensor/" + std::to_string(i % 4) + "\n";
+        TEST_ASSERT_EQUAL(request.size(), peer.buffered_write(request));
+        peer.push_out_data();
+        carry(*peer_wire, *device_wire);
+        device.pull_in_data();
+        auto transaction = device.new_transaction();
+        TEST_ASSERT_TRUE(transaction.has_value());
+        TEST_ASSERT_EQUAL(true, transaction->incoming() == request.substr(0, request.size() - 1));
+        transaction->outgoingv({telemetry_line(i)});
+        transaction->commit();
+
+        // a reply longer than the wire takes at once goes out over a few passes
+        std::optional<std::string_view> reply;
+        for (int passes = 0; passes < 10 && !reply; ++passes) {
+            device.push_out_data();
+            carry(*device_wire, *peer_wire);
+            peer.pull_in_data();
+            reply = peer.get_next_line_view();
+        }
+        TEST_ASSERT_EQUAL(true, reply && std::string(*reply) + "\n" == telemetry_line(i));
+        peer.drop_next_line();
+    }
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_compressed_stream_round_trip);
+    RUN_TEST(ut_compressed_stream_syncs);
+    RUN_TEST(ut_compressed_stream_binary);
+    RUN_TEST(ut_compressed_stream_short_lines);
+    RUN_TEST(ut_compressed_stream_flow_control);
+    RUN_TEST(ut_compressed_stream_buffered);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
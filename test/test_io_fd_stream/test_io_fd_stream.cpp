@@ -0,0 +1,292 @@
+#include <unity.h>
+
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/core/exception.hpp"
+#    include "spine/eventsystem/eventsystem.hpp"
+#    include "spine/io/stream/buffered_stream.hpp"
+#    include "spine/io/stream/implementations/fd.hpp"
+
+#    include <chrono>
+#    include <fcntl.h>
+#    include <memory>
+#    include <string>
+#    include <thread>
+#    include <unistd.h>
+
+using namespace spn::io;
+
+namespace {
+
+/// Both sides of a pseudo terminal pair as streams, the master as the peer and the slave as the serial device
+struct Pty {
+    std::shared_ptr<FdStream> master;
+    std::shared_ptr<FdStream> slave;
+
+    Pty() {
+        const auto fds = open_pty_pair();
+        TEST_ASSERT_TRUE(fds.has_value());
+        master = std::make_shared<FdStream>(FdStream::Config{.fd = fds->first});
+        slave = std::make_shared<FdStream>(FdStream::Config{.fd = fds->second});
+        master->initialize();
+        slave->initialize();
+    }
+
+    /// Wait for the terminal to pass `n` bytes to `to`
+    static bool wait_for(const FdStream& to, size_t n) {
+        for (int i = 0; i < 1000 && to.available() < n; ++i)
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        return to.available() >= n;
+    }
+};
+
+void ut_fd_stream_basics() {
+    auto pty = Pty();
+
+    // non-blocking: nothing to read returns right away
+    uint8_t value = 0;
+    TEST_ASSERT_EQUAL(0, pty.slave->available());
+    TEST_ASSERT_FALSE(pty.slave->read(value));
+    TEST_ASSERT_TRUE(pty.master->available_for_write() > 0);
+
+    TEST_ASSERT_EQUAL(5, pty.master->write(std::string_view("hello")));
+    TEST_ASSERT_TRUE(Pty::wait_for(*pty.slave, 5));
+    TEST_ASSERT_EQUAL(5, pty.slave->available()); // FIONREAD
+    char buffer[8] = {};
+    TEST_ASSERT_EQUAL(5, pty.slave->read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 5) == "hello");
+
+    // raw mode: bytes pass unaltered, also the other way around
+    TEST_ASSERT_EQUAL(9, pty.slave->writev({"a\r", std::string_view("\0b", 2), "\n", "\x03\x11\x13\x7f"}));
+    TEST_ASSERT_TRUE(Pty::wait_for(*pty.master, 9));
+    char echoed[16] = {};
+    TEST_ASSERT_EQUAL(9, pty.master->read(echoed, sizeof(echoed)));
+    TEST_ASSERT_EQUAL(true, std::string_view(echoed, 9) == std::string_view("a\r\0b\n\x03\x11\x13\x7f", 9));
+}
+
+void ut_fd_stream_buffered_lines() {
+    auto pty = Pty();
+    auto device = BufferedStream(pty.slave, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+    auto peer = BufferedStream(pty.master, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+
+    // request/response exchanges over the terminal
+    for (int i = 0; i < 200; ++i) {
+        const auto request = "get " + std::to_string(i) + "\n";
+        TEST_ASSERT_EQUAL(request.size(), peer.buffered_write(request));
+        peer.push_out_data();
+        TEST_ASSERT_TRUE(Pty::wait_for(*pty.slave, request.size()));
+        device.pull_in_data();
+        auto transaction = device.new_transaction();
+        TEST_ASSERT_TRUE(transaction.has_value());
+        TEST_ASSERT_EQUAL(true, transaction->incoming() == request.substr(0, request.size() - 1));
+        transaction->outgoingv({"ok ", transaction->incoming().substr(4), "\n"});
+        transaction->commit();
+        device.push_out_data();
+
+        TEST_ASSERT_TRUE(Pty::wait_for(*pty.master, 4));
+        for (int retries = 0; retries < 100 && !peer.has_line(); ++retries) {
+            peer.pull_in_data();
+            if (!peer.has_line()) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        const auto reply = peer.get_next_line_view();
+        TEST_ASSERT_EQUAL(true, reply && *reply == "ok " + std::to_string(i));
+        peer.drop_next_line();
+    }
+}
+
+void ut_fd_stream_partial_writev() {
+    // a pipe of a single page, written with a window larger than the page
+    int fds[2];
+    TEST_ASSERT_EQUAL(0, ::pipe(fds));
+    TEST_ASSERT_TRUE(::fcntl(fds[1], F_SETPIPE_SZ, 4096) > 0);
+    auto rx = FdStream({.fd = fds[0]});
+    auto tx = FdStream({.fd = fds[1], .write_window = 16384});
+    rx.initialize();
+    tx.initialize();
+
+    const auto head = std::string(3000, 'h');
+    const auto body = std::string(6000, 'b');
+    const auto tail = std::string(1000, 't');
+    const auto sent = head + body + tail;
+
+    // the pipe takes part of the segments: the write returns right away, with the rest kept for later
+    TEST_ASSERT_TRUE(tx.available_for_write() > 0);
+    TEST_ASSERT_EQUAL(sent.size(), tx.writev({head, body, tail}));
+    TEST_ASSERT_TRUE(rx.available() < sent.size());
+    TEST_ASSERT_EQUAL(0, tx.available_for_write());
+    TEST_ASSERT_FALSE(tx.write('x')); // nothing else is taken until the rest is out
+
+    // the rest goes out ahead of the next write as the pipe is drained, in order
+    auto expected = sent;
+    std::string received;
+    for (int rounds = 0; rounds < 100 && received.size() < expected.size(); ++rounds) {
+        char buffer[1024];
+        const auto n = rx.read(buffer, sizeof(buffer));
+        received.append(buffer, n);
+        if (expected.size() == sent.size() && tx.write('!')) expected += '!';
+    }
+    TEST_ASSERT_EQUAL(expected.size(), received.size());
+    TEST_ASSERT_EQUAL(true, received == sent + "!");
+    TEST_ASSERT_TRUE(tx.available_for_write() > 0);
+
+    // a flush waits for the rest to go out
+    TEST_ASSERT_EQUAL(sent.size(), tx.writev({head, body, tail}));
+    std::thread reader([&] {
+        std::string drained;
+        for (int rounds = 0; rounds < 1000 && drained.size() < sent.size(); ++rounds) {
+            char buffer[1024];
+            drained.append(buffer, rx.read(buffer, sizeof(buffer)));
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        received = drained;
+    });
+    tx.flush();
+    reader.join();
+    TEST_ASSERT_EQUAL(true, received == sent);
+}
+
+enum class Events { Input, Size };
+
+class InputHandler : public spn::core::EventHandler {
+public:
+    InputHandler(spn::core::EventSystem* evsys, FdStream& stream) : EventHandler(evsys), _stream(stream) {}
+
+    void handle_event(const spn::core::Event& event) override {
+        char buffer[16];
+        for (size_t n = 1; n > 0;) {
+            n = _stream.read(buffer, sizeof(buffer));
+            bytes += n;
+        }
+        ++events;
+    }
+
+    FdStream& _stream;
+    size_t bytes = 0;
+    size_t events = 0;
+};
+
+/// Counts the exceptions thrown, e.g. by failing assertions, while in scope
+struct CountingExceptionHandler {
+    struct Handler : spn::core::ExceptionHandler {
+        void handle_exception(const spn::core::Exception& e) override { ++exceptions; }
+        int exceptions = 0;
+    };
+
+    CountingExceptionHandler() : _original(spn::core::set_machine_exception_handler(std::make_unique<Handler>())) {}
+    ~CountingExceptionHandler() { spn::core::set_machine_exception_handler(std::move(_original)); }
+
+    int exceptions() const { return static_cast<Handler*>(spn::core::machine_exception_handler())->exceptions; }
+
+    std::unique_ptr<spn::core::ExceptionHandler> _original;
+};
+
+void ut_epoll_notifier() {
+    const auto exceptions = CountingExceptionHandler();
+    auto pty = Pty();
+    auto evsys = spn::core::EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                                         .events_cap = 8,
+                                         .handler_cap = 1,
+                                         .delay_between_ticks = true});
+    auto handler = InputHandler(&evsys, *pty.slave);
+    evsys.attach(Events::Input, &handler);
+    auto notifier = EpollNotifier({.event_system = &evsys});
+    TEST_ASSERT_TRUE(notifier.watch(pty.slave->fd(), Events::Input));
+    evsys.set_idle_waiter(&notifier);
+
+    // nothing to read: the wait times out
+    TEST_ASSERT_EQUAL(0, notifier.poll(k_time_ms(1)));
+
+    // input wakes the event system before its delay ran out, the next pass fires the event
+    std::thread writer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        pty.master->write(std::string_view("ping"));
+    });
+    const auto start = std::chrono::steady_clock::now();
+    evsys.loop(); // waits at most the minimal delay of 100 ms
+    const auto waited = std::chrono::steady_clock::now() - start;
+    writer.join();
+    evsys.loop();
+    TEST_ASSERT_EQUAL(1, handler.events);
+    TEST_ASSERT_EQUAL(4, handler.bytes);
+    TEST_ASSERT_TRUE(waited < std::chrono::milliseconds(90));
+
+    // a wake from another thread ends the wait without an event
+    std::thread waker([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        notifier.wake();
+    });
+    TEST_ASSERT_EQUAL(0, notifier.poll(k_time_ms(5000)));
+    waker.join();
+    TEST_ASSERT_TRUE(notifier.unwatch(pty.slave->fd()));
+    TEST_ASSERT_EQUAL(0, exceptions.exceptions());
+}
+
+void ut_epoll_notifier_hangup() {
+    auto pty = Pty();
+    auto evsys = spn::core::EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                                         .events_cap = 8,
+                                         .handler_cap = 1,
+                                         .delay_between_ticks = true});
+    auto handler = InputHandler(&evsys, *pty.master);
+    evsys.attach(Events::Input, &handler);
+    auto notifier = EpollNotifier({.event_system = &evsys});
+    TEST_ASSERT_TRUE(notifier.watch(pty.master->fd(), Events::Input));
+    evsys.set_idle_waiter(&notifier);
+
+    // nothing to read is no end of file
+    uint8_t value = 0;
+    TEST_ASSERT_FALSE(pty.master->read(value));
+    TEST_ASSERT_FALSE(pty.master->eof());
+
+    // the other side writes its last words and hangs up: the event fires once, its handler reads up to the end
+    TEST_ASSERT_EQUAL(3, pty.slave->write(std::string_view("bye")));
+    TEST_ASSERT_TRUE(Pty::wait_for(*pty.master, 3));
+    pty.slave.reset();
+    TEST_ASSERT_EQUAL(1, notifier.poll(k_time_ms(1000)));
+    TEST_ASSERT_EQUAL(1, notifier.hangups());
+    evsys.loop();
+    TEST_ASSERT_EQUAL(1, handler.events);
+    TEST_ASSERT_EQUAL(3, handler.bytes);
+    TEST_ASSERT_TRUE(pty.master->eof());
+
+    // the descriptor is no longer watched: the loop waits out its delay instead of spinning on the hang up
+    const auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT_EQUAL(0, notifier.poll(k_time_ms(50)));
+    TEST_ASSERT_TRUE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(40));
+    for (int i = 0; i < 3; ++i)
+        evsys.loop();
+    TEST_ASSERT_EQUAL(1, handler.events);
+}
+
+} // namespace
+
+#endif
+
+int run_all_tests() {
+    UNITY_BEGIN();
+#if defined(NATIVE) && defined(__linux__)
+    RUN_TEST(ut_fd_stream_basics);
+    RUN_TEST(ut_fd_stream_buffered_lines);
+    RUN_TEST(ut_fd_stream_partial_writev);
+    RUN_TEST(ut_epoll_notifier);
+    RUN_TEST(ut_epoll_notifier_hangup);
+#endif
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,198 @@
+#include "spine/io/stream/buffered_stream.hpp"
+#include "spine/io/stream/framed_stream.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace spn::io;
+
+namespace {
+
+constexpr size_t link_delay = 1; // ticks
+constexpr size_t receive_fifo_size = 32; // the receiver's hardware fifo, which loses what doesn't fit
+constexpr size_t max_ticks = 100000;
+
+/// A serial link between two MockStreams: every tick at most `rate` bytes (the size of the MockStream's output) travel
+/// in each direction, arriving `link_delay` ticks later
+struct Link {
+    std::shared_ptr<MockStream> sender;
+    std::shared_ptr<MockStream> receiver;
+    std::deque<std::vector<uint8_t>> forward;
+    std::deque<std::vector<uint8_t>> backward;
+
+    explicit Link(size_t rate)
+        : sender(std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 64, .output_buffer_size = rate})),
+          receiver(std::make_shared<MockStream>(
+              MockStream::Config{.input_buffer_size = receive_fifo_size, .output_buffer_size = rate})) {
+        sender->initialize();
+        receiver->initialize();
+    }
+
+    void tick() {
+        transfer(*sender, *receiver, forward);
+        transfer(*receiver, *sender, backward);
+    }
+
+    static void transfer(MockStream& from, MockStream& to, std::deque<std::vector<uint8_t>>& line) {
+        line.push_back(*from.extract_bytestream());
+        if (line.size() > link_delay) {
+            to.inject_bytestream(line.front());
+            line.pop_front();
+        }
+    }
+};
+
+/// Stream `count` numbered lines through a link into a receiver that takes in a line only every other tick, returns
+/// the amount of lines that were lost
+size_t stream_lines(FlowControl flow_control, uint32_t count, BufferedStream::InputCounters* counters = nullptr) {
+    auto link = Link(8);
+    auto sender = BufferedStream(link.sender, {.input_buffer_size = 16,
+                                               .output_buffer_size = 32,
+                                               .delimiters = "\n",
+                                               .flow_control = flow_control});
+    auto receiver = BufferedStream(link.receiver, {.input_buffer_size = 64,
+                                                   .output_buffer_size = 16,
+                                                   .delimiters = "\n",
+                                                   .flow_control = flow_control});
+
+    uint32_t next_sent = 0;
+    uint32_t next_expected = 0;
+    size_t delivered = 0; // intact lines, in order
+    for (size_t tick = 0; tick < max_ticks && next_expected < count; ++tick) {
+        char line[16];
+        while (next_sent < count && sender.output_buffer_space_left() >= 7) {
+            const auto length = std::snprintf(line, sizeof(line), "%06u\n", static_cast<unsigned>(next_sent++));
+            sender.buffered_write(line, static_cast<size_t>(length));
+        }
+        sender.pull_in_data();
+        sender.push_out_data();
+        link.tick();
+
+        receiver.pull_in_data();
+        if (tick % 2 == 0) {
+            if (auto transaction = receiver.new_transaction()) {
+                const auto line = std::string(transaction->incoming());
+                const auto number = static_cast<uint32_t>(std::atoi(line.c_str()));
+                if (line.size() == 6 && number >= next_expected) { // without its delimiter
+                    ++delivered;
+                    next_expected = number + 1;
+                }
+            }
+        }
+        receiver.push_out_data();
+        if (next_sent == count && link.forward.empty() && receiver.input_buffer_space_used() == 0
+            && link.receiver->available() == 0 && sender.output_buffer_space_used() == 0)
+            break; // everything that made it through was consumed
+    }
+    if (counters) *counters = receiver.input_counters();
+    return count - delivered;
+}
+
+void ut_flow_control_none_loses_lines() {
+    // without flow control the receiver's fifo overflows at this rate
+    TEST_ASSERT_GREATER_THAN(0, stream_lines(FlowControl::None, 2000));
+}
+
+void ut_flow_control_xon_xoff() {
+    auto counters = BufferedStream::InputCounters{};
+    TEST_ASSERT_EQUAL(0, stream_lines(FlowControl::XonXoff, 5000, &counters));
+    TEST_ASSERT_EQUAL(5000 * 7, counters.received_bytes);
+    TEST_ASSERT_EQUAL(0, counters.overrun_bytes);
+    TEST_ASSERT_EQUAL(0, counters.overruns);
+    TEST_ASSERT_GREATER_THAN(0, counters.pause_requests);
+}
+
+void ut_flow_control_overrun_counters() {
+    auto link = Link(8);
+    auto receiver =
+        BufferedStream(link.receiver, {.input_buffer_size = 8, .output_buffer_size = 8, .delimiters = "\n"});
+    link.receiver->inject_bytestream({'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', '\n'});
+    receiver.pull_in_data();
+    TEST_ASSERT_EQUAL(11, receiver.input_counters().received_bytes);
+    TEST_ASSERT_EQUAL(3, receiver.input_counters().overrun_bytes);
+    TEST_ASSERT_EQUAL(1, receiver.input_counters().overruns);
+    receiver.drop_next_line();
+    link.receiver->inject_bytestream({'0', '1', '2', '3', '4', '5', '6', '7', '8', '\n'});
+    receiver.pull_in_data();
+    TEST_ASSERT_EQUAL(5, receiver.input_counters().overrun_bytes);
+    TEST_ASSERT_EQUAL(2, receiver.input_counters().overruns);
+}
+
+void ut_flow_control_credit_frames() {
+    constexpr uint32_t count = 3000;
+    auto link = Link(16); // wide enough for a credit update of 9 bytes
+    const auto cfg = FramedStream::Config{.input_buffer_size = 64,
+                                          .output_buffer_size = 32,
+                                          .max_payload_size = 8,
+                                          .check = FrameCheck::Crc16,
+                                          .credit_tag = 0xFC};
+    auto sender = FramedStream(link.sender, FramedStream::Config(cfg));
+    auto receiver = FramedStream(link.receiver, FramedStream::Config(cfg));
+
+    uint32_t next_sent = 0;
+    uint32_t next_expected = 0;
+    size_t tick = 0;
+    for (; tick < max_ticks && next_expected < count; ++tick) {
+        while (next_sent < count) {
+            const auto payload = std::string_view(reinterpret_cast<const char*>(&next_sent), sizeof(next_sent));
+            if (!sender.write_frame(payload)) break;
+            ++next_sent;
+        }
+        sender.pull_in_data();
+        sender.push_out_data();
+        link.tick();
+
+        receiver.pull_in_data();
+        if (tick % 2 == 0) {
+            if (auto transaction = receiver.new_transaction()) {
+                uint32_t number = 0;
+                std::memcpy(&number, transaction->incoming().data(), sizeof(number));
+                TEST_ASSERT_EQUAL(next_expected, number);
+                next_expected = number + 1;
+            }
+        }
+        receiver.push_out_data();
+    }
+    TEST_ASSERT_EQUAL(count, next_expected);
+    TEST_ASSERT_EQUAL(0, receiver.dropped_frames());
+    TEST_ASSERT_EQUAL(0, receiver.buffered_stream().input_counters().overrun_bytes);
+    // the receiver takes in a frame every other tick, which the link can carry in well under that
+    TEST_ASSERT_LESS_OR_EQUAL(2 * count + 64, tick);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_flow_control_none_loses_lines);
+    RUN_TEST(ut_flow_control_xon_xoff);
+    RUN_TEST(ut_flow_control_overrun_counters);
+    RUN_TEST(ut_flow_control_credit_frames);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
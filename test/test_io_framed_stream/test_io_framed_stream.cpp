@@ -0,0 +1,285 @@
+#include "spine/core/memory.hpp"
+#include "spine/core/utils/cobs.hpp"
+#include "spine/core/utils/crc.hpp"
+#include "spine/io/stream/framed_stream.hpp"
+#include "spine/io/stream/implementations/mock.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using namespace spn::core::utils;
+using spn::io::FrameCheck;
+using spn::io::FramedStream;
+using spn::io::MockStream;
+
+namespace {
+
+const auto* as_bytes(const std::string& s) { return reinterpret_cast<const uint8_t*>(s.data()); }
+
+std::string cobs_round_trip(const std::string& data) {
+    auto encoded = std::vector<uint8_t>(cobs_max_encoded_size(data.size()));
+    const auto encoded_size = cobs_encode(as_bytes(data), data.size(), encoded.data());
+    TEST_ASSERT_LESS_OR_EQUAL(encoded.size(), encoded_size);
+    for (size_t i = 0; i < encoded_size; ++i)
+        TEST_ASSERT_TRUE(encoded[i] != 0);
+
+    // decode in place and in two pieces, as from a wrapped ring buffer
+    auto decoder = CobsDecoder(encoded.data(), encoded.size());
+    decoder.feed(encoded.data(), encoded_size / 2);
+    decoder.feed(encoded.data() + encoded_size / 2, encoded_size - encoded_size / 2);
+    TEST_ASSERT_TRUE(decoder.finish());
+    return std::string(reinterpret_cast<const char*>(encoded.data()), decoder.size());
+}
+
+void ut_crc_check_values() {
+    const auto check = std::string("123456789");
+    TEST_ASSERT_EQUAL_UINT32(0x29B1, crc16(as_bytes(check), check.size()));
+    TEST_ASSERT_EQUAL_UINT32(0xCBF43926, crc32(as_bytes(check), check.size()));
+
+    // continued over chunks of every alignment
+    for (size_t split = 0; split <= check.size(); ++split) {
+        const auto crc = crc32(as_bytes(check) + split, check.size() - split, crc32(as_bytes(check), split));
+        TEST_ASSERT_EQUAL_UINT32(0xCBF43926, crc);
+        const auto crc_16 = crc16(as_bytes(check) + split, check.size() - split, crc16(as_bytes(check), split));
+        TEST_ASSERT_EQUAL_UINT32(0x29B1, crc_16);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, crc32(nullptr, 0));
+}
+
+void ut_cobs() {
+    // known encodings
+    const auto data = std::string("\x11\x22\x00\x33", 4);
+    uint8_t encoded[8];
+    TEST_ASSERT_EQUAL(5, cobs_encode(as_bytes(data), data.size(), encoded));
+    TEST_ASSERT_EQUAL(true, std::string(reinterpret_cast<char*>(encoded), 5) == std::string("\x03\x11\x22\x02\x33"));
+    TEST_ASSERT_EQUAL(1, cobs_encode(nullptr, 0, encoded));
+    TEST_ASSERT_EQUAL(1, encoded[0]);
+
+    // round trips around the block size of 254
+    for (const auto size : {1, 2, 253, 254, 255, 508, 509, 1000}) {
+        auto ones = std::string(static_cast<size_t>(size), '\x01');
+        TEST_ASSERT_EQUAL(true, cobs_round_trip(ones) == ones);
+        auto zeros = std::string(static_cast<size_t>(size), '\0');
+        TEST_ASSERT_EQUAL(true, cobs_round_trip(zeros) == zeros);
+        auto mixed = std::string(static_cast<size_t>(size), 'x');
+        for (size_t i = 0; i < mixed.size(); i += 7)
+            mixed[i] = '\0';
+        TEST_ASSERT_EQUAL(true, cobs_round_trip(mixed) == mixed);
+    }
+    // a full block at the end needs no empty block after it
+    const auto full_block = std::string(254, 'x');
+    uint8_t full_block_encoded[cobs_max_encoded_size(254)];
+    TEST_ASSERT_EQUAL(255, cobs_encode(as_bytes(full_block), full_block.size(), full_block_encoded));
+
+    // invalid data
+    uint8_t out[8];
+    const uint8_t truncated[] = {0x05, 0x11};
+    TEST_ASSERT_EQUAL(0, cobs_decode(truncated, sizeof(truncated), out, sizeof(out)));
+    const uint8_t zero[] = {0x02, 0x11, 0x00};
+    TEST_ASSERT_EQUAL(0, cobs_decode(zero, sizeof(zero), out, sizeof(out)));
+    const uint8_t too_large[] = {0x09, 1, 2, 3, 4, 5, 6, 7, 8, 0x01};
+    TEST_ASSERT_EQUAL(0, cobs_decode(too_large, sizeof(too_large), out, sizeof(out)));
+}
+
+void ut_framed_stream_round_trip() {
+    for (const auto check : {FrameCheck::None, FrameCheck::Crc16, FrameCheck::Crc32}) {
+        auto mock_stream = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 1024, //
+                                                                       .output_buffer_size = 1024});
+        auto framed = FramedStream(mock_stream, FramedStream::Config{.input_buffer_size = 64,
+                                                                     .output_buffer_size = 64,
+                                                                     .max_payload_size = 32,
+                                                                     .check = check});
+        mock_stream->initialize();
+
+        // payloads with zeros, passing through the rings often enough for frames to wrap around their ends
+        for (size_t i = 0; i < 40; ++i) {
+            auto payload = std::string("\0frame\0", 7) + std::to_string(i) + std::string(i % 9, '\0');
+            TEST_ASSERT_TRUE(framed.write_frame(payload));
+            TEST_ASSERT_EQUAL(true, framed.push_out_data() > 0);
+
+            const auto wire = mock_stream->extract_bytestream();
+            TEST_ASSERT_TRUE(wire.has_value());
+            TEST_ASSERT_EQUAL(0, wire->back());
+            for (size_t j = 0; j + 1 < wire->size(); ++j)
+                TEST_ASSERT_TRUE((*wire)[j] != 0);
+
+            mock_stream->inject_bytestream(*wire);
+            framed.pull_in_data();
+            TEST_ASSERT_TRUE(framed.has_frame());
+            auto transaction = framed.new_transaction();
+            TEST_ASSERT_TRUE(transaction.has_value());
+            TEST_ASSERT_EQUAL(true, transaction->incoming() == payload);
+            transaction->commit();
+            TEST_ASSERT_FALSE(framed.has_frame());
+        }
+        TEST_ASSERT_EQUAL(0, framed.dropped_frames());
+    }
+
+    // payloads around the block size of 254
+    auto mock_stream = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 2048, //
+                                                                       .output_buffer_size = 2048});
+    auto framed = FramedStream(mock_stream, FramedStream::Config{.input_buffer_size = 1024,
+                                                                 .output_buffer_size = 1024,
+                                                                 .max_payload_size = 1000,
+                                                                 .check = FrameCheck::Crc32});
+    mock_stream->initialize();
+    for (const auto size : {253, 254, 255, 508, 509, 1000}) {
+        const auto payload = std::string(static_cast<size_t>(size), 'x');
+        TEST_ASSERT_TRUE(framed.write_frame(payload));
+        framed.push_out_data();
+        mock_stream->inject_bytestream(*mock_stream->extract_bytestream());
+        framed.pull_in_data();
+        auto transaction = framed.new_transaction();
+        TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == payload);
+    }
+}
+
+void ut_framed_stream_corruption() {
+    auto mock_stream = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 256, //
+                                                                       .output_buffer_size = 256});
+    auto framed = FramedStream(mock_stream, FramedStream::Config{.input_buffer_size = 128,
+                                                                 .output_buffer_size = 128,
+                                                                 .max_payload_size = 16,
+                                                                 .check = FrameCheck::Crc32});
+    mock_stream->initialize();
+
+    TEST_ASSERT_TRUE(framed.write_frame("first"));
+    TEST_ASSERT_TRUE(framed.write_frame("second"));
+    TEST_ASSERT_TRUE(framed.write_frame("third"));
+    TEST_ASSERT_FALSE(framed.write_frame(std::string(200, 'x'))); // doesn't fit the output buffer
+    framed.push_out_data();
+    auto wire = *mock_stream->extract_bytestream();
+    wire[13] ^= 0x20; // flip a bit in the second frame, the first takes 11 bytes
+
+    // padding, a corrupt frame and a frame larger than the payload buffer are all skipped
+    wire.insert(wire.begin(), {0, 0});
+    const auto large = std::vector<uint8_t>(40, 'y');
+    wire.insert(wire.end(), large.begin(), large.end());
+    wire.push_back(0);
+    mock_stream->inject_bytestream(wire);
+    framed.pull_in_data();
+
+    auto transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "first");
+    transaction->commit();
+    transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "third");
+    transaction->commit();
+    TEST_ASSERT_FALSE(framed.new_transaction().has_value());
+    TEST_ASSERT_EQUAL(2, framed.dropped_frames());
+}
+
+void ut_frame_transaction() {
+    auto mock_stream = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 256, //
+                                                                       .output_buffer_size = 256});
+    auto framed = FramedStream(mock_stream, FramedStream::Config{.input_buffer_size = 64,
+                                                                 .output_buffer_size = 64,
+                                                                 .max_payload_size = 16,
+                                                                 .check = FrameCheck::Crc16});
+    mock_stream->initialize();
+    TEST_ASSERT_TRUE(framed.write_frame("ping"));
+    TEST_ASSERT_TRUE(framed.write_frame("drop"));
+    framed.push_out_data();
+    mock_stream->inject_bytestream(*mock_stream->extract_bytestream());
+    framed.pull_in_data();
+
+    const char oversized[100] = {};
+    const auto allocations = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    {
+        auto transaction = framed.new_transaction();
+        TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "ping");
+        TEST_ASSERT_EQUAL(2, transaction->outgoing(std::string_view("po", 2)));
+        TEST_ASSERT_EQUAL(2, transaction->outgoing(std::string_view("\0g", 2)));
+        TEST_ASSERT_EQUAL(0, transaction->outgoing(oversized, sizeof(oversized))); // all or nothing
+        TEST_ASSERT_EQUAL(4, transaction->outgoing_space_used());
+        TEST_ASSERT_EQUAL(true, transaction->outgoing_space_left() > 40);
+    } // commits
+
+    auto transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "drop");
+    transaction->outgoing("never sent", 10);
+    transaction->abort();
+    TEST_ASSERT_EQUAL(allocations, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+
+    framed.push_out_data();
+    mock_stream->inject_bytestream(*mock_stream->extract_bytestream());
+    framed.pull_in_data();
+    transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == std::string_view("po\0g", 4));
+    transaction->commit();
+    TEST_ASSERT_FALSE(framed.new_transaction().has_value());
+}
+
+void ut_frame_transaction_push_while_open() {
+    auto mock_stream = std::make_shared<MockStream>(MockStream::Config{.input_buffer_size = 256, //
+                                                                       .output_buffer_size = 256});
+    auto framed = FramedStream(mock_stream, FramedStream::Config{.input_buffer_size = 64,
+                                                                 .output_buffer_size = 64,
+                                                                 .max_payload_size = 16,
+                                                                 .check = FrameCheck::Crc32});
+    mock_stream->initialize();
+    TEST_ASSERT_TRUE(framed.write_frame("ping"));
+    framed.push_out_data();
+    mock_stream->inject_bytestream(*mock_stream->extract_bytestream());
+    framed.pull_in_data();
+
+    auto transaction = framed.new_transaction();
+    TEST_ASSERT_TRUE(transaction.has_value());
+    TEST_ASSERT_TRUE(framed.write_frame("before")); // a complete frame queued ahead of the open one
+    TEST_ASSERT_EQUAL(5, transaction->outgoing(std::string_view("po ng", 5)));
+
+    // the complete frame goes out, the open one with its unpatched length bytes is held back
+    TEST_ASSERT_TRUE(framed.push_out_data() > 0);
+    auto wire = *mock_stream->extract_bytestream();
+    TEST_ASSERT_EQUAL(0, wire.back());
+    for (size_t j = 0; j + 1 < wire.size(); ++j)
+        TEST_ASSERT_TRUE(wire[j] != 0);
+    TEST_ASSERT_EQUAL(0, framed.push_out_data());
+
+    transaction->commit();
+    framed.push_out_data();
+    const auto rest = *mock_stream->extract_bytestream();
+    wire.insert(wire.end(), rest.begin(), rest.end());
+    mock_stream->inject_bytestream(wire);
+    framed.pull_in_data();
+    transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == "before");
+    transaction->commit();
+    transaction = framed.new_transaction();
+    TEST_ASSERT_EQUAL(true, transaction && transaction->incoming() == std::string_view("po\0ng", 5));
+    transaction->commit();
+    TEST_ASSERT_EQUAL(0, framed.dropped_frames());
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_crc_check_values);
+    RUN_TEST(ut_cobs);
+    RUN_TEST(ut_framed_stream_round_trip);
+    RUN_TEST(ut_framed_stream_corruption);
+    RUN_TEST(ut_frame_transaction);
+    RUN_TEST(ut_frame_transaction_push_while_open);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,211 @@
+#include <unity.h>
+
+#if defined(NATIVE) && defined(__linux__)
+
+#    include "spine/io/stream/buffered_stream.hpp"
+#    include "spine/io/stream/implementations/shared_memory.hpp"
+
+#    include <chrono>
+#    include <cstdio>
+#    include <memory>
+#    include <string>
+#    include <sys/wait.h>
+#    include <thread>
+#    include <unistd.h>
+
+using namespace spn::io;
+
+namespace {
+
+std::string shm_path() { return "/tmp/spine_test_shm_" + std::to_string(::getpid()); }
+
+void ut_shared_memory_stream_basics() {
+    const auto path = shm_path();
+    auto secondary = SharedMemoryStream({.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary});
+    secondary.initialize();
+    TEST_ASSERT_FALSE(secondary.is_open()); // there's no file to map before the primary side created it
+
+    auto primary =
+        SharedMemoryStream({.path = path.c_str(), .side = SharedMemoryStream::Side::Primary, .capacity = 16});
+    primary.initialize();
+    TEST_ASSERT_TRUE(primary.is_open());
+    secondary.initialize();
+    TEST_ASSERT_TRUE(secondary.is_open());
+    TEST_ASSERT_EQUAL(16, secondary.capacity());
+
+    // both directions are independent
+    TEST_ASSERT_EQUAL(5, primary.write(std::string_view("hello")));
+    TEST_ASSERT_EQUAL(3, secondary.write(std::string_view("hey")));
+    TEST_ASSERT_EQUAL(5, secondary.available());
+    TEST_ASSERT_EQUAL(3, primary.available());
+    char buffer[32] = {};
+    TEST_ASSERT_EQUAL(5, secondary.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 5) == "hello");
+    TEST_ASSERT_EQUAL(3, primary.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 3) == "hey");
+    TEST_ASSERT_EQUAL(0, primary.read(buffer, sizeof(buffer)));
+
+    // a full ring takes what fits, then wraps around as the reader makes room
+    TEST_ASSERT_EQUAL(16, primary.write(std::string_view("0123456789abcdefXYZ")));
+    TEST_ASSERT_EQUAL(0, primary.available_for_write());
+    TEST_ASSERT_FALSE(primary.write('!'));
+    TEST_ASSERT_EQUAL(10, secondary.read(buffer, 10));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 10) == "0123456789");
+    TEST_ASSERT_EQUAL(10, primary.available_for_write());
+
+    // writev is all or nothing
+    TEST_ASSERT_EQUAL(0, primary.writev({"ABCDEF", "GHIJK"}));
+    TEST_ASSERT_EQUAL(10, primary.writev({"ABCD", "EFGH", std::string_view(), "IJ"}));
+    TEST_ASSERT_EQUAL(16, secondary.read(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL(true, std::string_view(buffer, 16) == "abcdefABCDEFGHIJ");
+
+    // byte by byte across the wrap around
+    for (int round = 0; round < 40; ++round) {
+        TEST_ASSERT_TRUE(secondary.write(static_cast<uint8_t>(round)));
+        uint8_t value = 0;
+        TEST_ASSERT_TRUE(primary.read(value));
+        TEST_ASSERT_EQUAL(round, value);
+    }
+}
+
+/// Returns true if a stream that isn't open reads, writes and waits for nothing
+bool is_inert(SharedMemoryStream& stream) {
+    char buffer[8] = {};
+    return !stream.is_open() && stream.available() == 0 && stream.available_for_write() == 0
+           && stream.read(buffer, sizeof(buffer)) == 0 && stream.write(std::string_view("hello")) == 0
+           && stream.writev({"a", "b"}) == 0 && !stream.wait_for_input(k_time_ms(1000));
+}
+
+void ut_shared_memory_stream_invalid_segment() {
+    const auto path = shm_path();
+
+    // no file at all
+    auto missing = SharedMemoryStream({.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary});
+    missing.initialize();
+    TEST_ASSERT_TRUE(is_inert(missing));
+
+    // a file that's too small for the layout, and one large enough without the magic of the primary side
+    for (const size_t size : {size_t{8}, size_t{4096}}) {
+        auto* const file = std::fopen(path.c_str(), "wb");
+        TEST_ASSERT_TRUE(file != nullptr);
+        const auto garbage = std::string(size, 'x');
+        TEST_ASSERT_EQUAL(size, std::fwrite(garbage.data(), 1, size, file));
+        std::fclose(file);
+
+        auto invalid = SharedMemoryStream({.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary});
+        invalid.initialize();
+        TEST_ASSERT_TRUE(is_inert(invalid));
+    }
+    ::unlink(path.c_str());
+}
+
+void ut_shared_memory_stream_doorbell() {
+    const auto path = shm_path();
+    for (const bool doorbell : {true, false}) {
+        auto primary = SharedMemoryStream({.path = path.c_str(), .doorbell = doorbell});
+        auto secondary = SharedMemoryStream(
+            {.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary, .doorbell = doorbell});
+        primary.initialize();
+        secondary.initialize();
+
+        // nothing arrives: the wait times out
+        TEST_ASSERT_FALSE(secondary.wait_for_input(k_time_ms(5)));
+
+        // a write from another thread ends the wait
+        std::thread writer([&] {
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+            primary.write(std::string_view("ring"));
+        });
+        const auto start = std::chrono::steady_clock::now();
+        TEST_ASSERT_TRUE(secondary.wait_for_input(k_time_ms(5000)));
+        const auto waited = std::chrono::steady_clock::now() - start;
+        writer.join();
+        TEST_ASSERT_TRUE(waited < std::chrono::milliseconds(1000));
+        TEST_ASSERT_EQUAL(4, secondary.available());
+
+        // input that's there already returns right away
+        TEST_ASSERT_TRUE(secondary.wait_for_input(k_time_ms(0)));
+    }
+}
+
+void ut_shared_memory_stream_processes() {
+    const auto path = shm_path();
+    auto primary = std::make_shared<SharedMemoryStream>(SharedMemoryStream::Config{.path = path.c_str()});
+    primary->initialize();
+    constexpr int exchanges = 200;
+
+    const auto pid = ::fork();
+    TEST_ASSERT_TRUE(pid >= 0);
+    if (pid == 0) {
+        // the other process: answer every request, exits with the amount of requests that went wrong
+        auto stream = std::make_shared<SharedMemoryStream>(
+            SharedMemoryStream::Config{.path = path.c_str(), .side = SharedMemoryStream::Side::Secondary});
+        stream->initialize();
+        if (!stream->is_open()) ::_exit(exchanges);
+        auto device = BufferedStream(stream, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+        int failures = 0;
+        for (int i = 0; i < exchanges; ++i) {
+            while (!device.has_line()) {
+                stream->wait_for_input(k_time_ms(1000));
+                device.pull_in_data();
+            }
+            auto transaction = device.new_transaction();
+            if (!transaction) ::_exit(exchanges);
+            if (transaction->incoming() != "get " + std::to_string(i)) ++failures;
+            transaction->outgoingv({"ok ", transaction->incoming().substr(4), "\n"});
+            transaction->commit();
+            device.push_out_data();
+        }
+        ::_exit(failures);
+    }
+
+    auto peer = BufferedStream(primary, {.input_buffer_size = 64, .output_buffer_size = 64, .delimiters = "\n"});
+    for (int i = 0; i < exchanges; ++i) {
+        TEST_ASSERT_TRUE(peer.buffered_write("get " + std::to_string(i) + "\n") > 0);
+        peer.push_out_data();
+        for (int retries = 0; retries < 100 && !peer.has_line(); ++retries) {
+            primary->wait_for_input(k_time_ms(100));
+            peer.pull_in_data();
+        }
+        const auto reply = peer.get_next_line_view();
+        TEST_ASSERT_EQUAL(true, reply && *reply == "ok " + std::to_string(i));
+        peer.drop_next_line();
+    }
+
+    int status = -1;
+    TEST_ASSERT_EQUAL(pid, ::waitpid(pid, &status, 0));
+    TEST_ASSERT_TRUE(WIFEXITED(status));
+    TEST_ASSERT_EQUAL(0, WEXITSTATUS(status));
+}
+
+} // namespace
+
+#endif
+
+int run_all_tests() {
+    UNITY_BEGIN();
+#if defined(NATIVE) && defined(__linux__)
+    RUN_TEST(ut_shared_memory_stream_basics);
+    RUN_TEST(ut_shared_memory_stream_invalid_segment);
+    RUN_TEST(ut_shared_memory_stream_doorbell);
+    RUN_TEST(ut_shared_memory_stream_processes);
+#endif
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -1,11 +1,14 @@
 #include "spine/io/stream/implementations/mock.hpp"
+#include "spine/io/stream/static_stream.hpp"
 #include "spine/io/stream/stream.hpp"
+#include "spine/platform/implementations/mock.hpp"
 
 #include <unity.h>
 
 #include <climits>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <vector>
 
 using namespace spn::structure;
@@ -34,11 +37,75 @@ void ut_stream_basics() {
     TEST_ASSERT_EQUAL(true, test_data == result_data);
 }
 
+static_assert(spn::io::is_stream_v<spn::io::Stream>);
+static_assert(spn::io::is_stream_v<spn::io::StaticMockStream>);
+static_assert(spn::io::is_stream_v<spn::platform::MockUART>);
+static_assert(!spn::io::is_stream_v<LineBuffer>);
+
+void ut_static_stream() {
+    // the static stream and its adapter behave the same
+    auto static_stream = spn::io::StaticMockStream({.input_buffer_size = 8, .output_buffer_size = 8});
+    auto adapter = spn::io::MockStream({.input_buffer_size = 8, .output_buffer_size = 8});
+    spn::io::Stream& dynamic_stream = adapter;
+    const auto fill = [](auto& stream) {
+        TEST_ASSERT_EQUAL(8, stream.write(std::string_view("0123456789")));
+        TEST_ASSERT_FALSE(stream.write('x'));
+        TEST_ASSERT_EQUAL(0, stream.available_for_write());
+    };
+    fill(static_stream);
+    fill(dynamic_stream);
+    TEST_ASSERT_EQUAL(true, static_stream.extract_bytestream() == adapter.extract_bytestream());
+
+    // both write all segments or none of them
+    const auto gather = [](auto& stream) {
+        TEST_ASSERT_EQUAL(0, stream.writev({"0123", "45678"}));
+        TEST_ASSERT_EQUAL(8, stream.writev({"0123", "", "4567"}));
+        TEST_ASSERT_EQUAL(0, stream.available_for_write());
+    };
+    gather(static_stream);
+    gather(dynamic_stream);
+    TEST_ASSERT_EQUAL(true, static_stream.extract_bytestream() == adapter.extract_bytestream());
+
+    adapter.stream().inject_bytestream({'a', 'b'});
+    uint8_t value = 0;
+    TEST_ASSERT_TRUE(dynamic_stream.read(value));
+    TEST_ASSERT_EQUAL('a', value);
+    TEST_ASSERT_EQUAL(1, adapter.available());
+}
+
+void ut_stream_pumps() {
+    auto stream = spn::io::StaticMockStream({.input_buffer_size = 16, .output_buffer_size = 16});
+    auto buffer = LineBuffer(8);
+
+    // move the ring's head near its end, such that the pumps go through both of its spans
+    buffer.push(std::string_view("xxxxx"));
+    buffer.drop_first(5);
+    stream.inject_bytestream({'h', 'e', 'l', 'l', 'o', ' ', 'w', 'o', 'r', 'l', 'd'});
+    TEST_ASSERT_EQUAL(8, spn::io::pull_into(buffer, stream));
+    TEST_ASSERT_TRUE(buffer.full());
+    TEST_ASSERT_EQUAL(3, stream.available());
+
+    TEST_ASSERT_EQUAL(6, spn::io::push_from(buffer, stream, 6));
+    TEST_ASSERT_EQUAL(3, spn::io::pull_into(buffer, stream));
+    TEST_ASSERT_EQUAL(5, spn::io::push_from(buffer, stream));
+    TEST_ASSERT_TRUE(buffer.empty());
+    const auto wire = *stream.extract_bytestream();
+    TEST_ASSERT_EQUAL(true, std::string(wire.begin(), wire.end()) == "hello world");
+
+    // a stream that takes no more stops the pump
+    auto small = spn::io::StaticMockStream({.input_buffer_size = 1, .output_buffer_size = 3});
+    buffer.push(std::string_view("abcdef"));
+    TEST_ASSERT_EQUAL(3, spn::io::push_from(buffer, small));
+    TEST_ASSERT_EQUAL(3, buffer.used_space());
+}
+
 } // namespace
 
 int run_all_tests() {
     UNITY_BEGIN();
     RUN_TEST(ut_stream_basics);
+    RUN_TEST(ut_static_stream);
+    RUN_TEST(ut_stream_pumps);
     return UNITY_END();
 }
 
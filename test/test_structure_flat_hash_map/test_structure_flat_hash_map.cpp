@@ -0,0 +1,151 @@
+#include "spine/structure/flat_hash_map.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+using namespace spn::structure;
+
+namespace {
+
+void ut_flat_hash_map_basics() {
+    auto map = FlatHashMap<int, int, 8>();
+    TEST_ASSERT_EQUAL(true, map.empty());
+    TEST_ASSERT_EQUAL(8, map.capacity());
+
+    TEST_ASSERT_EQUAL(true, map.insert(1, 10));
+    TEST_ASSERT_EQUAL(true, map.insert(2, 20));
+    TEST_ASSERT_EQUAL(false, map.insert(2, 30)); // already present
+    TEST_ASSERT_EQUAL(2, map.size());
+    TEST_ASSERT_EQUAL(20, *map.find(2));
+
+    TEST_ASSERT_EQUAL(true, map.insert_or_assign(2, 30));
+    TEST_ASSERT_EQUAL(30, *map.find(2));
+    TEST_ASSERT_EQUAL(2, map.size());
+
+    TEST_ASSERT_EQUAL(true, map.find(3) == nullptr);
+    TEST_ASSERT_EQUAL(false, map.contains(3));
+    map[3] += 5;
+    TEST_ASSERT_EQUAL(5, *map.find(3));
+
+    TEST_ASSERT_EQUAL(true, map.erase(1));
+    TEST_ASSERT_EQUAL(false, map.erase(1));
+    TEST_ASSERT_EQUAL(false, map.contains(1));
+    TEST_ASSERT_EQUAL(2, map.size());
+
+    map.clear();
+    TEST_ASSERT_EQUAL(true, map.empty());
+    TEST_ASSERT_EQUAL(false, map.contains(2));
+}
+
+void ut_flat_hash_map_full() {
+    auto map = FlatHashMap<uint32_t, uint32_t, 16>();
+    for (uint32_t i = 0; i < 16; ++i) {
+        TEST_ASSERT_EQUAL(true, map.insert(i * 7, i));
+    }
+    TEST_ASSERT_EQUAL(true, map.full());
+    TEST_ASSERT_EQUAL(false, map.insert(1000, 0));
+    TEST_ASSERT_EQUAL(true, map.find(1000) == nullptr); // must terminate on a full table
+    for (uint32_t i = 0; i < 16; ++i) {
+        TEST_ASSERT_EQUAL(i, *map.find(i * 7));
+    }
+
+    // deletion from a full table must keep every other entry reachable
+    TEST_ASSERT_EQUAL(true, map.erase(0));
+    for (uint32_t i = 1; i < 16; ++i) {
+        TEST_ASSERT_EQUAL(i, *map.find(i * 7));
+    }
+    TEST_ASSERT_EQUAL(true, map.insert(1000, 1));
+    TEST_ASSERT_EQUAL(1, *map.find(1000));
+}
+
+void ut_flat_hash_map_iteration() {
+    const auto map = FlatHashMap<int, int, 5>{{1, 1}, {2, 2}, {3, 3}};
+    int sum = 0;
+    size_t count = 0;
+    for (const auto& [key, value] : map) {
+        TEST_ASSERT_EQUAL(key, value);
+        sum += value;
+        ++count;
+    }
+    TEST_ASSERT_EQUAL(3, count);
+    TEST_ASSERT_EQUAL(6, sum);
+
+    // values can be changed in place, keys can't
+    auto mutable_map = FlatHashMap<int, int, 5>{{1, 1}, {2, 2}};
+    using Entry = decltype(*mutable_map.begin());
+    static_assert(std::is_same_v<Entry, std::pair<const int&, int&>>);
+    static_assert(std::is_same_v<decltype(*map.begin()), std::pair<const int&, const int&>>);
+    for (auto [key, value] : mutable_map)
+        value = key * 10;
+    for (auto it = mutable_map.begin(); it != mutable_map.end(); ++it)
+        it->second += 1;
+    TEST_ASSERT_EQUAL(11, *mutable_map.find(1));
+    TEST_ASSERT_EQUAL(21, *mutable_map.find(2));
+}
+
+void ut_flat_hash_map_string_keys() {
+    auto map = FlatHashMap<std::string_view, int, 4>{{"get", 1}, {"set", 2}};
+    TEST_ASSERT_EQUAL(1, *map.find("get"));
+    TEST_ASSERT_EQUAL(2, *map.find("set"));
+    TEST_ASSERT_EQUAL(true, map.find("gets") == nullptr);
+}
+
+void ut_flat_hash_map_against_reference() {
+    // random insertions and deletions, verified against std::map
+    constexpr size_t capacity = 64;
+    auto map = FlatHashMap<uint16_t, uint32_t, capacity>();
+    auto reference = std::map<uint16_t, uint32_t>();
+
+    std::srand(42);
+    for (uint32_t i = 0; i < 20000; ++i) {
+        const auto key = static_cast<uint16_t>(std::rand() % 128);
+        if (std::rand() % 2 == 0 && reference.size() < capacity) {
+            map.insert_or_assign(key, i);
+            reference[key] = i;
+        } else {
+            TEST_ASSERT_EQUAL(reference.erase(key) == 1, map.erase(key));
+        }
+        TEST_ASSERT_EQUAL(reference.size(), map.size());
+    }
+    for (uint16_t key = 0; key < 128; ++key) {
+        const auto it = reference.find(key);
+        const auto* value = map.find(key);
+        TEST_ASSERT_EQUAL(it != reference.end(), value != nullptr);
+        if (value) TEST_ASSERT_EQUAL(it->second, *value);
+    }
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_flat_hash_map_basics);
+    RUN_TEST(ut_flat_hash_map_full);
+    RUN_TEST(ut_flat_hash_map_iteration);
+    RUN_TEST(ut_flat_hash_map_string_keys);
+    RUN_TEST(ut_flat_hash_map_against_reference);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
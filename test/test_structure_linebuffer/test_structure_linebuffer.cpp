@@ -74,12 +74,32 @@ void ut_linebuffer_various_strings() {
     test("\n\n\nab", {"", "", ""});
 }
 
+void ut_linebuffer_wrapping() {
+    // a line that wraps around the end of the ring is still found
+    LineBuffer line_buffer(8, "\r\n");
+    line_buffer.push("abcdef\n");
+    TEST_ASSERT_EQUAL(true, line_buffer.drop_next_line());
+    line_buffer.push("ghijk\r");
+    TEST_ASSERT_EQUAL(6, line_buffer.length_of_next_line());
+    TEST_ASSERT_EQUAL(true, line_buffer.is_delimiter('\r'));
+    TEST_ASSERT_EQUAL(false, line_buffer.is_delimiter('g'));
+
+    char buffer[8];
+    TEST_ASSERT_EQUAL(5, line_buffer.get_next_line(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("ghijk", buffer);
+
+    line_buffer.set_delimiters(";");
+    line_buffer.push("ab\ncd;");
+    TEST_ASSERT_EQUAL(6, line_buffer.length_of_next_line());
+}
+
 } // namespace
 
 int run_all_tests() {
     UNITY_BEGIN();
     RUN_TEST(ut_linebuffer_basics);
     RUN_TEST(ut_linebuffer_various_strings);
+    RUN_TEST(ut_linebuffer_wrapping);
     return UNITY_END();
 }
 
@@ -0,0 +1,158 @@
+#include <spine/structure/point_batch.hpp>
+#include <unity.h>
+
+#include <cfloat>
+#include <cmath>
+
+using namespace spn::structure;
+
+namespace {
+
+constexpr size_t points = 37; // not a multiple of the vector width, such that the remainder loops are covered
+
+template<typename T>
+XYZPoint<T> point_at(size_t i) {
+    return XYZPoint<T>(static_cast<T>(i % 7) - 3, static_cast<T>(i % 5) + 1, static_cast<T>(i % 3) - 2);
+}
+
+void ut_point_batch_basics() {
+    auto batch = XYZPointBatch<float, 4>();
+    TEST_ASSERT_TRUE(batch.empty());
+    TEST_ASSERT_EQUAL(4, batch.capacity());
+
+    TEST_ASSERT_TRUE(batch.push_back({1, 2, 3}));
+    TEST_ASSERT_TRUE(batch.push_back({4, 5, 6}));
+    TEST_ASSERT_EQUAL(2, batch.size());
+    TEST_ASSERT_TRUE(batch.at(1) == XYZPoint<float>(4, 5, 6));
+    TEST_ASSERT_EQUAL_FLOAT(1, batch.x()[0]);
+    TEST_ASSERT_EQUAL_FLOAT(5, batch.y()[1]);
+    TEST_ASSERT_EQUAL_FLOAT(6, batch.z()[1]);
+    TEST_ASSERT_EQUAL_FLOAT(2, batch.component(1)[0]);
+
+    batch.set(0, {7, 8, 9});
+    TEST_ASSERT_TRUE(batch.at(0) == XYZPoint<float>(7, 8, 9));
+
+    batch.resize(4);
+    TEST_ASSERT_TRUE(batch.full());
+    TEST_ASSERT_TRUE(batch.at(3) == XYZPoint<float>());
+    TEST_ASSERT_FALSE(batch.push_back({1, 1, 1}));
+
+    batch.clear();
+    TEST_ASSERT_TRUE(batch.empty());
+
+    // growing past the capacity is clamped and leaves the other components alone
+    batch.push_back({1, 2, 3});
+    batch.resize(6);
+    TEST_ASSERT_EQUAL(4, batch.size());
+    TEST_ASSERT_TRUE(batch.at(0) == XYZPoint<float>(1, 2, 3));
+    TEST_ASSERT_TRUE(batch.at(3) == XYZPoint<float>());
+}
+
+template<typename T>
+void check_against_scalar() {
+    auto a = XYZPointBatch<T, points>();
+    auto b = XYZPointBatch<T, points>();
+    for (size_t i = 0; i < points; ++i) {
+        a.push_back(point_at<T>(i));
+        b.push_back(point_at<T>(i * 3 + 1));
+    }
+
+    T dots[points];
+    a.dot(b, dots);
+    for (size_t i = 0; i < points; ++i)
+        TEST_ASSERT_TRUE(dots[i] == point_at<T>(i).dot(point_at<T>(i * 3 + 1)));
+
+    auto sum = a;
+    sum.add(b);
+    auto difference = a;
+    difference.subtract(b);
+    auto scaled = a;
+    scaled.scalar_multiplication(3);
+    auto shifted = a;
+    shifted.subtract(XYZPoint<T>(1, 2, 3));
+    shifted.add(XYZPoint<T>(0, 0, 1));
+    for (size_t i = 0; i < points; ++i) {
+        auto expected_scaled = point_at<T>(i);
+        expected_scaled.scalar_multiplication(3);
+        TEST_ASSERT_TRUE(sum.at(i) == point_at<T>(i) + point_at<T>(i * 3 + 1));
+        TEST_ASSERT_TRUE(difference.at(i) == point_at<T>(i) - point_at<T>(i * 3 + 1));
+        TEST_ASSERT_TRUE(scaled.at(i) == expected_scaled);
+        TEST_ASSERT_TRUE(shifted.at(i) == point_at<T>(i) - XYZPoint<T>(1, 2, 2));
+    }
+}
+
+void ut_point_batch_kernels_match_scalar() {
+    check_against_scalar<float>();
+    check_against_scalar<double>();
+    check_against_scalar<int>();
+}
+
+void ut_point_batch_mag_normalize() {
+    auto batch = XYZPointBatch<float, points>();
+    for (size_t i = 0; i < points; ++i)
+        batch.push_back(point_at<float>(i));
+
+    float mags[points];
+    batch.mag(mags);
+    for (size_t i = 0; i < points; ++i)
+        TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON * 4, point_at<float>(i).mag(), mags[i]);
+
+    batch.normalize();
+    batch.mag(mags);
+    for (size_t i = 0; i < points; ++i) {
+        auto expected = point_at<float>(i);
+        expected.normalize();
+        const auto normalized = batch.at(i);
+        TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON * 2, expected.x, normalized.x);
+        TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON * 2, expected.y, normalized.y);
+        TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON * 2, expected.z, normalized.z);
+        TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON * 4, 1.0f, mags[i]);
+    }
+}
+
+void ut_point_batch_xy() {
+    auto batch = XYPointBatch<float, 8>();
+    for (int i = 0; i < 6; ++i)
+        batch.push_back({static_cast<float>(i), 2});
+
+    auto other = batch;
+    float dots[8];
+    batch.dot(other, dots);
+    float mags[8];
+    batch.mag(mags);
+    for (int i = 0; i < 6; ++i) {
+        TEST_ASSERT_EQUAL_FLOAT(static_cast<float>(i * i + 4), dots[i]);
+        TEST_ASSERT_EQUAL_FLOAT(std::sqrt(static_cast<float>(i * i + 4)), mags[i]);
+    }
+
+    batch.subtract(XYPoint<float>(0, 2));
+    TEST_ASSERT_TRUE(batch.at(5) == XYPoint<float>(5, 0));
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_point_batch_basics);
+    RUN_TEST(ut_point_batch_kernels_match_scalar);
+    RUN_TEST(ut_point_batch_mag_normalize);
+    RUN_TEST(ut_point_batch_xy);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -6,6 +6,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 using namespace spn::structure;
@@ -314,6 +315,47 @@ void ut_result_unwrap_or_else() {
     TEST_ASSERT_EQUAL(42, fallback_value);
 }
 
+void ut_result_footprint() {
+    enum class Error : uint8_t { Failed };
+    using Compact = Result<uint32_t, Error>;
+    TEST_ASSERT_EQUAL(8, sizeof(Compact));
+    TEST_ASSERT_EQUAL(true, std::is_trivially_copyable_v<Compact>);
+    TEST_ASSERT_EQUAL(false, std::is_trivially_copyable_v<Result<std::string>>);
+
+    const auto copy = [](Compact r) { return r; };
+    TEST_ASSERT_EQUAL(7, copy(Compact(7)).value());
+    TEST_ASSERT_EQUAL(true, copy(Compact::failed(Error::Failed)).error_value() == Error::Failed);
+    TEST_ASSERT_EQUAL(false, copy(Compact()).is_success());
+}
+
+void ut_result_lifetime() {
+    static int alive = 0;
+    struct Tracked {
+        explicit Tracked(int v) : value(v) { ++alive; }
+        Tracked(const Tracked& other) : value(other.value) { ++alive; }
+        Tracked(Tracked&& other) noexcept : value(other.value) { ++alive; }
+        Tracked& operator=(const Tracked&) = default;
+        ~Tracked() { --alive; }
+        int value;
+    };
+    using ResultType = Result<Tracked, std::string, int>;
+
+    {
+        auto result = ResultType(Tracked(1));
+        TEST_ASSERT_EQUAL(1, alive);
+        auto copy = result;
+        TEST_ASSERT_EQUAL(2, alive);
+        copy = ResultType::failed("overwritten");
+        TEST_ASSERT_EQUAL(1, alive);
+        TEST_ASSERT_EQUAL_STRING("overwritten", copy.error_value().c_str());
+        auto moved = std::move(result);
+        TEST_ASSERT_EQUAL(1, moved.value().value);
+        result = ResultType::intermediary(3);
+        TEST_ASSERT_EQUAL(3, result.intermediary_value());
+    }
+    TEST_ASSERT_EQUAL(0, alive);
+}
+
 } // namespace
 
 int run_all_tests() {
@@ -330,6 +372,8 @@ int run_all_tests() {
     RUN_TEST(ut_result_match);
     RUN_TEST(ut_result_value_or_error_or);
     RUN_TEST(ut_result_unwrap_or_else);
+    RUN_TEST(ut_result_footprint);
+    RUN_TEST(ut_result_lifetime);
     return UNITY_END();
 }
 
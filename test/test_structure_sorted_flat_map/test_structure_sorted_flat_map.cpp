@@ -0,0 +1,105 @@
+#include "spine/structure/sorted_flat_map.hpp"
+
+#include <unity.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <map>
+#include <string_view>
+
+using namespace spn::structure;
+
+namespace {
+
+void ut_sorted_flat_map_basics() {
+    auto map = SortedFlatMap<int, int, 4>();
+    TEST_ASSERT_EQUAL(true, map.empty());
+
+    TEST_ASSERT_EQUAL(true, map.insert(3, 30));
+    TEST_ASSERT_EQUAL(true, map.insert(1, 10));
+    TEST_ASSERT_EQUAL(true, map.insert(2, 20));
+    TEST_ASSERT_EQUAL(false, map.insert(2, 25));
+    TEST_ASSERT_EQUAL(3, map.size());
+
+    // keys are kept in order
+    for (size_t i = 0; i < map.size(); ++i) {
+        TEST_ASSERT_EQUAL(i + 1, map.key_at(i));
+        TEST_ASSERT_EQUAL((i + 1) * 10, map.value_at(i));
+    }
+
+    TEST_ASSERT_EQUAL(true, map.insert_or_assign(2, 25));
+    TEST_ASSERT_EQUAL(25, *map.find(2));
+    TEST_ASSERT_EQUAL(true, map.find(4) == nullptr);
+
+    map[4] = 40;
+    TEST_ASSERT_EQUAL(true, map.full());
+    TEST_ASSERT_EQUAL(false, map.insert(5, 50));
+
+    TEST_ASSERT_EQUAL(true, map.erase(1));
+    TEST_ASSERT_EQUAL(false, map.contains(1));
+    TEST_ASSERT_EQUAL(2, map.key_at(0));
+    TEST_ASSERT_EQUAL(4, map.key_at(2));
+
+    map.clear();
+    TEST_ASSERT_EQUAL(true, map.empty());
+}
+
+void ut_sorted_flat_map_string_keys() {
+    const auto map = SortedFlatMap<std::string_view, int, 8>{{"set", 2}, {"get", 1}, {"reset", 3}};
+    TEST_ASSERT_EQUAL(1, *map.find("get"));
+    TEST_ASSERT_EQUAL(2, *map.find("set"));
+    TEST_ASSERT_EQUAL(3, *map.find("reset"));
+    TEST_ASSERT_EQUAL(true, map.find("ge") == nullptr);
+    TEST_ASSERT_EQUAL(true, map.key_at(0) == "get");
+}
+
+void ut_sorted_flat_map_against_reference() {
+    constexpr size_t capacity = 32;
+    auto map = SortedFlatMap<uint16_t, uint32_t, capacity>();
+    auto reference = std::map<uint16_t, uint32_t>();
+
+    std::srand(7);
+    for (uint32_t i = 0; i < 10000; ++i) {
+        const auto key = static_cast<uint16_t>(std::rand() % 64);
+        if (std::rand() % 2 == 0 && reference.size() < capacity) {
+            map.insert_or_assign(key, i);
+            reference[key] = i;
+        } else {
+            TEST_ASSERT_EQUAL(reference.erase(key) == 1, map.erase(key));
+        }
+    }
+    TEST_ASSERT_EQUAL(reference.size(), map.size());
+    size_t idx = 0;
+    for (const auto& [key, value] : reference) {
+        TEST_ASSERT_EQUAL(key, map.key_at(idx));
+        TEST_ASSERT_EQUAL(value, map.value_at(idx));
+        ++idx;
+    }
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_sorted_flat_map_basics);
+    RUN_TEST(ut_sorted_flat_map_string_keys);
+    RUN_TEST(ut_sorted_flat_map_against_reference);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -0,0 +1,153 @@
+#include "spine/core/memory.hpp"
+#include "spine/core/utils/string.hpp"
+#include "spine/structure/static_string.hpp"
+#include "spine/structure/units/si.hpp"
+
+#include <unity.h>
+
+#include <string_view>
+
+using namespace spn::structure;
+
+namespace {
+
+void ut_static_string_basics() {
+    auto s = StaticString<8>();
+    TEST_ASSERT_EQUAL(0, s.size());
+    TEST_ASSERT_EQUAL(8, s.capacity());
+    TEST_ASSERT_EQUAL(true, s.empty());
+    TEST_ASSERT_EQUAL_STRING("", s.c_str());
+
+    s.append("abc").push_back('d');
+    TEST_ASSERT_EQUAL(4, s.size());
+    TEST_ASSERT_EQUAL(4, s.space_left());
+    TEST_ASSERT_EQUAL_STRING("abcd", s.c_str());
+    TEST_ASSERT_EQUAL('c', s[2]);
+
+    // appending beyond the capacity truncates
+    s += "efghijk";
+    TEST_ASSERT_EQUAL(true, s.full());
+    TEST_ASSERT_EQUAL_STRING("abcdefgh", s.c_str());
+    s += 'x';
+    TEST_ASSERT_EQUAL_STRING("abcdefgh", s.c_str());
+
+    s.resize(3);
+    TEST_ASSERT_EQUAL_STRING("abc", s.c_str());
+    s.clear();
+    TEST_ASSERT_EQUAL(true, s.empty());
+
+    // writing through data()
+    s.data()[0] = 'x';
+    s.data()[1] = 'y';
+    s.resize(2);
+    TEST_ASSERT_EQUAL_STRING("xy", s.c_str());
+}
+
+void ut_static_string_conversions() {
+    const auto from_view = StaticString<4>(std::string_view("abcdef"));
+    TEST_ASSERT_EQUAL_STRING("abcd", from_view.c_str());
+
+    const std::string_view view = from_view;
+    TEST_ASSERT_EQUAL(4, view.size());
+    TEST_ASSERT_EQUAL(true, view == "abcd");
+
+    const auto widened = StaticString<16>(from_view);
+    TEST_ASSERT_EQUAL(true, widened == "abcd");
+
+    auto assigned = StaticString<16>("old");
+    assigned = std::string_view("new");
+    TEST_ASSERT_EQUAL_STRING("new", assigned.c_str());
+
+    // anything that takes a string_view takes a StaticString
+    TEST_ASSERT_EQUAL(true, spn::core::utils::starts_with(assigned, "ne"));
+}
+
+void ut_static_string_format() {
+    auto s = StaticString<32>();
+    s.format("v=", volt(3.3), ", n=", 42);
+    TEST_ASSERT_EQUAL_STRING("v=3.30V, n=42", s.c_str());
+
+    s.clear();
+    s.append_printf("%s-%03d", "id", 7);
+    TEST_ASSERT_EQUAL_STRING("id-007", s.c_str());
+
+    // printf output that doesn't fit is truncated
+    auto small = StaticString<4>("ab");
+    small.append_printf("%d", 12345);
+    TEST_ASSERT_EQUAL_STRING("ab12", small.c_str());
+    TEST_ASSERT_EQUAL(4, small.size());
+}
+
+void ut_static_string_strip() {
+    auto s = StaticString<16>(" \t value \n");
+    s.strip();
+    TEST_ASSERT_EQUAL_STRING("value", s.c_str());
+
+    s = "--value";
+    s.lstrip("-");
+    TEST_ASSERT_EQUAL_STRING("value", s.c_str());
+    s.rstrip("eu");
+    TEST_ASSERT_EQUAL_STRING("val", s.c_str());
+
+    // stripping everything leaves an empty string
+    s = "   ";
+    s.strip();
+    TEST_ASSERT_EQUAL(true, s.empty());
+    s.lstrip().rstrip();
+    TEST_ASSERT_EQUAL(true, s.empty());
+}
+
+void ut_static_string_compare() {
+    const auto s = StaticString<16>("hello world");
+    TEST_ASSERT_EQUAL(true, s.starts_with("hello"));
+    TEST_ASSERT_EQUAL(false, s.starts_with("world"));
+    TEST_ASSERT_EQUAL(true, s.ends_with("world"));
+    TEST_ASSERT_EQUAL(false, s.ends_with("a much longer needle"));
+    TEST_ASSERT_EQUAL(true, s == "hello world");
+    TEST_ASSERT_EQUAL(true, s != "hello");
+    TEST_ASSERT_EQUAL(true, s < "hello worlds");
+    TEST_ASSERT(s.compare("hello") > 0);
+}
+
+void ut_static_string_does_not_allocate() {
+    const auto before = spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations;
+    auto s = StaticString<64>();
+    for (int i = 0; i < 100; ++i) {
+        s.clear();
+        s.append("  id ").format(i, ": ", k_time_ms(i)).append_printf(" %d  ", i);
+        s.strip();
+        TEST_ASSERT_EQUAL(true, s.starts_with("id") && s.ends_with(StaticString<8>().format(i)));
+    }
+    TEST_ASSERT_EQUAL(before, spn::memory::usage(spn::memory::Subsystem::UNTAGGED).allocations);
+    TEST_ASSERT_EQUAL_STRING("id 99: 99ms 99", s.c_str());
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_static_string_basics);
+    RUN_TEST(ut_static_string_conversions);
+    RUN_TEST(ut_static_string_format);
+    RUN_TEST(ut_static_string_strip);
+    RUN_TEST(ut_static_string_compare);
+    RUN_TEST(ut_static_string_does_not_allocate);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
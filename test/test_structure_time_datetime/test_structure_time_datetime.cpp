@@ -0,0 +1,116 @@
+#include "spine/structure/time/calendar.hpp"
+#include "spine/structure/time/datetime.hpp"
+
+#include <unity.h>
+
+#include <cstring>
+#include <ctime>
+
+namespace {
+
+using namespace spn::structure::time;
+
+static_assert(days_from_civil(1970, 1, 1) == 0);
+static_assert(days_from_civil(2000, 3, 1) == 11017);
+static_assert(days_from_civil(1969, 12, 31) == -1);
+static_assert(civil_from_days(0) == CivilDate{1970, 1, 1});
+static_assert(civil_from_days(11016) == CivilDate{2000, 2, 29});
+static_assert(civil_from_days(-719468) == CivilDate{0, 3, 1});
+static_assert(weekday_from_days(0) == 4); // thursday
+static_assert(weekday_from_days(-4) == 0); // sunday
+static_assert(weekday_from_days(-5) == 6); // saturday
+static_assert(day_of_year(2024, 12, 31) == 365);
+static_assert(days_from_timestamp(-1) == -1);
+static_assert(days_from_timestamp(seconds_per_day) == 1);
+
+void ut_calendar_roundtrip() {
+    for (int32_t days = -800000; days < 800000; days += 7) {
+        const auto date = civil_from_days(days);
+        TEST_ASSERT_EQUAL(days, days_from_civil(date.year, date.month, date.day));
+    }
+}
+
+void ut_datetime_matches_gmtime() {
+    // a stride that is not a multiple of a minute, hour or day, covering 1901 through 2100
+    for (int64_t t = -2147483648LL; t < 4102444800LL; t += 86399 * 13 + 7) {
+        const auto timestamp = static_cast<time_t>(t);
+        tm expected = {};
+        gmtime_r(&timestamp, &expected);
+        const auto dt = DateTime(timestamp);
+
+        TEST_ASSERT_EQUAL(expected.tm_year + 1900, dt.getYear());
+        TEST_ASSERT_EQUAL(expected.tm_mon + 1, dt.getMonth());
+        TEST_ASSERT_EQUAL(expected.tm_mday, dt.getDay());
+        TEST_ASSERT_EQUAL(expected.tm_hour, dt.getHour());
+        TEST_ASSERT_EQUAL(expected.tm_min, dt.getMinute());
+        TEST_ASSERT_EQUAL(expected.tm_sec, dt.getSecond());
+        TEST_ASSERT_EQUAL(expected.tm_wday, dt.getWeekDay());
+        TEST_ASSERT_EQUAL(expected.tm_yday, dt.getYearDay());
+    }
+}
+
+void ut_datetime_from_fields() {
+    const auto dt = DateTime(2024, 2, 29, 23, 59, 58);
+    TEST_ASSERT_EQUAL(1709251198, dt.getUnixTime());
+    TEST_ASSERT_EQUAL(1709251198 - 946684800, dt.getY2kTime());
+    TEST_ASSERT_EQUAL(4, dt.getWeekDay()); // thursday
+    TEST_ASSERT_EQUAL(59, dt.getYearDay());
+
+    // out of range fields normalize
+    const auto normalized = DateTime(2023, 13, 32, 24, 0, 0);
+    TEST_ASSERT_EQUAL(2024, normalized.getYear());
+    TEST_ASSERT_EQUAL(2, normalized.getMonth());
+    TEST_ASSERT_EQUAL(2, normalized.getDay());
+    TEST_ASSERT_EQUAL(0, normalized.getHour());
+
+    const auto compiled = DateTime("Feb 29 2024", "23:59:58");
+    TEST_ASSERT_EQUAL(dt.getUnixTime(), compiled.getUnixTime());
+
+    TEST_ASSERT_EQUAL(0, DateTime().getUnixTime());
+    TEST_ASSERT_EQUAL(1970, DateTime().getYear());
+}
+
+void ut_datetime_iso8601() {
+    char buffer[DateTime::iso8601_length + 1];
+    TEST_ASSERT_EQUAL(DateTime::iso8601_length, DateTime(1709251198).to_iso8601(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("2024-02-29T23:59:58Z", buffer);
+
+    TEST_ASSERT_EQUAL(DateTime::iso8601_length, DateTime(0).to_iso8601(buffer, sizeof(buffer)));
+    TEST_ASSERT_EQUAL_STRING("1970-01-01T00:00:00Z", buffer);
+
+    TEST_ASSERT_EQUAL(0, DateTime(0).to_iso8601(buffer, sizeof(buffer) - 1)); // no room for the null character
+
+    auto dt = DateTime(1709251198);
+    char expected[32];
+    dt.strf_DateTime(expected, sizeof(expected), "%Y-%m-%dT%H:%M:%SZ");
+    DateTime(1709251198).to_iso8601(buffer, sizeof(buffer));
+    TEST_ASSERT_EQUAL_STRING(expected, buffer);
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_calendar_roundtrip);
+    RUN_TEST(ut_datetime_matches_gmtime);
+    RUN_TEST(ut_datetime_from_fields);
+    RUN_TEST(ut_datetime_iso8601);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
@@ -1,8 +1,13 @@
 #include "spine/structure/time/schedule.hpp"
 
+#include "spine/core/clock.hpp"
+#include "spine/eventsystem/eventsystem.hpp"
+
 #include <limits.h>
 #include <unity.h>
 
+using namespace spn::core;
+
 namespace {
 
 using Schedule = spn::structure::time::Schedule;
@@ -45,11 +50,133 @@ void ut_schedule_basics() {
     test_f(third, second_value, third_value, 0.0, k_time_h(24));
 }
 
+void ut_schedule_weekly() {
+    // blocks in arbitrary order; sunday's block runs into monday morning
+    const Schedule::Block blocks[] = {
+        {.start = k_time_s(k_time_d(6)) + k_time_h(22), .duration = k_time_h(4), .value = 16.0},
+        {.start = k_time_h(8), .duration = k_time_h(10), .value = 20.0},
+        {.start = k_time_s(k_time_d(2)) + k_time_h(8), .duration = k_time_h(10), .value = 21.0},
+    };
+    const auto s = Schedule(blocks, sizeof(blocks) / sizeof(blocks[0]), Schedule::week);
+    TEST_ASSERT_EQUAL(true, s.period() == k_time_d(7));
+
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_h(1)) == 16.0f); // wrapped from sunday
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_h(3)) == 0.0f);
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_h(9)) == 20.0f);
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_s(k_time_d(1)) + k_time_h(9)) == 0.0f);
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_s(k_time_d(2)) + k_time_h(17)) == 21.0f);
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_s(k_time_d(6)) + k_time_h(23)) == 16.0f);
+
+    // times beyond the first period repeat the schedule
+    TEST_ASSERT_EQUAL(true, s.value_at(k_time_s(k_time_d(7 * 52)) + k_time_h(9)) == 20.0f);
+    TEST_ASSERT_EQUAL(true, s.start_of_next_block(k_time_s(k_time_d(7)) + k_time_h(1)) == k_time_h(8));
+    TEST_ASSERT_EQUAL(true, s.start_of_next_block(k_time_s(k_time_d(6)) + k_time_h(23)) == k_time_d(7));
+}
+
+void ut_schedule_cursor() {
+    const auto s = Schedule({//
+                             Schedule::Block{.start = k_time_h(1), .duration = k_time_h(3), .value = 27.0},
+                             Schedule::Block{.start = k_time_h(4), .duration = k_time_h(3), .value = 27.0},
+                             Schedule::Block{.start = k_time_h(7), .duration = k_time_h(3), .value = 18.0}});
+
+    auto c = s.cursor(k_time_h(0));
+    TEST_ASSERT_EQUAL(true, c.value == 0.0f);
+    TEST_ASSERT_EQUAL(true, c.next_transition == k_time_h(1));
+    TEST_ASSERT_EQUAL(true, c.next_value == 27.0f);
+
+    // adjacent blocks with the same value don't transition
+    c = s.cursor(k_time_h(2));
+    TEST_ASSERT_EQUAL(true, c.value == 27.0f);
+    TEST_ASSERT_EQUAL(true, c.next_transition == k_time_h(7));
+    TEST_ASSERT_EQUAL(true, c.next_value == 18.0f);
+
+    c = s.cursor(k_time_h(7));
+    TEST_ASSERT_EQUAL(true, c.value == 18.0f);
+    TEST_ASSERT_EQUAL(true, c.next_transition == k_time_h(10));
+    TEST_ASSERT_EQUAL(true, c.next_value == 0.0f);
+
+    // the next transition lies in the next period and is returned as absolute time
+    c = s.cursor(k_time_s(k_time_d(3)) + k_time_h(12));
+    TEST_ASSERT_EQUAL(true, c.value == 0.0f);
+    TEST_ASSERT_EQUAL(true, c.next_transition == k_time_s(k_time_d(4)) + k_time_h(1));
+
+    // a schedule that never changes points to the start of the next period
+    const auto constant = Schedule({Schedule::Block{.start = k_time_h(0), .duration = k_time_h(24), .value = 5.0}});
+    c = constant.cursor(k_time_h(30));
+    TEST_ASSERT_EQUAL(true, c.value == 5.0f && c.next_value == 5.0f);
+    TEST_ASSERT_EQUAL(true, c.next_transition == k_time_h(48));
+}
+
+uint32_t g_simulated_ms = 0;
+uint32_t simulated_source() { return g_simulated_ms; }
+
+enum class Events { Transition, Size };
+
+/// Applies the value of a schedule and sleeps until it changes
+class ScheduleFollower : public EventHandler {
+public:
+    ScheduleFollower(EventSystem* evsys, const Schedule& schedule) : EventHandler(evsys), _schedule(schedule) {}
+
+    void handle_event(const Event& event) override {
+        const auto now = spn::Clock::now();
+        const auto cursor = _schedule.cursor(k_time_s(now));
+        value = cursor.value;
+        ++transitions;
+        evsys()->schedule(Events::Transition, k_time_ms(cursor.next_transition) - now);
+    }
+
+    float value = -1;
+    int transitions = 0;
+
+private:
+    const Schedule& _schedule;
+};
+
+void ut_schedule_drives_eventsystem() {
+    g_simulated_ms = 0;
+    spn::Clock::set_source(simulated_source);
+    const auto start = k_time_s(spn::Clock::now());
+
+    const auto s = Schedule({//
+                             Schedule::Block{.start = start + k_time_h(1), .duration = k_time_h(2), .value = 20.0},
+                             Schedule::Block{.start = start + k_time_h(5), .duration = k_time_h(1), .value = 15.0}});
+
+    auto evsys = EventSystem({.events_count = static_cast<size_t>(Events::Size),
+                              .events_cap = 4,
+                              .handler_cap = 1,
+                              .delay_between_ticks = false});
+    auto follower = ScheduleFollower(&evsys, s);
+    evsys.attach(Events::Transition, &follower);
+    evsys.trigger(Events::Transition);
+    TEST_ASSERT_EQUAL(true, follower.value == 0.0f);
+
+    const auto step = [&](k_time_m minutes) {
+        g_simulated_ms += static_cast<uint32_t>(k_time_ms(minutes).raw());
+        evsys.loop();
+    };
+
+    step(k_time_m(59));
+    TEST_ASSERT_EQUAL(1, follower.transitions); // nothing happens until the next transition
+    step(k_time_m(1));
+    TEST_ASSERT_EQUAL(2, follower.transitions);
+    TEST_ASSERT_EQUAL(true, follower.value == 20.0f);
+    step(k_time_m(120));
+    TEST_ASSERT_EQUAL(true, follower.value == 0.0f);
+    step(k_time_m(120));
+    TEST_ASSERT_EQUAL(true, follower.value == 15.0f);
+    TEST_ASSERT_EQUAL(4, follower.transitions);
+
+    spn::Clock::set_source(nullptr);
+}
+
 } // namespace
 
 int run_all_tests() {
     UNITY_BEGIN();
     RUN_TEST(ut_schedule_basics);
+    RUN_TEST(ut_schedule_weekly);
+    RUN_TEST(ut_schedule_cursor);
+    RUN_TEST(ut_schedule_drives_eventsystem);
     return UNITY_END();
 }
 
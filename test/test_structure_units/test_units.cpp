@@ -6,6 +6,7 @@
 #include <cfloat>
 #include <climits>
 #include <cstdio>
+#include <limits>
 #include <memory>
 #include <stdexcept>
 
@@ -88,6 +89,49 @@ void ut_unit_kernel_time_conversion_functions() {
     TEST_ASSERT_EQUAL_FLOAT(2.0, to_real_time(k_time_ms(2)).raw());
 }
 
+void ut_unit_kernel_time_long_uptime() {
+    // beyond 2^24 ms (~4.6 hours) a float can no longer represent every millisecond
+    const auto uptime = k_time_ms((1LL << 24) + 1);
+    TEST_ASSERT_EQUAL((1LL << 24) + 2, (uptime + k_time_ms(1)).raw());
+    TEST_ASSERT_TRUE(uptime + k_time_ms(1) > uptime);
+    TEST_ASSERT_TRUE(uptime + k_time_ms(1) != uptime);
+
+    // roughly 50 days and 10 years of uptime, mixing magnitudes
+    const auto days = k_time_ms(4321234567LL);
+    TEST_ASSERT_EQUAL(4321234567LL + 1000, (days + k_time_s(1)).raw());
+    TEST_ASSERT_EQUAL(4321234567LL - 60000, (days - k_time_m(1)).raw());
+    TEST_ASSERT_TRUE(k_time_d(3650) == k_time_ms(3650LL * 24 * 60 * 60 * 1000));
+    TEST_ASSERT_TRUE(k_time_ms(k_time_d(3650)) + k_time_ms(1) > k_time_d(3650));
+    TEST_ASSERT_EQUAL(315360000000001LL, (k_time_us(k_time_s(315360000)) + k_time_us(1)).raw());
+
+    // comparisons between magnitudes are exact and don't round the finer unit
+    TEST_ASSERT_TRUE(k_time_s(1) < k_time_ms(1400));
+    TEST_ASSERT_TRUE(k_time_ms(1400) > k_time_s(1));
+    TEST_ASSERT_TRUE(k_time_s(1) != k_time_ms(1001));
+    TEST_ASSERT_EQUAL(-2, k_time_s(k_time_ms(-1500)).raw());
+
+    // ratios that aren't 1/n: 13 months of 4 weeks are a day short of a year, 2.5 hours are 150 minutes
+    using k_time_M = spnu::Unit<spnu::TagKernelTime, spnu::Month, spnu::KernelTimeRawType>;
+    using k_time_Y = spnu::Unit<spnu::TagKernelTime, spnu::Year, spnu::KernelTimeRawType>;
+    TEST_ASSERT_TRUE(k_time_Y(1) > k_time_M(13));
+    TEST_ASSERT_TRUE(k_time_M(13) < k_time_Y(1));
+    TEST_ASSERT_TRUE(k_time_Y(1) != k_time_M(13));
+    TEST_ASSERT_TRUE(k_time_Y(28) == k_time_M(365));
+    TEST_ASSERT_TRUE(k_time_M(-13) > k_time_Y(-1));
+    TEST_ASSERT_TRUE(k_time_h(3) > k_time_m(150) && k_time_h(2) < k_time_m(150));
+    TEST_ASSERT_TRUE(k_time_m(150) < k_time_h(3) && k_time_m(150) > k_time_h(2));
+
+    // the scaled values don't fit: compared by quotient and remainder
+    constexpr auto max = std::numeric_limits<spnu::KernelTimeRawType>::max();
+    TEST_ASSERT_TRUE(k_time_h(max / 60 + 1) > k_time_m(max));
+    TEST_ASSERT_TRUE(k_time_m(max) < k_time_h(max / 60 + 1));
+    TEST_ASSERT_TRUE(k_time_h(max / 60) < k_time_m(max));
+    TEST_ASSERT_TRUE(k_time_Y(max) > k_time_M(max));
+    TEST_ASSERT_TRUE(k_time_M(-max) > k_time_Y(-max));
+    TEST_ASSERT_TRUE(k_time_Y(max / 365 * 28) == k_time_M(max / 365 * 365));
+    TEST_ASSERT_TRUE(k_time_Y(max / 365 * 28) < k_time_M(max / 365 * 365 + 1));
+}
+
 void ut_unit_kernel_time_printable() {
     char buffer[4];
     snprintf(buffer, sizeof(buffer), "%li", k_time_ms(100).raw());
@@ -203,6 +247,43 @@ void ut_unit_exception_handling() {
     set_machine_exception_handler(std::move(original_handler));
 }
 
+void ut_unit_dimensional_analysis() {
+    using namespace spnu;
+
+    static_assert(std::is_same_v<watt, decltype(joule(1) / time_s(1))>);
+    static_assert(std::is_same_v<joule, decltype(newton(1) * meter(1))>);
+    static_assert(std::is_same_v<joule, decltype(watt(1) * time_s(1))>);
+    static_assert(std::is_same_v<ohm, decltype(volt(1) / amp(1))>);
+    static_assert(std::is_same_v<float, decltype(meter(1) / meter_m(1))>);
+    static_assert(sizeof(decltype(joule(1) / time_s(1))) == sizeof(RealRawType));
+
+    TEST_ASSERT_EQUAL_FLOAT(5, (joule(10) / time_s(2)).raw());
+    TEST_ASSERT_EQUAL_FLOAT(5, (joule_k(10) / time_ms(2)).raw() / 1e6f);
+    TEST_ASSERT_EQUAL_FLOAT(6, (newton(3) * meter(2)).raw());
+    TEST_ASSERT_EQUAL_FLOAT(2, (gram_k(2) * (meter(1) / (time_s(1) * time_s(1)))).raw());
+    TEST_ASSERT_EQUAL_FLOAT(3000, meter(6) / meter_m(2));
+    TEST_ASSERT_EQUAL_FLOAT(0.5, (volt(1) / ohm(2)).raw());
+
+    // derived units without a named tag keep working, and collapse back into named ones
+    const auto area = meter(2) * meter_c(300);
+    TEST_ASSERT_EQUAL_FLOAT(6, area.raw());
+    TEST_ASSERT_EQUAL_FLOAT(12000, (area * meter(2)).raw()); // volume's base magnitude is the litre
+    TEST_ASSERT_EQUAL(true, litre(12000) == area * meter(2));
+
+    // integral units divide exactly
+    TEST_ASSERT_EQUAL(4, k_time_s(2) / k_time_ms(500));
+}
+
+void ut_unit_compound_collapse() {
+    using namespace spnu;
+    using mls = CompoundUnit<litre_ml, time_s>;
+
+    const auto flow = mls(litre_ml(600), time_s(30)).collapse();
+    static_assert(sizeof(flow) == sizeof(RealRawType));
+    TEST_ASSERT_EQUAL_FLOAT(20.0f / 1e6f, flow.raw()); // m^3/s
+    TEST_ASSERT_EQUAL_FLOAT(litre_ml(1200).raw(), litre_ml(flow * time_m(1)).raw());
+}
+
 void ut_unit_compound() {
     using namespace spnu;
     using mls = CompoundUnit<litre_ml, time_s>;
@@ -409,6 +490,7 @@ int run_all_tests() {
     RUN_TEST(ut_unit_kernel_time_raw);
     RUN_TEST(ut_unit_kernel_time_multiplication_division);
     RUN_TEST(ut_unit_kernel_time_conversion_functions);
+    RUN_TEST(ut_unit_kernel_time_long_uptime);
     RUN_TEST(ut_unit_kernel_time_printable);
     RUN_TEST(ut_unit_real_time);
     RUN_TEST(ut_unit_real_time_printable);
@@ -423,6 +505,8 @@ int run_all_tests() {
     RUN_TEST(ut_unit_temperature_convert);
     RUN_TEST(ut_unit_exception_handling);
     RUN_TEST(ut_unit_meta);
+    RUN_TEST(ut_unit_dimensional_analysis);
+    RUN_TEST(ut_unit_compound_collapse);
     RUN_TEST(ut_unit_compound);
     RUN_TEST(ut_unit_compound_addition);
     RUN_TEST(ut_unit_compound_multiplication);
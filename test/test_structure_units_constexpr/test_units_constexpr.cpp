@@ -0,0 +1,122 @@
+#include <spine/core/fixed.hpp>
+#include <spine/structure/units/primitives/compound_unit.hpp>
+#include <spine/structure/units/si.hpp>
+#include <unity.h>
+
+// Every check in this file is a static_assert: if it compiles, the units library is constant evaluable. The Unity
+// tests below only repeat a few of them at runtime, such that the suite shows up in the test report.
+
+using spnu::CompoundUnit;
+
+namespace {
+
+// construction and conversion
+static_assert(k_time_m(30).raw() == 30);
+static_assert(k_time_s(k_time_m(30)).raw() == 1800);
+static_assert(k_time_ms(k_time_h(24)).raw() == 86400000);
+static_assert(k_time_s(k_time_ms(1500)).raw() == 2); // rounds half away from zero
+static_assert(k_time_s(k_time_ms(-1500)).raw() == -2);
+static_assert(meter_m(meter(1.5f)).raw() == 1500.0f);
+static_assert(to_real_time(k_time_ms(20)).raw() == 20.0f);
+static_assert(to_kernel_time(time_ms(1.4f)).raw() == 2);
+static_assert(to_kernel_time(time_ms(-1.4f)).raw() == -1);
+static_assert(to_kernel_time(time_ms(2.0f)).raw() == 2);
+static_assert(to_kelvin(celsius(0)) == kelvin(273.15f));
+
+// arithmetic
+static_assert(k_time_m(30) + k_time_h(1) == k_time_m(90));
+static_assert(k_time_h(1) + k_time_m(30) == k_time_h(2)); // the left hand side determines the magnitude
+static_assert((k_time_m(1) - k_time_s(90)).raw() == -1); // -0.5 minute, rounded away from zero
+static_assert(-k_time_ms(5) == k_time_ms(-5));
+static_assert(k_time_s(4) * 3 == k_time_s(12));
+static_assert(k_time_s(12) / 4 == k_time_s(3));
+static_assert(k_time_s(1).is_negative() == false);
+static_assert([] {
+    auto t = k_time_ms(100);
+    t += k_time_s(1);
+    t -= k_time_ms(50);
+    t *= 2;
+    t /= 3;
+    return t;
+}() == k_time_ms(700));
+static_assert([] {
+    auto t = k_time_ms();
+    t = k_time_s(2);
+    return t.raw();
+}() == 2000);
+
+// comparison
+static_assert(k_time_s(1) < k_time_ms(1400));
+static_assert(k_time_s(2) > k_time_ms(1999));
+static_assert(k_time_d(1) == k_time_h(24));
+static_assert(k_time_d(1) != k_time_h(25));
+static_assert(k_time_m(1) <= k_time_s(60) && k_time_m(1) >= k_time_s(60));
+static_assert(k_time_h(3) > k_time_m(150) && k_time_m(150) > k_time_h(2));
+static_assert(spnu::Unit<spnu::TagKernelTime, spnu::Year, spnu::KernelTimeRawType>(1)
+              > spnu::Unit<spnu::TagKernelTime, spnu::Month, spnu::KernelTimeRawType>(13));
+static_assert(meter(1) == meter_m(1000));
+static_assert(meter(1) != meter_m(1001));
+
+// dimensional analysis
+static_assert(std::is_same_v<decltype(newton(2) * meter(3)), joule>);
+static_assert((newton(2) * meter(3)).raw() == 6.0f);
+static_assert((joule(10) / time_s(2)).raw() == 5.0f);
+static_assert(meter(6) / meter(3) == 2.0f);
+
+// compound units
+static_assert(CompoundUnit<litre_ml, time_s>(litre_ml(500), time_s(2)).raw() == 250.0f);
+static_assert(CompoundUnit<litre_ml, time_s>(litre_ml(500), time_s(2))
+              == CompoundUnit<litre_ml, time_s>(litre_ml(250), time_s(1)));
+static_assert((CompoundUnit<litre_ml, time_s>(litre_ml(1), time_s(1))
+               + CompoundUnit<litre_ml, time_s>(litre_ml(1), time_s(2)))
+                  .raw()
+              == 1.5f);
+static_assert((CompoundUnit<litre_ml, time_s>(litre_ml(3), time_s(1)) * 2).raw() == 6.0f);
+static_assert([] {
+    auto c = CompoundUnit<litre_ml, time_s>(litre_ml(40), time_s(8));
+    c.simplify(1);
+    return c.numerator().raw() == 5.0f && c.denominator().raw() == 1.0f;
+}());
+static_assert(CompoundUnit<litre_ml, time_s>(litre_ml(500), time_s(2)).collapse().raw() == 0.00025f);
+
+// fixed point units
+using meter_q = spnu::Unit<spnu::TagLength, spnu::Base, spn::fixed_q16>;
+static_assert(meter_q(1.5f) + meter_q(2) == meter_q(3.5f));
+static_assert(meter_q(4) / 2 == meter_q(2));
+
+// constants used by the time structures fold to immediates
+constexpr auto day = k_time_s(k_time_h(24));
+static_assert(day.raw() == 86400);
+
+void ut_units_constexpr() {
+    constexpr auto t = k_time_s(k_time_m(30)) + k_time_ms(500);
+    TEST_ASSERT_EQUAL(1801, t.raw());
+    constexpr auto w = joule(10) / time_s(2);
+    TEST_ASSERT_EQUAL_FLOAT(5.0f, w.raw());
+    TEST_ASSERT_EQUAL(86400, day.raw());
+}
+
+} // namespace
+
+int run_all_tests() {
+    UNITY_BEGIN();
+    RUN_TEST(ut_units_constexpr);
+    return UNITY_END();
+}
+
+#if defined(ARDUINO)
+#    include <Arduino.h>
+void setup() {
+    // NOTE!!! Wait for >2 secs
+    // if board doesn't support software reset via Serial.DTR/RTS
+    delay(2000);
+    run_all_tests();
+}
+
+void loop() {}
+#else
+int main(int argc, char** argv) {
+    run_all_tests();
+    return 0;
+}
+#endif
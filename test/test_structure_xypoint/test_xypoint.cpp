@@ -76,10 +76,13 @@ void ut_xypoint_math() {
 
     c = a;
     c.normalize();
-    TEST_ASSERT_TRUE(c == vec(a.x / m, a.y / m));
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, a.x / m, c.x);
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, a.y / m, c.y);
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, 1.0f, c.mag());
 
-    c = a.dot(b);
-    TEST_ASSERT_TRUE(c == vec(a.x * b.x, a.y * b.y));
+    TEST_ASSERT_TRUE(a.dot(b) == a.x * b.x + a.y * b.y);
+    TEST_ASSERT_TRUE(a.dot(b) == 14);
+    TEST_ASSERT_TRUE(vec(1, 0).dot(vec(0, 1)) == 0);
 }
 
 } // namespace
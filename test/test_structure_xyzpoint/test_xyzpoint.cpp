@@ -77,10 +77,14 @@ void ut_xyzpoint_math() {
 
     c = a;
     c.normalize();
-    TEST_ASSERT_TRUE(c == vec(a.x / m, a.y / m, a.z / m));
-
-    c = a.dot(b);
-    TEST_ASSERT_TRUE(c == vec(a.x * b.x, a.y * b.y, a.z * b.z));
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, a.x / m, c.x);
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, a.y / m, c.y);
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, a.z / m, c.z);
+    TEST_ASSERT_FLOAT_WITHIN(FLT_EPSILON, 1.0f, c.mag());
+
+    TEST_ASSERT_TRUE(a.dot(b) == a.x * b.x + a.y * b.y + a.z * b.z);
+    TEST_ASSERT_TRUE(a.dot(b) == 32);
+    TEST_ASSERT_TRUE(vec(1, 0, 0).dot(vec(0, 1, 0)) == 0);
 }
 
 } // namespace